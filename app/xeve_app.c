@@ -234,6 +234,42 @@ static void print_config(ARGS_PARSER * args, XEVE_PARAM * param)
     if (param->rc_type == XEVE_RC_ABR || param->rc_type == XEVE_RC_CRF)
     {
         logv2("\tBit_Rate                 = %dkbps\n", param->bitrate);
+        if (param->pass > 0)
+        {
+            logv2("\trate-control pass        = %d (%s)\n", param->pass, param->stats);
+        }
+        if (param->row_vbv)
+        {
+            logv2("\trow VBV                  = on\n");
+        }
+    }
+    if (param->lookahead_threads > 0)
+    {
+        logv2("\tlookahead threads        = %d\n", param->lookahead_threads);
+    }
+    if (param->scenecut > 0)
+    {
+        logv2("\tscene cut                = %d\n", param->scenecut);
+    }
+    if (param->adaptive_gop)
+    {
+        logv2("\tadaptive GOP             = on\n");
+    }
+    if (param->zero_copy)
+    {
+        logv2("\tzero-copy input          = on\n");
+    }
+    if (param->me_spel_plane)
+    {
+        logv2("\tsub-pel ME planes        = %s\n", param->me_spel_plane == 1 ? "half-pel" : "quarter-pel");
+    }
+    if (param->me_cache)
+    {
+        logv2("\tME cache                 = on\n");
+    }
+    if (param->early_skip)
+    {
+        logv2("\tearly SKIP               = on\n");
     }
     if (args->input_depth == 8 && param->codec_bit_depth > 8)
     {
@@ -1400,6 +1436,19 @@ int main(int argc, const char **argv)
         (float)xeve_clk_msec(clk_tot)/pic_ocnt);
     logv2("Average encoding speed            = %.3f frames/sec\n",
         ((float)pic_ocnt * 1000) / ((float)xeve_clk_msec(clk_tot)));
+    if(param->threads > 1 && op_verbose >= VERBOSE_FRAME)
+    {
+        long long * wait_time = (long long *)malloc(sizeof(long long) * param->threads);
+        size = (int)sizeof(long long) * param->threads;
+        if(wait_time && xeve_config(id, XEVE_CFG_GET_THREAD_WAIT_TIME, wait_time, &size) == XEVE_OK)
+        {
+            for(i = 0; i < param->threads; i++)
+            {
+                logv3("Dependency waiting time (thread %d) = %.3f msec\n", i, (float)wait_time[i] / 1000);
+            }
+        }
+        if(wait_time) free(wait_time);
+    }
     logv2_line(NULL);
 
     if (is_max_frames && pic_ocnt != max_frames)
@@ -195,6 +195,42 @@ static const ARGS_OPT args_opt_table[] = \
         ARGS_NO_KEY,  "closed-gop", ARGS_VAL_TYPE_NONE, 0, NULL,
         "use closed GOP structure. if not set, open GOP is used"
     },
+    {
+        ARGS_NO_KEY,  "zero-copy", ARGS_VAL_TYPE_NONE, 0, NULL,
+        "encode input pictures without copying them when the input bit depth\n"
+        "      is the same as the codec bit depth"
+    },
+    {
+        ARGS_NO_KEY,  "isa", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "instruction set of the optimized kernels, at most\n"
+        "      - 0: best one supported by the CPU (default)\n"
+        "      - 1: C\n"
+        "      - 2: SSE4.1\n"
+        "      - 3: AVX2\n"
+        "      - 4: AVX-512"
+    },
+    {
+        ARGS_NO_KEY,  "me-spel-plane", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "pre-interpolated sub-pel planes of reference pictures for motion\n"
+        "      estimation\n"
+        "      - 0: off\n"
+        "      - 1: half-pel planes\n"
+        "      - 2: half-pel and quarter-pel planes"
+    },
+    {
+        ARGS_NO_KEY,  "me-cache", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "seed the motion search of a CU with the best MVs of the other CU\n"
+        "      shapes searched over the same area of the CTU\n"
+        "      - 0: off\n"
+        "      - 1: on"
+    },
+    {
+        ARGS_NO_KEY,  "early-skip", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "stop the inter mode decision of a CU at SKIP when the residual\n"
+        "      of the best SKIP candidate certainly quantises to zero\n"
+        "      - 0: off\n"
+        "      - 1: on"
+    },
     {
         ARGS_NO_KEY,  "ibc", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "use IBC feature. if not set, IBC feature is disabled"
@@ -420,10 +456,45 @@ static const ARGS_OPT args_opt_table[] = \
         ARGS_NO_KEY,  "use-filler", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "user filler flag"
     },
+    {
+        ARGS_NO_KEY,  "pass", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "multi-pass rate control\n"
+        "      - 0: single pass\n"
+        "      - 1: first pass, write statistics to the stats file\n"
+        "      - 2: second pass, read statistics from the stats file (ABR only)"
+    },
+    {
+        ARGS_NO_KEY,  "stats", ARGS_VAL_TYPE_STRING, 0, NULL,
+        "file name of the multi-pass rate control statistics"
+    },
+    {
+        ARGS_NO_KEY,  "row-vbv", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "CTU-row level rate control keeping frames inside the VBV buffer\n"
+        "      - 0: off, one qp per frame\n"
+        "      - 1: on, qp of every CTU row follows the VBV buffer"
+    },
     {
         ARGS_NO_KEY,  "lookahead", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "number of pre analysis frames for rate control and cutree, disable:0"
     },
+    {
+        ARGS_NO_KEY,  "lookahead-threads", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "number of threads running the pre analysis ahead of the encoder\n"
+        "      - 0: pre analysis runs inside the encoding call\n"
+        "      - N: N threads, one more frame of latency"
+    },
+    {
+        ARGS_NO_KEY,  "scenecut", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "insert I pictures at scene cuts found by the pre analysis\n"
+        "      - 0: off\n"
+        "      - N: sensitivity (1-100), higher value inserts more I pictures"
+    },
+    {
+        ARGS_NO_KEY,  "adaptive-gop", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "choose the number of B pictures per mini-GOP by the pre analysis\n"
+        "      - 0: off, fixed mini-GOP\n"
+        "      - 1: on (main profile only)"
+    },
     {
         ARGS_NO_KEY,  "chroma-qp-table-present-flag", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "chroma-qp-table-present-flag"
@@ -1090,7 +1161,18 @@ static int args_init(ARGS_PARSER * args, XEVE_PARAM* param)
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, level_idc);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, rc_type);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, use_filler);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, zero_copy);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, pass);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, stats);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, row_vbv);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, isa);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, me_spel_plane);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, me_cache);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, early_skip);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, lookahead);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, lookahead_threads);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, scenecut);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, adaptive_gop);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, ref);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, sar_width);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, sar_height);
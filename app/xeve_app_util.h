@@ -474,6 +474,22 @@ static void imgb_cpy(XEVE_IMGB * dst, XEVE_IMGB * src)
     }
 }
 
+/* reference count of an image buffer held by the encoder (zero-copy input) */
+static int imgb_addref(XEVE_IMGB * imgb)
+{
+    return ++imgb->refcnt;
+}
+
+static int imgb_getref(XEVE_IMGB * imgb)
+{
+    return imgb->refcnt;
+}
+
+static int imgb_release(XEVE_IMGB * imgb)
+{
+    return --imgb->refcnt;
+}
+
 static void imgb_free(XEVE_IMGB * imgb)
 {
     int i;
@@ -536,6 +552,9 @@ XEVE_IMGB * imgb_alloc(int w, int h, int cs)
         memset(imgb->a[i], 0, imgb->bsize[i]);
     }
     imgb->cs = cs;
+    imgb->addref = imgb_addref;
+    imgb->getref = imgb_getref;
+    imgb->release = imgb_release;
     return imgb;
 
 ERR:
@@ -615,7 +634,7 @@ static IMGB_LIST *imgb_list_get_empty(IMGB_LIST *list)
     /* store original imgb for XEVE_TUNE_PSNR */
     for(i=0; i<MAX_BUMP_FRM_CNT; i++)
     {
-        if(list[i].used == 0)
+        if(list[i].used == 0 && list[i].imgb->getref(list[i].imgb) == 0)
         {
             return &list[i];
         }
@@ -39,7 +39,8 @@ extern "C"
 
 #include <xeve_exports.h>
 
-#define XEVE_MAX_THREADS                 (8)
+/* upper bound of threads, per-thread contexts are allocated for the requested number only */
+#define XEVE_MAX_THREADS                 (256)
 #define XEVE_MAX_NUM_TILES_ROW           (22)
 #define XEVE_MAX_NUM_TILES_COL           (20)
 
@@ -151,6 +152,7 @@ extern "C"
 #define XEVE_CFG_GET_HEIGHT             (702)
 #define XEVE_CFG_GET_RECON              (703)
 #define XEVE_CFG_GET_SUPPORT_PROF       (704)
+#define XEVE_CFG_GET_THREAD_WAIT_TIME   (705) /* long long array (us), one per thread */
 
 /*****************************************************************************
  * NALU types
@@ -326,6 +328,15 @@ typedef struct _XEVE_BITB
 #define XEVE_RC_ABR                             1
 #define XEVE_RC_CRF                             2
 
+/*****************************************************************************
+ * instruction sets of the optimized kernels
+ *****************************************************************************/
+#define XEVE_ISA_AUTO                           0
+#define XEVE_ISA_C                              1
+#define XEVE_ISA_SSE                            2
+#define XEVE_ISA_AVX2                           3
+#define XEVE_ISA_AVX512                         4
+
 /*****************************************************************************
  * coding parameters
  *****************************************************************************/
@@ -538,6 +549,65 @@ typedef struct _XEVE_PARAM
     int  master_display;
     int  max_cll;
     int  max_fall;
+
+    /* options added after the first release, kept at the end of the structure
+       so that the offsets of the fields above remain unchanged */
+    /* number of threads of the asynchronous lookahead
+       - 0 : lookahead runs inside the encoding call (default)
+       - N : lookahead runs on N threads ahead of the encoder,
+             with one more frame of latency */
+    int            lookahead_threads;
+    /* scene cut detection by the lookahead
+       - 0 : off (default)
+       - N : the anchor picture of a GOP is coded as an I picture when
+             its inter cost reaches (100 - N) percent of its intra cost */
+    int            scenecut;
+    /* adaptive mini-GOP by the lookahead (main profile)
+       - 0 : off, every mini-GOP has bframes B pictures (default)
+       - 1 : a GOP is halved into shorter mini-GOPs (down to 4 pictures)
+             while two anchors at half the distance cost less than one
+             anchor and its bi-predicted middle picture */
+    int            adaptive_gop;
+    /* use input pictures of the caller without copying
+       - 0 : input pictures are copied into internal buffers (default)
+       - 1 : input pictures in the internal format are referenced by
+             addref() at push and release() when they have been encoded */
+    int            zero_copy;
+    /* multi-pass rate control
+       - 0 : single pass (default)
+       - 1 : first pass, write per-frame statistics to 'stats'
+       - 2 : second pass, allocate bits from the statistics in 'stats' */
+    int            pass;
+    /* file name of the multi-pass rate control statistics */
+    char           stats[256];
+    /* CTU-row level rate control keeping every frame inside the VBV buffer
+       - 0 : off, one qp per frame (default)
+       - 1 : on, the qp of every CTU row is adjusted while the frame is coded */
+    int            row_vbv;
+    /* instruction set of the optimized kernels
+       - XEVE_ISA_AUTO : the best one supported by the CPU (default)
+       - XEVE_ISA_C .. XEVE_ISA_AVX512 : at most the given one, for comparing
+         the kernel tiers. on ARM, every value but XEVE_ISA_C selects NEON */
+    int            isa;
+    /* pre-interpolated sub-pel planes of the reference pictures for the
+       sub-pel motion search. each plane takes the size of a padded luma plane
+       per reference picture
+       - 0 : off, candidates are interpolated block by block (default)
+       - 1 : 3 half-pel planes
+       - 2 : 15 half- and quarter-pel planes */
+    int            me_spel_plane;
+    /* motion search cache of the CTU: the best integer MVs found for the CU
+       shapes searched so far seed the search of the following shapes over
+       the same area, which then stops earlier
+       - 0 : off (default)
+       - 1 : on */
+    int            me_cache;
+    /* early SKIP decision: a CU whose best SKIP candidate leaves a residual
+       that is certain to quantise to zero in every component skips the
+       remaining inter modes (merge with residual, motion search, affine)
+       - 0 : off (default)
+       - 1 : on */
+    int            early_skip;
 } XEVE_PARAM;
 
 /*****************************************************************************
@@ -50,7 +50,7 @@ dst = _mm256_srai_epi32(dst, shift);\
 dst = _mm256_max_epi32( dst, min);\
 dst = _mm256_min_epi32( dst, max);
 
-static void itx_pb4b_avx(void *src, void *dst, int shift, int line, int step)
+void xeve_itx_pb4b_avx(void *src, void *dst, int shift, int line, int step)
 {
     int add = shift == 0 ? 0 : 1 << (shift - 1);
 
@@ -236,7 +236,7 @@ static void itx_pb4b_avx(void *src, void *dst, int shift, int line, int step)
 
 }
 
-static void itx_pb8b_avx(void *src, void *dst, int shift, int line, int step)
+void xeve_itx_pb8b_avx(void *src, void *dst, int shift, int line, int step)
 {
     int add = shift == 0 ? 0 : 1 << (shift - 1);
 
@@ -552,7 +552,7 @@ static void itx_pb8b_avx(void *src, void *dst, int shift, int line, int step)
     }
 }
 
-static void itx_pb16b_avx(void *src, void *dst, int shift, int line, int step)
+void xeve_itx_pb16b_avx(void *src, void *dst, int shift, int line, int step)
 {
     int add = shift == 0 ? 0 : 1 << (shift - 1);
 
@@ -1082,7 +1082,7 @@ dst = _mm256_add_epi32(v0, v1);
     }
 }
 
-static void itx_pb32b_avx(void *src, void *dst, int shift, int line, int step)
+void xeve_itx_pb32b_avx(void *src, void *dst, int shift, int line, int step)
 {
     int add = shift == 0 ? 0 : 1 << (shift - 1);
 
@@ -1631,7 +1631,7 @@ dst = _mm256_add_epi32(v[0], v[1]);
 
 }
 
-static void itx_pb64b_avx(void *src, void *dst, int shift, int line, int step)
+void xeve_itx_pb64b_avx(void *src, void *dst, int shift, int line, int step)
 {
     int add = shift == 0 ? 0 : 1 << (shift - 1);
     int i_src[64];
@@ -2481,9 +2481,9 @@ dst = _mm256_add_epi32(v[0], v[1]);
 const XEVE_ITXB xeve_tbl_itxb_avx[MAX_TR_LOG2] =
 {
     xeve_itx_pb2b,
-    itx_pb4b_avx,
-    itx_pb8b_avx,
-    itx_pb16b_avx,
-    itx_pb32b_avx,
-    itx_pb64b_avx
+    xeve_itx_pb4b_avx,
+    xeve_itx_pb8b_avx,
+    xeve_itx_pb16b_avx,
+    xeve_itx_pb32b_avx,
+    xeve_itx_pb64b_avx
 };
@@ -33,6 +33,12 @@
 
 #if X86_SSE
 extern const XEVE_ITXB xeve_tbl_itxb_avx[MAX_TR_LOG2];
+
+void xeve_itx_pb4b_avx(void *src, void *dst, int shift, int line, int step);
+void xeve_itx_pb8b_avx(void *src, void *dst, int shift, int line, int step);
+void xeve_itx_pb16b_avx(void *src, void *dst, int shift, int line, int step);
+void xeve_itx_pb32b_avx(void *src, void *dst, int shift, int line, int step);
+void xeve_itx_pb64b_avx(void *src, void *dst, int shift, int line, int step);
 #endif /* X86_SSE */
 
 #endif /* _XEVE_ITDQ_AVX_H_  */
@@ -1875,3 +1875,31 @@ const XEVE_MC_C xeve_tbl_mc_c_avx[2][2] =
         xeve_mc_c_nn_avx  /* dx != 0 && dy != 0 */
     }
 };
+
+void xeve_average_16b_no_clip_avx(s16 *src, s16 *ref, s16 *dst, int s_src, int s_ref, int s_dst, int wd, int ht)
+{
+    __m256i m0, m1, offset_16x16b;
+    int i, j;
+
+    if(wd & 15)
+    {
+        xeve_average_16b_no_clip_sse(src, ref, dst, s_src, s_ref, s_dst, wd, ht);
+        return;
+    }
+
+    offset_16x16b = _mm256_set1_epi16(1);
+
+    for(i = 0; i < ht; i++)
+    {
+        for(j = 0; j < wd; j += 16)
+        {
+            m0 = _mm256_loadu_si256((__m256i *)(src + j));
+            m1 = _mm256_loadu_si256((__m256i *)(ref + j));
+            m0 = _mm256_add_epi16(_mm256_add_epi16(m0, m1), offset_16x16b);
+            _mm256_storeu_si256((__m256i *)(dst + j), _mm256_srai_epi16(m0, 1));
+        }
+        src += s_src;
+        ref += s_ref;
+        dst += s_dst;
+    }
+}
@@ -37,6 +37,15 @@
 
 extern const XEVE_MC_L xeve_tbl_mc_l_avx[2][2];
 extern const XEVE_MC_C xeve_tbl_mc_c_avx[2][2];
+
+void xeve_mc_l_n0_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16(*mc_l_coeff)[8]);
+void xeve_mc_l_0n_avx(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16(*mc_l_coeff)[8]);
+void xeve_mc_l_nn_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16(*mc_l_coeff)[8]);
+void xeve_mc_c_n0_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16(*mc_c_coeff)[4]);
+void xeve_mc_c_0n_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16(*mc_c_coeff)[4]);
+void xeve_mc_c_nn_avx(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16(*mc_c_coeff)[4]);
+
+void xeve_average_16b_no_clip_avx(s16 *src, s16 *ref, s16 *dst, int s_src, int s_ref, int s_dst, int wd, int ht);
 #endif /* X86_SSE */
 
 #endif /* _XEVE_MC_SSE_H_ */
@@ -198,4 +198,381 @@ const XEVE_FN_SAD xeve_tbl_sad_16b_avx[8][8] =
     }
 };
 
-#endif
\ No newline at end of file
+/* DIFF **********************************************************************/
+static void diff_16b_avx_16nx1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+{
+    s16 * s1 = (s16 *)src1;
+    s16 * s2 = (s16 *)src2;
+    __m256i m0, m1;
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j += 16)
+        {
+            m0 = _mm256_loadu_si256((__m256i *)(s1 + j));
+            m1 = _mm256_loadu_si256((__m256i *)(s2 + j));
+            _mm256_storeu_si256((__m256i *)(diff + j), _mm256_sub_epi16(m0, m1));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+        diff += s_diff;
+    }
+}
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_DIFF xeve_tbl_diff_16b_avx[8][8] =
+{
+    /* width == 1 */
+    {
+        diff_16b, /* height == 1 */
+        diff_16b, /* height == 2 */
+        diff_16b, /* height == 4 */
+        diff_16b, /* height == 8 */
+        diff_16b, /* height == 16 */
+        diff_16b, /* height == 32 */
+        diff_16b, /* height == 64 */
+        diff_16b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        diff_16b, /* height == 1 */
+        diff_16b, /* height == 2 */
+        diff_16b, /* height == 4 */
+        diff_16b, /* height == 8 */
+        diff_16b, /* height == 16 */
+        diff_16b, /* height == 32 */
+        diff_16b, /* height == 64 */
+        diff_16b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        diff_16b,         /* height == 1 */
+        diff_16b_sse_4x2, /* height == 2 */
+        diff_16b_sse_4x4, /* height == 4 */
+        diff_16b,         /* height == 8 */
+        diff_16b,         /* height == 16 */
+        diff_16b,         /* height == 32 */
+        diff_16b,         /* height == 64 */
+        diff_16b,         /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        diff_16b,           /* height == 1 */
+        diff_16b_sse_8nx2n, /* height == 2 */
+        diff_16b_sse_8nx2n, /* height == 4 */
+        diff_16b_sse_8x8,   /* height == 8 */
+        diff_16b_sse_8nx2n, /* height == 16 */
+        diff_16b_sse_8nx2n, /* height == 32 */
+        diff_16b_sse_8nx2n, /* height == 64 */
+        diff_16b_sse_8nx2n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        diff_16b_avx_16nx1n, /* height == 1 */
+        diff_16b_avx_16nx1n, /* height == 2 */
+        diff_16b_avx_16nx1n, /* height == 4 */
+        diff_16b_avx_16nx1n, /* height == 8 */
+        diff_16b_avx_16nx1n, /* height == 16 */
+        diff_16b_avx_16nx1n, /* height == 32 */
+        diff_16b_avx_16nx1n, /* height == 64 */
+        diff_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        diff_16b_avx_16nx1n, /* height == 1 */
+        diff_16b_avx_16nx1n, /* height == 2 */
+        diff_16b_avx_16nx1n, /* height == 4 */
+        diff_16b_avx_16nx1n, /* height == 8 */
+        diff_16b_avx_16nx1n, /* height == 16 */
+        diff_16b_avx_16nx1n, /* height == 32 */
+        diff_16b_avx_16nx1n, /* height == 64 */
+        diff_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        diff_16b_avx_16nx1n, /* height == 1 */
+        diff_16b_avx_16nx1n, /* height == 2 */
+        diff_16b_avx_16nx1n, /* height == 4 */
+        diff_16b_avx_16nx1n, /* height == 8 */
+        diff_16b_avx_16nx1n, /* height == 16 */
+        diff_16b_avx_16nx1n, /* height == 32 */
+        diff_16b_avx_16nx1n, /* height == 64 */
+        diff_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        diff_16b_avx_16nx1n, /* height == 1 */
+        diff_16b_avx_16nx1n, /* height == 2 */
+        diff_16b_avx_16nx1n, /* height == 4 */
+        diff_16b_avx_16nx1n, /* height == 8 */
+        diff_16b_avx_16nx1n, /* height == 16 */
+        diff_16b_avx_16nx1n, /* height == 32 */
+        diff_16b_avx_16nx1n, /* height == 64 */
+        diff_16b_avx_16nx1n, /* height == 128 */
+    }
+};
+
+/* SSD ***********************************************************************/
+/* squared differences are shifted sample by sample as in ssd_16b() and
+   accumulated into eight 32-bit lanes */
+#define AVX_SSD_16B_ACC(m0, m1, shift, acc) \
+    m1 = _mm256_mulhi_epi16(m0, m0); \
+    m0 = _mm256_mullo_epi16(m0, m0); \
+    acc = _mm256_add_epi32(acc, _mm256_srli_epi32(_mm256_unpacklo_epi16(m0, m1), shift)); \
+    acc = _mm256_add_epi32(acc, _mm256_srli_epi32(_mm256_unpackhi_epi16(m0, m1), shift));
+
+static s64 ssd_16b_avx_sum(__m256i acc)
+{
+    __m128i m = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    s64 ssd;
+
+    ssd  = (u32)_mm_extract_epi32(m, 0);
+    ssd += (u32)_mm_extract_epi32(m, 1);
+    ssd += (u32)_mm_extract_epi32(m, 2);
+    ssd += (u32)_mm_extract_epi32(m, 3);
+
+    return ssd;
+}
+
+static s64 ssd_16b_avx_8x2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1 = (s16 *)src1;
+    s16 * s2 = (s16 *)src2;
+    const int shift = (bit_depth - 8) << 1;
+    __m256i m0, m1, acc = _mm256_setzero_si256();
+    int i;
+
+    for(i = 0; i < h; i += 2)
+    {
+        m0 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)s1)), _mm_loadu_si128((__m128i *)(s1 + s_src1)), 1);
+        m1 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i *)s2)), _mm_loadu_si128((__m128i *)(s2 + s_src2)), 1);
+        m0 = _mm256_sub_epi16(m0, m1);
+        AVX_SSD_16B_ACC(m0, m1, shift, acc);
+        s1 += s_src1 << 1;
+        s2 += s_src2 << 1;
+    }
+    return ssd_16b_avx_sum(acc);
+}
+
+static s64 ssd_16b_avx_16nx1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1 = (s16 *)src1;
+    s16 * s2 = (s16 *)src2;
+    const int shift = (bit_depth - 8) << 1;
+    __m256i m0, m1, acc = _mm256_setzero_si256();
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j += 16)
+        {
+            m0 = _mm256_sub_epi16(_mm256_loadu_si256((__m256i *)(s1 + j)), _mm256_loadu_si256((__m256i *)(s2 + j)));
+            AVX_SSD_16B_ACC(m0, m1, shift, acc);
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+    return ssd_16b_avx_sum(acc);
+}
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SSD xeve_tbl_ssd_16b_avx[8][8] =
+{
+    /* width == 1 */
+    {
+        ssd_16b, /* height == 1 */
+        ssd_16b, /* height == 2 */
+        ssd_16b, /* height == 4 */
+        ssd_16b, /* height == 8 */
+        ssd_16b, /* height == 16 */
+        ssd_16b, /* height == 32 */
+        ssd_16b, /* height == 64 */
+        ssd_16b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        ssd_16b, /* height == 1 */
+        ssd_16b, /* height == 2 */
+        ssd_16b, /* height == 4 */
+        ssd_16b, /* height == 8 */
+        ssd_16b, /* height == 16 */
+        ssd_16b, /* height == 32 */
+        ssd_16b, /* height == 64 */
+        ssd_16b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        ssd_16b,          /* height == 1 */
+        ssd_16b_sse_4x2,  /* height == 2 */
+        ssd_16b_sse_4x4,  /* height == 4 */
+        ssd_16b_sse_4x8,  /* height == 8 */
+        ssd_16b_sse_4x16, /* height == 16 */
+        ssd_16b_sse_4x32, /* height == 32 */
+        ssd_16b,          /* height == 64 */
+        ssd_16b,          /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        ssd_16b,          /* height == 1 */
+        ssd_16b_avx_8x2n, /* height == 2 */
+        ssd_16b_avx_8x2n, /* height == 4 */
+        ssd_16b_avx_8x2n, /* height == 8 */
+        ssd_16b_avx_8x2n, /* height == 16 */
+        ssd_16b_avx_8x2n, /* height == 32 */
+        ssd_16b_avx_8x2n, /* height == 64 */
+        ssd_16b_avx_8x2n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        ssd_16b_avx_16nx1n, /* height == 1 */
+        ssd_16b_avx_16nx1n, /* height == 2 */
+        ssd_16b_avx_16nx1n, /* height == 4 */
+        ssd_16b_avx_16nx1n, /* height == 8 */
+        ssd_16b_avx_16nx1n, /* height == 16 */
+        ssd_16b_avx_16nx1n, /* height == 32 */
+        ssd_16b_avx_16nx1n, /* height == 64 */
+        ssd_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        ssd_16b_avx_16nx1n, /* height == 1 */
+        ssd_16b_avx_16nx1n, /* height == 2 */
+        ssd_16b_avx_16nx1n, /* height == 4 */
+        ssd_16b_avx_16nx1n, /* height == 8 */
+        ssd_16b_avx_16nx1n, /* height == 16 */
+        ssd_16b_avx_16nx1n, /* height == 32 */
+        ssd_16b_avx_16nx1n, /* height == 64 */
+        ssd_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        ssd_16b_avx_16nx1n, /* height == 1 */
+        ssd_16b_avx_16nx1n, /* height == 2 */
+        ssd_16b_avx_16nx1n, /* height == 4 */
+        ssd_16b_avx_16nx1n, /* height == 8 */
+        ssd_16b_avx_16nx1n, /* height == 16 */
+        ssd_16b_avx_16nx1n, /* height == 32 */
+        ssd_16b_avx_16nx1n, /* height == 64 */
+        ssd_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        ssd_16b_avx_16nx1n, /* height == 1 */
+        ssd_16b_avx_16nx1n, /* height == 2 */
+        ssd_16b_avx_16nx1n, /* height == 4 */
+        ssd_16b_avx_16nx1n, /* height == 8 */
+        ssd_16b_avx_16nx1n, /* height == 16 */
+        ssd_16b_avx_16nx1n, /* height == 32 */
+        ssd_16b_avx_16nx1n, /* height == 64 */
+        ssd_16b_avx_16nx1n, /* height == 128 */
+    }
+};
+
+/* SATD **********************************************************************/
+/* 8x8 transpose of 16-bit samples within each 128-bit lane */
+#define AVX_TRANSPOSE_8x8_16B(s, o) \
+{ \
+    __m256i a0, a1, b0, b1, c0, c1, d0, d1, e0, e1, f0, f1, g0, g1, h0, h1; \
+    a0 = _mm256_unpacklo_epi16(s[0], s[1]); a1 = _mm256_unpackhi_epi16(s[0], s[1]); \
+    b0 = _mm256_unpacklo_epi16(s[2], s[3]); b1 = _mm256_unpackhi_epi16(s[2], s[3]); \
+    c0 = _mm256_unpacklo_epi16(s[4], s[5]); c1 = _mm256_unpackhi_epi16(s[4], s[5]); \
+    d0 = _mm256_unpacklo_epi16(s[6], s[7]); d1 = _mm256_unpackhi_epi16(s[6], s[7]); \
+    e0 = _mm256_unpacklo_epi32(a0, b0); e1 = _mm256_unpackhi_epi32(a0, b0); \
+    f0 = _mm256_unpacklo_epi32(c0, d0); f1 = _mm256_unpackhi_epi32(c0, d0); \
+    g0 = _mm256_unpacklo_epi32(a1, b1); g1 = _mm256_unpackhi_epi32(a1, b1); \
+    h0 = _mm256_unpacklo_epi32(c1, d1); h1 = _mm256_unpackhi_epi32(c1, d1); \
+    o[0] = _mm256_unpacklo_epi64(e0, f0); o[1] = _mm256_unpackhi_epi64(e0, f0); \
+    o[2] = _mm256_unpacklo_epi64(e1, f1); o[3] = _mm256_unpackhi_epi64(e1, f1); \
+    o[4] = _mm256_unpacklo_epi64(g0, h0); o[5] = _mm256_unpackhi_epi64(g0, h0); \
+    o[6] = _mm256_unpacklo_epi64(g1, h1); o[7] = _mm256_unpackhi_epi64(g1, h1); \
+}
+
+/* 8-point Hadamard butterflies in the output order of xeve_had_8x8_sse() */
+#define AVX_HAD_8PT(r, o, add, sub) \
+{ \
+    __m256i p0, p1, p2, p4, p5, p6; \
+    p0 = add(r[0], r[1]); p2 = add(r[2], r[3]); p4 = add(r[4], r[5]); p6 = add(r[6], r[7]); \
+    p1 = add(p0, p2); p5 = add(p4, p6); o[0] = add(p1, p5); o[4] = sub(p1, p5); \
+    p1 = sub(p0, p2); p5 = sub(p4, p6); o[2] = add(p1, p5); o[6] = sub(p1, p5); \
+    p0 = sub(r[0], r[1]); p2 = sub(r[2], r[3]); p4 = sub(r[4], r[5]); p6 = sub(r[6], r[7]); \
+    p1 = add(p0, p2); p5 = add(p4, p6); o[1] = add(p1, p5); o[5] = sub(p1, p5); \
+    p1 = sub(p0, p2); p5 = sub(p4, p6); o[3] = add(p1, p5); o[7] = sub(p1, p5); \
+}
+
+/* two horizontally adjacent 8x8 blocks, one per 128-bit lane, with the
+   arithmetic and rounding of xeve_had_8x8_sse() applied to each block */
+static int had_8x8x2_avx(pel *org, pel *cur, int s_org, int s_cur)
+{
+    __m256i r[8], t[8], lo[8], hi[8], acc;
+    int i, sad0, sad1;
+
+    for(i = 0; i < 8; i++)
+    {
+        r[i] = _mm256_sub_epi16(_mm256_loadu_si256((__m256i *)(org + i * s_org)), _mm256_loadu_si256((__m256i *)(cur + i * s_cur)));
+    }
+
+    /* horizontal transform on 16-bit */
+    AVX_TRANSPOSE_8x8_16B(r, t);
+    AVX_HAD_8PT(t, r, _mm256_add_epi16, _mm256_sub_epi16);
+    AVX_TRANSPOSE_8x8_16B(r, t);
+
+    /* vertical transform on 32-bit, first and last four columns */
+    for(i = 0; i < 8; i++)
+    {
+        r[i] = _mm256_srai_epi32(_mm256_unpacklo_epi16(t[i], t[i]), 16);
+        t[i] = _mm256_srai_epi32(_mm256_unpackhi_epi16(t[i], t[i]), 16);
+    }
+    AVX_HAD_8PT(r, lo, _mm256_add_epi32, _mm256_sub_epi32);
+    AVX_HAD_8PT(t, hi, _mm256_add_epi32, _mm256_sub_epi32);
+
+    /* DC of each block is scaled down */
+    acc = _mm256_abs_epi32(lo[0]);
+    acc = _mm256_blend_epi32(acc, _mm256_srai_epi32(acc, 2), 0x11);
+    for(i = 1; i < 8; i++)
+    {
+        acc = _mm256_add_epi32(acc, _mm256_abs_epi32(lo[i]));
+    }
+    for(i = 0; i < 8; i++)
+    {
+        acc = _mm256_add_epi32(acc, _mm256_abs_epi32(hi[i]));
+    }
+    acc = _mm256_hadd_epi32(acc, acc);
+    acc = _mm256_hadd_epi32(acc, acc);
+
+    sad0 = _mm_cvtsi128_si32(_mm256_castsi256_si128(acc));
+    sad1 = _mm_cvtsi128_si32(_mm256_extracti128_si256(acc, 1));
+
+    return ((sad0 + 2) >> 2) + ((sad1 + 2) >> 2);
+}
+
+static int xeve_had_avx(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_depth)
+{
+    pel *org = o;
+    pel *cur = c;
+    int  x, y;
+    int  sum = 0;
+
+    /* square blocks are covered by 8x8 transforms in xeve_had_sse() */
+    if(w == h && (w & 15) == 0)
+    {
+        for(y = 0; y < h; y += 8)
+        {
+            for(x = 0; x < w; x += 16)
+            {
+                sum += had_8x8x2_avx(&org[x], &cur[x], s_org, s_cur);
+            }
+            org += s_org << 3;
+            cur += s_cur << 3;
+        }
+        return (sum >> (bit_depth - 8));
+    }
+    return xeve_had_sse(w, h, o, c, s_org, s_cur, bit_depth);
+}
+
+const XEVE_FN_SATD xeve_tbl_satd_16b_avx[1] =
+{
+    xeve_had_avx,
+};
+
+#endif
@@ -36,5 +36,8 @@
 
 #if X86_SSE
 extern const XEVE_FN_SAD xeve_tbl_sad_16b_avx[8][8];
+extern const XEVE_FN_SSD xeve_tbl_ssd_16b_avx[8][8];
+extern const XEVE_FN_DIFF xeve_tbl_diff_16b_avx[8][8];
+extern const XEVE_FN_SATD xeve_tbl_satd_16b_avx[1];
 #endif /* X86_SSE */
 #endif /* _XEVE_SAD_AVX_H_ */
\ No newline at end of file
@@ -66,7 +66,7 @@ ALIGNED_32(static const s16 tab_dct2_1st_shuffle_256i[][16]) = {
 };
 
 
-static void tx_pb8b_avx(void* src_, void* dst_, int shift, int line, int step)
+void xeve_tx_pb8b_avx(void* src_, void* dst_, int shift, int line, int step)
 {
     if (line % 8 != 0 || step == 1)
     {
@@ -128,7 +128,7 @@ static void tx_pb8b_avx(void* src_, void* dst_, int shift, int line, int step)
     
 }
 
-static void tx_pb16b_avx(void* src, void* dst, int shift, int line, int step)
+void xeve_tx_pb16b_avx(void* src, void* dst, int shift, int line, int step)
 {
     if (line % 8 != 0 || step == 1)
     {
@@ -226,7 +226,7 @@ static void tx_pb16b_avx(void* src, void* dst, int shift, int line, int step)
     
 }
 
-static void tx_pb32b_avx(void* src, void* dst, int shift, int line, int step)
+void xeve_tx_pb32b_avx(void* src, void* dst, int shift, int line, int step)
 {
     if (line % 8 != 0 || step == 1)
     {
@@ -611,7 +611,7 @@ static void tx_pb32b_avx(void* src, void* dst, int shift, int line, int step)
     }
 }
 
-static void tx_pb64b_avx(void* src, void* dst, int shift, int line, int step)
+void xeve_tx_pb64b_avx(void* src, void* dst, int shift, int line, int step)
 {
     if (line % 4 != 0 || step == 1)
     {
@@ -996,8 +996,141 @@ const XEVE_TXB xeve_tbl_txb_avx[MAX_TR_LOG2] =
 {
     tx_pb2b,
     tx_pb4b,
-    tx_pb8b_avx,
-    tx_pb16b_avx,
-    tx_pb32b_avx,
-    tx_pb64b_avx
-};
\ No newline at end of file
+    xeve_tx_pb8b_avx,
+    xeve_tx_pb16b_avx,
+    xeve_tx_pb32b_avx,
+    xeve_tx_pb64b_avx
+};
+static __inline u32 hmax_epu16_avx(__m256i v)
+{
+    __m128i m = _mm_max_epu16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+
+    return 0xFFFF - _mm_extract_epi16(_mm_minpos_epu16(_mm_xor_si128(m, _mm_set1_epi16(-1))), 0);
+}
+
+/* number of zero lanes counted with cmpeq/sub into sixteen 16 bit lanes */
+static __inline int hsum_epi16_avx(__m256i v)
+{
+    __m128i s;
+
+    v = _mm256_madd_epi16(v, _mm256_set1_epi16(1));
+    s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+}
+
+u32 xeve_coef_abs_max_avx(s16 * coef, int num)
+{
+    __m256i max = _mm256_setzero_si256();
+    int i;
+
+    if(num & 15)
+    {
+        return xeve_coef_abs_max_sse(coef, num);
+    }
+    for(i = 0; i < num; i += 16)
+    {
+        max = _mm256_max_epu16(max, _mm256_abs_epi16(_mm256_loadu_si256((__m256i *)(coef + i))));
+    }
+    return hmax_epu16_avx(max);
+}
+
+static __inline __m256i quant_epu32_avx(__m256i a, __m256i scale, __m256i offset, __m128i shift)
+{
+    __m256i e = _mm256_srl_epi64(_mm256_add_epi64(_mm256_mul_epu32(a, scale), offset), shift);
+    __m256i o = _mm256_srl_epi64(_mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), scale), offset), shift);
+
+    return _mm256_blend_epi32(e, _mm256_slli_epi64(o, 32), 0xAA);
+}
+
+int xeve_quant_avx(s16 * coef, int num, int scale, s64 offset, int shift)
+{
+    __m256i vscale, voffset, c, a, lo, hi, zeros;
+    __m256i zero = _mm256_setzero_si256();
+    __m128i vshift;
+    int i;
+
+    if(num & 15)
+    {
+        return xeve_quant_sse(coef, num, scale, offset, shift);
+    }
+
+    if((((s64)xeve_coef_abs_max_avx(coef, num) * scale + offset) >> shift) == 0)
+    {
+        xeve_mset(coef, 0, sizeof(s16) * num);
+        return 0;
+    }
+
+    vscale = _mm256_set1_epi32(scale);
+    voffset = _mm256_set1_epi64x(offset);
+    vshift = _mm_cvtsi32_si128(shift);
+    zeros = zero;
+
+    for(i = 0; i < num; i += 16)
+    {
+        c = _mm256_loadu_si256((__m256i *)(coef + i));
+        a = _mm256_abs_epi16(c);
+        /* lanes 0-3 and 8-11 in lo, 4-7 and 12-15 in hi; packs puts them back */
+        lo = quant_epu32_avx(_mm256_unpacklo_epi16(a, zero), vscale, voffset, vshift);
+        hi = quant_epu32_avx(_mm256_unpackhi_epi16(a, zero), vscale, voffset, vshift);
+        lo = _mm256_srai_epi32(_mm256_slli_epi32(lo, 16), 16);
+        hi = _mm256_srai_epi32(_mm256_slli_epi32(hi, 16), 16);
+        a = _mm256_sign_epi16(_mm256_packs_epi32(lo, hi), c);
+        _mm256_storeu_si256((__m256i *)(coef + i), a);
+        zeros = _mm256_sub_epi16(zeros, _mm256_cmpeq_epi16(a, zero));
+    }
+
+    return num - hsum_epi16_avx(zeros);
+}
+
+int xeve_rdoq_est_level_avx(s16 * src, s16 * level, s32 * level_double, s64 * err0, int num, int q_value, int q_bits, s64 err_scale, s64 * err0_sum)
+{
+    __m256i vq = _mm256_set1_epi32(q_value);
+    __m256i vmax = _mm256_set1_epi32(XEVE_INT32_MAX - (1 << (q_bits - 1)));
+    __m256i vhalf = _mm256_set1_epi32(1 << (q_bits - 1));
+    __m128i vqbits = _mm_cvtsi32_si128(q_bits);
+    __m256i vlmax = _mm256_set1_epi32(MAX_TX_VAL);
+    __m256i vscale = _mm256_set1_epi32((int)err_scale);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i sum = zero;
+    __m256i zeros = zero;
+    __m256i c, ld[2], lv[2], e, o;
+    s64 s[2];
+    int i, k;
+
+    if((num & 15) || (err_scale >> 32))
+    {
+        return xeve_rdoq_est_level_sse(src, level, level_double, err0, num, q_value, q_bits, err_scale, err0_sum);
+    }
+
+    for(i = 0; i < num; i += 16)
+    {
+        c = _mm256_abs_epi16(_mm256_loadu_si256((__m256i *)(src + i)));
+        ld[0] = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(c));
+        ld[1] = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(c, 1));
+
+        for(k = 0; k < 2; k++)
+        {
+            ld[k] = _mm256_min_epi32(_mm256_mullo_epi32(ld[k], vq), vmax);
+            lv[k] = _mm256_min_epi32(_mm256_sra_epi32(_mm256_add_epi32(ld[k], vhalf), vqbits), vlmax);
+            _mm256_storeu_si256((__m256i *)(level_double + i + 8 * k), ld[k]);
+
+            e = _mm256_srli_epi64(_mm256_mul_epu32(ld[k], vscale), ERR_SCALE_PRECISION_BITS);
+            o = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(ld[k], 32), vscale), ERR_SCALE_PRECISION_BITS);
+            e = _mm256_mul_epu32(e, e);
+            o = _mm256_mul_epu32(o, o);
+            sum = _mm256_add_epi64(sum, _mm256_add_epi64(e, o));
+            /* e holds lanes 0, 2, 4, 6 and o lanes 1, 3, 5, 7 */
+            _mm256_storeu_si256((__m256i *)(err0 + i + 8 * k), _mm256_permute2x128_si256(_mm256_unpacklo_epi64(e, o), _mm256_unpackhi_epi64(e, o), 0x20));
+            _mm256_storeu_si256((__m256i *)(err0 + i + 8 * k + 4), _mm256_permute2x128_si256(_mm256_unpacklo_epi64(e, o), _mm256_unpackhi_epi64(e, o), 0x31));
+        }
+        c = _mm256_permute4x64_epi64(_mm256_packs_epi32(lv[0], lv[1]), 0xD8);
+        _mm256_storeu_si256((__m256i *)(level + i), c);
+        zeros = _mm256_sub_epi16(zeros, _mm256_cmpeq_epi16(c, zero));
+    }
+    _mm_storeu_si128((__m128i *)s, _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+    *err0_sum = s[0] + s[1];
+
+    return num - hsum_epi16_avx(zeros);
+}
@@ -33,6 +33,15 @@
 
 #if X86_SSE
 extern const XEVE_TXB xeve_tbl_txb_avx[MAX_TR_LOG2];
+
+void xeve_tx_pb8b_avx(void* src, void* dst, int shift, int line, int step);
+void xeve_tx_pb16b_avx(void* src, void* dst, int shift, int line, int step);
+void xeve_tx_pb32b_avx(void* src, void* dst, int shift, int line, int step);
+void xeve_tx_pb64b_avx(void* src, void* dst, int shift, int line, int step);
+
+int xeve_quant_avx(s16 * coef, int num, int scale, s64 offset, int shift);
+u32 xeve_coef_abs_max_avx(s16 * coef, int num);
+int xeve_rdoq_est_level_avx(s16 * src, s16 * level, s32 * level_double, s64 * err0, int num, int q_value, int q_bits, s64 err_scale, s64 * err0_sum);
 #endif /* X86_SSE */
 
 #define CALCU_2x8(c0, c1, d0, d1) \
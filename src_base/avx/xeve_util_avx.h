@@ -0,0 +1,45 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _XEVE_UTIL_AVX_H_
+#define _XEVE_UTIL_AVX_H_
+
+#if X86_SSE
+void xeve_plane_shl_8b_avx(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift);
+void xeve_plane_shl_16b_avx(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift);
+void xeve_plane_expand_lr_avx(pel *a, int s, int w, int h, int exp);
+#endif /* X86_SSE */
+
+#endif /* _XEVE_UTIL_AVX_H_ */
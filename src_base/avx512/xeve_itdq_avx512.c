@@ -0,0 +1,172 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if X86_SSE
+/* inverse transform of sixteen lines at a time, one line per 32-bit lane.
+   even and odd input rows are accumulated separately so that each pass
+   produces a pair of mirrored outputs, the results are then transposed back
+   into line order. the first pass works on pairs of input rows with madd and
+   the second on 32-bit intermediates with mullo, both in 32-bit arithmetic
+   like the AVX2 version */
+static __inline void itx_pbNb_avx512(void * src, void * dst, int n, const s8 * tm, int shift, int line, int step)
+{
+    s32     cp[2][16][32]; /* even and odd coefficient pairs of the first pass */
+    __m512i t[64], r[32], e, o;
+    __m512i add = _mm512_set1_epi32(shift == 0 ? 0 : 1 << (shift - 1));
+    int     half = n >> 1, np = n >> 2;
+    int     j, k, m, p, b;
+
+    if(step == 0)
+    {
+        for(p = 0; p < np; p++)
+        {
+            k = p << 2;
+            for(m = 0; m < half; m++)
+            {
+                cp[0][p][m] = (int)(((u32)(u16)tm[(k + 2) * n + m] << 16) | (u16)tm[k * n + m]);
+                cp[1][p][m] = (int)(((u32)(u16)tm[(k + 3) * n + m] << 16) | (u16)tm[(k + 1) * n + m]);
+            }
+        }
+    }
+
+    for(j = 0; j < line; j += 16)
+    {
+        if(step == 0)
+        {
+            s16 * s = (s16 *)src + j;
+
+            for(p = 0; p < np; p++)
+            {
+                k = p << 2;
+                r[p] = _mm512_or_si512(_mm512_cvtepu16_epi32(_mm256_loadu_si256((__m256i *)(s + k * line))),
+                       _mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((__m256i *)(s + (k + 2) * line))), 16));
+                r[np + p] = _mm512_or_si512(_mm512_cvtepu16_epi32(_mm256_loadu_si256((__m256i *)(s + (k + 1) * line))),
+                            _mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((__m256i *)(s + (k + 3) * line))), 16));
+            }
+            for(m = 0; m < half; m++)
+            {
+                e = add;
+                o = _mm512_setzero_si512();
+                for(p = 0; p < np; p++)
+                {
+                    e = _mm512_add_epi32(e, _mm512_madd_epi16(r[p], _mm512_set1_epi32(cp[0][p][m])));
+                    o = _mm512_add_epi32(o, _mm512_madd_epi16(r[np + p], _mm512_set1_epi32(cp[1][p][m])));
+                }
+                t[m] = _mm512_srai_epi32(_mm512_add_epi32(e, o), shift);
+                t[n - 1 - m] = _mm512_srai_epi32(_mm512_sub_epi32(e, o), shift);
+            }
+        }
+        else
+        {
+            s32 * s = (s32 *)src + j;
+
+            for(m = 0; m < half; m++)
+            {
+                e = add;
+                o = _mm512_setzero_si512();
+                for(k = 0; k < n; k += 2)
+                {
+                    e = _mm512_add_epi32(e, _mm512_mullo_epi32(_mm512_loadu_si512((__m512i *)(s + k * line)), _mm512_set1_epi32(tm[k * n + m])));
+                    o = _mm512_add_epi32(o, _mm512_mullo_epi32(_mm512_loadu_si512((__m512i *)(s + (k + 1) * line)), _mm512_set1_epi32(tm[(k + 1) * n + m])));
+                }
+                t[m] = _mm512_srai_epi32(_mm512_add_epi32(e, o), shift);
+                t[n - 1 - m] = _mm512_srai_epi32(_mm512_sub_epi32(e, o), shift);
+            }
+        }
+
+        for(b = 0; b < n; b += 16)
+        {
+            AVX512_TRANSPOSE_16x16_32B((t + b));
+            if(step == 0)
+            {
+                for(m = 0; m < 16; m++)
+                {
+                    _mm512_storeu_si512((__m512i *)((s32 *)dst + (j + m) * n + b), t[b + m]);
+                }
+            }
+            else
+            {
+                /* saturation to 16 bits is the clipping to [MIN_TX_VAL, MAX_TX_VAL] */
+                for(m = 0; m < 16; m++)
+                {
+                    _mm256_storeu_si256((__m256i *)((s16 *)dst + (j + m) * n + b), _mm512_cvtsepi32_epi16(t[b + m]));
+                }
+            }
+        }
+    }
+}
+
+static void itx_pb16b_avx512(void * src, void * dst, int shift, int line, int step)
+{
+    if(line & 15)
+    {
+        xeve_itx_pb16b_avx(src, dst, shift, line, step);
+        return;
+    }
+    itx_pbNb_avx512(src, dst, 16, xeve_tbl_tm16[0], shift, line, step);
+}
+
+static void itx_pb32b_avx512(void * src, void * dst, int shift, int line, int step)
+{
+    if(line & 15)
+    {
+        xeve_itx_pb32b_avx(src, dst, shift, line, step);
+        return;
+    }
+    itx_pbNb_avx512(src, dst, 32, xeve_tbl_tm32[0], shift, line, step);
+}
+
+static void itx_pb64b_avx512(void * src, void * dst, int shift, int line, int step)
+{
+    if(line & 15)
+    {
+        xeve_itx_pb64b_avx(src, dst, shift, line, step);
+        return;
+    }
+    itx_pbNb_avx512(src, dst, 64, xeve_tbl_tm64[0], shift, line, step);
+}
+
+const XEVE_ITXB xeve_tbl_itxb_avx512[MAX_TR_LOG2] =
+{
+    xeve_itx_pb2b,
+    xeve_itx_pb4b_avx,
+    xeve_itx_pb8b_avx,
+    itx_pb16b_avx512,
+    itx_pb32b_avx512,
+    itx_pb64b_avx512
+};
+#endif /* X86_SSE */
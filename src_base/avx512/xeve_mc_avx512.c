@@ -0,0 +1,296 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_def.h"
+#include "xeve_mc_avx512.h"
+
+#if X86_SSE
+/* blocks narrower than this are left to the AVX2 kernels */
+#define MC_AVX512_MIN_W         16
+
+/* 2, 4 and 8-tap separable filters, 32 output samples per iteration. the
+   taps are applied pairwise with madd on interleaved samples exactly as in
+   the AVX2 kernels, and the last group of a row is handled with masked loads
+   and stores so any width can be filtered without reading past the row */
+static __inline void mc_filter_avx512(s16 *ref, int src_stride, int tap_stride, s16 *pred, int dst_stride
+                                    , const s16 *coeff, int ntap, int width, int height, int min_val, int max_val
+                                    , int offset, int shift, s8 is_last)
+{
+    __m512i c[4], a, b, acc0, acc1, res;
+    __m512i mm_offset = _mm512_set1_epi32(offset);
+    __m512i mm_min = _mm512_set1_epi16(min_val);
+    __m512i mm_max = _mm512_set1_epi16(max_val);
+    __mmask32 mask;
+    s16 *src;
+    int row, col, k;
+
+    for(k = 0; k < ntap; k += 2)
+    {
+        c[k >> 1] = _mm512_set1_epi32((int)(((u32)(u16)coeff[k + 1] << 16) | (u16)coeff[k]));
+    }
+
+    for(row = 0; row < height; row++)
+    {
+        for(col = 0; col < width; col += 32)
+        {
+            mask = (width - col >= 32) ? 0xFFFFFFFF : (((__mmask32)1 << (width - col)) - 1);
+            src = ref + col;
+            acc0 = mm_offset;
+            acc1 = mm_offset;
+
+            for(k = 0; k < ntap; k += 2)
+            {
+                a = _mm512_maskz_loadu_epi16(mask, src);
+                b = _mm512_maskz_loadu_epi16(mask, src + tap_stride);
+                acc0 = _mm512_add_epi32(acc0, _mm512_madd_epi16(_mm512_unpacklo_epi16(a, b), c[k >> 1]));
+                acc1 = _mm512_add_epi32(acc1, _mm512_madd_epi16(_mm512_unpackhi_epi16(a, b), c[k >> 1]));
+                src += tap_stride * 2;
+            }
+
+            acc0 = _mm512_srai_epi32(acc0, shift);
+            acc1 = _mm512_srai_epi32(acc1, shift);
+            res = _mm512_packs_epi32(acc0, acc1);
+            if(is_last)
+            {
+                res = _mm512_min_epi16(res, mm_max);
+                res = _mm512_max_epi16(res, mm_min);
+            }
+            _mm512_mask_storeu_epi16(pred + col, mask, res);
+        }
+        ref += src_stride;
+        pred += dst_stride;
+    }
+}
+
+void xeve_mc_filter_horz_avx512(s16 *ref, int src_stride, s16 *pred, int dst_stride, const s16 *coeff, int ntap
+                              , int width, int height, int min_val, int max_val, int offset, int shift, s8 is_last)
+{
+    switch(ntap)
+    {
+    case 8:
+        mc_filter_avx512(ref, src_stride, 1, pred, dst_stride, coeff, 8, width, height, min_val, max_val, offset, shift, is_last);
+        break;
+    case 4:
+        mc_filter_avx512(ref, src_stride, 1, pred, dst_stride, coeff, 4, width, height, min_val, max_val, offset, shift, is_last);
+        break;
+    default:
+        mc_filter_avx512(ref, src_stride, 1, pred, dst_stride, coeff, 2, width, height, min_val, max_val, offset, shift, is_last);
+        break;
+    }
+}
+
+void xeve_mc_filter_vert_avx512(s16 *ref, int src_stride, s16 *pred, int dst_stride, const s16 *coeff, int ntap
+                              , int width, int height, int min_val, int max_val, int offset, int shift, s8 is_last)
+{
+    switch(ntap)
+    {
+    case 8:
+        mc_filter_avx512(ref, src_stride, src_stride, pred, dst_stride, coeff, 8, width, height, min_val, max_val, offset, shift, is_last);
+        break;
+    case 4:
+        mc_filter_avx512(ref, src_stride, src_stride, pred, dst_stride, coeff, 4, width, height, min_val, max_val, offset, shift, is_last);
+        break;
+    default:
+        mc_filter_avx512(ref, src_stride, src_stride, pred, dst_stride, coeff, 2, width, height, min_val, max_val, offset, shift, is_last);
+        break;
+    }
+}
+
+/****************************************************************************
+ * motion compensation for luma
+ ****************************************************************************/
+
+static void mc_l_n0_avx512(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16(*mc_l_coeff)[8])
+{
+    int dx = gmv_x & 15;
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_mc_l_n0_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_l_coeff);
+        return;
+    }
+
+    ref += (gmv_y >> 4) * s_ref + (gmv_x >> 4) - 3;
+    xeve_mc_filter_horz_avx512(ref, s_ref, pred, s_pred, mc_l_coeff[dx], 8, w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+}
+
+static void mc_l_0n_avx512(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth, const s16(*mc_l_coeff)[8])
+{
+    int dy = gmv_y & 15;
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_mc_l_0n_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_l_coeff);
+        return;
+    }
+
+    ref += ((gmv_y >> 4) - 3) * s_ref + (gmv_x >> 4);
+    xeve_mc_filter_vert_avx512(ref, s_ref, pred, s_pred, mc_l_coeff[dy], 8, w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+}
+
+static void mc_l_nn_avx512(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16(*mc_l_coeff)[8])
+{
+    s16 buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*(MAX_CU_SIZE + MC_IBUF_PAD_L)];
+    int dx = gmv_x & 15;
+    int dy = gmv_y & 15;
+    int shift1 = XEVE_MIN(4, bit_depth - 8);
+    int shift2 = XEVE_MAX(8, 20 - bit_depth);
+    int offset1 = 0;
+    int offset2 = (1 << (shift2 - 1));
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_mc_l_nn_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_l_coeff);
+        return;
+    }
+
+    ref += ((gmv_y >> 4) - 3) * s_ref + (gmv_x >> 4) - 3;
+    xeve_mc_filter_horz_avx512(ref, s_ref, buf, w, mc_l_coeff[dx], 8, w, (h + 7), min, max, offset1, shift1, 0);
+    xeve_mc_filter_vert_avx512(buf, w, pred, s_pred, mc_l_coeff[dy], 8, w, h, min, max, offset2, shift2, 1);
+}
+
+/****************************************************************************
+ * motion compensation for chroma
+ ****************************************************************************/
+
+static void mc_c_n0_avx512(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16(*mc_c_coeff)[4])
+{
+    int dx = gmv_x & 31;
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_mc_c_n0_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_c_coeff);
+        return;
+    }
+
+    ref += (gmv_y >> 5) * s_ref + (gmv_x >> 5) - 1;
+    xeve_mc_filter_horz_avx512(ref, s_ref, pred, s_pred, mc_c_coeff[dx], 4, w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+}
+
+static void mc_c_0n_avx512(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16(*mc_c_coeff)[4])
+{
+    int dy = gmv_y & 31;
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_mc_c_0n_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_c_coeff);
+        return;
+    }
+
+    ref += ((gmv_y >> 5) - 1) * s_ref + (gmv_x >> 5);
+    xeve_mc_filter_vert_avx512(ref, s_ref, pred, s_pred, mc_c_coeff[dy], 4, w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+}
+
+static void mc_c_nn_avx512(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth, const s16(*mc_c_coeff)[4])
+{
+    s16 buf[(MAX_CU_SIZE + MC_IBUF_PAD_C)*MAX_CU_SIZE];
+    int dx = gmv_x & 31;
+    int dy = gmv_y & 31;
+    int shift1 = XEVE_MIN(4, bit_depth - 8);
+    int shift2 = XEVE_MAX(8, 20 - bit_depth);
+    int offset1 = 0;
+    int offset2 = (1 << (shift2 - 1));
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_mc_c_nn_avx(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, mc_c_coeff);
+        return;
+    }
+
+    ref += ((gmv_y >> 5) - 1) * s_ref + (gmv_x >> 5) - 1;
+    xeve_mc_filter_horz_avx512(ref, s_ref, buf, w, mc_c_coeff[dx], 4, w, (h + 3), min, max, offset1, shift1, 0);
+    xeve_mc_filter_vert_avx512(buf, w, pred, s_pred, mc_c_coeff[dy], 4, w, h, min, max, offset2, shift2, 1);
+}
+
+const XEVE_MC_L xeve_tbl_mc_l_avx512[2][2] =
+{
+    {
+        xeve_mc_l_00,     /* dx == 0 && dy == 0 */
+        mc_l_0n_avx512    /* dx == 0 && dy != 0 */
+    },
+    {
+        mc_l_n0_avx512,   /* dx != 0 && dy == 0 */
+        mc_l_nn_avx512    /* dx != 0 && dy != 0 */
+    }
+};
+
+const XEVE_MC_C xeve_tbl_mc_c_avx512[2][2] =
+{
+    {
+        xeve_mc_c_00,     /* dx == 0 && dy == 0 */
+        mc_c_0n_avx512    /* dx == 0 && dy != 0 */
+    },
+    {
+        mc_c_n0_avx512,   /* dx != 0 && dy == 0 */
+        mc_c_nn_avx512    /* dx != 0 && dy != 0 */
+    }
+};
+
+/* 32 samples per iteration, the last group of a row is masked as in
+   mc_filter_avx512() */
+void xeve_average_16b_no_clip_avx512(s16 *src, s16 *ref, s16 *dst, int s_src, int s_ref, int s_dst, int wd, int ht)
+{
+    __m512i m0, m1, offset = _mm512_set1_epi16(1);
+    __mmask32 mask;
+    int i, j;
+
+    for(i = 0; i < ht; i++)
+    {
+        for(j = 0; j < wd; j += 32)
+        {
+            mask = (wd - j >= 32) ? 0xFFFFFFFF : (((__mmask32)1 << (wd - j)) - 1);
+            m0 = _mm512_maskz_loadu_epi16(mask, src + j);
+            m1 = _mm512_maskz_loadu_epi16(mask, ref + j);
+            m0 = _mm512_add_epi16(_mm512_add_epi16(m0, m1), offset);
+            _mm512_mask_storeu_epi16(dst + j, mask, _mm512_srai_epi16(m0, 1));
+        }
+        src += s_src;
+        ref += s_ref;
+        dst += s_dst;
+    }
+}
+#endif /* X86_SSE */
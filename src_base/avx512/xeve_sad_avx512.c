@@ -0,0 +1,611 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_sad_avx512.h"
+
+#if X86_SSE
+/* two rows of sixteen samples in one register */
+#define AVX512_LOAD_16x2(p, s) \
+    _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256((__m256i *)(p))), \
+                       _mm256_loadu_si256((__m256i *)((p) + (s))), 1)
+
+static int sad_16b_avx512_16x2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1 = (s16 *)src1;
+    s16 * s2 = (s16 *)src2;
+    __m512i m0, m1, acc = _mm512_setzero_si512();
+    __m512i one = _mm512_set1_epi16(1);
+    int i;
+
+    assert(bit_depth <= 14);
+
+    for(i = 0; i < h; i += 2)
+    {
+        m0 = AVX512_LOAD_16x2(s1, s_src1);
+        m1 = AVX512_LOAD_16x2(s2, s_src2);
+        m0 = _mm512_abs_epi16(_mm512_sub_epi16(m0, m1));
+        acc = _mm512_add_epi32(acc, _mm512_madd_epi16(m0, one));
+        s1 += s_src1 * 2;
+        s2 += s_src2 * 2;
+    }
+
+    return (_mm512_reduce_add_epi32(acc) >> (bit_depth - 8));
+}
+
+/* absolute differences of two 32-sample groups are summed in 16 bits before
+   widening, which is safe for sample bit depths up to 14 as in the AVX2
+   version */
+static int sad_16b_avx512_32nx1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1 = (s16 *)src1;
+    s16 * s2 = (s16 *)src2;
+    __m512i m0, m1, acc = _mm512_setzero_si512();
+    __m512i one = _mm512_set1_epi16(1);
+    int i, j;
+
+    assert(bit_depth <= 14);
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j += 64)
+        {
+            m0 = _mm512_abs_epi16(_mm512_sub_epi16(_mm512_loadu_si512((__m512i *)(s1 + j)),
+                                                   _mm512_loadu_si512((__m512i *)(s2 + j))));
+            if(j + 32 < w)
+            {
+                m1 = _mm512_abs_epi16(_mm512_sub_epi16(_mm512_loadu_si512((__m512i *)(s1 + j + 32)),
+                                                       _mm512_loadu_si512((__m512i *)(s2 + j + 32))));
+                m0 = _mm512_add_epi16(m0, m1);
+            }
+            acc = _mm512_add_epi32(acc, _mm512_madd_epi16(m0, one));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+
+    return (_mm512_reduce_add_epi32(acc) >> (bit_depth - 8));
+}
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SAD xeve_tbl_sad_16b_avx512[8][8] =
+{
+    /* width == 1 */
+    {
+        sad_16b, /* height == 1 */
+        sad_16b, /* height == 2 */
+        sad_16b, /* height == 4 */
+        sad_16b, /* height == 8 */
+        sad_16b, /* height == 16 */
+        sad_16b, /* height == 32 */
+        sad_16b, /* height == 64 */
+        sad_16b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        sad_16b, /* height == 1 */
+        sad_16b, /* height == 2 */
+        sad_16b, /* height == 4 */
+        sad_16b, /* height == 8 */
+        sad_16b, /* height == 16 */
+        sad_16b, /* height == 32 */
+        sad_16b, /* height == 64 */
+        sad_16b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        sad_16b, /* height == 1 */
+        sad_16b_sse_4x2,  /* height == 2 */
+        sad_16b_sse_4x4,  /* height == 4 */
+        sad_16b_sse_4x2n, /* height == 8 */
+        sad_16b_sse_4x2n, /* height == 16 */
+        sad_16b_sse_4x2n, /* height == 32 */
+        sad_16b_sse_4x2n, /* height == 64 */
+        sad_16b_sse_4x2n, /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        sad_16b,          /* height == 1 */
+        sad_16b_sse_8x2n, /* height == 2 */
+        sad_16b_sse_8x2n, /* height == 4 */
+        sad_16b_sse_8x2n, /* height == 8 */
+        sad_16b_sse_8x2n, /* height == 16 */
+        sad_16b_sse_8x2n, /* height == 32 */
+        sad_16b_sse_8x2n, /* height == 64 */
+        sad_16b_sse_8x2n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        sad_16b_sse_16nx1n,    /* height == 1 */
+        sad_16b_avx512_16x2n,  /* height == 2 */
+        sad_16b_avx512_16x2n,  /* height == 4 */
+        sad_16b_avx512_16x2n,  /* height == 8 */
+        sad_16b_avx512_16x2n,  /* height == 16 */
+        sad_16b_avx512_16x2n,  /* height == 32 */
+        sad_16b_avx512_16x2n,  /* height == 64 */
+        sad_16b_avx512_16x2n,  /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        sad_16b_avx512_32nx1n, /* height == 1 */
+        sad_16b_avx512_32nx1n, /* height == 2 */
+        sad_16b_avx512_32nx1n, /* height == 4 */
+        sad_16b_avx512_32nx1n, /* height == 8 */
+        sad_16b_avx512_32nx1n, /* height == 16 */
+        sad_16b_avx512_32nx1n, /* height == 32 */
+        sad_16b_avx512_32nx1n, /* height == 64 */
+        sad_16b_avx512_32nx1n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        sad_16b_avx512_32nx1n, /* height == 1 */
+        sad_16b_avx512_32nx1n, /* height == 2 */
+        sad_16b_avx512_32nx1n, /* height == 4 */
+        sad_16b_avx512_32nx1n, /* height == 8 */
+        sad_16b_avx512_32nx1n, /* height == 16 */
+        sad_16b_avx512_32nx1n, /* height == 32 */
+        sad_16b_avx512_32nx1n, /* height == 64 */
+        sad_16b_avx512_32nx1n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        sad_16b_avx512_32nx1n, /* height == 1 */
+        sad_16b_avx512_32nx1n, /* height == 2 */
+        sad_16b_avx512_32nx1n, /* height == 4 */
+        sad_16b_avx512_32nx1n, /* height == 8 */
+        sad_16b_avx512_32nx1n, /* height == 16 */
+        sad_16b_avx512_32nx1n, /* height == 32 */
+        sad_16b_avx512_32nx1n, /* height == 64 */
+        sad_16b_avx512_32nx1n, /* height == 128 */
+    }
+};
+
+/* DIFF **********************************************************************/
+static void diff_16b_avx512_16x2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+{
+    s16 * s1 = (s16 *)src1;
+    s16 * s2 = (s16 *)src2;
+    __m512i m0;
+    int i;
+
+    for(i = 0; i < h; i += 2)
+    {
+        m0 = _mm512_sub_epi16(AVX512_LOAD_16x2(s1, s_src1), AVX512_LOAD_16x2(s2, s_src2));
+        _mm256_storeu_si256((__m256i *)diff, _mm512_castsi512_si256(m0));
+        _mm256_storeu_si256((__m256i *)(diff + s_diff), _mm512_extracti64x4_epi64(m0, 1));
+        s1 += s_src1 * 2;
+        s2 += s_src2 * 2;
+        diff += s_diff * 2;
+    }
+}
+
+/* a row narrower than 32 samples is handled with a lane mask */
+static void diff_16b_avx512_16nx1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+{
+    s16 * s1 = (s16 *)src1;
+    s16 * s2 = (s16 *)src2;
+    const __mmask32 mask = (w >= 32) ? 0xFFFFFFFF : (((__mmask32)1 << w) - 1);
+    __m512i m0, m1;
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j += 32)
+        {
+            m0 = _mm512_maskz_loadu_epi16(mask, s1 + j);
+            m1 = _mm512_maskz_loadu_epi16(mask, s2 + j);
+            _mm512_mask_storeu_epi16(diff + j, mask, _mm512_sub_epi16(m0, m1));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+        diff += s_diff;
+    }
+}
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_DIFF xeve_tbl_diff_16b_avx512[8][8] =
+{
+    /* width == 1 */
+    {
+        diff_16b, /* height == 1 */
+        diff_16b, /* height == 2 */
+        diff_16b, /* height == 4 */
+        diff_16b, /* height == 8 */
+        diff_16b, /* height == 16 */
+        diff_16b, /* height == 32 */
+        diff_16b, /* height == 64 */
+        diff_16b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        diff_16b, /* height == 1 */
+        diff_16b, /* height == 2 */
+        diff_16b, /* height == 4 */
+        diff_16b, /* height == 8 */
+        diff_16b, /* height == 16 */
+        diff_16b, /* height == 32 */
+        diff_16b, /* height == 64 */
+        diff_16b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        diff_16b,         /* height == 1 */
+        diff_16b_sse_4x2, /* height == 2 */
+        diff_16b_sse_4x4, /* height == 4 */
+        diff_16b,         /* height == 8 */
+        diff_16b,         /* height == 16 */
+        diff_16b,         /* height == 32 */
+        diff_16b,         /* height == 64 */
+        diff_16b,         /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        diff_16b,           /* height == 1 */
+        diff_16b_sse_8nx2n, /* height == 2 */
+        diff_16b_sse_8nx2n, /* height == 4 */
+        diff_16b_sse_8x8,   /* height == 8 */
+        diff_16b_sse_8nx2n, /* height == 16 */
+        diff_16b_sse_8nx2n, /* height == 32 */
+        diff_16b_sse_8nx2n, /* height == 64 */
+        diff_16b_sse_8nx2n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        diff_16b_avx512_16nx1n, /* height == 1 */
+        diff_16b_avx512_16x2n,  /* height == 2 */
+        diff_16b_avx512_16x2n,  /* height == 4 */
+        diff_16b_avx512_16x2n,  /* height == 8 */
+        diff_16b_avx512_16x2n,  /* height == 16 */
+        diff_16b_avx512_16x2n,  /* height == 32 */
+        diff_16b_avx512_16x2n,  /* height == 64 */
+        diff_16b_avx512_16x2n,  /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        diff_16b_avx512_16nx1n, /* height == 1 */
+        diff_16b_avx512_16nx1n, /* height == 2 */
+        diff_16b_avx512_16nx1n, /* height == 4 */
+        diff_16b_avx512_16nx1n, /* height == 8 */
+        diff_16b_avx512_16nx1n, /* height == 16 */
+        diff_16b_avx512_16nx1n, /* height == 32 */
+        diff_16b_avx512_16nx1n, /* height == 64 */
+        diff_16b_avx512_16nx1n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        diff_16b_avx512_16nx1n, /* height == 1 */
+        diff_16b_avx512_16nx1n, /* height == 2 */
+        diff_16b_avx512_16nx1n, /* height == 4 */
+        diff_16b_avx512_16nx1n, /* height == 8 */
+        diff_16b_avx512_16nx1n, /* height == 16 */
+        diff_16b_avx512_16nx1n, /* height == 32 */
+        diff_16b_avx512_16nx1n, /* height == 64 */
+        diff_16b_avx512_16nx1n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        diff_16b_avx512_16nx1n, /* height == 1 */
+        diff_16b_avx512_16nx1n, /* height == 2 */
+        diff_16b_avx512_16nx1n, /* height == 4 */
+        diff_16b_avx512_16nx1n, /* height == 8 */
+        diff_16b_avx512_16nx1n, /* height == 16 */
+        diff_16b_avx512_16nx1n, /* height == 32 */
+        diff_16b_avx512_16nx1n, /* height == 64 */
+        diff_16b_avx512_16nx1n, /* height == 128 */
+    }
+};
+
+/* SSD ***********************************************************************/
+/* squared differences are shifted sample by sample as in ssd_16b() and
+   accumulated into sixteen 32-bit lanes */
+#define AVX512_SSD_16B_ACC(m0, m1, shift, acc) \
+    m1 = _mm512_mulhi_epi16(m0, m0); \
+    m0 = _mm512_mullo_epi16(m0, m0); \
+    acc = _mm512_add_epi32(acc, _mm512_srli_epi32(_mm512_unpacklo_epi16(m0, m1), shift)); \
+    acc = _mm512_add_epi32(acc, _mm512_srli_epi32(_mm512_unpackhi_epi16(m0, m1), shift));
+
+static s64 ssd_16b_avx512_sum(__m512i acc)
+{
+    return _mm512_reduce_add_epi64(_mm512_add_epi64(_mm512_cvtepu32_epi64(_mm512_castsi512_si256(acc)),
+                                                    _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(acc, 1))));
+}
+
+static s64 ssd_16b_avx512_8x4n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1 = (s16 *)src1;
+    s16 * s2 = (s16 *)src2;
+    const int shift = (bit_depth - 8) << 1;
+    __m512i m0, m1, acc = _mm512_setzero_si512();
+    int i, k;
+
+    for(i = 0; i < h; i += 4)
+    {
+        m0 = _mm512_castsi128_si512(_mm_loadu_si128((__m128i *)s1));
+        m1 = _mm512_castsi128_si512(_mm_loadu_si128((__m128i *)s2));
+        for(k = 1; k < 4; k++)
+        {
+            m0 = _mm512_inserti32x4(m0, _mm_loadu_si128((__m128i *)(s1 + s_src1 * k)), k);
+            m1 = _mm512_inserti32x4(m1, _mm_loadu_si128((__m128i *)(s2 + s_src2 * k)), k);
+        }
+        m0 = _mm512_sub_epi16(m0, m1);
+        AVX512_SSD_16B_ACC(m0, m1, shift, acc);
+        s1 += s_src1 << 2;
+        s2 += s_src2 << 2;
+    }
+    return ssd_16b_avx512_sum(acc);
+}
+
+static s64 ssd_16b_avx512_16x2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1 = (s16 *)src1;
+    s16 * s2 = (s16 *)src2;
+    const int shift = (bit_depth - 8) << 1;
+    __m512i m0, m1, acc = _mm512_setzero_si512();
+    int i;
+
+    for(i = 0; i < h; i += 2)
+    {
+        m0 = _mm512_sub_epi16(AVX512_LOAD_16x2(s1, s_src1), AVX512_LOAD_16x2(s2, s_src2));
+        AVX512_SSD_16B_ACC(m0, m1, shift, acc);
+        s1 += s_src1 << 1;
+        s2 += s_src2 << 1;
+    }
+    return ssd_16b_avx512_sum(acc);
+}
+
+/* masked lanes load as zero and add nothing to the sum */
+static s64 ssd_16b_avx512_16nx1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1 = (s16 *)src1;
+    s16 * s2 = (s16 *)src2;
+    const int shift = (bit_depth - 8) << 1;
+    const __mmask32 mask = (w >= 32) ? 0xFFFFFFFF : (((__mmask32)1 << w) - 1);
+    __m512i m0, m1, acc = _mm512_setzero_si512();
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j += 32)
+        {
+            m0 = _mm512_sub_epi16(_mm512_maskz_loadu_epi16(mask, s1 + j), _mm512_maskz_loadu_epi16(mask, s2 + j));
+            AVX512_SSD_16B_ACC(m0, m1, shift, acc);
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+    return ssd_16b_avx512_sum(acc);
+}
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SSD xeve_tbl_ssd_16b_avx512[8][8] =
+{
+    /* width == 1 */
+    {
+        ssd_16b, /* height == 1 */
+        ssd_16b, /* height == 2 */
+        ssd_16b, /* height == 4 */
+        ssd_16b, /* height == 8 */
+        ssd_16b, /* height == 16 */
+        ssd_16b, /* height == 32 */
+        ssd_16b, /* height == 64 */
+        ssd_16b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        ssd_16b, /* height == 1 */
+        ssd_16b, /* height == 2 */
+        ssd_16b, /* height == 4 */
+        ssd_16b, /* height == 8 */
+        ssd_16b, /* height == 16 */
+        ssd_16b, /* height == 32 */
+        ssd_16b, /* height == 64 */
+        ssd_16b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        ssd_16b,          /* height == 1 */
+        ssd_16b_sse_4x2,  /* height == 2 */
+        ssd_16b_sse_4x4,  /* height == 4 */
+        ssd_16b_sse_4x8,  /* height == 8 */
+        ssd_16b_sse_4x16, /* height == 16 */
+        ssd_16b_sse_4x32, /* height == 32 */
+        ssd_16b,          /* height == 64 */
+        ssd_16b,          /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        ssd_16b,             /* height == 1 */
+        ssd_16b,             /* height == 2 */
+        ssd_16b_avx512_8x4n, /* height == 4 */
+        ssd_16b_avx512_8x4n, /* height == 8 */
+        ssd_16b_avx512_8x4n, /* height == 16 */
+        ssd_16b_avx512_8x4n, /* height == 32 */
+        ssd_16b_avx512_8x4n, /* height == 64 */
+        ssd_16b_avx512_8x4n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        ssd_16b_avx512_16nx1n, /* height == 1 */
+        ssd_16b_avx512_16x2n,  /* height == 2 */
+        ssd_16b_avx512_16x2n,  /* height == 4 */
+        ssd_16b_avx512_16x2n,  /* height == 8 */
+        ssd_16b_avx512_16x2n,  /* height == 16 */
+        ssd_16b_avx512_16x2n,  /* height == 32 */
+        ssd_16b_avx512_16x2n,  /* height == 64 */
+        ssd_16b_avx512_16x2n,  /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        ssd_16b_avx512_16nx1n, /* height == 1 */
+        ssd_16b_avx512_16nx1n, /* height == 2 */
+        ssd_16b_avx512_16nx1n, /* height == 4 */
+        ssd_16b_avx512_16nx1n, /* height == 8 */
+        ssd_16b_avx512_16nx1n, /* height == 16 */
+        ssd_16b_avx512_16nx1n, /* height == 32 */
+        ssd_16b_avx512_16nx1n, /* height == 64 */
+        ssd_16b_avx512_16nx1n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        ssd_16b_avx512_16nx1n, /* height == 1 */
+        ssd_16b_avx512_16nx1n, /* height == 2 */
+        ssd_16b_avx512_16nx1n, /* height == 4 */
+        ssd_16b_avx512_16nx1n, /* height == 8 */
+        ssd_16b_avx512_16nx1n, /* height == 16 */
+        ssd_16b_avx512_16nx1n, /* height == 32 */
+        ssd_16b_avx512_16nx1n, /* height == 64 */
+        ssd_16b_avx512_16nx1n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        ssd_16b_avx512_16nx1n, /* height == 1 */
+        ssd_16b_avx512_16nx1n, /* height == 2 */
+        ssd_16b_avx512_16nx1n, /* height == 4 */
+        ssd_16b_avx512_16nx1n, /* height == 8 */
+        ssd_16b_avx512_16nx1n, /* height == 16 */
+        ssd_16b_avx512_16nx1n, /* height == 32 */
+        ssd_16b_avx512_16nx1n, /* height == 64 */
+        ssd_16b_avx512_16nx1n, /* height == 128 */
+    }
+};
+
+/* SATD **********************************************************************/
+/* 8x8 transpose of 16-bit samples within each 128-bit lane */
+#define AVX512_TRANSPOSE_8x8_16B(s, o) \
+{ \
+    __m512i a0, a1, b0, b1, c0, c1, d0, d1, e0, e1, f0, f1, g0, g1, h0, h1; \
+    a0 = _mm512_unpacklo_epi16(s[0], s[1]); a1 = _mm512_unpackhi_epi16(s[0], s[1]); \
+    b0 = _mm512_unpacklo_epi16(s[2], s[3]); b1 = _mm512_unpackhi_epi16(s[2], s[3]); \
+    c0 = _mm512_unpacklo_epi16(s[4], s[5]); c1 = _mm512_unpackhi_epi16(s[4], s[5]); \
+    d0 = _mm512_unpacklo_epi16(s[6], s[7]); d1 = _mm512_unpackhi_epi16(s[6], s[7]); \
+    e0 = _mm512_unpacklo_epi32(a0, b0); e1 = _mm512_unpackhi_epi32(a0, b0); \
+    f0 = _mm512_unpacklo_epi32(c0, d0); f1 = _mm512_unpackhi_epi32(c0, d0); \
+    g0 = _mm512_unpacklo_epi32(a1, b1); g1 = _mm512_unpackhi_epi32(a1, b1); \
+    h0 = _mm512_unpacklo_epi32(c1, d1); h1 = _mm512_unpackhi_epi32(c1, d1); \
+    o[0] = _mm512_unpacklo_epi64(e0, f0); o[1] = _mm512_unpackhi_epi64(e0, f0); \
+    o[2] = _mm512_unpacklo_epi64(e1, f1); o[3] = _mm512_unpackhi_epi64(e1, f1); \
+    o[4] = _mm512_unpacklo_epi64(g0, h0); o[5] = _mm512_unpackhi_epi64(g0, h0); \
+    o[6] = _mm512_unpacklo_epi64(g1, h1); o[7] = _mm512_unpackhi_epi64(g1, h1); \
+}
+
+/* 8-point Hadamard butterflies in the output order of xeve_had_8x8_sse() */
+#define AVX512_HAD_8PT(r, o, add, sub) \
+{ \
+    __m512i p0, p1, p2, p4, p5, p6; \
+    p0 = add(r[0], r[1]); p2 = add(r[2], r[3]); p4 = add(r[4], r[5]); p6 = add(r[6], r[7]); \
+    p1 = add(p0, p2); p5 = add(p4, p6); o[0] = add(p1, p5); o[4] = sub(p1, p5); \
+    p1 = sub(p0, p2); p5 = sub(p4, p6); o[2] = add(p1, p5); o[6] = sub(p1, p5); \
+    p0 = sub(r[0], r[1]); p2 = sub(r[2], r[3]); p4 = sub(r[4], r[5]); p6 = sub(r[6], r[7]); \
+    p1 = add(p0, p2); p5 = add(p4, p6); o[1] = add(p1, p5); o[5] = sub(p1, p5); \
+    p1 = sub(p0, p2); p5 = sub(p4, p6); o[3] = add(p1, p5); o[7] = sub(p1, p5); \
+}
+
+/* four horizontally adjacent 8x8 blocks, one per 128-bit lane, with the
+   arithmetic and rounding of xeve_had_8x8_sse() applied to each block */
+static int had_8x8x4_avx512(pel *org, pel *cur, int s_org, int s_cur)
+{
+    __m512i r[8], t[8], lo[8], hi[8], acc;
+    int i, sum;
+
+    for(i = 0; i < 8; i++)
+    {
+        r[i] = _mm512_sub_epi16(_mm512_loadu_si512((__m512i *)(org + i * s_org)), _mm512_loadu_si512((__m512i *)(cur + i * s_cur)));
+    }
+
+    /* horizontal transform on 16-bit */
+    AVX512_TRANSPOSE_8x8_16B(r, t);
+    AVX512_HAD_8PT(t, r, _mm512_add_epi16, _mm512_sub_epi16);
+    AVX512_TRANSPOSE_8x8_16B(r, t);
+
+    /* vertical transform on 32-bit, first and last four columns */
+    for(i = 0; i < 8; i++)
+    {
+        r[i] = _mm512_srai_epi32(_mm512_unpacklo_epi16(t[i], t[i]), 16);
+        t[i] = _mm512_srai_epi32(_mm512_unpackhi_epi16(t[i], t[i]), 16);
+    }
+    AVX512_HAD_8PT(r, lo, _mm512_add_epi32, _mm512_sub_epi32);
+    AVX512_HAD_8PT(t, hi, _mm512_add_epi32, _mm512_sub_epi32);
+
+    /* DC of each block is scaled down */
+    acc = _mm512_abs_epi32(lo[0]);
+    acc = _mm512_mask_blend_epi32(0x1111, acc, _mm512_srai_epi32(acc, 2));
+    for(i = 1; i < 8; i++)
+    {
+        acc = _mm512_add_epi32(acc, _mm512_abs_epi32(lo[i]));
+    }
+    for(i = 0; i < 8; i++)
+    {
+        acc = _mm512_add_epi32(acc, _mm512_abs_epi32(hi[i]));
+    }
+    /* sum of each block in the first element of its lane */
+    acc = _mm512_add_epi32(acc, _mm512_shuffle_epi32(acc, _MM_PERM_BADC));
+    acc = _mm512_add_epi32(acc, _mm512_shuffle_epi32(acc, _MM_PERM_CDAB));
+
+    sum  = (_mm_cvtsi128_si32(_mm512_castsi512_si128(acc)) + 2) >> 2;
+    sum += (_mm_cvtsi128_si32(_mm512_extracti32x4_epi32(acc, 1)) + 2) >> 2;
+    sum += (_mm_cvtsi128_si32(_mm512_extracti32x4_epi32(acc, 2)) + 2) >> 2;
+    sum += (_mm_cvtsi128_si32(_mm512_extracti32x4_epi32(acc, 3)) + 2) >> 2;
+
+    return sum;
+}
+
+static int xeve_had_avx512(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_depth)
+{
+    pel *org = o;
+    pel *cur = c;
+    int  x, y;
+    int  sum = 0;
+
+    /* square blocks use 8x8 transforms, the other shapes go to the AVX2 kernel */
+    if(w == h && (w & 31) == 0)
+    {
+        for(y = 0; y < h; y += 8)
+        {
+            for(x = 0; x < w; x += 32)
+            {
+                sum += had_8x8x4_avx512(&org[x], &cur[x], s_org, s_cur);
+            }
+            org += s_org << 3;
+            cur += s_cur << 3;
+        }
+        return (sum >> (bit_depth - 8));
+    }
+    return xeve_tbl_satd_16b_avx[0](w, h, o, c, s_org, s_cur, bit_depth);
+}
+
+const XEVE_FN_SATD xeve_tbl_satd_16b_avx512[1] =
+{
+    xeve_had_avx512,
+};
+#endif /* X86_SSE */
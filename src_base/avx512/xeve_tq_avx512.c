@@ -0,0 +1,116 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if X86_SSE
+/* first pass of the forward transform as a plain matrix product, sixteen
+   lines at a time. the lines are transposed so that each register holds one
+   pair of neighbouring samples of all sixteen lines, after which a row of
+   output coefficients is a sum of madd with broadcast coefficient pairs and
+   is stored without any further shuffling. only the first nz rows are
+   computed; the rest are zero as in the C version of the 64-point transform */
+static __inline void tx_pbNb_avx512(s16 * src, s32 * dst, int n, int nz, const s8 * tm, int shift, int line)
+{
+    s32     cp[32][32]; /* coefficient pairs of the output rows */
+    __m512i p[32], acc, add = _mm512_set1_epi32(shift == 0 ? 0 : 1 << (shift - 1));
+    int     j, k, q, b;
+
+    for(k = 0; k < nz; k++)
+    {
+        for(q = 0; q < n; q += 32)
+        {
+            _mm512_storeu_si512((__m512i *)(cp[k] + (q >> 1)),
+                                _mm512_cvtepi8_epi16(_mm256_loadu_si256((__m256i *)(tm + k * n + q))));
+        }
+    }
+
+    for(j = 0; j < line; j += 16)
+    {
+        for(b = 0; b < (n >> 5); b++)
+        {
+            for(q = 0; q < 16; q++)
+            {
+                p[b * 16 + q] = _mm512_loadu_si512((__m512i *)(src + (j + q) * n + b * 32));
+            }
+            AVX512_TRANSPOSE_16x16_32B((p + b * 16));
+        }
+
+        for(k = 0; k < nz; k++)
+        {
+            acc = add;
+            for(q = 0; q < (n >> 1); q++)
+            {
+                acc = _mm512_add_epi32(acc, _mm512_madd_epi16(p[q], _mm512_set1_epi32(cp[k][q])));
+            }
+            _mm512_storeu_si512((__m512i *)(dst + k * line + j), _mm512_srai_epi32(acc, shift));
+        }
+        for(; k < n; k++)
+        {
+            _mm512_storeu_si512((__m512i *)(dst + k * line + j), _mm512_setzero_si512());
+        }
+    }
+}
+
+static void tx_pb32b_avx512(void * src, void * dst, int shift, int line, int step)
+{
+    if(step == 1 || (line & 15))
+    {
+        xeve_tx_pb32b_avx(src, dst, shift, line, step);
+        return;
+    }
+    tx_pbNb_avx512((s16 *)src, (s32 *)dst, 32, 32, xeve_tbl_tm32[0], shift, line);
+}
+
+static void tx_pb64b_avx512(void * src, void * dst, int shift, int line, int step)
+{
+    if(step == 1 || (line & 15))
+    {
+        xeve_tx_pb64b_avx(src, dst, shift, line, step);
+        return;
+    }
+    tx_pbNb_avx512((s16 *)src, (s32 *)dst, 64, 32, xeve_tbl_tm64[0], shift, line);
+}
+
+const XEVE_TXB xeve_tbl_txb_avx512[MAX_TR_LOG2] =
+{
+    tx_pb2b,
+    tx_pb4b,
+    xeve_tx_pb8b_avx,
+    xeve_tx_pb16b_avx,
+    tx_pb32b_avx512,
+    tx_pb64b_avx512
+};
+#endif /* X86_SSE */
@@ -0,0 +1,73 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _XEVE_TQ_AVX512_H_
+#define _XEVE_TQ_AVX512_H_
+
+#if X86_SSE
+/* in-place transpose of a 16x16 block of 32-bit values held in r[0..15] */
+#define AVX512_TRANSPOSE_16x16_32B(r) \
+{ \
+    __m512i t_[16], u_[16], v0_, v1_, v2_, v3_; \
+    int i_; \
+    for(i_ = 0; i_ < 16; i_ += 2) \
+    { \
+        t_[i_]     = _mm512_unpacklo_epi32(r[i_], r[i_ + 1]); \
+        t_[i_ + 1] = _mm512_unpackhi_epi32(r[i_], r[i_ + 1]); \
+    } \
+    for(i_ = 0; i_ < 16; i_ += 4) \
+    { \
+        u_[i_]     = _mm512_unpacklo_epi64(t_[i_], t_[i_ + 2]); \
+        u_[i_ + 1] = _mm512_unpackhi_epi64(t_[i_], t_[i_ + 2]); \
+        u_[i_ + 2] = _mm512_unpacklo_epi64(t_[i_ + 1], t_[i_ + 3]); \
+        u_[i_ + 3] = _mm512_unpackhi_epi64(t_[i_ + 1], t_[i_ + 3]); \
+    } \
+    for(i_ = 0; i_ < 4; i_++) \
+    { \
+        v0_ = _mm512_shuffle_i32x4(u_[i_], u_[i_ + 4], 0x88); \
+        v1_ = _mm512_shuffle_i32x4(u_[i_], u_[i_ + 4], 0xDD); \
+        v2_ = _mm512_shuffle_i32x4(u_[i_ + 8], u_[i_ + 12], 0x88); \
+        v3_ = _mm512_shuffle_i32x4(u_[i_ + 8], u_[i_ + 12], 0xDD); \
+        r[i_]      = _mm512_shuffle_i32x4(v0_, v2_, 0x88); \
+        r[i_ + 8]  = _mm512_shuffle_i32x4(v0_, v2_, 0xDD); \
+        r[i_ + 4]  = _mm512_shuffle_i32x4(v1_, v3_, 0x88); \
+        r[i_ + 12] = _mm512_shuffle_i32x4(v1_, v3_, 0xDD); \
+    } \
+}
+
+extern const XEVE_TXB xeve_tbl_txb_avx512[MAX_TR_LOG2];
+#endif /* X86_SSE */
+
+#endif /* _XEVE_TQ_AVX512_H_ */
@@ -0,0 +1,113 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if ARM_NEON
+#include <arm_neon.h>
+
+void xeve_plane_shl_8b_neon(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift)
+{
+    u8 *s = (u8 *)src;
+    int16x8_t sft = vdupq_n_s16((s16)shift);
+    uint8x16_t m0;
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j + 16 <= w; j += 16)
+        {
+            m0 = vld1q_u8(s + j);
+            vst1q_s16(dst + j, vreinterpretq_s16_u16(vshlq_u16(vmovl_u8(vget_low_u8(m0)), sft)));
+            vst1q_s16(dst + j + 8, vreinterpretq_s16_u16(vshlq_u16(vmovl_u8(vget_high_u8(m0)), sft)));
+        }
+        for(; j < w; j++)
+        {
+            dst[j] = (pel)(s[j] << shift);
+        }
+        s += s_src;
+        dst += s_dst;
+    }
+}
+
+void xeve_plane_shl_16b_neon(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift)
+{
+    u16 *s = (u16 *)src;
+    int16x8_t sft = vdupq_n_s16((s16)shift);
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j + 16 <= w; j += 16)
+        {
+            vst1q_s16(dst + j, vreinterpretq_s16_u16(vshlq_u16(vld1q_u16(s + j), sft)));
+            vst1q_s16(dst + j + 8, vreinterpretq_s16_u16(vshlq_u16(vld1q_u16(s + j + 8), sft)));
+        }
+        for(; j < w; j++)
+        {
+            dst[j] = (pel)(s[j] << shift);
+        }
+        s += s_src;
+        dst += s_dst;
+    }
+}
+
+void xeve_plane_expand_lr_neon(pel *a, int s, int w, int h, int exp)
+{
+    pel *l, *r;
+    int16x8_t ml, mr;
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        l = a - exp;
+        r = a + w;
+        ml = vdupq_n_s16(a[0]);
+        mr = vdupq_n_s16(a[w - 1]);
+
+        for(j = 0; j + 8 <= exp; j += 8)
+        {
+            vst1q_s16(l + j, ml);
+            vst1q_s16(r + j, mr);
+        }
+        for(; j < exp; j++)
+        {
+            l[j] = a[0];
+            r[j] = a[w - 1];
+        }
+        a += s;
+    }
+}
+#endif /* ARM_NEON */
@@ -0,0 +1,194 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if X86_SSE
+/* four lines of one edge are filtered at once, one 16-bit lane per line;
+   the arithmetic follows deblock_scu_hor()/deblock_scu_ver() exactly */
+static __inline void dbk_filter_sse(__m128i * A, __m128i * B, __m128i * C, __m128i * D, int st, int bit_depth_minus8, int is_luma)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16((1 << (bit_depth_minus8 + 8)) - 1);
+    const __m128i vst = _mm_set1_epi16(st);
+    __m128i d, abs, t16, clip, d1, d2;
+
+    /* d = (A - 4 * B + 4 * C - D) / 8, rounded toward zero */
+    d = _mm_sub_epi16(_mm_add_epi16(_mm_sub_epi16(*A, _mm_slli_epi16(*B, 2)), _mm_slli_epi16(*C, 2)), *D);
+    d = _mm_srai_epi16(_mm_add_epi16(d, _mm_and_si128(_mm_srai_epi16(d, 15), _mm_set1_epi16(7))), 3);
+
+    abs = _mm_abs_epi16(d);
+    t16 = _mm_max_epi16(zero, _mm_slli_epi16(_mm_sub_epi16(abs, vst), 1));
+    clip = _mm_max_epi16(zero, _mm_sub_epi16(abs, t16));
+    d1 = _mm_sign_epi16(clip, d);
+
+    *B = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(*B, d1), zero), max);
+    *C = _mm_min_epi16(_mm_max_epi16(_mm_sub_epi16(*C, d1), zero), max);
+
+    if(is_luma)
+    {
+        /* d2 = clip3(-clip / 2, clip / 2, (A - D) / 4) */
+        clip = _mm_srai_epi16(clip, 1);
+        d2 = _mm_sub_epi16(*A, *D);
+        d2 = _mm_srai_epi16(_mm_add_epi16(d2, _mm_and_si128(_mm_srai_epi16(d2, 15), _mm_set1_epi16(3))), 2);
+        d2 = _mm_min_epi16(_mm_max_epi16(d2, _mm_sub_epi16(zero, clip)), clip);
+
+        *A = _mm_min_epi16(_mm_max_epi16(_mm_sub_epi16(*A, d2), zero), max);
+        *D = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(*D, d2), zero), max);
+    }
+}
+
+static __inline void dbk_store_sse(pel * buf, __m128i v, int size)
+{
+    if(size == 4)
+    {
+        _mm_storel_epi64((__m128i*)buf, v);
+    }
+    else
+    {
+        int t = _mm_cvtsi128_si32(v);
+        xeve_mcpy(buf, &t, sizeof(int));
+    }
+}
+
+/* 4x4 transpose of the low 64 bits of four registers */
+#define DBK_TRANSPOSE_4x4(r0, r1, r2, r3, c0, c1, c2, c3) \
+{ \
+    __m128i t0 = _mm_unpacklo_epi16(r0, r1); \
+    __m128i t1 = _mm_unpacklo_epi16(r2, r3); \
+    c0 = _mm_unpacklo_epi32(t0, t1); \
+    c2 = _mm_unpackhi_epi32(t0, t1); \
+    c1 = _mm_srli_si128(c0, 8); \
+    c3 = _mm_srli_si128(c2, 8); \
+}
+
+static void deblock_scu_hor_sse(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8, int chroma_format_idc)
+{
+    int st = tbl_qp_to_st[qp] << bit_depth_minus8;
+    __m128i A, B, C, D;
+
+    if(st)
+    {
+        A = _mm_loadl_epi64((__m128i*)(buf - 2 * stride));
+        B = _mm_loadl_epi64((__m128i*)(buf - stride));
+        C = _mm_loadl_epi64((__m128i*)(buf));
+        D = _mm_loadl_epi64((__m128i*)(buf + stride));
+
+        dbk_filter_sse(&A, &B, &C, &D, st, bit_depth_minus8, 1);
+
+        _mm_storel_epi64((__m128i*)(buf - 2 * stride), A);
+        _mm_storel_epi64((__m128i*)(buf - stride), B);
+        _mm_storel_epi64((__m128i*)(buf), C);
+        _mm_storel_epi64((__m128i*)(buf + stride), D);
+    }
+}
+
+static void deblock_scu_hor_chroma_sse(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8, int chroma_format_idc)
+{
+    int st = tbl_qp_to_st[qp] << bit_depth_minus8;
+    int size = MIN_CU_SIZE >> XEVE_GET_CHROMA_W_SHIFT(chroma_format_idc);
+    __m128i A, B, C, D;
+
+    if(st)
+    {
+        A = _mm_loadl_epi64((__m128i*)(buf - 2 * stride));
+        B = _mm_loadl_epi64((__m128i*)(buf - stride));
+        C = _mm_loadl_epi64((__m128i*)(buf));
+        D = _mm_loadl_epi64((__m128i*)(buf + stride));
+
+        dbk_filter_sse(&A, &B, &C, &D, st, bit_depth_minus8, 0);
+
+        dbk_store_sse(buf - stride, B, size);
+        dbk_store_sse(buf, C, size);
+    }
+}
+
+static void deblock_scu_ver_sse(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8, int chroma_format_idc)
+{
+    int st = tbl_qp_to_st[qp] << bit_depth_minus8;
+    __m128i r0, r1, r2, r3, A, B, C, D;
+
+    if(st)
+    {
+        r0 = _mm_loadl_epi64((__m128i*)(buf - 2));
+        r1 = _mm_loadl_epi64((__m128i*)(buf + stride - 2));
+        r2 = _mm_loadl_epi64((__m128i*)(buf + 2 * stride - 2));
+        r3 = _mm_loadl_epi64((__m128i*)(buf + 3 * stride - 2));
+        DBK_TRANSPOSE_4x4(r0, r1, r2, r3, A, B, C, D);
+
+        dbk_filter_sse(&A, &B, &C, &D, st, bit_depth_minus8, 1);
+
+        DBK_TRANSPOSE_4x4(A, B, C, D, r0, r1, r2, r3);
+        _mm_storel_epi64((__m128i*)(buf - 2), r0);
+        _mm_storel_epi64((__m128i*)(buf + stride - 2), r1);
+        _mm_storel_epi64((__m128i*)(buf + 2 * stride - 2), r2);
+        _mm_storel_epi64((__m128i*)(buf + 3 * stride - 2), r3);
+    }
+}
+
+static void deblock_scu_ver_chroma_sse(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8, int chroma_format_idc)
+{
+    int st = tbl_qp_to_st[qp] << bit_depth_minus8;
+    int size = MIN_CU_SIZE >> XEVE_GET_CHROMA_H_SHIFT(chroma_format_idc);
+    __m128i r[4], A, B, C, D;
+    int i;
+
+    if(st)
+    {
+        for(i = 0; i < 4; i++)
+        {
+            r[i] = i < size ? _mm_loadl_epi64((__m128i*)(buf + i * stride - 2)) : _mm_setzero_si128();
+        }
+        DBK_TRANSPOSE_4x4(r[0], r[1], r[2], r[3], A, B, C, D);
+
+        dbk_filter_sse(&A, &B, &C, &D, st, bit_depth_minus8, 0);
+
+        DBK_TRANSPOSE_4x4(A, B, C, D, r[0], r[1], r[2], r[3]);
+        for(i = 0; i < size; i++)
+        {
+            /* only the two pels next to the edge are modified */
+            dbk_store_sse(buf + i * stride - 1, _mm_srli_si128(r[i], 2), 2);
+        }
+    }
+}
+
+const XEVE_DBK xeve_tbl_dbk_sse[2][2] =
+{
+    /* horizontal edge: luma, chroma */
+    { deblock_scu_hor_sse, deblock_scu_hor_chroma_sse },
+    /* vertical edge: luma, chroma */
+    { deblock_scu_ver_sse, deblock_scu_ver_chroma_sse }
+};
+#endif /* X86_SSE */
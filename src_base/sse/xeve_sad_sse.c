@@ -362,7 +362,7 @@ const XEVE_FN_SAD xeve_tbl_sad_16b_sse[8][8] =
     m02 = _mm_sub_epi16(m00, m01); \
     _mm_storeu_si128((__m128i*)(diff), m02);
 
-static void diff_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+void diff_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
 {
     s16 * s1;
     s16 * s2;
@@ -375,7 +375,7 @@ static void diff_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1,
     SSE_DIFF_16B_4PEL(s1 + s_src1, s2 + s_src2, diff + s_diff, m04, m05, m06);
 }
 
-static void diff_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+void diff_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
 {
     s16 * s1;
     s16 * s2;
@@ -390,7 +390,7 @@ static void diff_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1,
     SSE_DIFF_16B_4PEL(s1 + s_src1*3, s2 + s_src2*3, diff + s_diff*3, m10, m11, m12);
 }
 
-static void diff_16b_sse_8x8(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+void diff_16b_sse_8x8(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
 {
     s16 * s1;
     s16 * s2;
@@ -409,7 +409,7 @@ static void diff_16b_sse_8x8(int w, int h, void * src1, void * src2, int s_src1,
     SSE_DIFF_16B_8PEL(s1 + s_src1*7, s2 + s_src2*7, diff + s_diff*7, m10, m11, m12);
 }
 
-static void diff_16b_sse_8nx2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+void diff_16b_sse_8nx2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
 {
     s16 * s1;
     s16 * s2;
@@ -627,7 +627,7 @@ const XEVE_FN_DIFF xeve_tbl_diff_16b_sse[8][8] =
     s00a = _mm_add_epi32(s00a, s00); \
     s00a = _mm_add_epi32(s00a, s01);
 
-static s64 ssd_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
 {
     s64   ssd;
     s16 * s1;
@@ -651,7 +651,7 @@ static s64 ssd_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, i
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
 {
     s64   ssd;
     s16 * s1;
@@ -677,7 +677,7 @@ static s64 ssd_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, i
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x8(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x8(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
 {
     s64   ssd;
     s16 * s1;
@@ -707,7 +707,7 @@ static s64 ssd_16b_sse_4x8(int w, int h, void * src1, void * src2, int s_src1, i
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x16(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x16(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
 {
     s64   ssd;
     s16 * s1;
@@ -745,7 +745,7 @@ static s64 ssd_16b_sse_4x16(int w, int h, void * src1, void * src2, int s_src1,
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x32(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x32(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
 {
     s64   ssd;
     s16 * s1;
@@ -0,0 +1,261 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if X86_SSE
+/* first pass of the forward transform as a plain matrix product with the
+   transform matrix: four lines at a time, eight samples per madd. the result
+   is identical to the partial butterflies of the C version, including the
+   zeroed high frequency half of the 64-point transform */
+static void tx_pb4b_sse(void * src_, void * dst_, int shift, int line, int step)
+{
+    s16 * src = (s16 *)src_;
+    s32 * dst = (s32 *)dst_;
+    __m128i s01, s23, c, m0, m1;
+    __m128i add = _mm_set1_epi32(shift == 0 ? 0 : 1 << (shift - 1));
+    int j, k;
+
+    if(step == 1 || (line & 3))
+    {
+        tx_pb4b(src_, dst_, shift, line, step);
+        return;
+    }
+
+    for(j = 0; j < line; j += 4)
+    {
+        s01 = _mm_loadu_si128((__m128i *)(src + j * 4));
+        s23 = _mm_loadu_si128((__m128i *)(src + j * 4 + 8));
+
+        for(k = 0; k < 4; k++)
+        {
+            c = _mm_cvtepi8_epi16(_mm_set1_epi32(*(const int *)xeve_tbl_tm4[k]));
+            m0 = _mm_madd_epi16(s01, c);
+            m1 = _mm_madd_epi16(s23, c);
+            m0 = _mm_add_epi32(_mm_hadd_epi32(m0, m1), add);
+            _mm_storeu_si128((__m128i *)(dst + k * line + j), _mm_srai_epi32(m0, shift));
+        }
+    }
+}
+
+#define TX_PBNB_SSE(n, tm, nz) \
+static void tx_pb##n##b_sse(void * src_, void * dst_, int shift, int line, int step) \
+{ \
+    s16 * src = (s16 *)src_; \
+    s32 * dst = (s32 *)dst_; \
+    __m128i c, a0, a1, a2, a3; \
+    __m128i add = _mm_set1_epi32(shift == 0 ? 0 : 1 << (shift - 1)); \
+    s16 * s; \
+    int j, k, i; \
+    \
+    if(step == 1 || (line & 3)) \
+    { \
+        tx_pb##n##b(src_, dst_, shift, line, step); \
+        return; \
+    } \
+    \
+    for(j = 0; j < line; j += 4) \
+    { \
+        s = src + j * n; \
+        for(k = 0; k < nz; k++) \
+        { \
+            a0 = a1 = a2 = a3 = _mm_setzero_si128(); \
+            for(i = 0; i < n; i += 8) \
+            { \
+                c = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(tm[k] + i))); \
+                a0 = _mm_add_epi32(a0, _mm_madd_epi16(_mm_loadu_si128((__m128i *)(s + i)), c)); \
+                a1 = _mm_add_epi32(a1, _mm_madd_epi16(_mm_loadu_si128((__m128i *)(s + n + i)), c)); \
+                a2 = _mm_add_epi32(a2, _mm_madd_epi16(_mm_loadu_si128((__m128i *)(s + 2 * n + i)), c)); \
+                a3 = _mm_add_epi32(a3, _mm_madd_epi16(_mm_loadu_si128((__m128i *)(s + 3 * n + i)), c)); \
+            } \
+            a0 = _mm_hadd_epi32(_mm_hadd_epi32(a0, a1), _mm_hadd_epi32(a2, a3)); \
+            a0 = _mm_srai_epi32(_mm_add_epi32(a0, add), shift); \
+            _mm_storeu_si128((__m128i *)(dst + k * line + j), a0); \
+        } \
+        for(; k < n; k++) \
+        { \
+            _mm_storeu_si128((__m128i *)(dst + k * line + j), _mm_setzero_si128()); \
+        } \
+    } \
+}
+
+TX_PBNB_SSE(8, xeve_tbl_tm8, 8)
+TX_PBNB_SSE(16, xeve_tbl_tm16, 16)
+TX_PBNB_SSE(32, xeve_tbl_tm32, 32)
+TX_PBNB_SSE(64, xeve_tbl_tm64, 32)
+
+#undef TX_PBNB_SSE
+
+/* largest magnitude of eight lanes of unsigned 16 bit values */
+static __inline u32 hmax_epu16_sse(__m128i v)
+{
+    return 0xFFFF - _mm_extract_epi16(_mm_minpos_epu16(_mm_xor_si128(v, _mm_set1_epi16(-1))), 0);
+}
+
+u32 xeve_coef_abs_max_sse(s16 * coef, int num)
+{
+    __m128i max = _mm_setzero_si128();
+    int i;
+
+    if(num & 7)
+    {
+        return xeve_coef_abs_max(coef, num);
+    }
+    for(i = 0; i < num; i += 8)
+    {
+        max = _mm_max_epu16(max, _mm_abs_epi16(_mm_loadu_si128((__m128i *)(coef + i))));
+    }
+    return hmax_epu16_sse(max);
+}
+
+/* (|c| * scale + offset) >> shift of four 32 bit lanes with 64 bit products,
+   truncated to 32 bit */
+static __inline __m128i quant_epu32_sse(__m128i a, __m128i scale, __m128i offset, __m128i shift)
+{
+    __m128i e = _mm_srl_epi64(_mm_add_epi64(_mm_mul_epu32(a, scale), offset), shift);
+    __m128i o = _mm_srl_epi64(_mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), scale), offset), shift);
+
+    return _mm_blend_epi16(e, _mm_slli_epi64(o, 32), 0xCC);
+}
+
+int xeve_quant_sse(s16 * coef, int num, int scale, s64 offset, int shift)
+{
+    __m128i vscale, voffset, vshift, c, a, lo, hi, zeros;
+    __m128i zero = _mm_setzero_si128();
+    int i;
+
+    if(num & 7)
+    {
+        return xeve_quant(coef, num, scale, offset, shift);
+    }
+
+    /* the largest coefficient quantising to zero means an all-zero block */
+    if((((s64)xeve_coef_abs_max_sse(coef, num) * scale + offset) >> shift) == 0)
+    {
+        xeve_mset(coef, 0, sizeof(s16) * num);
+        return 0;
+    }
+
+    vscale = _mm_set1_epi32(scale);
+    voffset = _mm_set1_epi64x(offset);
+    vshift = _mm_cvtsi32_si128(shift);
+    zeros = zero;
+
+    for(i = 0; i < num; i += 8)
+    {
+        c = _mm_loadu_si128((__m128i *)(coef + i));
+        a = _mm_abs_epi16(c);
+        lo = quant_epu32_sse(_mm_cvtepu16_epi32(a), vscale, voffset, vshift);
+        hi = quant_epu32_sse(_mm_unpackhi_epi16(a, zero), vscale, voffset, vshift);
+        /* keep the low 16 bits of the levels, as the cast to s16 does */
+        lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+        hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+        a = _mm_sign_epi16(_mm_packs_epi32(lo, hi), c);
+        _mm_storeu_si128((__m128i *)(coef + i), a);
+        zeros = _mm_sub_epi16(zeros, _mm_cmpeq_epi16(a, zero));
+    }
+    zeros = _mm_madd_epi16(zeros, _mm_set1_epi16(1));
+    zeros = _mm_add_epi32(zeros, _mm_shuffle_epi32(zeros, 0x4E));
+    zeros = _mm_add_epi32(zeros, _mm_shuffle_epi32(zeros, 0xB1));
+
+    return num - _mm_cvtsi128_si32(zeros);
+}
+
+/* the uncoded error is below 2^32 and the scaled level below 2^31 for every
+   block size, so the 64 bit products can use the unsigned 32x32 multiply */
+int xeve_rdoq_est_level_sse(s16 * src, s16 * level, s32 * level_double, s64 * err0, int num, int q_value, int q_bits, s64 err_scale, s64 * err0_sum)
+{
+    __m128i vq = _mm_set1_epi32(q_value);
+    __m128i vmax = _mm_set1_epi32(XEVE_INT32_MAX - (1 << (q_bits - 1)));
+    __m128i vhalf = _mm_set1_epi32(1 << (q_bits - 1));
+    __m128i vqbits = _mm_cvtsi32_si128(q_bits);
+    __m128i vlmax = _mm_set1_epi32(MAX_TX_VAL);
+    __m128i vscale = _mm_set1_epi32((int)err_scale);
+    __m128i zero = _mm_setzero_si128();
+    __m128i sum = zero;
+    __m128i zeros = zero;
+    __m128i c, ld[2], lv[2], e, o;
+    int i, k;
+    s64 s[2];
+
+    if((num & 7) || (err_scale >> 32))
+    {
+        return xeve_rdoq_est_level(src, level, level_double, err0, num, q_value, q_bits, err_scale, err0_sum);
+    }
+
+    for(i = 0; i < num; i += 8)
+    {
+        c = _mm_abs_epi16(_mm_loadu_si128((__m128i *)(src + i)));
+        ld[0] = _mm_cvtepu16_epi32(c);
+        ld[1] = _mm_unpackhi_epi16(c, zero);
+
+        for(k = 0; k < 2; k++)
+        {
+            ld[k] = _mm_min_epi32(_mm_mullo_epi32(ld[k], vq), vmax);
+            lv[k] = _mm_min_epi32(_mm_sra_epi32(_mm_add_epi32(ld[k], vhalf), vqbits), vlmax);
+            _mm_storeu_si128((__m128i *)(level_double + i + 4 * k), ld[k]);
+
+            e = _mm_srli_epi64(_mm_mul_epu32(ld[k], vscale), ERR_SCALE_PRECISION_BITS);
+            o = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(ld[k], 32), vscale), ERR_SCALE_PRECISION_BITS);
+            e = _mm_mul_epu32(e, e);
+            o = _mm_mul_epu32(o, o);
+            _mm_storeu_si128((__m128i *)(err0 + i + 4 * k), _mm_unpacklo_epi64(e, o));
+            _mm_storeu_si128((__m128i *)(err0 + i + 4 * k + 2), _mm_unpackhi_epi64(e, o));
+            sum = _mm_add_epi64(sum, _mm_add_epi64(e, o));
+        }
+        c = _mm_packs_epi32(lv[0], lv[1]);
+        _mm_storeu_si128((__m128i *)(level + i), c);
+        zeros = _mm_sub_epi16(zeros, _mm_cmpeq_epi16(c, zero));
+    }
+    _mm_storeu_si128((__m128i *)s, sum);
+    *err0_sum = s[0] + s[1];
+
+    zeros = _mm_madd_epi16(zeros, _mm_set1_epi16(1));
+    zeros = _mm_add_epi32(zeros, _mm_shuffle_epi32(zeros, 0x4E));
+    zeros = _mm_add_epi32(zeros, _mm_shuffle_epi32(zeros, 0xB1));
+
+    return num - _mm_cvtsi128_si32(zeros);
+}
+
+const XEVE_TXB xeve_tbl_txb_sse[MAX_TR_LOG2] =
+{
+    tx_pb2b,
+    tx_pb4b_sse,
+    tx_pb8b_sse,
+    tx_pb16b_sse,
+    tx_pb32b_sse,
+    tx_pb64b_sse
+};
+#endif /* X86_SSE */
@@ -0,0 +1,117 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if X86_SSE
+void xeve_plane_shl_8b_sse(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift)
+{
+    u8 *s = (u8 *)src;
+    __m128i zero = _mm_setzero_si128();
+    __m128i sft = _mm_cvtsi32_si128(shift);
+    __m128i m0, m1;
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j + 16 <= w; j += 16)
+        {
+            m0 = _mm_loadu_si128((__m128i *)(s + j));
+            m1 = _mm_unpackhi_epi8(m0, zero);
+            m0 = _mm_unpacklo_epi8(m0, zero);
+            _mm_storeu_si128((__m128i *)(dst + j), _mm_sll_epi16(m0, sft));
+            _mm_storeu_si128((__m128i *)(dst + j + 8), _mm_sll_epi16(m1, sft));
+        }
+        for(; j < w; j++)
+        {
+            dst[j] = (pel)(s[j] << shift);
+        }
+        s += s_src;
+        dst += s_dst;
+    }
+}
+
+void xeve_plane_shl_16b_sse(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift)
+{
+    u16 *s = (u16 *)src;
+    __m128i sft = _mm_cvtsi32_si128(shift);
+    __m128i m0, m1;
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j + 16 <= w; j += 16)
+        {
+            m0 = _mm_loadu_si128((__m128i *)(s + j));
+            m1 = _mm_loadu_si128((__m128i *)(s + j + 8));
+            _mm_storeu_si128((__m128i *)(dst + j), _mm_sll_epi16(m0, sft));
+            _mm_storeu_si128((__m128i *)(dst + j + 8), _mm_sll_epi16(m1, sft));
+        }
+        for(; j < w; j++)
+        {
+            dst[j] = (pel)(s[j] << shift);
+        }
+        s += s_src;
+        dst += s_dst;
+    }
+}
+
+void xeve_plane_expand_lr_sse(pel *a, int s, int w, int h, int exp)
+{
+    pel *l, *r;
+    __m128i ml, mr;
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        l = a - exp;
+        r = a + w;
+        ml = _mm_set1_epi16(a[0]);
+        mr = _mm_set1_epi16(a[w - 1]);
+
+        for(j = 0; j + 8 <= exp; j += 8)
+        {
+            _mm_storeu_si128((__m128i *)(l + j), ml);
+            _mm_storeu_si128((__m128i *)(r + j), mr);
+        }
+        for(; j < exp; j++)
+        {
+            l[j] = a[0];
+            r[j] = a[w - 1];
+        }
+        a += s;
+    }
+}
+#endif /* X86_SSE */
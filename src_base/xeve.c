@@ -52,6 +52,9 @@ XEVE xeve_create(XEVE_CDSC * cdsc, int * err)
     /* memory allocation for ctx and core structure */
     ctx = (XEVE_CTX*)xeve_ctx_alloc();
 
+    /* kernels are dispatched through the context the calling thread works for */
+    thread_owner = ctx;
+
     /* set default value for encoding parameter */
     xeve_mcpy(&ctx->param, &(cdsc->param), sizeof(XEVE_PARAM));
     ret = xeve_set_init_param(ctx, &ctx->param);
@@ -85,6 +88,7 @@ ERR:
         xeve_platform_deinit(ctx);
         xeve_delete_bs_buf(ctx);
         xeve_ctx_free(ctx);
+        thread_owner = NULL;
     }
     if(err) *err = ret;
     return NULL;
@@ -95,6 +99,7 @@ void xeve_delete(XEVE id)
     XEVE_CTX * ctx;
 
     XEVE_ID_TO_CTX_R(id, ctx);
+    thread_owner = ctx;
 
 #if ENC_DEC_TRACE
     fclose(fp_trace);
@@ -108,13 +113,16 @@ void xeve_delete(XEVE id)
     xeve_platform_deinit(ctx);
     xeve_delete_bs_buf(ctx);
     xeve_ctx_free(ctx);
+    thread_owner = NULL;
 }
 
 int xeve_encode(XEVE id, XEVE_BITB * bitb, XEVE_STAT * stat)
 {
     XEVE_CTX * ctx;
+    int        ret;
 
     XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
+    thread_owner = ctx;
     xeve_assert_rv(ctx->fn_enc, XEVE_ERR_UNEXPECTED);
 
     /* bumping - check whether input pictures are remaining or not in pico_buf[] */
@@ -122,12 +130,11 @@ int xeve_encode(XEVE id, XEVE_BITB * bitb, XEVE_STAT * stat)
     {
         return XEVE_OK_NO_MORE_FRM;
     }
-    if (!FORCE_OUT(ctx))
+    if (ctx->param.use_fcst && FORCE_OUT(ctx))
     {
-        if (ctx->param.use_fcst)
-        {
-            xeve_forecast_fixed_gop(ctx);
-        }
+        /* the last pictures are coded with the analysis of the last push */
+        ret = xeve_fcst_sync(ctx);
+        xeve_assert_rv(ret == XEVE_OK, ret);
     }
     /* store input picture and return if needed */
     if(XEVE_OK_OUT_NOT_AVAILABLE == xeve_check_frame_delay(ctx))
@@ -144,11 +151,28 @@ int xeve_encode(XEVE id, XEVE_BITB * bitb, XEVE_STAT * stat)
 int xeve_push(XEVE id, XEVE_IMGB * img)
 {
     XEVE_CTX * ctx;
+    int        ret;
 
     XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
+    thread_owner = ctx;
     xeve_assert_rv(ctx->fn_push, XEVE_ERR_UNEXPECTED);
 
-    return ctx->fn_push(ctx, img);
+    if (ctx->param.use_fcst)
+    {
+        /* the picture buffers read by the running analysis are reused by the push */
+        ret = xeve_fcst_sync(ctx);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
+
+    ret = ctx->fn_push(ctx, img);
+    xeve_assert_rv(ret == XEVE_OK, ret);
+
+    if (ctx->param.use_fcst)
+    {
+        /* analyse the pushed picture, ahead of the encoder with lookahead threads */
+        ret = xeve_fcst_run(ctx);
+    }
+    return ret;
 }
 
 int xeve_config(XEVE id, int cfg, void * buf, int * size)
@@ -158,6 +182,7 @@ int xeve_config(XEVE id, int cfg, void * buf, int * size)
     XEVE_IMGB      * imgb;
 
     XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
+    thread_owner = ctx;
 
     switch(cfg)
     {
@@ -303,6 +328,14 @@ int xeve_config(XEVE id, int cfg, void * buf, int * size)
             xeve_assert_rv(*size == sizeof(int), XEVE_ERR_INVALID_ARGUMENT);
             *((int *)buf) = XEVE_PROFILE_BASELINE;
             break;
+        case XEVE_CFG_GET_THREAD_WAIT_TIME:
+            xeve_assert_rv(*size >= (int)sizeof(long long) * ctx->param.threads, XEVE_ERR_INVALID_ARGUMENT);
+            for (t0 = 0; t0 < ctx->param.threads; t0++)
+            {
+                ((long long *)buf)[t0] = (long long)ctx->core[t0]->wait_time;
+            }
+            *size = (int)sizeof(long long) * ctx->param.threads;
+            break;
         default:
             xeve_trace("unknown config value (%d)\n", cfg);
             xeve_assert_rv(0, XEVE_ERR_UNSUPPORTED);
@@ -350,6 +383,25 @@ int xeve_param_check(const XEVE_PARAM* param)
     if (param->ibc_flag     == 1) { xeve_trace("IBC cannot be on in base profile\n"); ret = -1; }
     if (param->tool_rpl     == 1) { xeve_trace("RPL cannot be on in base profile\n"); ret = -1; }
     if (param->tool_pocs    == 1) { xeve_trace("POCS cannot be on in base profile\n"); ret = -1; }
+    if (param->adaptive_gop == 1) { xeve_trace("Adaptive GOP cannot be on in base profile\n"); ret = -1; }
+
+    if (param->pass < 0 || param->pass > 2) { xeve_trace("Rate control pass should be 0, 1 or 2\n"); ret = -1; }
+    if (param->pass > 0)
+    {
+        if (param->stats[0] == '\0') { xeve_trace("Multi-pass rate control needs a stats file\n"); ret = -1; }
+        if (param->rc_type == XEVE_RC_CQP) { xeve_trace("Multi-pass rate control cannot be used with CQP\n"); ret = -1; }
+        if (param->pass == 2 && param->rc_type != XEVE_RC_ABR) { xeve_trace("Second pass of rate control needs ABR\n"); ret = -1; }
+    }
+    if (param->row_vbv != 0 && param->row_vbv != 1) { xeve_trace("Row VBV should be 0 or 1\n"); ret = -1; }
+    if (param->cu_qp_delta_area < 6) { xeve_trace("CU QP delta area should not be less than 6\n"); ret = -1; }
+    if (param->row_vbv && param->rc_type == XEVE_RC_CQP) { xeve_trace("Row VBV cannot be used with CQP\n"); ret = -1; }
+    if (param->lookahead_threads < 0) { xeve_trace("Lookahead threads should not be negative\n"); ret = -1; }
+    if (param->isa < XEVE_ISA_AUTO || param->isa > XEVE_ISA_AVX512) { xeve_trace("Instruction set should be in the range of 0 to 4\n"); ret = -1; }
+    if (param->me_spel_plane < 0 || param->me_spel_plane > 2) { xeve_trace("Sub-pel ME planes should be 0, 1 or 2\n"); ret = -1; }
+    if (param->me_cache != 0 && param->me_cache != 1) { xeve_trace("ME cache should be 0 or 1\n"); ret = -1; }
+    if (param->early_skip != 0 && param->early_skip != 1) { xeve_trace("Early SKIP should be 0 or 1\n"); ret = -1; }
+    if (param->scenecut < 0 || param->scenecut > 100) { xeve_trace("Scene cut should be in the range of 0 to 100\n"); ret = -1; }
+    if (param->scenecut && param->closed_gop) { xeve_trace("Scene cut cannot be used with closed GOP\n"); ret = -1; }
 
     if (XEVE_CS_GET_FORMAT(param->cs) != XEVE_CF_YCBCR400)
     {
@@ -71,6 +71,20 @@ void xeve_bsw_deinit(XEVE_BSW * bs)
     bs->fn_flush(bs);
 }
 
+int xeve_bsw_write_byte_array(XEVE_BSW * bs, u8 * buf, int size)
+{
+    /* byte array can be appended only at byte aligned position */
+    xeve_assert_rv(XEVE_BSW_IS_BYTE_ALIGN(bs), -1);
+
+    bs->fn_flush(bs);
+    xeve_assert_rv(bs->cur + size <= bs->end, -1);
+
+    xeve_mcpy(bs->cur, buf, size);
+    bs->cur += size;
+
+    return 0;
+}
+
 #if TRACE_HLS
 void xeve_bsw_write_ue_trace(XEVE_BSW * bs, u32 val, char * name)
 {
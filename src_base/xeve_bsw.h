@@ -72,6 +72,7 @@ struct _XEVE_BSW
 void xeve_bsw_init(XEVE_BSW * bs, u8 * buf, int size, XEVE_BSW_FN_FLUSH fn_flush);
 void xeve_bsw_init_slice(XEVE_BSW * bs, u8 * buf, int size, XEVE_BSW_FN_FLUSH fn_flush);
 void xeve_bsw_deinit(XEVE_BSW * bs);
+int xeve_bsw_write_byte_array(XEVE_BSW * bs, u8 * buf, int size);
 #if TRACE_HLS
 #define xeve_bsw_write1(A, B) xeve_bsw_write1_trace(A, B, #B)
 int xeve_bsw_write1_trace(XEVE_BSW * bs, int val, char* name);
@@ -378,6 +378,9 @@ extern int fp_trace_started;
 
 #define PIC_PAD_SIZE_L                     (MAX_CU_SIZE + 16)
 #define PIC_PAD_SIZE_C                     (PIC_PAD_SIZE_L >> 1)
+/* sub-pel planes start this far inside the padded picture, where the
+   8-tap luma filter still has all of its input samples */
+#define SPEL_PLANE_MARGIN                  4
 
 /* number of MVP candidates */
 #define MAX_NUM_MVP_SMALL_CU               4
@@ -884,6 +887,13 @@ typedef struct _XEVE_PIC
     int              pic_qp_u_offset;
     int              pic_qp_v_offset;
     u8               digest[N_C][16];
+    /* pre-interpolated luma planes for sub-pel motion estimation, indexed by
+       the quarter-pel phase ((y & 3) << 2) | (x & 3). same geometry as y,
+       valid up to SPEL_PLANE_MARGIN samples from the padded border.
+       NULL for the phases which are not built */
+    pel             *spel[16];
+    /* buffer of the sub-pel planes */
+    pel             *buf_spel;
 } XEVE_PIC;
 
 /*****************************************************************************
@@ -1351,7 +1361,12 @@ typedef struct _XEVE_TILE
     /* first ctb address in raster scan order */
     u16              ctba_rs_first;
     u8               qp;
-    u8               qp_prev_eco[XEVE_MAX_THREADS];
+    /* previous qp of entropy coding for each thread (param.threads entries) */
+    u8             * qp_prev_eco;
+    /* byte size of the tile bitstream in bs_tbuf */
+    int              bs_size;
+    /* number of bins coded in the tile */
+    u32              bin_cnt;
 } XEVE_TILE;
 
 /*****************************************************************************/
@@ -1517,6 +1532,7 @@ enum TQC_RUN {
 #ifndef ARM
 #include "xeve_mc_sse.h"
 #include "xeve_mc_avx.h"
+#include "xeve_mc_avx512.h"
 #else
 #include "xeve_mc_neon.h"
 #endif
@@ -97,7 +97,7 @@ static const u8 * get_tbl_qp_to_st(u32 mcu0, u32 mcu1, s8 *refi0, s8 *refi1, s16
     return xeve_tbl_df_st[idx];
 }
 
-static void deblock_scu_hor(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8)
+static void deblock_scu_hor(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8, int chroma_format_idc)
 {
     s16 A, B, C, D, d, d1, d2;
     s16 abs, t16, clip, sign, st;
@@ -177,7 +177,7 @@ static void deblock_scu_hor_chroma(pel *buf, int qp, int stride, int is_luma, co
     }
 }
 
-static void deblock_scu_ver(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8)
+static void deblock_scu_ver(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8, int chroma_format_idc)
 {
     s16 A, B, C, D, d, d1, d2;
     s16 abs, t16, clip, sign, st;
@@ -257,6 +257,14 @@ static void deblock_scu_ver_chroma(pel *buf, int qp, int stride, int is_luma, co
     }
 }
 
+const XEVE_DBK xeve_tbl_dbk[2][2] =
+{
+    /* horizontal edge: luma, chroma */
+    { deblock_scu_hor, deblock_scu_hor_chroma },
+    /* vertical edge: luma, chroma */
+    { deblock_scu_ver, deblock_scu_ver_chroma }
+};
+
 void xeve_deblock_cu_hor(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, int cuh, u32 *map_scu, s8(*map_refi)[REFP_NUM], s16(*map_mv)[REFP_NUM][MV_D], int w_scu
                        , TREE_CONS tree_cons, u8* map_tidx, int boundary_filtering, int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc, int* qp_chroma_dynamic[2])
 {
@@ -304,7 +312,7 @@ void xeve_deblock_cu_hor(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, int cuh,
 
             if (xeve_check_luma(tree_cons))
             {
-                deblock_scu_hor(y + t, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8);
+                xeve_func_dbk[0][0](y + t, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8, chroma_format_idc);
             }
 
             if(xeve_check_chroma(tree_cons) && chroma_format_idc)
@@ -312,8 +320,8 @@ void xeve_deblock_cu_hor(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, int cuh,
                 t = t >> w_shift;
                 int qp_u = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_u_offset);
                 int qp_v = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
-                deblock_scu_hor_chroma(u + t, qp_chroma_dynamic[0][qp_u], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
-                deblock_scu_hor_chroma(v + t, qp_chroma_dynamic[1][qp_v], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
+                xeve_func_dbk[0][1](u + t, qp_chroma_dynamic[0][qp_u], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
+                xeve_func_dbk[0][1](v + t, qp_chroma_dynamic[1][qp_v], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
             }
         }
     }
@@ -381,15 +389,15 @@ void xeve_deblock_cu_ver(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, int cuh,
 
             if (xeve_check_luma(tree_cons))
             {
-                deblock_scu_ver(y, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8);
+                xeve_func_dbk[1][0](y, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8, chroma_format_idc);
             }
 
             if (xeve_check_chroma(tree_cons) && chroma_format_idc)
             {
                 int qp_u = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_u_offset);
                 int qp_v = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
-                deblock_scu_ver_chroma(u, qp_chroma_dynamic[0][qp_u], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
-                deblock_scu_ver_chroma(v, qp_chroma_dynamic[1][qp_v], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
+                xeve_func_dbk[1][1](u, qp_chroma_dynamic[0][qp_u], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
+                xeve_func_dbk[1][1](v, qp_chroma_dynamic[1][qp_v], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
             }
 
             y += (s_l << MIN_CU_LOG2);
@@ -429,14 +437,14 @@ void xeve_deblock_cu_ver(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, int cuh,
 
             if(xeve_check_luma(tree_cons))
             {
-                deblock_scu_ver(y, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8);
+                xeve_func_dbk[1][0](y, qp, s_l, 1, tbl_qp_to_st, bit_depth_luma - 8, chroma_format_idc);
             }
             if(xeve_check_chroma(tree_cons) && chroma_format_idc)
             {
                 int qp_u = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_u_offset);
                 int qp_v = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
-                deblock_scu_ver_chroma(u, qp_chroma_dynamic[0][qp_u], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
-                deblock_scu_ver_chroma(v, qp_chroma_dynamic[1][qp_v], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
+                xeve_func_dbk[1][1](u, qp_chroma_dynamic[0][qp_u], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
+                xeve_func_dbk[1][1](v, qp_chroma_dynamic[1][qp_v], s_c, 0, tbl_qp_to_st, bit_depth_chroma - 8, chroma_format_idc);
             }
 
             y += (s_l << MIN_CU_LOG2);
@@ -474,24 +482,16 @@ void xeve_deblock_unit(XEVE_CTX * ctx, XEVE_PIC * pic, int x, int y, int cuw, in
     }
 }
 
-int xeve_deblock(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int filter_across_boundary , XEVE_CORE * core)
+static void deblock_init_lcu(XEVE_CTX * ctx, int x_lcu, int y_lcu)
 {
     int i, j;
-    int x_l, x_r, y_l, y_r, l_scu, r_scu, t_scu, b_scu;
     u32 k1;
     int scu_in_lcu_wh = 1 << (ctx->log2_max_cuwh - MIN_CU_LOG2);
-    int boundary_filtering = 0;
-    x_l = (ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu; //entry point lcu's x location
-    y_l = (ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu; // entry point lcu's y location
-    x_r = x_l + ctx->tile[tile_idx].w_ctb;
-    y_r = y_l + ctx->tile[tile_idx].h_ctb;
-    l_scu = x_l * scu_in_lcu_wh;
-    r_scu = XEVE_CLIP3(0, ctx->w_scu, x_r*scu_in_lcu_wh);
-    t_scu = y_l * scu_in_lcu_wh;
-    b_scu = XEVE_CLIP3(0, ctx->h_scu, y_r*scu_in_lcu_wh);
+    int l_scu = x_lcu * scu_in_lcu_wh;
+    int r_scu = XEVE_CLIP3(0, ctx->w_scu, (x_lcu + 1) * scu_in_lcu_wh);
+    int t_scu = y_lcu * scu_in_lcu_wh;
+    int b_scu = XEVE_CLIP3(0, ctx->h_scu, (y_lcu + 1) * scu_in_lcu_wh);
 
-    xeve_assert(!filter_across_boundary);
- 
     for (j = t_scu; j < b_scu; j++)
     {
         for (i = l_scu; i < r_scu; i++)
@@ -508,20 +508,78 @@ int xeve_deblock(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int filter_across
             }
         }
     }
+}
 
-    /* horizontal filtering */
-    for (j = y_l; j < y_r; j++)
+int xeve_deblock_lcu(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int x_lcu, int y_lcu, XEVE_CORE * core)
+{
+    int x_l, x_r, y_l;
+    int boundary_filtering = 0;
+    x_l = (ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu; //entry point lcu's x location
+    y_l = (ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu; // entry point lcu's y location
+    x_r = x_l + ctx->tile[tile_idx].w_ctb;
+
+    /* LCU maps are prepared just before their vertical edges are filtered, so that
+       only the LCUs up to two positions to the right are touched */
+    if (x_lcu == x_l)
     {
-        for (i = x_l; i < x_r; i++)
+        deblock_init_lcu(ctx, x_lcu, y_lcu);
+        if (x_lcu + 1 < x_r)
         {
-            ctx->fn_deblock_tree(ctx, pic, (i << ctx->log2_max_cuwh), (j << ctx->log2_max_cuwh), ctx->max_cuwh, ctx->max_cuwh, 0, 0, core->deblock_is_hor
-                                , xeve_get_default_tree_cons(), core, boundary_filtering);
+            deblock_init_lcu(ctx, x_lcu + 1, y_lcu);
         }
+        ctx->fn_deblock_tree(ctx, pic, (x_l << ctx->log2_max_cuwh), (y_lcu << ctx->log2_max_cuwh), ctx->max_cuwh, ctx->max_cuwh, 0, 0, 0
+                            , xeve_get_default_tree_cons(), core, boundary_filtering);
+    }
+    if (x_lcu + 2 < x_r)
+    {
+        deblock_init_lcu(ctx, x_lcu + 2, y_lcu);
     }
 
+    /* vertical edges of the next LCU are filtered before horizontal edges of the current LCU,
+       as they modify the right columns of the current LCU */
+    if (x_lcu + 1 < x_r)
+    {
+        ctx->fn_deblock_tree(ctx, pic, ((x_lcu + 1) << ctx->log2_max_cuwh), (y_lcu << ctx->log2_max_cuwh), ctx->max_cuwh, ctx->max_cuwh, 0, 0, 0
+                            , xeve_get_default_tree_cons(), core, boundary_filtering);
+    }
+    if (y_lcu > y_l)
+    {
+        /* horizontal edges of the upper LCU have to be filtered first */
+        threadsafe_wait(ctx->sync_wait, &ctx->sync_dbk[y_lcu - 1], x_lcu - x_l + 1, &core->wait_time);
+    }
+    ctx->fn_deblock_tree(ctx, pic, (x_lcu << ctx->log2_max_cuwh), (y_lcu << ctx->log2_max_cuwh), ctx->max_cuwh, ctx->max_cuwh, 0, 0, 1
+                        , xeve_get_default_tree_cons(), core, boundary_filtering);
+    threadsafe_signal(ctx->sync_wait, &ctx->sync_dbk[y_lcu], x_lcu - x_l + 1);
+
     return XEVE_OK;
 }
 
+int xeve_deblock(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int y_lcu, int filter_across_boundary, XEVE_CORE * core)
+{
+    int x_l = (ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu;
+    int ret;
+
+    xeve_assert(!filter_across_boundary);
+
+    for (int i = x_l; i < x_l + ctx->tile[tile_idx].w_ctb; i++)
+    {
+        ret = xeve_deblock_lcu(ctx, pic, tile_idx, i, y_lcu, core);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
+
+    return XEVE_OK;
+}
+
+/* filter offsets of the slice, set before the deblocking of the slice is started
+   since the LCUs of a picture are deblocked by several threads */
+void xeve_deblock_set_offsets(XEVE_PIC * pic, XEVE_SH * sh)
+{
+    pic->pic_deblock_alpha_offset = sh->sh_deblock_alpha_offset;
+    pic->pic_deblock_beta_offset = sh->sh_deblock_beta_offset;
+    pic->pic_qp_u_offset = sh->qp_u_offset;
+    pic->pic_qp_v_offset = sh->qp_v_offset;
+}
+
 void xeve_deblock_tree(XEVE_CTX * ctx, XEVE_PIC * pic, int x, int y, int cuw, int cuh, int cud, int cup, int is_hor_edge
                      , TREE_CONS tree_cons, XEVE_CORE * core, int boundary_filtering)
 {
@@ -529,10 +587,6 @@ void xeve_deblock_tree(XEVE_CTX * ctx, XEVE_PIC * pic, int x, int y, int cuw, in
     int lcu_num;
 
     core->tree_cons = tree_cons;
-    pic->pic_deblock_alpha_offset = ctx->sh->sh_deblock_alpha_offset;
-    pic->pic_deblock_beta_offset = ctx->sh->sh_deblock_beta_offset;
-    pic->pic_qp_u_offset = ctx->sh->qp_u_offset;
-    pic->pic_qp_v_offset = ctx->sh->qp_v_offset;
 
     lcu_num = (x >> ctx->log2_max_cuwh) + (y >> ctx->log2_max_cuwh) * ctx->w_lcu;
     xeve_get_split_mode(&split_mode, cud, cup, cuw, cuh, ctx->max_cuwh, ctx->map_cu_data[lcu_num].split_mode);
@@ -31,7 +31,14 @@
 #ifndef _XEVE_DF_H_
 #define _XEVE_DF_H_
 
-int  xeve_deblock(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int filter_across_boundary, XEVE_CORE * core);
+/* deblocking of the four lines (luma) or the chroma lines of one SCU edge */
+typedef void (*XEVE_DBK)(pel *buf, int qp, int stride, int is_luma, const u8 *tbl_qp_to_st, int bit_depth_minus8, int chroma_format_idc);
+
+/* [horizontal/vertical edge][luma/chroma] */
+extern const XEVE_DBK xeve_tbl_dbk[2][2];
+
+int  xeve_deblock(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int y_lcu, int filter_across_boundary, XEVE_CORE * core);
+int  xeve_deblock_lcu(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int x_lcu, int y_lcu, XEVE_CORE * core);
 void xeve_deblock_unit(XEVE_CTX * ctx, XEVE_PIC * pic, int x, int y, int cuw, int cuh, int is_hor_edge, XEVE_CORE * core, int boundary_filtering);
 void xeve_deblock_cu_hor(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, int cuh, u32 *map_scu, s8 (*map_refi)[REFP_NUM], s16 (*map_mv)[REFP_NUM][MV_D]
                          , int w_scu, TREE_CONS tree_cons, u8* map_tidx, int boundary_filtering
@@ -40,6 +47,7 @@ void xeve_deblock_cu_ver(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, int cuh,
                          , int w_scu, u32 *map_cu, TREE_CONS tree_cons, u8 *map_tidx, int boundary_filtering
                          , int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc, int* qp_chroma_dynamic[2]);
 
+void xeve_deblock_set_offsets(XEVE_PIC * pic, XEVE_SH * sh);
 void xeve_deblock_tree(XEVE_CTX * ctx, XEVE_PIC * pic, int x, int y, int cuw, int cuh, int cud, int cup, int is_hor_edge
                      , TREE_CONS tree_cons, XEVE_CORE * core, int boundary_filtering);
 #endif /* _XEVE_DF_H_ */
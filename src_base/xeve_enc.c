@@ -87,7 +87,7 @@ ERR:
     return ret;
 }
 
-static int xeve_ctu_mt_core(void * arg)
+static int xeve_ctu_mt_core(void * arg, int task_idx, int worker_id)
 {
     assert(arg != NULL);
 
@@ -107,6 +107,7 @@ static int xeve_ctu_mt_core(void * arg)
     xeve_update_core_loc_param_mt(ctx, core);
 
     int bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
+    int ctu_bits = 0;
 
     /* LCU encoding loop */
     while (ctx->tile[i].f_ctb > 0)
@@ -114,7 +115,13 @@ static int xeve_ctu_mt_core(void * arg)
         if (core->y_lcu != sp_y_lcu && core->x_lcu < (sp_x_lcu + ctx->tile[core->tile_idx].w_ctb - 1))
         {
             /* up-right CTB */
-            spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + 1], THREAD_TERMINATED);
+            threadsafe_wait(ctx->sync_wait, &ctx->sync_flag[core->lcu_num - ctx->w_lcu + 1], THREAD_TERMINATED, &core->wait_time);
+        }
+
+        if (ctx->param.row_vbv && core->x_lcu == sp_x_lcu)
+        {
+            /* qp of the CTU row from the bits of the rows above */
+            xeve_rc_row_qp(ctx, core);
         }
 
         /* initialize structures *****************************************/
@@ -134,14 +141,29 @@ static int xeve_ctu_mt_core(void * arg)
         ctx->tile[i].qp_prev_eco[core->thread_cnt] = bef_cu_qp;
 
         /* entropy coding ************************************************/
+        if (ctx->param.row_vbv)
+        {
+            ctu_bits = xeve_rc_bsw_bits(bs);
+        }
         ret = xeve_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0, 0, xeve_get_default_tree_cons(), bs);
         bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
 
         xeve_assert_rv(ret == XEVE_OK, ret);
 
-        threadsafe_assign(&ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
+        if (ctx->param.row_vbv)
+        {
+            xeve_rc_row_update(ctx, core, xeve_rc_bsw_bits(bs) - ctu_bits);
+        }
+
+        threadsafe_signal(ctx->sync_wait, &ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
         threadsafe_decrement(ctx->sync_block, (volatile s32 *)&ctx->tile[i].f_ctb);
 
+        if (ctx->loop_filter_pipe)
+        {
+            ret = xeve_loop_filter_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+        }
+
         core->lcu_num = xeve_mt_get_next_ctu_num(ctx, core, ctx->parallel_rows);
         if (core->lcu_num == -1)
             break;
@@ -149,6 +171,58 @@ static int xeve_ctu_mt_core(void * arg)
     return XEVE_OK;
 }
 
+static int xeve_tile_eco_mt_core(void * arg, int tile_pos, int worker_id)
+{
+    XEVE_CTX  * ctx = (XEVE_CTX *)arg;
+    XEVE_CORE * core = ctx->core[worker_id];
+    XEVE_SH   * sh = ctx->sh;
+    XEVE_BSW    bs;
+    int         i = sh->tile_order[tile_pos];
+    int         sp_x_lcu = ctx->tile[i].ctba_rs_first % ctx->w_lcu;
+    int         ctb_cnt_in_tile = ctx->tile[i].f_ctb;
+    int         ret;
+
+    /* tile is coded into its own buffer with the CABAC engine of the worker */
+    xeve_bsw_init(&bs, ctx->bs_tbuf[i], ctx->bs_tbuf_size, NULL);
+    bs.pdata[1] = &ctx->sbac_enc[worker_id];
+    ctx->fn_eco_sbac_reset(GET_SBAC_ENC(&bs), sh->slice_type, sh->qp, ctx->sps.tool_cm_init);
+
+    core->ctx = ctx;
+    core->tile_idx = i;
+    core->thread_cnt = worker_id;
+    ctx->tile[i].qp_prev_eco[worker_id] = sh->qp;
+
+    core->x_lcu = sp_x_lcu;
+    core->y_lcu = ctx->tile[i].ctba_rs_first / ctx->w_lcu;
+    xeve_update_core_loc_param(ctx, core);
+
+    while (ctb_cnt_in_tile > 0) // LCU level CABAC loop
+    {
+        ret = xeve_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0, 0, xeve_get_default_tree_cons(), &bs);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+
+        /* prepare next step *********************************************/
+        core->x_lcu++;
+        if (core->x_lcu >= sp_x_lcu + ctx->tile[i].w_ctb)
+        {
+            core->x_lcu = sp_x_lcu;
+            core->y_lcu++;
+        }
+        xeve_update_core_loc_param(ctx, core);
+        ctb_cnt_in_tile--;
+    }
+
+    xeve_eco_tile_end_flag(&bs, 1);
+    xeve_sbac_finish(&bs);
+    xeve_bsw_deinit(&bs);
+
+    ctx->tile[i].bs_size = XEVE_BSW_GET_WRITE_BYTE(&bs);
+    ctx->tile[i].bin_cnt = GET_SBAC_ENC(&bs)->bin_counter;
+    sh->entry_point_offset_minus1[tile_pos] = ctx->tile[i].bs_size - 1;
+
+    return XEVE_OK;
+}
+
 XEVE_CTX * xeve_ctx_alloc(void)
 {
     XEVE_CTX * ctx;
@@ -161,9 +235,53 @@ XEVE_CTX * xeve_ctx_alloc(void)
 
 void xeve_ctx_free(XEVE_CTX * ctx)
 {
+    xeve_mfree(ctx->thread_pool);
+    xeve_mfree(ctx->core);
+    xeve_mfree(ctx->bs);
+    xeve_mfree(ctx->sbac_enc);
+    xeve_mfree(ctx->mode);
+    xeve_mfree(ctx->pintra);
+    if(ctx->pinter)
+    {
+        for(int i = 0; i < ctx->param.threads; i++)
+        {
+            xeve_me_cache_delete(ctx->pinter[i].me_cache);
+        }
+    }
+    xeve_mfree(ctx->pinter);
     xeve_mfree_fast(ctx);
 }
 
+int xeve_thread_ctx_alloc(XEVE_CTX * ctx)
+{
+    int threads = ctx->param.threads;
+
+    /* per-thread contexts, the number of threads is fixed for the lifetime of the encoder */
+    ctx->thread_pool = (POOL_THREAD *)xeve_malloc(sizeof(POOL_THREAD) * threads);
+    xeve_assert_rv(ctx->thread_pool, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->thread_pool, 0, sizeof(POOL_THREAD) * threads);
+    ctx->core = (XEVE_CORE **)xeve_malloc(sizeof(XEVE_CORE *) * threads);
+    xeve_assert_rv(ctx->core, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->core, 0, sizeof(XEVE_CORE *) * threads);
+    ctx->bs = (XEVE_BSW *)xeve_malloc(sizeof(XEVE_BSW) * threads);
+    xeve_assert_rv(ctx->bs, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->bs, 0, sizeof(XEVE_BSW) * threads);
+    ctx->sbac_enc = (XEVE_SBAC *)xeve_malloc(sizeof(XEVE_SBAC) * threads);
+    xeve_assert_rv(ctx->sbac_enc, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->sbac_enc, 0, sizeof(XEVE_SBAC) * threads);
+    ctx->mode = (XEVE_MODE *)xeve_malloc(sizeof(XEVE_MODE) * threads);
+    xeve_assert_rv(ctx->mode, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->mode, 0, sizeof(XEVE_MODE) * threads);
+    ctx->pintra = (XEVE_PINTRA *)xeve_malloc(sizeof(XEVE_PINTRA) * threads);
+    xeve_assert_rv(ctx->pintra, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->pintra, 0, sizeof(XEVE_PINTRA) * threads);
+    ctx->pinter = (XEVE_PINTER *)xeve_malloc(sizeof(XEVE_PINTER) * threads);
+    xeve_assert_rv(ctx->pinter, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(ctx->pinter, 0, sizeof(XEVE_PINTER) * threads);
+
+    return XEVE_OK;
+}
+
 
 XEVE_CORE * xeve_core_alloc(int chroma_format_idc)
 {
@@ -208,8 +326,6 @@ int xeve_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
     XEVE_CORE     * core;
     XEVE_BSW      * bs;
     XEVE_SH       * sh;
-    int             ctb_cnt_in_tile = 0;
-    int             col_bd = 0;
     int             num_slice_in_pic = ctx->param.num_slice_in_pic;
     u8            * tiles_in_slice;
     u8            * curr_temp = ctx->bs[0].cur;
@@ -250,6 +366,7 @@ int xeve_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
         xeve_assert_rv(ret == XEVE_OK, ret);
 
         ctx->fn_mode_analyze_frame(ctx);
+        xeve_loop_filter_pipe_init(ctx, 1);
 
         /* slice layer encoding loop */
         core->x_lcu = core->y_lcu = 0;
@@ -292,12 +409,8 @@ int xeve_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
         /* Tile wise encoding with in a slice */
         u32 k = 0;
         u16 total_tiles_in_slice = sh->num_tiles_in_slice;
-        THREAD_CONTROLLER * tc;
-        int res;
         u32 i = 0;
-        tc = ctx->tc;
-        int thread_cnt = 0, thread_cnt1 = 0;;
-        int task_completed = 0;
+        int thread_cnt = 0;
         int tile_cnt = 0;
 
         //Code for CTU parallel encoding
@@ -320,7 +433,9 @@ int xeve_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
                 xeve_init_core_mt(ctx, i, core, thread_cnt);
 
                 ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-                tc->run(ctx->thread_pool[thread_cnt], xeve_ctu_mt_core, (void*)ctx->core[thread_cnt]);
+                task_init(&ctx->task[thread_cnt], xeve_ctu_mt_core, (void*)ctx->core[thread_cnt], thread_cnt);
+                ret = task_submit(ctx->sched, &ctx->task[thread_cnt]);
+                xeve_assert_rv(ret == THREAD_SUCCESS, XEVE_ERR_UNKNOWN);
             }
 
             ctx->tile[i].qp = ctx->sh->qp;
@@ -331,65 +446,24 @@ int xeve_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
             xeve_init_core_mt(ctx, i, core, 0);
 
             ctx->core[0]->thread_cnt = 0;
-            xeve_ctu_mt_core((void*)ctx->core[0]);
+            task_init(&ctx->task[0], xeve_ctu_mt_core, (void*)ctx->core[0], 0);
+            ret = task_submit(ctx->sched, &ctx->task[0]);
+            xeve_assert_rv(ret == THREAD_SUCCESS, XEVE_ERR_UNKNOWN);
 
-             for (thread_cnt1 = 1; thread_cnt1 < parallel_task; thread_cnt1++)
-            {
-                tc->join(ctx->thread_pool[thread_cnt1], &res);
-                if (XEVE_FAILED(res))
-                {
-                    ret = res;
-                }
-            }
+            /* lanes are started as soon as they are submitted, idle workers take over the lanes of busy ones */
+            ret = task_wait_all(ctx->sched);
+            xeve_assert_rv(ret == XEVE_OK, ret);
 
             ctx->tile[i].f_ctb = temp_store_total_ctb;
-
-
-            /*Set entry point for each Tile in the tile Slice*/
-            ctx->core[0]->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu; //entry point lcu's x location
-            ctx->core[0]->y_lcu = (ctx->tile[i].ctba_rs_first) / ctx->w_lcu; // entry point lcu's y location
-            ctb_cnt_in_tile = ctx->tile[i].f_ctb; //Total LCUs in the current tile
-            xeve_update_core_loc_param(ctx, ctx->core[0]);
-            ctx->lcu_cnt = ctx->f_lcu;
-            while (1)
-            {
-                /* entropy coding ************************************************/
-                ret = xeve_eco_tree(ctx, ctx->core[0], ctx->core[0]->x_pel, ctx->core[0]->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0
-                                  , 0, xeve_get_default_tree_cons(), &ctx->bs[0]);
-                /* prepare next step *********************************************/
-                ctx->core[0]->x_lcu++;
-                if (ctx->core[0]->x_lcu >= ctx->tile[i].w_ctb + col_bd)
-                {
-                    ctx->core[0]->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu;
-                    ctx->core[0]->y_lcu++;
-                }
-                xeve_update_core_loc_param(ctx, ctx->core[0]);
-                ctb_cnt_in_tile--;
-                ctx->lcu_cnt--;
-                if (ctb_cnt_in_tile == 0)
-                {
-                    xeve_eco_tile_end_flag(bs, 1);
-                    xeve_sbac_finish(bs);
-                    break;
-                }
-            }
             total_tiles_in_slice -= 1;
         }
 
-        ctx->sh->qp_prev_eco = ctx->sh->qp;
-        ctx->fn_loop_filter(ctx, core);
-        core->x_lcu = core->y_lcu = 0;
-        core->x_pel = core->y_pel = 0;
-        core->lcu_num = 0;
-        ctx->lcu_cnt = ctx->f_lcu;
+        /* entropy coding, each tile into its own buffer in parallel */
         for (i = 0; i < ctx->f_scu; i++)
         {
             MCU_CLR_COD(ctx->map_scu[i]);
         }
 
-        /* Bit-stream re-writing (START) */
-        xeve_bsw_init_slice(&ctx->bs[0], (u8*)curr_temp, bitb->bsize, NULL);
-
 #if TRACE_START_POC
         if (fp_trace_started == 1)
         {
@@ -412,15 +486,34 @@ int xeve_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
 #endif
 #endif
 
-        XEVE_SBAC* t_sbac;
-        t_sbac = GET_SBAC_ENC(bs);
-        t_sbac->bin_counter = 0;
+        for (k = 0; k < sh->num_tiles_in_slice; k++)
+        {
+#if ENC_DEC_TRACE
+            /* keep the trace in bitstream order */
+            ret = xeve_tile_eco_mt_core((void*)ctx, k, 0);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+#else
+            task_init(&ctx->task[k], xeve_tile_eco_mt_core, (void*)ctx, k);
+            ret = task_submit(ctx->sched, &ctx->task[k]);
+            xeve_assert_rv(ret == THREAD_SUCCESS, XEVE_ERR_UNKNOWN);
+#endif
+        }
+        ret = task_wait_all(ctx->sched);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+
+        ctx->sh->qp_prev_eco = ctx->sh->qp;
+        ctx->fn_loop_filter(ctx, core);
+        core->x_lcu = core->y_lcu = 0;
+        core->x_pel = core->y_pel = 0;
+        core->lcu_num = 0;
+        ctx->lcu_cnt = ctx->f_lcu;
+
+        /* Bit-stream writing (START) */
+        xeve_bsw_init_slice(&ctx->bs[0], (u8*)curr_temp, bitb->bsize, NULL);
 
         unsigned int bin_counts_in_units = 0;
         unsigned int num_bytes_in_units = 0;
 
-        /* Send available APSs */
-        int aps_nalu_size = 0;
         u8 * nalu_len_buf = bs->cur;
         u8* cur_tmp = bs->cur;
 
@@ -428,99 +521,19 @@ int xeve_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
         ret = xeve_eco_nalu(bs, &ctx->nalu);
         xeve_assert_rv(ret == XEVE_OK, ret);
 
-        /* Encode slice header */
+        /* Encode slice header, entry points are already known from the tile buffers */
         sh->num_ctb = ctx->f_lcu;
-        XEVE_BSW bs_sh;
-        xeve_mcpy(&bs_sh, bs, sizeof(XEVE_BSW));
-#if TRACE_HLS
-        s32 tmp_fp_point = ftell(fp_trace);
-#endif
         ret = ctx->fn_eco_sh(bs, &ctx->sps, &ctx->pps, sh, ctx->nalu.nal_unit_type_plus1 - 1);
         xeve_assert_rv(ret == XEVE_OK, ret);
 
-        core->x_lcu = core->y_lcu = 0;
-        core->x_pel = core->y_pel = 0;
-        core->lcu_num = 0;
-        ctx->lcu_cnt = ctx->f_lcu;
-        for(i = 0; i < ctx->f_scu; i++)
+        /* Concatenate tile bitstreams in tile order of the slice */
+        for (k = 0; k < sh->num_tiles_in_slice; k++)
         {
-            MCU_CLR_COD(ctx->map_scu[i]);
+            i = tiles_in_slice[k];
+            ret = xeve_bsw_write_byte_array(bs, ctx->bs_tbuf[i], ctx->tile[i].bs_size);
+            xeve_assert_rv(ret == XEVE_OK, XEVE_ERR_UNKNOWN);
+            bin_counts_in_units += ctx->tile[i].bin_cnt;
         }
-        ctx->sh->qp_prev_eco = ctx->sh->qp;
-
-        /* Tile level encoding for a slice */
-        /* Tile wise encoding with in a slice */
-        k = 0;
-        total_tiles_in_slice = sh->num_tiles_in_slice;
-        while (total_tiles_in_slice)
-        {
-            int i = tiles_in_slice[k++];
-            ctx->tile[i].qp = ctx->sh->qp;
-            ctx->tile[i].qp_prev_eco[0] = ctx->sh->qp;
-            core->tile_idx = i;
-
-            /* CABAC Initialize for each Tile */
-            ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
-
-            /*Set entry point for each Tile in the tile Slice*/
-            core->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu; //entry point lcu's x location
-            core->y_lcu = (ctx->tile[i].ctba_rs_first) / ctx->w_lcu; // entry point lcu's y location
-            ctb_cnt_in_tile = ctx->tile[i].f_ctb; //Total LCUs in the current tile
-            xeve_update_core_loc_param(ctx, core);
-
-            XEVE_BSW bs_beg;
-            bs_beg.cur = bs->cur;
-            bs_beg.leftbits = bs->leftbits;
-
-            col_bd = 0;
-            if (i% ctx->param.tile_columns)
-            {
-                int temp = i - 1;
-                while (temp >= 0)
-                {
-                    col_bd += ctx->tile[temp].w_ctb;
-                    if (!(temp%ctx->param.tile_columns)) break;
-                    temp--;
-                }
-            }
-            else
-            {
-                col_bd = 0;
-            }
-
-            while (1) // LCU level CABAC loop
-            {
-                ret = xeve_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0, 0, xeve_get_default_tree_cons(), bs);
-
-                xeve_assert_rv(ret == XEVE_OK, ret);
-                /* prepare next step *********************************************/
-                core->x_lcu++;
-                if (core->x_lcu >= ctx->tile[i].w_ctb + col_bd)
-                {
-                    core->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu;
-                    core->y_lcu++;
-                }
-
-                xeve_update_core_loc_param(ctx, core);
-                ctb_cnt_in_tile--;
-                ctx->lcu_cnt--;
-
-                /* end_of_picture_flag */
-                if (ctb_cnt_in_tile == 0)
-                {
-                    xeve_eco_tile_end_flag(bs, 1);
-                    xeve_sbac_finish(bs);
-                    break;
-                }
-            } //End of LCU encoding loop in a tile
-
-            XEVE_SBAC* tmp_sbac;
-            tmp_sbac = GET_SBAC_ENC(bs);
-            bin_counts_in_units += tmp_sbac->bin_counter;
-            total_tiles_in_slice--;
-
-            sh->entry_point_offset_minus1[k - 1] = (u32)((bs)->cur - bs_beg.cur - 4 + (4 - (bs->leftbits >> 3)) + (bs_beg.leftbits >> 3) - 1);
-        } // End to tile encoding loop in a slice
 
         num_bytes_in_units = (int)(bs->cur - cur_tmp) - 4;
 
@@ -539,7 +552,6 @@ int xeve_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
             {
                 unsigned int num_add_bytes_needed = target_num_bytes_in_units - num_bytes_in_units;
                 unsigned int num_add_cabac_zero_words = (num_add_bytes_needed + 2) / 3;
-                unsigned int num_add_cabac_zero_bytes = num_add_cabac_zero_words * 3;
                 for (unsigned int i = 0; i < num_add_cabac_zero_words; i++)
                 {
                     xeve_bsw_write(bs, 0, 16); //2 bytes (=00 00))
@@ -551,19 +563,7 @@ int xeve_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
         xeve_eco_nal_unit_len(nalu_len_buf, (int)(bs->cur - cur_tmp) - 4);
 
         curr_temp = bs->cur;
-
-        /* slice header re-writing */
-#if TRACE_HLS
-        s32 tmp_fp_point2 = ftell(fp_trace);
-        fseek(fp_trace, tmp_fp_point, SEEK_SET);
-#endif
-        ret = ctx->fn_eco_sh(&bs_sh, &ctx->sps, &ctx->pps, sh, ctx->nalu.nal_unit_type_plus1 - 1);
-        xeve_assert_rv(ret == XEVE_OK, ret);
-        xeve_bsw_deinit(&bs_sh);
-#if TRACE_HLS
-        fseek(fp_trace, tmp_fp_point2, SEEK_SET);
-#endif
-        /* Bit-stream re-writing (END) */
+        /* Bit-stream writing (END) */
 
     }  // End of slice loop
 
@@ -609,6 +609,54 @@ int xeve_enc(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
 }
 
 
+static int imgb_zero_copy_check(XEVE_CTX * ctx, XEVE_IMGB * img)
+{
+    int i, w, h;
+
+    /* the filter of input picture works in place */
+    if (!ctx->param.zero_copy || ctx->param.tool_dra) return 0;
+    if (img->cs != ctx->param.cs || XEVE_CS_GET_BYTE_DEPTH(img->cs) != 2) return 0;
+    if (img->addref == NULL || img->release == NULL) return 0;
+
+    for (i = 0; i < img->np; i++)
+    {
+        w = i == 0 ? ctx->w : ctx->w >> ctx->param.cs_w_shift;
+        h = i == 0 ? ctx->h : ctx->h >> ctx->param.cs_h_shift;
+        if (img->aw[i] < w || img->ah[i] < h) return 0;
+    }
+    return 1;
+}
+
+static void imgb_pad_border(XEVE_CTX * ctx, XEVE_IMGB * img)
+{
+    int i, j, k, w, h;
+    pel * p;
+
+    /* fill the area between the picture and the aligned size only */
+    for (i = 0; i < img->np; i++)
+    {
+        w = i == 0 ? ctx->w : ctx->w >> ctx->param.cs_w_shift;
+        h = i == 0 ? ctx->h : ctx->h >> ctx->param.cs_h_shift;
+
+        if (img->w[i] < w)
+        {
+            p = (pel *)img->a[i];
+            for (j = 0; j < img->h[i]; j++)
+            {
+                for (k = img->w[i]; k < w; k++)
+                {
+                    p[k] = p[img->w[i] - 1];
+                }
+                p = (pel *)((u8 *)p + img->s[i]);
+            }
+        }
+        for (j = img->h[i]; j < h; j++)
+        {
+            xeve_mcpy((u8 *)img->a[i] + j * img->s[i], (u8 *)img->a[i] + (img->h[i] - 1) * img->s[i], w * sizeof(pel));
+        }
+    }
+}
+
 int xeve_push_frm(XEVE_CTX * ctx, XEVE_IMGB * img)
 {
     XEVE_PIC  * pic;
@@ -617,11 +665,21 @@ int xeve_push_frm(XEVE_CTX * ctx, XEVE_IMGB * img)
 
     int ret;
 
-    ret = ctx->fn_get_inbuf(ctx, &imgb);
-    xeve_assert_rv(XEVE_OK == ret, ret);
+    if (imgb_zero_copy_check(ctx, img))
+    {
+        /* the planes of the caller are used until the picture is encoded */
+        imgb = img;
+        imgb->addref(imgb);
+        imgb_pad_border(ctx, imgb);
+    }
+    else
+    {
+        ret = ctx->fn_get_inbuf(ctx, &imgb);
+        xeve_assert_rv(XEVE_OK == ret, ret);
 
-    imgb->cs = ctx->param.cs;
-    xeve_imgb_cpy(imgb, img);
+        imgb->cs = ctx->param.cs;
+        xeve_imgb_cpy(imgb, img);
+    }
 
     if (ctx->fn_pic_flt != NULL)
     {
@@ -695,65 +753,140 @@ int xeve_push_frm(XEVE_CTX * ctx, XEVE_IMGB * img)
 }
 
 
+#if ARM_NEON
+static const XEVE_FUNC xeve_func_neon =
+{
+    xeve_tbl_sad_16b_neon,
+    xeve_tbl_ssd_16b_neon,
+    xeve_tbl_diff_16b_neon,
+    xeve_tbl_satd_16b_neon,
+    xeve_tbl_mc_l_neon,
+    xeve_tbl_mc_c_neon,
+    &xeve_average_16b_no_clip_neon,
+    &xeve_tbl_itxb_neon,
+    &xeve_tbl_txb_neon,
+    &xeve_quant,
+    &xeve_coef_abs_max,
+    &xeve_rdoq_est_level,
+    xeve_tbl_dbk,
+    &xeve_plane_shl_8b_neon,
+    &xeve_plane_shl_16b_neon,
+    &xeve_plane_expand_lr_neon
+};
+#elif X86_SSE
+static const XEVE_FUNC xeve_func_avx512 =
+{
+    xeve_tbl_sad_16b_avx512,
+    xeve_tbl_ssd_16b_avx512,
+    xeve_tbl_diff_16b_avx512,
+    xeve_tbl_satd_16b_avx512,
+    xeve_tbl_mc_l_avx512,
+    xeve_tbl_mc_c_avx512,
+    &xeve_average_16b_no_clip_avx512,
+    &xeve_tbl_itxb_avx512,
+    &xeve_tbl_txb_avx512,
+    &xeve_quant_avx,
+    &xeve_coef_abs_max_avx,
+    &xeve_rdoq_est_level_avx,
+    xeve_tbl_dbk_sse,
+    &xeve_plane_shl_8b_avx,
+    &xeve_plane_shl_16b_avx,
+    &xeve_plane_expand_lr_avx
+};
+
+static const XEVE_FUNC xeve_func_avx =
+{
+    xeve_tbl_sad_16b_avx,
+    xeve_tbl_ssd_16b_avx,
+    xeve_tbl_diff_16b_avx,
+    xeve_tbl_satd_16b_avx,
+    xeve_tbl_mc_l_avx,
+    xeve_tbl_mc_c_avx,
+    &xeve_average_16b_no_clip_avx,
+    &xeve_tbl_itxb_avx,
+    &xeve_tbl_txb_avx,
+    &xeve_quant_avx,
+    &xeve_coef_abs_max_avx,
+    &xeve_rdoq_est_level_avx,
+    xeve_tbl_dbk_sse,
+    &xeve_plane_shl_8b_avx,
+    &xeve_plane_shl_16b_avx,
+    &xeve_plane_expand_lr_avx
+};
+
+static const XEVE_FUNC xeve_func_sse =
+{
+    xeve_tbl_sad_16b_sse,
+    xeve_tbl_ssd_16b_sse,
+    xeve_tbl_diff_16b_sse,
+    xeve_tbl_satd_16b_sse,
+    xeve_tbl_mc_l_sse,
+    xeve_tbl_mc_c_sse,
+    &xeve_average_16b_no_clip_sse,
+    &xeve_tbl_itxb_sse,
+    &xeve_tbl_txb_sse,
+    &xeve_quant_sse,
+    &xeve_coef_abs_max_sse,
+    &xeve_rdoq_est_level_sse,
+    xeve_tbl_dbk_sse,
+    &xeve_plane_shl_8b_sse,
+    &xeve_plane_shl_16b_sse,
+    &xeve_plane_expand_lr_sse
+};
+#endif
+
+static const XEVE_FUNC xeve_func_c =
+{
+    xeve_tbl_sad_16b,
+    xeve_tbl_ssd_16b,
+    xeve_tbl_diff_16b,
+    xeve_tbl_satd_16b,
+    xeve_tbl_mc_l,
+    xeve_tbl_mc_c,
+    &xeve_average_16b_no_clip,
+    &xeve_tbl_itxb,
+    &xeve_tbl_txb,
+    &xeve_quant,
+    &xeve_coef_abs_max,
+    &xeve_rdoq_est_level,
+    xeve_tbl_dbk,
+    &xeve_plane_shl_8b,
+    &xeve_plane_shl_16b,
+    &xeve_plane_expand_lr
+};
+
 void xeve_platform_init_func(XEVE_CTX * ctx)
 {
 #if ARM_NEON
-  if(1)
-  {
-        xeve_func_sad               = xeve_tbl_sad_16b_neon;
-        xeve_func_ssd               = xeve_tbl_ssd_16b_neon;
-        xeve_func_diff              = xeve_tbl_diff_16b_neon;
-        xeve_func_satd              = xeve_tbl_satd_16b_neon;
-        xeve_func_mc_l              = xeve_tbl_mc_l_neon;
-        xeve_func_mc_c              = xeve_tbl_mc_c_neon;
-        xeve_func_average_no_clip   = &xeve_average_16b_no_clip_neon;
-        ctx->fn_itxb                = &xeve_tbl_itxb_neon;
-        xeve_func_txb               = &xeve_tbl_txb_neon;
-  }
-  else
+    if (ctx->param.isa != XEVE_ISA_C)
+    {
+        ctx->func = &xeve_func_neon;
+    }
+    else
 #elif X86_SSE
-    int check_cpu, support_sse, support_avx, support_avx2;
+    int check_cpu, support_sse, support_avx2, support_avx512;
 
-    check_cpu = xeve_check_cpu_info();
-    support_sse  = (check_cpu >> 1) & 1;
-    support_avx2 = (check_cpu >> 2) & 1;
+    check_cpu = xeve_check_cpu_info(ctx->param.isa);
+    support_sse    = (check_cpu >> 1) & 1;
+    support_avx2   = (check_cpu >> 2) & 1;
+    support_avx512 = (check_cpu >> 3) & 1;
 
-    if (support_avx2)
+    if (support_avx512)
     {
-        xeve_func_sad               = xeve_tbl_sad_16b_avx;
-        xeve_func_ssd               = xeve_tbl_ssd_16b_sse;
-        xeve_func_diff              = xeve_tbl_diff_16b_sse;
-        xeve_func_satd              = xeve_tbl_satd_16b_sse;
-        xeve_func_mc_l              = xeve_tbl_mc_l_avx;
-        xeve_func_mc_c              = xeve_tbl_mc_c_avx;
-        xeve_func_average_no_clip   = &xeve_average_16b_no_clip_sse;
-        ctx->fn_itxb                = &xeve_tbl_itxb_avx;
-        xeve_func_txb               = &xeve_tbl_txb_avx;
+        ctx->func = &xeve_func_avx512;
+    }
+    else if (support_avx2)
+    {
+        ctx->func = &xeve_func_avx;
     }
     else if (support_sse)
     {
-        xeve_func_sad               = xeve_tbl_sad_16b_sse;
-        xeve_func_ssd               = xeve_tbl_ssd_16b_sse;
-        xeve_func_diff              = xeve_tbl_diff_16b_sse;
-        xeve_func_satd              = xeve_tbl_satd_16b_sse;
-        xeve_func_mc_l              = xeve_tbl_mc_l_sse;
-        xeve_func_mc_c              = xeve_tbl_mc_c_sse;
-        xeve_func_average_no_clip   = &xeve_average_16b_no_clip_sse;
-        ctx->fn_itxb                = &xeve_tbl_itxb_sse;
-        xeve_func_txb               = &xeve_tbl_txb; /*to be updated*/
+        ctx->func = &xeve_func_sse;
     }
     else
 #endif
     {
-        xeve_func_sad               = xeve_tbl_sad_16b;
-        xeve_func_ssd               = xeve_tbl_ssd_16b;
-        xeve_func_diff              = xeve_tbl_diff_16b;
-        xeve_func_satd              = xeve_tbl_satd_16b;
-        xeve_func_mc_l              = xeve_tbl_mc_l;
-        xeve_func_mc_c              = xeve_tbl_mc_c;
-        xeve_func_average_no_clip   = &xeve_average_16b_no_clip;
-        ctx->fn_itxb                = &xeve_tbl_itxb;
-        xeve_func_txb               = &xeve_tbl_txb;
+        ctx->func = &xeve_func_c;
     }
 }
 
@@ -761,6 +894,9 @@ int xeve_platform_init(XEVE_CTX * ctx)
 {
     int ret = XEVE_ERR_UNKNOWN;
 
+    ret = xeve_thread_ctx_alloc(ctx);
+    xeve_assert_rv(XEVE_OK == ret, ret);
+
     /* create mode decision */
     ret = xeve_mode_create(ctx, 0);
     xeve_assert_rv(XEVE_OK == ret, ret);
@@ -797,6 +933,7 @@ int xeve_platform_init(XEVE_CTX * ctx)
     ctx->fn_eco_coef          = xeve_eco_coef;
     ctx->fn_eco_pic_signature = xeve_eco_pic_signature;
     ctx->fn_tq                = xeve_sub_block_tq;
+    ctx->fn_tq_zero           = xeve_sub_block_tq_zero;
     ctx->fn_rdoq_set_ctx_cc   = xeve_rdoq_set_ctx_cc;
     ctx->fn_itdp              = xeve_itdq;
     ctx->fn_recon             = xeve_recon;
@@ -844,6 +981,8 @@ int xeve_create_bs_buf(XEVE_CTX  * ctx, int max_bs_buf_size)
             ctx->bs[task_id].pdata[1] = &ctx->sbac_enc[task_id];
         }
     }
+    /* upper bound of tile bitstream buffer, actual size is decided with tile info */
+    ctx->bs_tbuf_size = max_bs_buf_size;
     return XEVE_OK;
 }
 
@@ -985,6 +1124,25 @@ static void decide_normal_gop(XEVE_CTX * ctx, u32 pic_imcnt)
     i_period = ctx->param.keyint;
     gop_size = ctx->param.gop_size;
 
+    if (ctx->param.adaptive_gop)
+    {
+        int pos_gop = pic_imcnt % gop_size;
+
+        if (pos_gop == 0)
+        {
+            /* the forecast decided the mini-GOP size when the GOP anchor came in */
+            XEVE_PICO * pico = ctx->pico_buf[pic_imcnt % ctx->pico_max_cnt];
+            ctx->mgop_size = ctx->force_slice ? gop_size : pico->sinfo.mgop_size;
+        }
+        if (ctx->mgop_size < gop_size)
+        {
+            /* code the GOP as gop_size/mgop_size mini-GOPs: pic_imcnt becomes
+               the count of the same position in the mini-GOP they split into */
+            pic_imcnt = pic_imcnt - pos_gop - gop_size + (pos_gop / ctx->mgop_size + 1) * ctx->mgop_size + pos_gop % ctx->mgop_size;
+            gop_size = ctx->mgop_size;
+        }
+    }
+
     if (i_period == 0 && pic_imcnt == 0)
     {
         ctx->slice_type = SLICE_I;
@@ -1179,6 +1337,13 @@ static void decide_slice_type(XEVE_CTX * ctx)
             decide_normal_gop(ctx, pic_imcnt);
         }
     }
+    if (ctx->param.scenecut && ctx->slice_type != SLICE_I && ctx->pico->sinfo.slice_type == SLICE_I)
+    {
+        /* scene cut found by the forecast: the anchor picture keeps its
+           position in the GOP and is coded as an I picture */
+        ctx->slice_type = SLICE_I;
+        ctx->slice_depth = FRM_DEPTH_0;
+    }
     if (ctx->param.disable_hgop == 0 && gop_size > 1)
     {
         ctx->nalu.nuh_temporal_id = ctx->slice_depth - (ctx->slice_depth > 0);
@@ -1204,19 +1369,27 @@ int xeve_pic_prepare(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
 
     PIC_CURR(ctx) = xeve_picman_get_empty_pic(&ctx->rpm, &ret);
     xeve_assert_rv(PIC_CURR(ctx) != NULL, ret);
+    if(ctx->param.me_spel_plane)
+    {
+        ret = xeve_picbuf_spel_alloc(PIC_CURR(ctx), ctx->param.me_spel_plane);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
     ctx->map_refi = PIC_CURR(ctx)->map_refi;
     ctx->map_mv = PIC_CURR(ctx)->map_mv;
     ctx->map_unrefined_mv = PIC_CURR(ctx)->map_unrefined_mv;
-    ctx->map_dqp_lah = ctx->pico->sinfo.map_qp_scu;
 
     PIC_MODE(ctx) = PIC_CURR(ctx);
     if(ctx->pic_dbk == NULL)
     {
         ctx->pic_dbk = xeve_pic_alloc(&ctx->rpm.pa, &ret);
         xeve_assert_rv(ctx->pic_dbk != NULL, ret);
+        /* the CTU lanes filter their CUs in it during the analysis */
+        ctx->pic_dbk->pic_deblock_alpha_offset = ctx->param.deblock_alpha_offset;
+        ctx->pic_dbk->pic_deblock_beta_offset = ctx->param.deblock_beta_offset;
     }
 
     decide_slice_type(ctx);
+    ctx->map_dqp_lah = ctx->pico->sinfo.map_qp_scu;
 
     ctx->lcu_cnt = ctx->f_lcu;
     ctx->slice_num = 0;
@@ -1288,7 +1461,11 @@ int xeve_pic_finish(XEVE_CTX *ctx, XEVE_BITB *bitb, XEVE_STAT *stat)
     }
 
     /* expand current encoding picture, if needs */
-    ctx->fn_picbuf_expand(ctx, PIC_CURR(ctx));
+    if (!ctx->expand_pipe)
+    {
+        ctx->fn_picbuf_expand(ctx, PIC_CURR(ctx));
+        xeve_pic_spel_build(ctx, PIC_CURR(ctx));
+    }
 
     /* picture buffer management */
     ret = xeve_picman_put_pic(&ctx->rpm, PIC_CURR(ctx), ctx->nalu.nal_unit_type_plus1 - 1 == XEVE_IDR_NUT,
@@ -1345,6 +1522,7 @@ int xeve_pic_finish(XEVE_CTX *ctx, XEVE_BITB *bitb, XEVE_STAT *stat)
     if (ctx->param.rc_type != 0)
     {
         ctx->rcore->real_bits = (stat->write - stat->sei_size) << 3;
+        xeve_rc_write_stats(ctx);
     }
 
     imgb_o->release(imgb_o);
@@ -1469,7 +1647,8 @@ void xeve_set_pps(XEVE_CTX * ctx, XEVE_PPS * pps)
     pps->loop_filter_across_tiles_enabled_flag = 0;
     pps->single_tile_in_pic_flag = 1;
     pps->constrained_intra_pred_flag = ctx->param.constrained_intra_pred;
-    pps->cu_qp_delta_enabled_flag = (ctx->param.aq_mode || ctx->param.cutree);
+    pps->cu_qp_delta_enabled_flag = (ctx->param.aq_mode || ctx->param.cutree || ctx->param.row_vbv);
+    pps->cu_qp_delta_area = ctx->param.cu_qp_delta_area;
 
     pps->num_ref_idx_default_active_minus1[REFP_0] = 0;
     pps->num_ref_idx_default_active_minus1[REFP_1] = 0;
@@ -1613,7 +1792,8 @@ int xeve_ready(XEVE_CTX* ctx)
 
     if (ctx->param.rc_type != 0 || ctx->param.lookahead != 0 || ctx->param.use_fcst != 0)
     {
-        xeve_rc_create(ctx);
+        ret = xeve_rc_create(ctx);
+        xeve_assert_gv(ret == XEVE_OK, ret, ret, ERR);
     }
     else
     {
@@ -1623,7 +1803,7 @@ int xeve_ready(XEVE_CTX* ctx)
     }
 
     //initialize the threads to NULL
-    for (int i = 0; i < XEVE_MAX_THREADS; i++)
+    for (int i = 0; i < ctx->param.threads; i++)
     {
         ctx->thread_pool[i] = 0;
     }
@@ -1631,6 +1811,8 @@ int xeve_ready(XEVE_CTX* ctx)
     //get the context synchronization handle
     ctx->sync_block = get_synchronized_object();
     xeve_assert_gv(ctx->sync_block != NULL, ret, XEVE_ERR_UNKNOWN, ERR);
+    ctx->sync_wait = get_wait_object();
+    xeve_assert_gv(ctx->sync_wait != NULL, ret, XEVE_ERR_UNKNOWN, ERR);
 
     if (ctx->param.threads >= 1)
     {
@@ -1641,6 +1823,8 @@ int xeve_ready(XEVE_CTX* ctx)
             ctx->thread_pool[i] = ctx->tc->create(ctx->tc, i);
             xeve_assert_gv(ctx->thread_pool[i] != NULL, ret, XEVE_ERR_UNKNOWN, ERR);
         }
+        ctx->sched = create_task_scheduler(ctx->tc, ctx->thread_pool, ctx->param.threads);
+        xeve_assert_gv(ctx->sched != NULL, ret, XEVE_ERR_UNKNOWN, ERR);
     }
 
     size = ctx->f_lcu * sizeof(int);
@@ -1651,6 +1835,10 @@ int xeve_ready(XEVE_CTX* ctx)
         ctx->sync_flag[i] = 0;
     }
 
+    size = ctx->h_lcu * sizeof(int);
+    ctx->sync_dbk = (volatile s32 *)xeve_malloc(size);
+    xeve_assert_gv(ctx->sync_dbk, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
     /*  allocate CU data map*/
     if (ctx->map_cu_data == NULL)
     {
@@ -1707,6 +1895,7 @@ int xeve_ready(XEVE_CTX* ctx)
     ctx->pic_cnt = 0;
     ctx->pic_icnt = -1;
     ctx->poc.poc_val = 0;
+    ctx->mgop_size = ctx->param.gop_size;
     ctx->pa.chroma_format_idc = ctx->param.chroma_format_idc;
 
     ret = xeve_picman_init(&ctx->rpm, MAX_PB_SIZE, XEVE_MAX_NUM_REF_PICS, &ctx->pa);
@@ -1729,6 +1918,11 @@ int xeve_ready(XEVE_CTX* ctx)
     {
         ctx->frm_rnum = 0;
     }
+    if (ctx->param.use_fcst && ctx->param.lookahead_threads > 0)
+    {
+        /* one more picture is kept while the lookahead analyses the last one */
+        ctx->frm_rnum++;
+    }
 
     ctx->qp = ctx->param.qp;
     if (ctx->param.use_fcst)
@@ -1737,6 +1931,12 @@ int xeve_ready(XEVE_CTX* ctx)
         fcst->w_blk = (ctx->w/2 + (((1 << (fcst->log2_fcst_blk_spic + 1)) - 1))) >> (fcst->log2_fcst_blk_spic + 1);
         fcst->h_blk = (ctx->h/2 + (((1 << (fcst->log2_fcst_blk_spic + 1)) - 1))) >> (fcst->log2_fcst_blk_spic + 1);
         fcst->f_blk = fcst->w_blk * fcst->h_blk;
+
+        if (ctx->param.lookahead_threads > 0)
+        {
+            ret = xeve_fcst_create(ctx);
+            xeve_assert_gv(ret == XEVE_OK, ret, ret, ERR);
+        }
     }
 
     for (i = 0; i < ctx->pico_max_cnt; i++)
@@ -1809,6 +2009,34 @@ int xeve_ready(XEVE_CTX* ctx)
         {
             goto ERR;
         }
+
+        size = sizeof(u8) * ctx->tile_cnt * ctx->param.threads;
+        ctx->tile_qp_prev_eco = (u8 *)xeve_malloc(size);
+        xeve_assert_gv(ctx->tile_qp_prev_eco, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+        for (int i = 0; i < (int)ctx->tile_cnt; i++)
+        {
+            ctx->tile[i].qp_prev_eco = ctx->tile_qp_prev_eco + i * ctx->param.threads;
+        }
+
+        /* one task per tile or per CTU row lane */
+        size = sizeof(THREAD_TASK) * XEVE_MAX((int)ctx->tile_cnt, ctx->param.threads);
+        ctx->task = (THREAD_TASK *)xeve_malloc(size);
+        xeve_assert_gv(ctx->task, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
+        /* tile bitstream buffers, large enough for twice the raw 4:4:4 16-bit data of the largest tile */
+        int max_tile_ctb = 0;
+        for (int i = 0; i < (int)ctx->tile_cnt; i++)
+        {
+            max_tile_ctb = XEVE_MAX(max_tile_ctb, (int)ctx->tile[i].f_ctb);
+        }
+        ctx->bs_tbuf_size = XEVE_MIN(ctx->bs_tbuf_size, max_tile_ctb * (1 << (ctx->log2_max_cuwh << 1)) * 3 * 2 * 2);
+        size = sizeof(u8) * ctx->tile_cnt * ctx->bs_tbuf_size;
+        ctx->bs_tbuf[0] = (u8 *)xeve_malloc(size);
+        xeve_assert_gv(ctx->bs_tbuf[0], ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+        for (int i = 1; i < (int)ctx->tile_cnt; i++)
+        {
+            ctx->bs_tbuf[i] = ctx->bs_tbuf[0] + i * ctx->bs_tbuf_size;
+        }
     }
 
     ctx->sh_array = (XEVE_SH*)xeve_malloc(sizeof(XEVE_SH) * ctx->ts_info.num_slice_in_pic);
@@ -1820,9 +2048,12 @@ int xeve_ready(XEVE_CTX* ctx)
 
     return XEVE_OK;
 ERR:
-    for (i = 0; i < (int)ctx->f_lcu; i++)
+    if (ctx->map_cu_data)
     {
-        xeve_delete_cu_data(ctx->map_cu_data + i, ctx->log2_max_cuwh - MIN_CU_LOG2, ctx->log2_max_cuwh - MIN_CU_LOG2);
+        for (i = 0; i < (int)ctx->f_lcu; i++)
+        {
+            xeve_delete_cu_data(ctx->map_cu_data + i, ctx->log2_max_cuwh - MIN_CU_LOG2, ctx->log2_max_cuwh - MIN_CU_LOG2);
+        }
     }
 
     xeve_mfree_fast(ctx->map_cu_data);
@@ -1831,15 +2062,31 @@ ERR:
     xeve_mfree_fast(ctx->map_cu_mode);
     xeve_mfree_fast(ctx->sh_array);
     xeve_mfree(ctx->tile);
+    xeve_mfree(ctx->tile_qp_prev_eco);
+    xeve_mfree(ctx->task);
+    xeve_mfree(ctx->bs_tbuf[0]);
+
+    if (ctx->tc)
+    {
+        xeve_fcst_delete(ctx);
+    }
 
     //free the threadpool and created thread if any
     if (ctx->sync_block)
     {
         release_synchornized_object(&ctx->sync_block);
     }
+    if (ctx->sync_wait)
+    {
+        release_wait_object(&ctx->sync_wait);
+    }
 
     if (ctx->param.threads >= 1)
     {
+        if (ctx->sched)
+        {
+            release_task_scheduler(&ctx->sched);
+        }
         if (ctx->tc)
         {
             //thread controller instance is present
@@ -1860,6 +2107,7 @@ ERR:
     }
     xeve_mfree_fast(ctx->map_tidx);
     xeve_mfree_fast((void*)ctx->sync_flag);
+    xeve_mfree_fast((void*)ctx->sync_dbk);
 
     for (i = 0; i < ctx->pico_max_cnt; i++)
     {
@@ -1900,6 +2148,11 @@ void xeve_flush(XEVE_CTX * ctx)
     int i;
     xeve_assert(ctx);
 
+    if (ctx->tc)
+    {
+        xeve_fcst_delete(ctx);
+    }
+
     xeve_mfree_fast(ctx->map_scu);
     for(i = 0; i < (int)ctx->f_lcu; i++)
     {
@@ -1910,15 +2163,26 @@ void xeve_flush(XEVE_CTX * ctx)
     xeve_mfree_fast(ctx->map_depth);
     xeve_mfree_fast(ctx->sh_array);
     xeve_mfree(ctx->tile);
+    xeve_mfree(ctx->tile_qp_prev_eco);
+    xeve_mfree(ctx->task);
+    xeve_mfree(ctx->bs_tbuf[0]);
     //release the sync block
     if (ctx->sync_block)
     {
         release_synchornized_object(&ctx->sync_block);
     }
+    if (ctx->sync_wait)
+    {
+        release_wait_object(&ctx->sync_wait);
+    }
 
     //Release thread pool controller and created threads
     if (ctx->param.threads >= 1)
     {
+        if (ctx->sched)
+        {
+            release_task_scheduler(&ctx->sched);
+        }
         if(ctx->tc)
         {
             //thread controller instance is present
@@ -1939,6 +2203,7 @@ void xeve_flush(XEVE_CTX * ctx)
     }
 
     xeve_mfree_fast((void*) ctx->sync_flag);
+    xeve_mfree_fast((void*) ctx->sync_dbk);
 
     xeve_mfree_fast(ctx->map_cu_mode);
     xeve_picbuf_free(ctx->pic_dbk);
@@ -1951,6 +2216,11 @@ void xeve_flush(XEVE_CTX * ctx)
 
     for (i = 0; i < ctx->pico_max_cnt; i++)
     {
+        if (ctx->pico_buf[i]->is_used && ctx->pico_buf[i]->pic.imgb)
+        {
+            /* input picture which has not been encoded */
+            ctx->pico_buf[i]->pic.imgb->release(ctx->pico_buf[i]->pic.imgb);
+        }
         if (ctx->param.use_fcst)
         {
             xeve_mfree_fast(ctx->pico_buf[i]->sinfo.map_pdir);
@@ -2280,7 +2550,11 @@ int xeve_set_init_param(XEVE_CTX * ctx, XEVE_PARAM * param)
     xeve_assert_rv(param->w > 0 && param->h > 0, XEVE_ERR_INVALID_ARGUMENT);
     xeve_assert_rv(param->qp >= MIN_QUANT && param->qp <= MAX_QUANT, XEVE_ERR_INVALID_ARGUMENT);
     xeve_assert_rv(param->keyint >= 0 ,XEVE_ERR_INVALID_ARGUMENT);
-    xeve_assert_rv(param->threads <= XEVE_MAX_THREADS ,XEVE_ERR_INVALID_ARGUMENT);
+    xeve_assert_rv(param->threads >= 1 && param->threads <= XEVE_MAX_THREADS ,XEVE_ERR_INVALID_ARGUMENT);
+    xeve_assert_rv(param->lookahead_threads >= 0 && param->lookahead_threads <= XEVE_MAX_THREADS ,XEVE_ERR_INVALID_ARGUMENT);
+    xeve_assert_rv(param->scenecut >= 0 && param->scenecut <= 100 && !(param->scenecut && param->closed_gop), XEVE_ERR_INVALID_ARGUMENT);
+    xeve_assert_rv(param->adaptive_gop == 0 || (param->profile == XEVE_PROFILE_MAIN && !param->closed_gop && \
+                   (param->bframes == 7 || param->bframes == 15)), XEVE_ERR_INVALID_ARGUMENT);
 
     if(param->disable_hgop == 0)
     {
@@ -2329,8 +2603,8 @@ int xeve_set_init_param(XEVE_CTX * ctx, XEVE_PARAM * param)
 
     /* set default encoding parameter */
     param->gop_size          = param->bframes +1;
-    param->lookahead         = XEVE_MIN(XEVE_MAX((param->cutree)? param->gop_size : 0, param->lookahead), XEVE_MAX_INBUF_CNT>>1);
-    param->use_fcst          = ((param->use_fcst || param->lookahead) && (param->rc_type || param->aq_mode)) ? 1 : 0;
+    param->lookahead         = XEVE_MIN(XEVE_MAX((param->cutree || param->scenecut || param->adaptive_gop)? param->gop_size : 0, param->lookahead), XEVE_MAX_INBUF_CNT>>1);
+    param->use_fcst          = ((param->use_fcst || param->lookahead) && (param->rc_type || param->aq_mode || param->scenecut || param->adaptive_gop)) ? 1 : 0;
     param->chroma_format_idc = XEVE_CFI_FROM_CF(XEVE_CS_GET_FORMAT(param->cs));
     param->cs_w_shift        = XEVE_GET_CHROMA_W_SHIFT(param->chroma_format_idc);
     param->cs_h_shift        = XEVE_GET_CHROMA_H_SHIFT(param->chroma_format_idc);
@@ -2381,6 +2655,7 @@ int xeve_param_init(XEVE_PARAM* param)
     param->use_annexb                 = 1;
     param->qp_max                     = MAX_QUANT;
     param->qp_min                     = MIN_QUANT;
+    param->cu_qp_delta_area           = 6;
 
     param->sei_cmd_info               = 1;
 
@@ -2406,6 +2681,7 @@ int xeve_init_core_mt(XEVE_CTX * ctx, int tile_num, XEVE_CORE * core, int thread
     ctx->core[thread_cnt]->qp_y = core->qp_y;
     ctx->core[thread_cnt]->qp_u = core->qp_u;
     ctx->core[thread_cnt]->qp_v = core->qp_v;
+    ctx->core[thread_cnt]->dqp_row = 0;
     ctx->sh->qp_prev_eco = ctx->sh->qp;
     ctx->sh->qp_prev_mode = ctx->sh->qp;
     ctx->core[thread_cnt]->dqp_data[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2].prev_qp = ctx->sh->qp_prev_mode;
@@ -2417,12 +2693,21 @@ int xeve_init_core_mt(XEVE_CTX * ctx, int tile_num, XEVE_CORE * core, int thread
     return XEVE_OK;
 }
 
-int xeve_deblock_mt(void * arg)
+int xeve_deblock_mt(void * arg, int task_idx, int worker_id)
 {
     XEVE_CORE * core = (XEVE_CORE *)arg;
-    XEVE_CTX * ctx = core->ctx;
-    int i = core->tile_num;
-    ctx->fn_deblock(ctx, PIC_MODE(ctx), i, ctx->pps.loop_filter_across_tiles_enabled_flag, core);
+    XEVE_CTX  * ctx = core->ctx;
+    XEVE_TILE * tile = &ctx->tile[core->tile_num];
+    int         y_l = tile->ctba_rs_first / ctx->w_lcu;
+    int         lanes = XEVE_MIN(ctx->param.threads, tile->h_ctb);
+    int         ret;
+
+    /* lane filters every lanes-th LCU row of the tile, lagging behind the lane of the upper row */
+    for (int y_lcu = y_l + task_idx; y_lcu < y_l + tile->h_ctb; y_lcu += lanes)
+    {
+        ret = ctx->fn_deblock(ctx, PIC_MODE(ctx), core->tile_num, y_lcu, ctx->pps.loop_filter_across_tiles_enabled_flag, core);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
     return XEVE_OK;
 }
 
@@ -2430,12 +2715,15 @@ int xeve_loop_filter(XEVE_CTX * ctx, XEVE_CORE * core)
 {
     int ret = XEVE_OK;
 
-    if (ctx->sh->deblocking_filter_on)
+    if (ctx->sh->deblocking_filter_on && !ctx->loop_filter_pipe)
     {
 #if TRACE_DBF
         XEVE_TRACE_SET(1);
 #endif
-        for (int is_hor_edge = 0; is_hor_edge <= 1; is_hor_edge++)
+        /* vertical and horizontal edges are filtered in one pass unless filtering across tiles */
+        int num_pass = ctx->pps.loop_filter_across_tiles_enabled_flag ? 2 : 1;
+
+        for (int is_hor_edge = 0; is_hor_edge < num_pass; is_hor_edge++)
         {
             for (u32 i = 0; i < ctx->f_scu; i++)
             {
@@ -2445,45 +2733,33 @@ int xeve_loop_filter(XEVE_CTX * ctx, XEVE_CORE * core)
             for (ctx->slice_num = 0; ctx->slice_num < ctx->ts_info.num_slice_in_pic; ctx->slice_num++)
             {
                 ctx->sh = &ctx->sh_array[ctx->slice_num];
-                u16 total_tiles_in_slice = ctx->sh->num_tiles_in_slice;
-                THREAD_CONTROLLER * tc;
-                int res;
-                int i, k = 0;
-                tc = ctx->tc;
-                int parallel_task = 1;
-                int thread_cnt = 0, thread_cnt1 = 0;;
-                int task_completed = 0;
-
-                while (total_tiles_in_slice)
+                xeve_deblock_set_offsets(PIC_MODE(ctx), ctx->sh);
+
+                for (int k = 0; k < ctx->sh->num_tiles_in_slice; k++)
                 {
-                    parallel_task = 1;// (ctx->param.threads > total_tiles_in_slice) ? total_tiles_in_slice : ctx->param.threads;
-                    for (thread_cnt = 0; (thread_cnt < parallel_task - 1); thread_cnt++)
+                    int i = ctx->sh->tile_order[k];
+                    int y_l = ctx->tile[i].ctba_rs_first / ctx->w_lcu;
+                    int lanes = XEVE_MIN(ctx->param.threads, ctx->tile[i].h_ctb);
+
+                    for (int y_lcu = y_l; y_lcu < y_l + ctx->tile[i].h_ctb; y_lcu++)
+                    {
+                        ctx->sync_dbk[y_lcu] = 0;
+                    }
+
+                    for (int thread_cnt = 0; thread_cnt < lanes; thread_cnt++)
                     {
-                        i = ctx->sh->tile_order[thread_cnt + task_completed];
-                        ctx->core[thread_cnt]->thread_cnt = thread_cnt;
+                        ctx->core[thread_cnt]->ctx = ctx;
                         ctx->core[thread_cnt]->tile_num = i;
                         ctx->core[thread_cnt]->deblock_is_hor = is_hor_edge;
 
-                        tc->run(ctx->thread_pool[thread_cnt], xeve_deblock_mt, (void*)ctx->core[thread_cnt]);
+                        task_init(&ctx->task[thread_cnt], xeve_deblock_mt, (void*)ctx->core[thread_cnt], thread_cnt);
+                        ret = task_submit(ctx->sched, &ctx->task[thread_cnt]);
+                        xeve_assert_rv(ret == THREAD_SUCCESS, XEVE_ERR_UNKNOWN);
                     }
-                    i = ctx->sh->tile_order[thread_cnt + task_completed];
-                    ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-                    ctx->core[thread_cnt]->tile_num = i;
-                    ctx->core[thread_cnt]->deblock_is_hor = is_hor_edge;
 
-                    xeve_deblock_mt((void*)ctx->core[thread_cnt]);
-                    for (thread_cnt1 = 0; thread_cnt1 < parallel_task - 1; thread_cnt1++)
-                    {
-                        tc->join(ctx->thread_pool[thread_cnt1], &res);
-                        if (XEVE_FAILED(res))
-                        {
-                            ret = res;
-                        }
-                    }
-                    total_tiles_in_slice -= parallel_task;
-                    task_completed += parallel_task;
+                    ret = task_wait_all(ctx->sched);
+                    xeve_assert_rv(ret == XEVE_OK, ret);
                 }
-                total_tiles_in_slice = ctx->sh->num_tiles_in_slice;
             }
 #if TRACE_DBF
             XEVE_TRACE_SET(0);
@@ -2494,6 +2770,84 @@ int xeve_loop_filter(XEVE_CTX * ctx, XEVE_CORE * core)
     return ret;
 }
 
+void xeve_loop_filter_pipe_init(XEVE_CTX * ctx, int enable)
+{
+    /* the analysis reads unfiltered samples of the LCU row above, so the
+       LCU rows can only follow each other within a single tile */
+    ctx->loop_filter_pipe = enable && ctx->tile_cnt == 1 && ctx->sh->deblocking_filter_on;
+    ctx->expand_pipe = ctx->loop_filter_pipe;
+
+    if (ctx->loop_filter_pipe)
+    {
+        xeve_deblock_set_offsets(PIC_MODE(ctx), ctx->sh);
+        for (int y_lcu = 0; y_lcu < ctx->h_lcu; y_lcu++)
+        {
+            ctx->sync_dbk[y_lcu] = 0;
+        }
+    }
+}
+
+int xeve_loop_filter_lcu(XEVE_CTX * ctx, XEVE_CORE * core)
+{
+    XEVE_TILE * tile = &ctx->tile[core->tile_num];
+    TREE_CONS   tree_cons = core->tree_cons;
+    int         x_l = tile->ctba_rs_first % ctx->w_lcu;
+    int         y_l = tile->ctba_rs_first / ctx->w_lcu;
+    int         x_r = x_l + tile->w_ctb;
+    int         ret = XEVE_OK;
+
+    /* analysis of an LCU reads the unfiltered samples and the coded flags of the upper row up to
+       the next LCU, and deblocking of an LCU prepares the maps up to two LCUs ahead, so the upper
+       row is filtered three LCUs behind the analysis and completed at the end of the row */
+    if (core->y_lcu > y_l)
+    {
+        int x_e = (core->x_lcu + 1 == x_r) ? x_r : core->x_lcu - 2;
+
+        for (int i = XEVE_MAX(x_l, core->x_lcu - 3); i < x_e; i++)
+        {
+            ret = xeve_deblock_lcu(ctx, PIC_MODE(ctx), core->tile_num, i, core->y_lcu - 1, core);
+            xeve_assert_g(ret == XEVE_OK, ERR);
+        }
+    }
+
+    /* the upper row is deblocked completely, which finishes the row above it.
+       the sub-pel planes of a row read a few lines of the next row, so they
+       follow one row behind the expansion */
+    if (ctx->expand_pipe && core->x_lcu + 1 == x_r && core->y_lcu - 2 >= y_l)
+    {
+        xeve_pic_expand_lcu_row(ctx, PIC_MODE(ctx), core->y_lcu - 2);
+        if (core->y_lcu - 3 >= y_l)
+        {
+            xeve_pic_spel_build_lcu_row(ctx, PIC_MODE(ctx), core->y_lcu - 3);
+        }
+    }
+
+    /* no lane follows the last LCU row of the tile */
+    if (core->y_lcu + 1 == y_l + tile->h_ctb && core->x_lcu + 1 == x_r)
+    {
+        for (int i = x_l; i < x_r; i++)
+        {
+            ret = xeve_deblock_lcu(ctx, PIC_MODE(ctx), core->tile_num, i, core->y_lcu, core);
+            xeve_assert_g(ret == XEVE_OK, ERR);
+        }
+        if (ctx->expand_pipe)
+        {
+            for (int y = XEVE_MAX(y_l, core->y_lcu - 1); y <= core->y_lcu; y++)
+            {
+                xeve_pic_expand_lcu_row(ctx, PIC_MODE(ctx), y);
+            }
+            for (int y = XEVE_MAX(y_l, core->y_lcu - 2); y <= core->y_lcu; y++)
+            {
+                xeve_pic_spel_build_lcu_row(ctx, PIC_MODE(ctx), y);
+            }
+        }
+    }
+
+ERR:
+    core->tree_cons = tree_cons;
+    return ret;
+}
+
 void xeve_recon(XEVE_CTX * ctx, XEVE_CORE * core, s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth)
 {
     xeve_recon_blk(coef, pred, is_coef, cuw, cuh, s_rec, rec, bit_depth);
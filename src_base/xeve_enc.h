@@ -47,6 +47,7 @@
 
 XEVE_CTX * xeve_ctx_alloc(void);
 void xeve_ctx_free(XEVE_CTX * ctx);
+int xeve_thread_ctx_alloc(XEVE_CTX * ctx);
 XEVE_CORE * xeve_core_alloc(int chroma_format_idc);
 void xeve_core_free(XEVE_CORE * core);
 
@@ -85,8 +86,10 @@ int  xeve_set_tile_info(XEVE_CTX * ctx);
 int  xeve_header(XEVE_CTX * ctx);
 
 int  xeve_init_core_mt(XEVE_CTX * ctx, int tile_num, XEVE_CORE * core, int thread_cnt);
-int  xeve_deblock_mt(void * arg);
+int  xeve_deblock_mt(void * arg, int task_idx, int worker_id);
 int  xeve_loop_filter(XEVE_CTX * ctx, XEVE_CORE * core);
+void xeve_loop_filter_pipe_init(XEVE_CTX * ctx, int enable);
+int  xeve_loop_filter_lcu(XEVE_CTX * ctx, XEVE_CORE * core);
 void xeve_recon(XEVE_CTX * ctx, XEVE_CORE * core, s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth);
 
 int  xeve_param_apply_ppt_baseline(XEVE_PARAM* param, int profile, int preset, int tune);
@@ -39,6 +39,9 @@ static const s8 tbl_small_dia_search[4][3] =
 };
 
 
+/* shortest mini-GOP of the adaptive GOP */
+#define FCST_MGOP_MIN           4
+
 /* weighting factor for current pic to reference pic */
 static const double tbl_rpic_dist_wt[8] =
 {
@@ -313,15 +316,15 @@ static void adaptive_quantization(XEVE_CTX * ctx)
     y_blk        = 0;
     log2_cuwh    = fcst->log2_fcst_blk_spic +1; /* fcst block (subpic) + 1 for fullpic */
     blk_size     = 1 << log2_cuwh;
-    qp_offset = ctx->pico->sinfo.map_qp_blk;
+    qp_offset = fcst->pico->sinfo.map_qp_blk;
 
     h_blk = fcst->h_blk;
     w_blk = fcst->w_blk;
     f_blk = fcst->f_blk;
 
     aq_bd_const  = (ctx->sps.bit_depth_luma_minus8 + 7.2135) * 2;
-    s_l = ctx->pico->pic.s_l;
-    s_c = ctx->pico->pic.s_c;
+    s_l = fcst->pico->pic.s_l;
+    s_c = fcst->pico->pic.s_c;
 
     while(1)
     {
@@ -334,12 +337,12 @@ static void adaptive_quantization(XEVE_CTX * ctx)
         }
         else
         {
-            var  = get_lcu_var(ctx, ctx->pico->pic.buf_y, log2_cuwh,
+            var  = get_lcu_var(ctx, fcst->pico->pic.buf_y, log2_cuwh,
                 log2_cuwh, x, y, s_l);
             if(ctx->sps.chroma_format_idc)
             {
-                var += get_lcu_var(ctx, ctx->pico->pic.buf_u, log2_cuwh - w_shift, log2_cuwh - h_shift, (x >> w_shift), (y >> h_shift), s_c);
-                var += get_lcu_var(ctx, ctx->pico->pic.buf_v, log2_cuwh - w_shift, log2_cuwh - h_shift, (x >> w_shift), (y >> h_shift), s_c);
+                var += get_lcu_var(ctx, fcst->pico->pic.buf_u, log2_cuwh - w_shift, log2_cuwh - h_shift, (x >> w_shift), (y >> h_shift), s_c);
+                var += get_lcu_var(ctx, fcst->pico->pic.buf_v, log2_cuwh - w_shift, log2_cuwh - h_shift, (x >> w_shift), (y >> h_shift), s_c);
             }
         }
 
@@ -681,7 +684,7 @@ static void blk_tree_fixed_gop(XEVE_CTX * ctx)
     s32        * qp_offset;
 
     bframes       = 0;
-    pic_icnt_last = ctx->pico->pic_icnt;
+    pic_icnt_last = ctx->fcst.pico->pic_icnt;
     gop_size = ctx->param.bframes + 1;
 
     max_depth = 0;
@@ -917,8 +920,8 @@ static s32 xeve_est_intra_cost(XEVE_CTX * ctx, s32 x0, s32 y0)
     s32        cost, cost_best, tot_cost, intra_penalty;
     u8         temp_avil[5] = { 0 };
     pel      * org;
-    XEVE_PIC * spic = ctx->pico->spic;
-    pel      * pred = ctx->rcore->pred;
+    XEVE_PIC * spic = ctx->fcst.pico->spic;
+    pel        pred[4096];
     pel        buf_le0[65];
     pel        buf_up0[65 + 1];
 
@@ -1184,15 +1187,15 @@ static s32 est_inter_cost(XEVE_CTX * ctx, s32 x, s32 y, XEVE_PICO * pico_cur
 
     log2_cuwh = ctx->fcst.log2_fcst_blk_spic + 1;
     cuwh      = 1 << log2_cuwh;
-    pos       = (x >> log2_cuwh) + (y >> log2_cuwh) * ctx->w_lcu;
+    pos       = (x >> log2_cuwh) + (y >> log2_cuwh) * ctx->fcst.w_blk;
     map_mv    = uni_inter_mode > 1 ? pico_cur->sinfo.map_mv_pga : pico_cur->sinfo.map_mv;
     lambda    = (u16)ctx->rc->lambda[2];
 
-    get_mvc_median(mvc[0], &map_mv[pos], pos, list, ctx->w_lcu);
+    get_mvc_median(mvc[0], &map_mv[pos], pos, list, ctx->fcst.w_blk);
 
     if (XEVE_ABS((s32)(pico_cur->pic_icnt - pico_ref->pic_icnt)) != 1)
     {
-        get_mvc_nev(mvc + 1, &map_mv[pos], pos, list, ctx->w_lcu);
+        get_mvc_nev(mvc + 1, &map_mv[pos], pos, list, ctx->fcst.w_blk);
         mvp_num = 4;
     }
 
@@ -1230,78 +1233,6 @@ static s32 est_inter_cost(XEVE_CTX * ctx, s32 x, s32 y, XEVE_PICO * pico_cur
     return min_cost;
 }
 
-void uni_direction_cost_estimation(XEVE_CTX * ctx, XEVE_PICO * pico_cur, XEVE_PICO * pico_ref
-                                        , s32 is_intra_pic, s32 intra_cost_compute, s32 uni_inter_mode)
-{
-    s32     lcu_num = 0, x_lcu = 0, y_lcu = 0, log2_cuwh;
-    s32 ( * map_lcu_cost)[4];
-    u16     intra_blk_cnt = 0; /* count of intra blocks in inter picutre */
-    u8    * map_pdir, ref_list;
-
-    map_lcu_cost = pico_cur->sinfo.map_uni_lcost;
-    map_pdir = pico_cur->sinfo.map_pdir;
-    log2_cuwh =  ctx->fcst.log2_fcst_blk_spic + 1;
-
-    if (intra_cost_compute) pico_cur->sinfo.uni_est_cost[INTRA] = 0;
-
-    pico_cur->sinfo.uni_est_cost[uni_inter_mode] = 0;
-
-    /* get fcost */
-    for (lcu_num = 0; lcu_num < ctx->fcst.f_blk; lcu_num++)
-    {
-        if (intra_cost_compute)
-        {
-            map_lcu_cost[lcu_num][INTRA] = xeve_est_intra_cost(ctx, x_lcu << log2_cuwh, y_lcu << log2_cuwh) +
-                                           ctx->rc->param->sub_pic_penalty;
-            pico_cur->sinfo.uni_est_cost[INTRA] += map_lcu_cost[lcu_num][INTRA];
-        }
-
-        if (!is_intra_pic)
-        {
-            map_lcu_cost[lcu_num][uni_inter_mode] = est_inter_cost(ctx, x_lcu << log2_cuwh, y_lcu << log2_cuwh, pico_cur
-                                                                      , pico_ref, REFP_0, uni_inter_mode) + ctx->rc->param->sub_pic_penalty;
-
-            if (map_lcu_cost[lcu_num][INTRA] < map_lcu_cost[lcu_num][uni_inter_mode])
-            {
-                pico_cur->sinfo.uni_est_cost[uni_inter_mode] += map_lcu_cost[lcu_num][INTRA];
-                /* increase intra count for inter picture */
-                intra_blk_cnt++;
-            }
-            else
-            {
-                if(uni_inter_mode == INTER_UNI0) map_pdir[lcu_num] = INTER_L0;
-                pico_cur->sinfo.uni_est_cost[uni_inter_mode] += map_lcu_cost[lcu_num][uni_inter_mode];
-            }
-        }
-
-        x_lcu++;
-        if (x_lcu == ctx->fcst.w_blk)
-        {
-            /* switch to the new lcu row*/
-            x_lcu = 0;
-            y_lcu++;
-        }
-    }
-
-    /* Storing intra block count in inter frame*/
-    ref_list = uni_inter_mode - 1;
-    pico_cur->sinfo.icnt[ref_list] = intra_blk_cnt;
-
-    /* weighting intra fcost */
-    if (intra_cost_compute)
-    {
-        if (pico_cur->pic_icnt == 0)
-        {
-            pico_cur->sinfo.uni_est_cost[INTRA] = (s32)(pico_cur->sinfo.uni_est_cost[INTRA] >> 1);
-
-        }
-        else
-        {
-            pico_cur->sinfo.uni_est_cost[INTRA] = (s32)((pico_cur->sinfo.uni_est_cost[INTRA] * 3) >> 2);
-        }
-    }
-}
-
 static s32 fcst_me_ipel_b(XEVE_PIC * org_pic, XEVE_PIC * ref_pic_0, XEVE_PIC * ref_pic_1, s32 x, s32 y, s32 log2_cuwh, u16 lambda
                         , s16 mv_l0[MV_D], s16 mvd_L0[MV_D], s16 mv_L1[MV_D], s16 mvd_L1[MV_D], u8 bit_depth, s16* min_mv_l0, s16* max_mv_l0, s16* min_mv_l1, s16* max_mv_l1)
 {
@@ -1378,7 +1309,7 @@ static s32 get_bi_lcost(XEVE_CTX * ctx, int x, int y, XEVE_PICO * pico_1,
         }
 
         /* set maximum/minimum value of search range */
-        get_mvc_median(mvc_l1, &map_mv[pos], pos, PRED_L1, ctx->w_lcu);
+        get_mvc_median(mvc_l1, &map_mv[pos], pos, PRED_L1, ctx->fcst.w_blk);
         set_mv_bound(x + (mvc_l1[MV_X] >> 2), y + (mvc_l1[MV_Y] >> 2),  sub_w, sub_h, min_l1, max_l1);
 
         /* Find mvc at pos in fcst_ref */
@@ -1430,33 +1361,217 @@ static s32 get_bi_lcost(XEVE_CTX * ctx, int x, int y, XEVE_PICO * pico_1,
     return best_cost;
 }
 
+/* block rows of one cost estimation pass */
+typedef struct _FCST_ROWS
+{
+    XEVE_CTX  * ctx;
+    XEVE_PICO * pico_cur;
+    XEVE_PICO * pico_l0;
+    XEVE_PICO * pico_l1;
+    s32         is_intra_pic;
+    s32         intra_cost_compute;
+    s32         uni_inter_mode;
+    /* bi-direction pass, otherwise uni-direction */
+    s32         bi;
+    int         lanes;
+} FCST_ROWS;
+
+static void fcst_blk_cost(FCST_ROWS * rows, s32 x_blk, s32 y_blk)
+{
+    XEVE_CTX  * ctx = rows->ctx;
+    XEVE_PICO * pico_cur = rows->pico_cur;
+    s32         log2_cuwh = ctx->fcst.log2_fcst_blk_spic + 1;
+    s32         blk_num = x_blk + y_blk * ctx->fcst.w_blk;
+    s32         x = x_blk << log2_cuwh;
+    s32         y = y_blk << log2_cuwh;
+    s32     ( * map_lcu_cost)[4] = pico_cur->sinfo.map_uni_lcost;
+    s32       * bi_lcost = pico_cur->sinfo.map_bi_lcost;
+
+    if (rows->bi)
+    {
+        bi_lcost[blk_num] = get_bi_lcost(ctx, x, y, pico_cur, rows->pico_l0, rows->pico_l1, &pico_cur->sinfo.map_pdir_bi[blk_num]);
+        if (bi_lcost[blk_num] != XEVE_INT32_MAX)
+        {
+            bi_lcost[blk_num] += ctx->rc->param->sub_pic_penalty;
+        }
+        return;
+    }
+
+    if (rows->intra_cost_compute)
+    {
+        map_lcu_cost[blk_num][INTRA] = xeve_est_intra_cost(ctx, x, y) + ctx->rc->param->sub_pic_penalty;
+    }
+
+    if (!rows->is_intra_pic)
+    {
+        map_lcu_cost[blk_num][rows->uni_inter_mode] = est_inter_cost(ctx, x, y, pico_cur, rows->pico_l0, REFP_0, rows->uni_inter_mode)
+                                                      + ctx->rc->param->sub_pic_penalty;
+    }
+}
+
+static void fcst_blk_row(FCST_ROWS * rows, s32 y_blk)
+{
+    XEVE_FCST * fcst = &rows->ctx->fcst;
+    s32         x_blk;
+
+    for (x_blk = 0; x_blk < fcst->w_blk; x_blk++)
+    {
+        if (rows->lanes > 1 && y_blk > 0)
+        {
+            /* mv predictors of the block use the up and up-left blocks */
+            threadsafe_wait(fcst->sync_wait, &fcst->sync_row[y_blk - 1], x_blk + 1, NULL);
+        }
+
+        fcst_blk_cost(rows, x_blk, y_blk);
+
+        if (rows->lanes > 1)
+        {
+            threadsafe_signal(fcst->sync_wait, &fcst->sync_row[y_blk], x_blk + 1);
+        }
+    }
+}
+
+static int fcst_blk_rows_lane(void * arg, int task_idx, int worker_id)
+{
+    FCST_ROWS * rows = (FCST_ROWS *)arg;
+    s32         y_blk;
+
+    for (y_blk = task_idx; y_blk < rows->ctx->fcst.h_blk; y_blk += rows->lanes)
+    {
+        fcst_blk_row(rows, y_blk);
+    }
+    return XEVE_OK;
+}
+
+/* costs of all blocks of a pass, block rows are coded as a wavefront on the
+   lookahead workers; the results do not depend on the number of workers */
+static void fcst_blk_rows(FCST_ROWS * rows)
+{
+    XEVE_FCST * fcst = &rows->ctx->fcst;
+    s32         i;
+
+    rows->lanes = fcst->sched ? XEVE_MIN(rows->ctx->param.lookahead_threads, fcst->h_blk) : 1;
+
+    if (rows->lanes == 1)
+    {
+        for (i = 0; i < fcst->h_blk; i++)
+        {
+            fcst_blk_row(rows, i);
+        }
+        return;
+    }
+
+    for (i = 0; i < fcst->h_blk; i++)
+    {
+        threadsafe_assign(&fcst->sync_row[i], 0);
+    }
+    for (i = 0; i < rows->lanes; i++)
+    {
+        task_init(&fcst->task[i], fcst_blk_rows_lane, rows, i);
+        task_submit(fcst->sched, &fcst->task[i]);
+    }
+    task_wait_all(fcst->sched);
+}
+
+void uni_direction_cost_estimation(XEVE_CTX * ctx, XEVE_PICO * pico_cur, XEVE_PICO * pico_ref
+                                        , s32 is_intra_pic, s32 intra_cost_compute, s32 uni_inter_mode)
+{
+    s32     lcu_num = 0;
+    s32 ( * map_lcu_cost)[4];
+    u16     intra_blk_cnt = 0; /* count of intra blocks in inter picutre */
+    u8    * map_pdir, ref_list;
+    FCST_ROWS rows;
+
+    map_lcu_cost = pico_cur->sinfo.map_uni_lcost;
+    map_pdir = pico_cur->sinfo.map_pdir;
+
+    rows.ctx                = ctx;
+    rows.pico_cur           = pico_cur;
+    rows.pico_l0            = pico_ref;
+    rows.pico_l1            = NULL;
+    rows.is_intra_pic       = is_intra_pic;
+    rows.intra_cost_compute = intra_cost_compute;
+    rows.uni_inter_mode     = uni_inter_mode;
+    rows.bi                 = 0;
+    fcst_blk_rows(&rows);
+
+    if (intra_cost_compute) pico_cur->sinfo.uni_est_cost[INTRA] = 0;
+
+    pico_cur->sinfo.uni_est_cost[uni_inter_mode] = 0;
+
+    /* get fcost */
+    for (lcu_num = 0; lcu_num < ctx->fcst.f_blk; lcu_num++)
+    {
+        if (intra_cost_compute)
+        {
+            pico_cur->sinfo.uni_est_cost[INTRA] += map_lcu_cost[lcu_num][INTRA];
+        }
+
+        if (!is_intra_pic)
+        {
+            if (map_lcu_cost[lcu_num][INTRA] < map_lcu_cost[lcu_num][uni_inter_mode])
+            {
+                pico_cur->sinfo.uni_est_cost[uni_inter_mode] += map_lcu_cost[lcu_num][INTRA];
+                /* increase intra count for inter picture */
+                intra_blk_cnt++;
+            }
+            else
+            {
+                if(uni_inter_mode == INTER_UNI0) map_pdir[lcu_num] = INTER_L0;
+                pico_cur->sinfo.uni_est_cost[uni_inter_mode] += map_lcu_cost[lcu_num][uni_inter_mode];
+            }
+        }
+    }
+
+    /* Storing intra block count in inter frame*/
+    ref_list = uni_inter_mode - 1;
+    pico_cur->sinfo.icnt[ref_list] = intra_blk_cnt;
+
+    /* weighting intra fcost */
+    if (intra_cost_compute)
+    {
+        if (pico_cur->pic_icnt == 0)
+        {
+            pico_cur->sinfo.uni_est_cost[INTRA] = (s32)(pico_cur->sinfo.uni_est_cost[INTRA] >> 1);
+
+        }
+        else
+        {
+            pico_cur->sinfo.uni_est_cost[INTRA] = (s32)((pico_cur->sinfo.uni_est_cost[INTRA] * 3) >> 2);
+        }
+    }
+}
+
 void bi_direction_cost_estimation(XEVE_CTX * ctx, XEVE_PICO * pico_cur, XEVE_PICO * pico_l0, XEVE_PICO * pico_l1)
 {
-    s32      lcu_num = 0, x_lcu = 0, y_lcu = 0, log2_cuwh, intra_blk_cnt = 0;
+    s32      lcu_num = 0, intra_blk_cnt = 0;
     s32(*uni_lcost)[4], uni_min_cost;
     s32      * bi_lcost;
+    FCST_ROWS  rows;
 
     u8   * map_pdir;
 
     /* get map_lcost for pictures */
     uni_lcost = pico_cur->sinfo.map_uni_lcost; /* current pic */
     bi_lcost = pico_cur->sinfo.map_bi_lcost; /* current pic */
-    log2_cuwh = ctx->fcst.log2_fcst_blk_spic + 1;
     map_pdir = pico_cur->sinfo.map_pdir_bi;
 
+    /*BI_estimation*/
+    rows.ctx                = ctx;
+    rows.pico_cur           = pico_cur;
+    rows.pico_l0            = pico_l0;
+    rows.pico_l1            = pico_l1;
+    rows.is_intra_pic       = 0;
+    rows.intra_cost_compute = 0;
+    rows.uni_inter_mode     = INTER_UNI0;
+    rows.bi                 = 1;
+    fcst_blk_rows(&rows);
+
     /* first init delayed_fcost */
     pico_cur->sinfo.bi_fcost = 0;
 
-    while (1)
+    for (lcu_num = 0; lcu_num < ctx->fcst.f_blk; lcu_num++)
     {
-        /*BI_estimation*/
-
-        bi_lcost[lcu_num] = get_bi_lcost(ctx, x_lcu << log2_cuwh, y_lcu << log2_cuwh, pico_cur, pico_l0, pico_l1, &map_pdir[lcu_num]);
-        if (bi_lcost[lcu_num] != XEVE_INT32_MAX)
-        {
-            bi_lcost[lcu_num] += ctx->rc->param->sub_pic_penalty;
-        }
-
         uni_min_cost = XEVE_MIN(uni_lcost[lcu_num][INTRA], XEVE_MIN(uni_lcost[lcu_num][INTER_UNI0], bi_lcost[lcu_num]));
         if (uni_lcost[lcu_num][INTRA] == uni_min_cost)
         {
@@ -1464,16 +1579,6 @@ void bi_direction_cost_estimation(XEVE_CTX * ctx, XEVE_PICO * pico_cur, XEVE_PIC
             intra_blk_cnt++;
         }
         pico_cur->sinfo.bi_fcost += uni_min_cost;
-
-        lcu_num++;
-        if (lcu_num == ctx->fcst.f_blk) break;
-
-        x_lcu++;
-        if (x_lcu == ctx->fcst.w_blk)
-        {
-            x_lcu = 0;
-            y_lcu++;
-        }
     }
     pico_cur->sinfo.icnt[0] = intra_blk_cnt;
     pico_cur->sinfo.bi_fcost = (pico_cur->sinfo.bi_fcost * 10) / 12; /* weighting bi-cost */
@@ -1484,6 +1589,7 @@ void set_subpic(XEVE_CTX * ctx, XEVE_PICO* pico, int is_intra_pic)
     int gop_idx, gop_pos, pic_icnt = pico->pic_icnt;
     int gop_size = ctx->param.bframes + 1;
     pico->sinfo.scene_type = xeve_fcst_get_scene_type(ctx, pico);
+    pico->sinfo.mgop_size = gop_size;
 
     if (is_intra_pic)
     {
@@ -1529,12 +1635,12 @@ void get_fcost_fixed_gop(XEVE_CTX * ctx, int is_intra_pic)
     int           pico_ridx, pic_icnt;
     int        i, pic_icnt_last, depth, refp_l0, refp_l1, gop_size;
 
-    pic_icnt_last = ctx->pico->pic_icnt;
+    pic_icnt_last = ctx->fcst.pico->pic_icnt;
     gop_size = ctx->param.bframes + 1;
 
     if (ctx->param.gop_size == 1 && ctx->param.keyint != 1) //LD case
     {
-         pic_icnt = XEVE_MOD_IDX(ctx->pico->pic_icnt, ctx->pico_max_cnt);
+         pic_icnt = XEVE_MOD_IDX(ctx->fcst.pico->pic_icnt, ctx->pico_max_cnt);
          pico = ctx->pico_buf[pic_icnt];
          refp_l0 = pico->sinfo.ref_pic[REFP_0];
          pico_ridx = XEVE_MOD_IDX(pic_icnt - refp_l0, ctx->pico_max_cnt);
@@ -1572,7 +1678,7 @@ void get_fcost_fixed_gop(XEVE_CTX * ctx, int is_intra_pic)
                     pico_l1 = ctx->pico_buf[pico_ridx];
                     bi_direction_cost_estimation(ctx, pico, pico_l0, pico_l1);
 
-                    xeve_mset(pico->sinfo.map_mv_pga, 0, sizeof(s16) * ctx->f_lcu * REFP_NUM * MV_D);
+                    xeve_mset(pico->sinfo.map_mv_pga, 0, sizeof(s16) * ctx->fcst.f_blk * REFP_NUM * MV_D);
 
                     /* get PGA cost */
                     pico_ridx = XEVE_MOD_IDX(((pic_icnt - 1) / ctx->param.gop_size) * ctx->param.gop_size, ctx->pico_max_cnt);
@@ -1584,14 +1690,55 @@ void get_fcost_fixed_gop(XEVE_CTX * ctx, int is_intra_pic)
     }
 }
 
+static void set_scene_cut(XEVE_CTX * ctx, XEVE_PICO * pico)
+{
+    s64 cost_inter = pico->sinfo.uni_est_cost[INTER_UNI0];
+    s64 cost_intra = pico->sinfo.uni_est_cost[INTRA];
+
+    /* the anchor picture is hardly predicted from the previous anchor */
+    if (cost_inter * 100 >= cost_intra * (100 - ctx->param.scenecut))
+    {
+        pico->sinfo.slice_type = SLICE_I;
+        /* cutree does not propagate through an intra picture */
+        xeve_mset(pico->sinfo.map_pdir_bi, INTRA, sizeof(u8) * ctx->fcst.f_blk);
+    }
+}
+
+static void set_mgop_size(XEVE_CTX * ctx, XEVE_PICO * pico)
+{
+    XEVE_PICO * pico_a, * pico_h;
+    int         gop_size = ctx->param.gop_size;
+    int         mgop_size = gop_size;
+    s64         cost_mgop, cost_split;
+
+    /* the forecast GOP has the costs of the pictures at distance gop_size/2,
+       gop_size/4, ... from the previous GOP anchor. the mini-GOP is halved
+       while its anchor predicted from that far plus its middle picture as a
+       B picture costs more than both pictures as anchors half as far */
+    while (mgop_size > FCST_MGOP_MIN)
+    {
+        pico_a = ctx->pico_buf[XEVE_MOD_IDX(pico->pic_icnt - gop_size + mgop_size, ctx->pico_max_cnt)];
+        pico_h = ctx->pico_buf[XEVE_MOD_IDX(pico->pic_icnt - gop_size + (mgop_size >> 1), ctx->pico_max_cnt)];
+        cost_mgop = (s64)pico_a->sinfo.uni_est_cost[INTER_UNI0] + pico_h->sinfo.bi_fcost;
+        cost_split = (s64)pico_h->sinfo.uni_est_cost[INTER_UNI0] * 2;
+
+        if (cost_mgop <= cost_split)
+        {
+            break;
+        }
+        mgop_size >>= 1;
+    }
+    pico->sinfo.mgop_size = mgop_size;
+}
+
 int xeve_forecast_fixed_gop(XEVE_CTX* ctx)
 {
     XEVE_PICO * pico;
     int        i_period, is_intra_pic = 0;
     int        pic_icnt;
 
-    pico      = ctx->pico;
-    pic_icnt  = ctx->pico->pic_icnt;
+    pico      = ctx->fcst.pico;
+    pic_icnt  = pico->pic_icnt;
     i_period  = ctx->param.keyint;
     int gop_size = ctx->param.bframes + 1;
 
@@ -1606,6 +1753,15 @@ int xeve_forecast_fixed_gop(XEVE_CTX* ctx)
     if (((pic_icnt % gop_size == 0) && (pic_icnt != 0) && ctx->param.use_fcst) || gop_size == 1)
     {
         get_fcost_fixed_gop(ctx, is_intra_pic);
+
+        if (ctx->param.adaptive_gop != 0 && !is_intra_pic)
+        {
+            set_mgop_size(ctx, pico);
+        }
+        if (ctx->param.scenecut != 0 && !is_intra_pic)
+        {
+            set_scene_cut(ctx, pico);
+        }
     }
 
     if (ctx->param.aq_mode != 0)
@@ -1621,3 +1777,110 @@ int xeve_forecast_fixed_gop(XEVE_CTX* ctx)
     return XEVE_OK;
 }
 
+
+static int fcst_thread_entry(void * arg)
+{
+    return xeve_forecast_fixed_gop((XEVE_CTX *)arg);
+}
+
+int xeve_fcst_create(XEVE_CTX * ctx)
+{
+    XEVE_FCST * fcst = &ctx->fcst;
+    int         i, cnt = ctx->param.lookahead_threads;
+
+    fcst->thread_pool = (POOL_THREAD *)xeve_malloc(sizeof(POOL_THREAD) * cnt);
+    xeve_assert_rv(fcst->thread_pool != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(fcst->thread_pool, 0, sizeof(POOL_THREAD) * cnt);
+
+    /* lookahead threads follow the encoding threads */
+    for (i = 0; i < cnt; i++)
+    {
+        fcst->thread_pool[i] = ctx->tc->create(ctx->tc, ctx->param.threads + i);
+        xeve_assert_rv(fcst->thread_pool[i] != NULL, XEVE_ERR_UNKNOWN);
+    }
+
+    if (cnt > 1)
+    {
+        /* thread_pool[0] owns the scheduler of the block row workers */
+        fcst->sched = create_task_scheduler(ctx->tc, fcst->thread_pool, cnt);
+        xeve_assert_rv(fcst->sched != NULL, XEVE_ERR_UNKNOWN);
+        fcst->task = (THREAD_TASK *)xeve_malloc(sizeof(THREAD_TASK) * cnt);
+        xeve_assert_rv(fcst->task != NULL, XEVE_ERR_OUT_OF_MEMORY);
+        fcst->sync_wait = get_wait_object();
+        xeve_assert_rv(fcst->sync_wait != NULL, XEVE_ERR_UNKNOWN);
+        fcst->sync_row = (volatile s32 *)xeve_malloc(sizeof(s32) * fcst->h_blk);
+        xeve_assert_rv(fcst->sync_row != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    }
+    fcst->busy = 0;
+
+    return XEVE_OK;
+}
+
+void xeve_fcst_delete(XEVE_CTX * ctx)
+{
+    XEVE_FCST * fcst = &ctx->fcst;
+    int         i;
+
+    xeve_fcst_sync(ctx);
+
+    if (fcst->sched)
+    {
+        release_task_scheduler(&fcst->sched);
+    }
+    if (fcst->sync_wait)
+    {
+        release_wait_object(&fcst->sync_wait);
+    }
+    if (fcst->thread_pool)
+    {
+        for (i = 0; i < ctx->param.lookahead_threads; i++)
+        {
+            if (fcst->thread_pool[i])
+            {
+                ctx->tc->release(&fcst->thread_pool[i]);
+            }
+        }
+    }
+    xeve_mfree(fcst->thread_pool);
+    xeve_mfree(fcst->task);
+    xeve_mfree((void *)fcst->sync_row);
+    fcst->thread_pool = NULL;
+    fcst->task = NULL;
+    fcst->sync_row = NULL;
+}
+
+int xeve_fcst_run(XEVE_CTX * ctx)
+{
+    XEVE_FCST * fcst = &ctx->fcst;
+    int         ret;
+
+    ret = xeve_fcst_sync(ctx);
+    xeve_assert_rv(ret == XEVE_OK, ret);
+
+    fcst->pico = ctx->pico;
+
+    if (fcst->thread_pool == NULL)
+    {
+        return xeve_forecast_fixed_gop(ctx);
+    }
+
+    /* the encoder keeps one more input picture, so the analysis of the
+       last pushed picture is not used before the next xeve_fcst_sync() */
+    xeve_assert_rv(ctx->tc->run(fcst->thread_pool[0], fcst_thread_entry, (void *)ctx) == THREAD_SUCCESS, XEVE_ERR_UNKNOWN);
+    fcst->busy = 1;
+
+    return XEVE_OK;
+}
+
+int xeve_fcst_sync(XEVE_CTX * ctx)
+{
+    XEVE_FCST * fcst = &ctx->fcst;
+    int         res;
+
+    if (fcst->busy)
+    {
+        fcst->busy = 0;
+        xeve_assert_rv(ctx->tc->join(fcst->thread_pool[0], &res) == THREAD_SUCCESS, XEVE_ERR_UNKNOWN);
+    }
+    return XEVE_OK;
+}
@@ -91,6 +91,14 @@ enum QPA_TYPE
 /* complexity threthold */
 
 int  xeve_forecast_fixed_gop(XEVE_CTX* ctx);
+/* lookahead stage, runs xeve_forecast_fixed_gop() on its own threads
+   when param.lookahead_threads is set */
+int  xeve_fcst_create(XEVE_CTX * ctx);
+void xeve_fcst_delete(XEVE_CTX * ctx);
+/* analyse the last pushed picture */
+int  xeve_fcst_run(XEVE_CTX * ctx);
+/* wait for the running analysis */
+int  xeve_fcst_sync(XEVE_CTX * ctx);
 void xeve_gen_subpic(pel* src_y, pel* dst_y, int w, int h, int s_s, int d_s, int bit_depth);
 s32  xeve_fcst_get_scene_type(XEVE_CTX * ctx, XEVE_PICO * pico);
 
@@ -142,24 +142,19 @@ static void ipred_dc(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *d
 
 static void ipred_ul(pel *src_le, pel *src_up, pel * src_ri, u16 avail_lr, pel *dst, int w, int h)
 {
-    int i, j;
-    for (i = 0; i<h; i++)
+    pel diag[MAX_CU_SIZE * 2];
+    int i;
+
+    /* samples along the diagonal, diag[h - 1 + j - i] is the one of (j, i) */
+    for (i = 0; i < h - 1; i++)
     {
-        for (j = 0; j<w; j++)
-        {
-            int diag = i - j;
-            if (diag > 0) {
-                dst[j] = src_le[diag - 1];
-            }
-            else if (diag == 0)
-            {
-                dst[j] = src_up[-1];
-            }
-            else
-            {
-                dst[j] = src_up[-diag - 1];
-            }
-        }
+        diag[i] = src_le[h - 2 - i];
+    }
+    xeve_mcpy(diag + h - 1, src_up - 1, w * sizeof(pel));
+
+    for (i = 0; i < h; i++)
+    {
+        xeve_mcpy(dst, diag + h - 1 - i, w * sizeof(pel));
         dst += w;
     }
 }
@@ -455,8 +455,8 @@ const XEVE_ITXB xeve_tbl_itxb[MAX_TR_LOG2] =
 static void xeve_itrans(XEVE_CTX * ctx, s16 *coef, int log2_cuw, int log2_cuh, int bit_depth)
 {
     s32 tb[MAX_TR_DIM]; /* temp buffer */
-    (*ctx->fn_itxb)[log2_cuh - 1](coef, tb, 0, 1 << log2_cuw, 0);
-    (*ctx->fn_itxb)[log2_cuw - 1](tb, coef, (ITX_SHIFT1 + ITX_SHIFT2(bit_depth)), 1 << log2_cuh, 1);
+    (*ctx->func->itxb)[log2_cuh - 1](coef, tb, 0, 1 << log2_cuw, 0);
+    (*ctx->func->itxb)[log2_cuw - 1](tb, coef, (ITX_SHIFT1 + ITX_SHIFT2(bit_depth)), 1 << log2_cuh, 1);
 }
 
 static void xeve_dquant(s16 *coef, int log2_w, int log2_h, int scale, s32 offset, u8 shift)
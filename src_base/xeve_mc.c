@@ -31,10 +31,6 @@
 #include "xeve_def.h"
 #include <assert.h>
 
-const XEVE_MC_L (*xeve_func_mc_l)[2];
-const XEVE_MC_C (*xeve_func_mc_c)[2];
-XEVE_AVG_NO_CLIP xeve_func_average_no_clip;
-
 const s16 xeve_tbl_mc_l_coeff[16][8] =
 {
     {  0, 0,   0, 64,  0,   0,  0,  0 },
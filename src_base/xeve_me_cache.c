@@ -0,0 +1,124 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+/* best MVs are kept for the 8x8 blocks of the CTU */
+#define MEC_LOG2_BLK                3
+#define MEC_GRID                    (MAX_CU_SIZE >> MEC_LOG2_BLK)
+#define MEC_BLK_NUM                 (MEC_GRID * MEC_GRID)
+#define MEC_REF_NUM                 (REFP_NUM * XEVE_MAX_NUM_ACTIVE_REF_FRAME)
+
+struct _XEVE_ME_CACHE
+{
+    /* CTU which the MVs have been set in, older ones are not valid */
+    u32                 stamp;
+    /* top-left luma position of the CTU */
+    int                 x_lcu;
+    int                 y_lcu;
+    /* best integer MV of the last search over each 8x8 block */
+    s16                 mv[MEC_REF_NUM][MEC_BLK_NUM][MV_D];
+    u32                 mv_stamp[MEC_REF_NUM][MEC_BLK_NUM];
+};
+
+XEVE_ME_CACHE * xeve_me_cache_create(void)
+{
+    XEVE_ME_CACHE * mc;
+
+    mc = (XEVE_ME_CACHE *)xeve_malloc(sizeof(XEVE_ME_CACHE));
+    xeve_assert_rv(mc, NULL);
+    xeve_mset(mc, 0, sizeof(XEVE_ME_CACHE));
+
+    return mc;
+}
+
+void xeve_me_cache_delete(XEVE_ME_CACHE * mc)
+{
+    if(mc)
+    {
+        xeve_mfree(mc);
+    }
+}
+
+void xeve_me_cache_init_lcu(XEVE_ME_CACHE * mc, int x_lcu_pel, int y_lcu_pel)
+{
+    /* a new stamp invalidates every MV, they are only cleared when it wraps around */
+    mc->stamp++;
+    if(mc->stamp == 0)
+    {
+        xeve_mset(mc->mv_stamp, 0, sizeof(mc->mv_stamp));
+        mc->stamp = 1;
+    }
+    mc->x_lcu = x_lcu_pel;
+    mc->y_lcu = y_lcu_pel;
+}
+
+void xeve_me_cache_set_mv(XEVE_ME_CACHE * mc, int x, int y, int log2_cuw, int log2_cuh, int lidx, int refi, s16 mv[MV_D])
+{
+    int ref = lidx * XEVE_MAX_NUM_ACTIVE_REF_FRAME + refi;
+    int x0 = (x - mc->x_lcu) >> MEC_LOG2_BLK;
+    int y0 = (y - mc->y_lcu) >> MEC_LOG2_BLK;
+    int x1 = XEVE_MIN(MEC_GRID, (x - mc->x_lcu + (1 << log2_cuw) + (1 << MEC_LOG2_BLK) - 1) >> MEC_LOG2_BLK);
+    int y1 = XEVE_MIN(MEC_GRID, (y - mc->y_lcu + (1 << log2_cuh) + (1 << MEC_LOG2_BLK) - 1) >> MEC_LOG2_BLK);
+    int i, j, idx;
+
+    for(j = XEVE_MAX(0, y0); j < y1; j++)
+    {
+        for(i = XEVE_MAX(0, x0); i < x1; i++)
+        {
+            idx = j * MEC_GRID + i;
+            mc->mv[ref][idx][MV_X] = mv[MV_X];
+            mc->mv[ref][idx][MV_Y] = mv[MV_Y];
+            mc->mv_stamp[ref][idx] = mc->stamp;
+        }
+    }
+}
+
+int xeve_me_cache_get_mv(XEVE_ME_CACHE * mc, int x, int y, int log2_cuw, int log2_cuh, int lidx, int refi, s16 mv[MV_D])
+{
+    int ref = lidx * XEVE_MAX_NUM_ACTIVE_REF_FRAME + refi;
+    int bx = (x - mc->x_lcu + (1 << (log2_cuw - 1))) >> MEC_LOG2_BLK;
+    int by = (y - mc->y_lcu + (1 << (log2_cuh - 1))) >> MEC_LOG2_BLK;
+    int idx = by * MEC_GRID + bx;
+
+    /* the block at the center of the CU */
+    if(bx < 0 || by < 0 || bx >= MEC_GRID || by >= MEC_GRID || mc->mv_stamp[ref][idx] != mc->stamp)
+    {
+        return 0;
+    }
+    mv[MV_X] = mc->mv[ref][idx][MV_X];
+    mv[MV_Y] = mc->mv[ref][idx][MV_Y];
+    return 1;
+}
@@ -0,0 +1,51 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _XEVE_ME_CACHE_H_
+#define _XEVE_ME_CACHE_H_
+
+#include "xeve_type.h"
+
+/* motion search cache of a CTU, shared by all of the CU shapes searched in it.
+   it keeps the best integer MV of the last search over every 8x8 block of the
+   CTU for each reference, which seeds the searches of the following CU shapes */
+
+XEVE_ME_CACHE * xeve_me_cache_create(void);
+void xeve_me_cache_delete(XEVE_ME_CACHE * mc);
+void xeve_me_cache_init_lcu(XEVE_ME_CACHE * mc, int x_lcu_pel, int y_lcu_pel);
+void xeve_me_cache_set_mv(XEVE_ME_CACHE * mc, int x, int y, int log2_cuw, int log2_cuh, int lidx, int refi, s16 mv[MV_D]);
+int  xeve_me_cache_get_mv(XEVE_ME_CACHE * mc, int x, int y, int log2_cuw, int log2_cuh, int lidx, int refi, s16 mv[MV_D]);
+
+#endif /* _XEVE_ME_CACHE_H_ */
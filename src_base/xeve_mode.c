@@ -667,6 +667,7 @@ void get_min_max_qp(XEVE_CTX * ctx, XEVE_CORE *core, s8 * min_qp, s8 * max_qp, i
     u8  min_dqp, max_dqp;
     u16 x_scu = PEL2SCU(x0);
     u16 y_scu = PEL2SCU(y0);
+    u8  qp_row = ctx->tile[core->tile_idx].qp + core->dqp_row;
 
     *is_dqp_set = 0;
     if (!ctx->pps.cu_qp_delta_enabled_flag)
@@ -680,13 +681,13 @@ void get_min_max_qp(XEVE_CTX * ctx, XEVE_CORE *core, s8 * min_qp, s8 * max_qp, i
         {
 
             dqp = get_averaged_qp(ctx->map_dqp_lah, x_scu, y_scu, ctx->w_scu, ctx->h_scu, cuw, cuh);
-            qp0 = ctx->tile[core->tile_idx].qp;
+            qp0 = qp_row;
             max_dqp = min_dqp = qp0 + dqp;
         }
         else
         {
-            min_dqp = ctx->tile[core->tile_idx].qp;
-            max_dqp = ctx->tile[core->tile_idx].qp + ctx->sh->dqp;
+            min_dqp = qp_row;
+            max_dqp = qp_row + ctx->sh->dqp;
         }
 
         if (!(ctx->sps.dquant_flag))
@@ -1670,8 +1671,6 @@ void calc_delta_dist_filter_boundary(XEVE_CTX* ctx, XEVE_PIC *pic_rec, XEVE_PIC
     /********************************* filter the pred/rec **************************************/
     if(do_filter)
     {
-        pic_dbk->pic_deblock_alpha_offset = ctx->param.deblock_alpha_offset;
-        pic_dbk->pic_deblock_beta_offset = ctx->param.deblock_beta_offset;
         int w_scu = cuw >> MIN_CU_LOG2;
         int h_scu = cuh >> MIN_CU_LOG2;
         int ind, k;
@@ -1886,7 +1885,7 @@ static double mode_coding_tree(XEVE_CTX *ctx, XEVE_CORE *core, int x0, int y0, i
         check_min_cu = ctx->param.min_cu_inter;
     }
 
-    set_lambda(ctx, core, ctx->sh, ctx->tile[core->tile_idx].qp);
+    set_lambda(ctx, core, ctx->sh, ctx->tile[core->tile_idx].qp + core->dqp_row);
 
     core->tree_cons = tree_cons;
     core->avail_lr = avail_lr;
@@ -2342,7 +2341,7 @@ static int mode_analyze_lcu(XEVE_CTX *ctx, XEVE_CORE *core)
     xeve_mset(mi->mvd, 0, sizeof(s16) * REFP_NUM * MV_D);
 
     /* decide mode */
-    mode_coding_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->log2_max_cuwh, ctx->log2_max_cuwh, 0, mi, 1, ctx->tile[core->tile_idx].qp, xeve_get_default_tree_cons() );
+    mode_coding_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->log2_max_cuwh, ctx->log2_max_cuwh, 0, mi, 1, ctx->tile[core->tile_idx].qp + core->dqp_row, xeve_get_default_tree_cons() );
 
 #if TRACE_ENC_CU_DATA_CHECK
     h = w = 1 << (ctx->log2_max_cuwh - MIN_CU_LOG2);
@@ -2445,66 +2444,31 @@ int xeve_mode_create(XEVE_CTX *ctx, int complexity)
  * picture buffer alloc/free/expand
  ******************************************************************************/
 
-static void picbuf_expand(pel *a, int s, int w, int h, int exp)
+void xeve_pic_expand(XEVE_CTX *ctx, XEVE_PIC *pic)
 {
-    int i, j;
-    pel pixel;
-    pel *src, *dst;
-
-    /* left */
-    src = a;
-    dst = a - exp;
-
-    for(i = 0; i < h; i++)
-    {
-        pixel = *src; /* get boundary pixel */
-        for(j = 0; j < exp; j++)
-        {
-            dst[j] = pixel;
-        }
-        dst += s;
-        src += s;
-    }
-
-    /* right */
-    src = a + (w - 1);
-    dst = a + w;
-
-    for(i = 0; i < h; i++)
-    {
-        pixel = *src; /* get boundary pixel */
-        for(j = 0; j < exp; j++)
-        {
-            dst[j] = pixel;
-        }
-        dst += s;
-        src += s;
-    }
-
-    /* upper */
-    src = a - exp;
-    dst = a - exp - (exp * s);
-
-    for(i = 0; i < exp; i++)
-    {
-        xeve_mcpy(dst, src, s*sizeof(pel));
-        dst += s;
-    }
+    xeve_picbuf_expand(pic, pic->pad_l, pic->pad_c, ctx->sps.chroma_format_idc);
+}
 
-    /* below */
-    src = a + ((h - 1)*s) - exp;
-    dst = a + ((h - 1)*s) - exp + s;
+void xeve_pic_expand_lcu_row(XEVE_CTX *ctx, XEVE_PIC *pic, int y_lcu)
+{
+    xeve_picbuf_expand_rows(pic, y_lcu << ctx->log2_max_cuwh, ctx->max_cuwh, pic->pad_l, pic->pad_c, ctx->sps.chroma_format_idc);
+}
 
-    for(i = 0; i < exp; i++)
+/* sub-pel planes are only built for pictures which are referenced later */
+void xeve_pic_spel_build(XEVE_CTX *ctx, XEVE_PIC *pic)
+{
+    if(ctx->slice_ref_flag)
     {
-        xeve_mcpy(dst, src, s*sizeof(pel));
-        dst += s;
+        xeve_picbuf_spel_build(pic, 0, pic->h_l, ctx->pinter[0].mc_l_coeff, ctx->sps.bit_depth_luma_minus8 + 8);
     }
 }
 
-void xeve_pic_expand(XEVE_CTX *ctx, XEVE_PIC *pic)
+void xeve_pic_spel_build_lcu_row(XEVE_CTX *ctx, XEVE_PIC *pic, int y_lcu)
 {
-    xeve_picbuf_expand(pic, pic->pad_l, pic->pad_c, ctx->sps.chroma_format_idc);
+    if(ctx->slice_ref_flag)
+    {
+        xeve_picbuf_spel_build(pic, y_lcu << ctx->log2_max_cuwh, ctx->max_cuwh, ctx->pinter[0].mc_l_coeff, ctx->sps.bit_depth_luma_minus8 + 8);
+    }
 }
 
 XEVE_PIC * xeve_pic_alloc(PICBUF_ALLOCATOR * pa, int * ret)
@@ -32,6 +32,9 @@
 #define _XEVE_MODE_H_
 
 void       xeve_pic_expand(XEVE_CTX *ctx, XEVE_PIC *pic);
+void       xeve_pic_expand_lcu_row(XEVE_CTX *ctx, XEVE_PIC *pic, int y_lcu);
+void       xeve_pic_spel_build(XEVE_CTX *ctx, XEVE_PIC *pic);
+void       xeve_pic_spel_build_lcu_row(XEVE_CTX *ctx, XEVE_PIC *pic, int y_lcu);
 XEVE_PIC * xeve_pic_alloc(PICBUF_ALLOCATOR *pa, int *ret);
 void       xeve_pic_free(PICBUF_ALLOCATOR *pa, XEVE_PIC *pic);
 
@@ -78,9 +78,20 @@ static const XEVE_PARAM_METADATA xeve_params_metadata[] = {
     SET_XEVE_PARAM_METADATA( bframes,                                   DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( aq_mode,                                   DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( lookahead,                                 DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( lookahead_threads,                         DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( scenecut,                                  DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( adaptive_gop,                              DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( closed_gop,                                DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( use_annexb,                                DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( use_filler,                                DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( zero_copy,                                 DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( pass,                                      DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( stats,                                     DT_STRING ),
+    SET_XEVE_PARAM_METADATA( row_vbv,                                   DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( isa,                                       DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( me_spel_plane,                             DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( me_cache,                                  DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( early_skip,                                DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( chroma_qp_table_present_flag,              DT_INTEGER ),
 
     SET_XEVE_PARAM_METADATA( chroma_qp_num_points_in_table,             DT_STRING ),
@@ -552,23 +552,44 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2
     return cost_best;
 }
 
+/* returns the luma prediction of a cuw x cuh block at the quarter-pel position
+   (mv_x, mv_y) of the reference picture. it is read from the sub-pel planes of
+   the picture when they cover the block, otherwise it is interpolated */
+pel * xeve_pinter_spel_pred(XEVE_PINTER *pi, XEVE_PIC *ref_pic, int mv_x, int mv_y, int cuw, int cuh, int *s_pred, int bit_depth_luma)
+{
+    int   phase = ((mv_y & 3) << 2) | (mv_x & 3);
+    int   x = mv_x >> 2;
+    int   y = mv_y >> 2;
+    int   lo = SPEL_PLANE_MARGIN - ref_pic->pad_l;
+    pel * plane = phase ? ref_pic->spel[phase] : ref_pic->y;
+
+    if(plane != NULL && x >= lo && y >= lo && x + cuw <= ref_pic->w_l - lo && y + cuh <= ref_pic->h_l - lo)
+    {
+        *s_pred = ref_pic->s_l;
+        return plane + y * ref_pic->s_l + x;
+    }
+
+    xeve_mc_l((mv_x << 2), (mv_y << 2), ref_pic->y, (mv_x << 2), (mv_y << 2), ref_pic->s_l, cuw, pi->pred_buf, cuw, cuh, bit_depth_luma, pi->mc_l_coeff);
+    *s_pred = cuw;
+    return pi->pred_buf;
+}
+
 static u32 me_spel_pattern(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx, s16 gmvp[MV_D], s16 mvi[MV_D], s16 mv[MV_D], int bi, int bit_depth_luma)
 {
-    pel     *org, *ref, *pred;
+    pel     *org, *pred;
+    XEVE_PIC *ref_pic;
     s16     *org_bi;
     u32      cost, cost_best = XEVE_UINT32_MAX;
     s16      mv_x, mv_y, cx, cy;
     int      lidx_r = (lidx == REFP_0) ? REFP_1 : REFP_0;
-    int      i, mv_bits, cuw, cuh, s_org, s_ref, best_mv_bits;
+    int      i, mv_bits, cuw, cuh, s_org, s_pred, best_mv_bits;
 
     s_org = pi->s_o[Y_C];
     org = pi->o[Y_C] + x + y * pi->s_o[Y_C];
-    s_ref = pi->refp[refi][lidx].pic->s_l;
-    ref = pi->refp[refi][lidx].pic->y;
+    ref_pic = pi->refp[refi][lidx].pic;
     cuw = 1 << log2_cuw;
     cuh = 1 << log2_cuh;
     org_bi = pi->org_bi;
-    pred = pi->pred_buf;
     best_mv_bits = 0;
 
     /* make MV to be global coordinate */
@@ -598,17 +619,17 @@ static u32 me_spel_pattern(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2
         cost = MV_COST(pi, mv_bits);
 
         /* get the interpolated(predicted) image */
-        xeve_mc_l((mv_x << 2), (mv_y << 2), ref, (mv_x << 2), (mv_y << 2), s_ref, cuw, pred, cuw, cuh, bit_depth_luma, pi->mc_l_coeff);
+        pred = xeve_pinter_spel_pred(pi, ref_pic, mv_x, mv_y, cuw, cuh, &s_pred, bit_depth_luma);
 
         if(bi)
         {
             /* get sad */
-            cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+            cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, s_pred, bit_depth_luma);
         }
         else
         {
             /* get sad */
-            cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+            cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, s_pred, bit_depth_luma);
         }
 
         /* check if motion cost_best is less than minimum cost_best */
@@ -645,17 +666,17 @@ static u32 me_spel_pattern(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2
             cost = MV_COST(pi, mv_bits);
 
             /* get the interpolated(predicted) image */
-            xeve_mc_l((mv_x << 2), (mv_y << 2), ref, (mv_x << 2), (mv_y << 2), s_ref, cuw, pred, cuw, cuh, bit_depth_luma, pi->mc_l_coeff);
+            pred = xeve_pinter_spel_pred(pi, ref_pic, mv_x, mv_y, cuw, cuh, &s_pred, bit_depth_luma);
 
             if(bi)
             {
                 /* get sad */
-                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, s_pred, bit_depth_luma);
             }
             else
             {
                 /* get sad */
-                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, s_pred, bit_depth_luma);
             }
 
             /* check if motion cost_best is less than minimum cost_best */
@@ -684,6 +705,9 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
     s16 range[MV_RANGE_DIM][MV_D]; /* search range after clipping */
     s16 mvi[MV_D];
     s16 mvt[MV_D];
+    s16 mvs[MV_D]; /* MV seed from the motion search cache */
+    int seeded = 0;
+    s16 range_s[MV_RANGE_DIM][MV_D];
     u32 cost, cost_best = XEVE_UINT32_MAX;
     s8 ri = 0;  /* reference buffer index */
     int tmpstep = 0;
@@ -714,7 +738,15 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
 
     get_range_ipel(pi, mvc, range, (bi != BI_NORMAL) ? 0 : 1, ri, lidx);
 
-    cost = me_ipel_diamond(pi, x, y, log2_cuw, log2_cuh, ri, lidx, range, gmvp, mvi, mvt, bi, &tmpstep, MAX_FIRST_SEARCH_STEP, bit_depth_luma);
+    /* a search of another CU shape over this area has left its best MV, which
+       is searched around as well. the search from the MV predictor then
+       stops as early as a refinement */
+    if(pi->me_cache && bi == BI_NON && xeve_me_cache_get_mv(pi->me_cache, x, y, log2_cuw, log2_cuh, lidx, ri, mvs))
+    {
+        seeded = 1;
+    }
+
+    cost = me_ipel_diamond(pi, x, y, log2_cuw, log2_cuh, ri, lidx, range, gmvp, mvi, mvt, bi, &tmpstep, seeded ? MAX_REFINE_SEARCH_STEP : MAX_FIRST_SEARCH_STEP, bit_depth_luma);
     if(cost < cost_best)
     {
         cost_best = cost;
@@ -730,6 +762,33 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
         }
     }
 
+    /* search around the seed, unless the search from the MV predictor has
+       already come close to it */
+    if(seeded && (abs(mvs[MV_X] - mv[MV_X]) > (2 << 2) || abs(mvs[MV_Y] - mv[MV_Y]) > (2 << 2)))
+    {
+        mvi[MV_X] = mvs[MV_X] + (x << 2);
+        mvi[MV_Y] = mvs[MV_Y] + (y << 2);
+        mvc[MV_X] = XEVE_CLIP3(pi->min_clip[MV_X], pi->max_clip[MV_X], x + (mvs[MV_X] >> 2));
+        mvc[MV_Y] = XEVE_CLIP3(pi->min_clip[MV_Y], pi->max_clip[MV_Y], y + (mvs[MV_Y] >> 2));
+
+        get_range_ipel(pi, mvc, range_s, 0, ri, lidx);
+        cost = me_ipel_diamond(pi, x, y, log2_cuw, log2_cuh, ri, lidx, range_s, gmvp, mvi, mvt, bi, &tmpstep, MAX_REFINE_SEARCH_STEP, bit_depth_luma);
+        if(cost < cost_best)
+        {
+            cost_best = cost;
+            mv[MV_X] = mvt[MV_X];
+            mv[MV_Y] = mvt[MV_Y];
+            if(abs(mvp[MV_X] - mv[MV_X]) < 2 && abs(mvp[MV_Y] - mv[MV_Y]) < 2)
+            {
+                beststep = 0;
+            }
+            else
+            {
+                beststep = tmpstep;
+            }
+        }
+    }
+
     if(bi == BI_NON && beststep > RASTER_SEARCH_THD  && pi->me_complexity > 1)
     {
         cost = me_raster(pi, x, y, log2_cuw, log2_cuh, ri, lidx, range, gmvp, mvt, bit_depth_luma);
@@ -775,6 +834,11 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
         }
     }
 
+    if(pi->me_cache && bi == BI_NON)
+    {
+        xeve_me_cache_set_mv(pi->me_cache, x, y, log2_cuw, log2_cuh, lidx, ri, mv);
+    }
+
     if(pi->me_level > ME_LEV_IPEL)
     {
         /* sub-pel ME */
@@ -1371,6 +1435,14 @@ static double xeve_analyze_skip(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, in
         }
     }
 
+    pi->early_skip = 0;
+    if(ctx->param.early_skip && cost_best < MAX_COST)
+    {
+        xeve_diff_pred(x, y, log2_cuw, log2_cuh, pi->pic_o, pi->pred[PRED_SKIP][0], pi->resi
+                     , ctx->sps.bit_depth_luma_minus8 + 8, ctx->sps.bit_depth_chroma_minus8 + 8, ctx->sps.chroma_format_idc);
+        pi->early_skip = ctx->fn_tq_zero(ctx, core, pi->resi, log2_cuw, log2_cuh, pi->slice_type);
+    }
+
     return cost_best;
 }
 
@@ -1593,6 +1665,11 @@ int xeve_pinter_init_lcu(XEVE_CTX *ctx, XEVE_CORE *core)
     pi->poc       = ctx->poc.poc_val;
     pi->gop_size  = ctx->param.gop_size;
 
+    if(pi->me_cache)
+    {
+        xeve_me_cache_init_lcu(pi->me_cache, core->x_lcu << ctx->log2_max_cuwh, core->y_lcu << ctx->log2_max_cuwh);
+    }
+
     return XEVE_OK;
 }
 
@@ -1700,7 +1777,8 @@ double xeve_pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int
         xeve_mcpy(pi->nnz_sub_best[PRED_SKIP], core->nnz_sub, sizeof(int) * N_C * MAX_SUB_TB_NUM);
     }
 
-    if (core->cu_mode == MODE_SKIP && pi->best_ssd >
+    /* keep a SKIP whose residual quantises to zero without trying the other modes */
+    if (core->cu_mode == MODE_SKIP && !pi->early_skip && pi->best_ssd >
         ((s64)1 << (log2_cuw + log2_cuh + ctx->sps.bit_depth_luma_minus8 + ctx->sps.bit_depth_luma_minus8)) * ctx->param.skip_th)
     {
         if(pi->slice_type == SLICE_B)
@@ -1911,6 +1989,11 @@ int xeve_pinter_create(XEVE_CTX *ctx, int complexity)
         pi->max_clip[MV_Y] = ctx->param.h - 1;
         pi->mc_l_coeff = xeve_tbl_mc_l_coeff;
         pi->mc_c_coeff = xeve_tbl_mc_c_coeff;
+        if(ctx->param.me_cache && pi->me_cache == NULL)
+        {
+            pi->me_cache = xeve_me_cache_create();
+            xeve_assert_rv(pi->me_cache != NULL, XEVE_ERR_OUT_OF_MEMORY);
+        }
     }
 
     return ctx->fn_pinter_set_complexity(ctx, complexity);
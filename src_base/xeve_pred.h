@@ -41,6 +41,7 @@ int xeve_pintra_analyze_lcu(XEVE_CTX * ctx, XEVE_CORE * core);
 double xeve_pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log2_cuw, int log2_cuh, XEVE_MODE *mi, s16 coef[N_C][MAX_CU_DIM], pel *rec[N_C], int s_rec[N_C]);
 double xeve_pintra_analyze_cu_simple(XEVE_CTX* ctx, XEVE_CORE* core, int x, int y, int log2_cuw, int log2_cuh, s16 coef[N_C][MAX_CU_DIM]);
 int    xeve_pinter_init_lcu(XEVE_CTX *ctx, XEVE_CORE *core);
+pel *  xeve_pinter_spel_pred(XEVE_PINTER *pi, XEVE_PIC *ref_pic, int mv_x, int mv_y, int cuw, int cuh, int *s_pred, int bit_depth_luma);
 
 /* Inter prediction */
 extern const XEVE_PRED_INTER_COMP tbl_inter_pred_comp[2];
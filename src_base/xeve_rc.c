@@ -31,6 +31,7 @@
 #include "xeve_type.h"
 #include "xeve_rc.h"
 #include "xeve_fcst.h"
+#include "xeve_eco.h"
 #include <math.h>
 
 #define XEVE_VBV_MSEC_DEFAULT 2000 /* msec */
@@ -100,6 +101,157 @@ __inline static double qf_to_qp(double qf)
     return 21.0 + 4.2 * log(qf / 0.85) * 2.88538;
 }
 
+__inline static int rc_stats_class(int stype, int sdepth)
+{
+    return (stype != SLICE_B) ? stype : SLICE_I + sdepth;
+}
+
+/* allocate qp of the second pass with the global scale k and return the
+   estimated bits of the sequence (bits of a picture are inversely
+   proportional to its qf as in the bit estimator) */
+static double rc_stats_plan_bits(XEVE_CTX * ctx, double * t_cls, double k)
+{
+    XEVE_RC      * rc = ctx->rc;
+    XEVE_RC_STAT * st;
+    double         bits = 0, qf, cpx, qp;
+
+    for (int i = 0; i < rc->stats_cnt; i++)
+    {
+        st = rc->stats + i;
+        if (st->stype < 0)
+        {
+            continue;
+        }
+        qf  = qp_to_qf(st->qp);
+        cpx = XEVE_MAX(st->bits * qf, 1.0);
+        qp  = qf_to_qp(k * t_cls[rc_stats_class(st->stype, st->sdepth)] * pow(cpx, rc->param->pow_cplx));
+        qp  = XEVE_CLIP3(10, 49, qp);
+        qp  = XEVE_CLIP3(ctx->param.qp_min, ctx->param.qp_max, qp);
+        st->qp_plan = qp;
+        bits += st->bits * qf / qp_to_qf(qp);
+    }
+    return bits;
+}
+
+/* qf of every picture is k * t_cls * cpx^pow_cplx, where cpx is the bits*qf
+   product of the first pass and t_cls keeps the I/P/B depth balance the first
+   pass settled on. k is searched so that the sequence meets the target bits. */
+static void rc_stats_plan(XEVE_CTX * ctx)
+{
+    XEVE_RC      * rc = ctx->rc;
+    XEVE_RC_STAT * st;
+    double         t_cls[RC_NUM_SLICE_TYPE], n_cls[RC_NUM_SLICE_TYPE];
+    double         qf, target, lo = -16.0, hi = 16.0, k;
+    int            i, c, cnt = 0;
+
+    for (c = 0; c < RC_NUM_SLICE_TYPE; c++)
+    {
+        t_cls[c] = 0;
+        n_cls[c] = 0;
+    }
+    for (i = 0; i < rc->stats_cnt; i++)
+    {
+        st = rc->stats + i;
+        if (st->stype < 0)
+        {
+            continue;
+        }
+        c  = rc_stats_class(st->stype, st->sdepth);
+        qf = qp_to_qf(st->qp);
+        t_cls[c] += log(qf) - rc->param->pow_cplx * log(XEVE_MAX(st->bits * qf, 1.0));
+        n_cls[c]++;
+        cnt++;
+    }
+    for (c = 0; c < RC_NUM_SLICE_TYPE; c++)
+    {
+        t_cls[c] = (n_cls[c] > 0) ? exp(t_cls[c] / n_cls[c]) : 1.0;
+    }
+
+    target = rc->bitrate * cnt / rc->fps;
+    for (i = 0; i < 64; i++)
+    {
+        k = (lo + hi) / 2;
+        if (rc_stats_plan_bits(ctx, t_cls, pow(2.0, k)) > target)
+        {
+            lo = k;
+        }
+        else
+        {
+            hi = k;
+        }
+    }
+    rc_stats_plan_bits(ctx, t_cls, pow(2.0, hi));
+}
+
+static int rc_stats_read(XEVE_CTX * ctx)
+{
+    XEVE_RC      * rc = ctx->rc;
+    XEVE_RC_STAT * st;
+    char           line[256];
+    int            w, h, fps, keyint, bframes;
+    int            idx, stype, sdepth, cpx, cnt, i;
+    double         qp, bits;
+
+    rc->stats_fp = fopen(ctx->param.stats, "r");
+    xeve_assert_rv(rc->stats_fp != NULL, XEVE_ERR_INVALID_ARGUMENT);
+
+    /* the second pass has to code the same pictures with the same GOP structure */
+    if (fgets(line, sizeof(line), rc->stats_fp) == NULL ||
+        sscanf(line, "#xeve w:%d h:%d fps:%d keyint:%d bframes:%d", &w, &h, &fps, &keyint, &bframes) != 5 ||
+        w != ctx->param.w || h != ctx->param.h || fps != ctx->param.fps ||
+        keyint != ctx->param.keyint || bframes != ctx->param.bframes)
+    {
+        xeve_trace("stats file does not match the current encoding parameters\n");
+        return XEVE_ERR_INVALID_ARGUMENT;
+    }
+
+    /* pictures are written in coding order, they are kept in input order */
+    cnt = 0;
+    while (fgets(line, sizeof(line), rc->stats_fp) != NULL)
+    {
+        if (sscanf(line, "in:%d", &idx) == 1 && idx >= 0)
+        {
+            cnt = XEVE_MAX(cnt, idx + 1);
+        }
+    }
+    xeve_assert_rv(cnt > 0, XEVE_ERR_INVALID_ARGUMENT);
+
+    rc->stats = (XEVE_RC_STAT *)xeve_malloc(sizeof(XEVE_RC_STAT) * cnt);
+    xeve_assert_rv(rc->stats != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(rc->stats, 0, sizeof(XEVE_RC_STAT) * cnt);
+    for (i = 0; i < cnt; i++)
+    {
+        rc->stats[i].stype = -1;
+    }
+    rc->stats_cnt = cnt;
+
+    rewind(rc->stats_fp);
+    if (fgets(line, sizeof(line), rc->stats_fp) == NULL)
+    {
+        return XEVE_ERR_UNEXPECTED;
+    }
+    while (fgets(line, sizeof(line), rc->stats_fp) != NULL)
+    {
+        if (sscanf(line, "in:%d type:%d depth:%d qp:%lf bits:%lf cpx:%d", &idx, &stype, &sdepth, &qp, &bits, &cpx) != 6 ||
+            idx < 0 || idx >= cnt || stype < SLICE_B || stype > SLICE_I || sdepth < 0 || SLICE_I + sdepth >= RC_NUM_SLICE_TYPE)
+        {
+            continue;
+        }
+        st = rc->stats + idx;
+        st->stype   = stype;
+        st->sdepth  = sdepth;
+        st->qp      = qp;
+        st->bits    = bits;
+        st->cpx_frm = cpx;
+    }
+    fclose(rc->stats_fp);
+    rc->stats_fp = NULL;
+
+    rc_stats_plan(ctx);
+
+    return XEVE_OK;
+}
+
 int xeve_rc_create(XEVE_CTX * ctx)
 {
     /* create RC */
@@ -114,16 +266,42 @@ int xeve_rc_create(XEVE_CTX * ctx)
     xeve_mset(ctx->rcore, 0, sizeof(XEVE_RCORE));
     xeve_rc_rcore_set(ctx);
 
-    const XEVE_RC_PARAM *rc_param = ctx->rc->param;
-    ctx->rcore->pred = xeve_malloc(sizeof(pel) * rc_param->rc_blk_wh * rc_param->rc_blk_wh);
-    xeve_mset(ctx->rcore->pred, 0, sizeof(pel) * rc_param->rc_blk_wh * rc_param->rc_blk_wh);
+    if (ctx->param.row_vbv)
+    {
+        ctx->rcore->ctu_plan = xeve_malloc(sizeof(double) * ctx->f_lcu);
+        ctx->rcore->ctu_bits = xeve_malloc(sizeof(s32) * ctx->f_lcu);
+        ctx->rcore->ctu_dqp = xeve_malloc(sizeof(s8) * ctx->f_lcu);
+        ctx->rcore->row_dqp = xeve_malloc(sizeof(s8) * ctx->h_lcu);
+        xeve_assert_rv(ctx->rcore->ctu_plan != NULL && ctx->rcore->ctu_bits != NULL &&
+                       ctx->rcore->ctu_dqp != NULL && ctx->rcore->row_dqp != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    }
+
+    if (ctx->param.pass == 1)
+    {
+        ctx->rc->stats_fp = fopen(ctx->param.stats, "w");
+        xeve_assert_rv(ctx->rc->stats_fp != NULL, XEVE_ERR_INVALID_ARGUMENT);
+        fprintf(ctx->rc->stats_fp, "#xeve w:%d h:%d fps:%d keyint:%d bframes:%d\n",
+                ctx->param.w, ctx->param.h, ctx->param.fps, ctx->param.keyint, ctx->param.bframes);
+    }
+    else if (ctx->param.pass == 2)
+    {
+        return rc_stats_read(ctx);
+    }
 
     return XEVE_OK;
 }
 
 int xeve_rc_delete(XEVE_CTX * ctx)
 {
-    xeve_mfree(ctx->rcore->pred);
+    if (ctx->rc->stats_fp != NULL)
+    {
+        fclose(ctx->rc->stats_fp);
+    }
+    xeve_mfree(ctx->rc->stats);
+    xeve_mfree(ctx->rcore->ctu_plan);
+    xeve_mfree(ctx->rcore->ctu_bits);
+    xeve_mfree(ctx->rcore->ctu_dqp);
+    xeve_mfree(ctx->rcore->row_dqp);
     xeve_mfree(ctx->rcore);
     xeve_mfree(ctx->rc);
 
@@ -990,19 +1168,54 @@ static void update_rc_model(XEVE_RCORE *rcore, XEVE_RC * rc, s32 bits, s32 max_b
     rc->rcm->qp_cnt++;
 }
 
+static double get_qf_2pass(XEVE_CTX *ctx, XEVE_RCORE *rcore, XEVE_RC_STAT * st)
+{
+    XEVE_RC  * rc = ctx->rc;
+    double     qf, buf, overflow;
+
+    qf = qp_to_qf(st->qp_plan);
+
+    /* compensate the drift of real bits from the plan, the tolerance grows
+       with the encoded duration */
+    buf = 2.0 * rc->bitrate * XEVE_MAX(1.0, sqrt(rc->total_frames / rc->fps));
+    overflow = XEVE_CLIP3(0.5, 2.0, 1.0 + (rc->plan_real_bits - rc->plan_bits) / buf);
+    qf *= overflow;
+
+    rcore->plan_bits = st->bits * qp_to_qf(st->qp) / qf;
+    rcore->est_bits = rcore->plan_bits;
+
+    return qf;
+}
+
 static double get_qfactor(XEVE_CTX *ctx)
 {
-    XEVE_RCORE * rcore = ctx->rcore;
-    XEVE_RC    * rc = ctx->rc;
-    double       qf, frm_qf_min, frm_qf_max;
+    XEVE_RCORE   * rcore = ctx->rcore;
+    XEVE_RC      * rc = ctx->rc;
+    XEVE_RC_STAT * st;
+    double         qf, frm_qf_min, frm_qf_max;
+    int            vbv_enabled;
 
     qf = get_qf(ctx, rcore);
-    qf = get_qfactor_clip(ctx, rcore, qf);
+    st = ((int)ctx->pico->pic_icnt < rc->stats_cnt) ? &rc->stats[ctx->pico->pic_icnt] : NULL;
+
+    if (st != NULL && st->stype == rcore->stype && st->sdepth == rcore->sdepth)
+    {
+        /* second pass: the allocation over the whole sequence replaces the
+           windowed model, the buffer is only checked when a VBV size is set */
+        qf = get_qf_2pass(ctx, rcore, st);
+        vbv_enabled = ctx->param.vbv_bufsize > 0;
+    }
+    else
+    {
+        qf = get_qfactor_clip(ctx, rcore, qf);
+        vbv_enabled = rc->vbv_enabled;
+        rcore->plan_bits = 0;
+    }
 
     frm_qf_min = rcore->qf_min[rcore->stype];
     frm_qf_max = rcore->qf_max[rcore->stype];
 
-    if (rc->vbv_enabled && rcore->cpx_frm > 0)
+    if (vbv_enabled && rcore->cpx_frm > 0)
     {
         /* clipping  qstep min and max before vbv cliping */
         qf = (frm_qf_min == frm_qf_max) ? frm_qf_min : XEVE_CLIP3(frm_qf_min, frm_qf_max, qf);
@@ -1033,6 +1246,115 @@ int xeve_rc_get_frame_qp(XEVE_CTX *ctx)
     return XEVE_CLIP3(RC_QP_MIN, RC_QP_MAX, (int)qp);
 }
 
+/* distribute the bits of the frame over the CTUs in proportion to the
+   forecast block costs, and derive the frame limit from the VBV buffer */
+static void rc_row_plan(XEVE_CTX *ctx, int qp)
+{
+    XEVE_RC    * rc = ctx->rc;
+    XEVE_RCORE * rcore = ctx->rcore;
+    XEVE_PICO  * pico = ctx->pico;
+    XEVE_RCBE  * bit_estimator;
+    double       sum, drain;
+    s32          cost;
+    int          i, x, y, nx, ny, bx, by, bx1, by1, blk_size, log2_ctu = ctx->log2_max_cuwh;
+
+    for (i = 0; i < (int)ctx->f_lcu; i++)
+    {
+        rcore->ctu_plan[i] = 0;
+        rcore->ctu_bits[i] = -1;
+        rcore->ctu_dqp[i] = 0;
+    }
+    xeve_mset(rcore->row_dqp, 0, sizeof(s8) * ctx->h_lcu);
+
+    sum = 0;
+    if (ctx->param.use_fcst)
+    {
+        /* forecast blocks are analysed on the half size picture */
+        blk_size = 1 << (ctx->fcst.log2_fcst_blk_spic + 2);
+        for (i = 0; i < ctx->fcst.f_blk; i++)
+        {
+            cost = pico->sinfo.map_uni_lcost[i][INTRA];
+            if (ctx->slice_type != SLICE_I)
+            {
+                cost = XEVE_MIN(cost, pico->sinfo.map_uni_lcost[i][INTER_UNI0]);
+                if (ctx->slice_type == SLICE_B && rc->encoding_mode != XEVE_LD)
+                {
+                    cost = XEVE_MIN(cost, pico->sinfo.map_bi_lcost[i]);
+                }
+            }
+            cost = XEVE_MAX(cost, 1);
+
+            bx = (i % ctx->fcst.w_blk) * blk_size;
+            by = (i / ctx->fcst.w_blk) * blk_size;
+            bx1 = XEVE_MIN(bx + blk_size, ctx->w);
+            by1 = XEVE_MIN(by + blk_size, ctx->h);
+
+            /* split the block cost by the area covered in each CTU */
+            for (y = by; y < by1; y = ny)
+            {
+                ny = XEVE_MIN(((y >> log2_ctu) + 1) << log2_ctu, by1);
+                for (x = bx; x < bx1; x = nx)
+                {
+                    nx = XEVE_MIN(((x >> log2_ctu) + 1) << log2_ctu, bx1);
+                    rcore->ctu_plan[(y >> log2_ctu) * ctx->w_lcu + (x >> log2_ctu)] +=
+                        (double)cost * (nx - x) * (ny - y) / (blk_size * blk_size);
+                }
+            }
+            sum += cost;
+        }
+    }
+    if (sum <= 0)
+    {
+        /* no analysis, plan by the CTU area */
+        for (y = 0; y < ctx->h_lcu; y++)
+        {
+            for (x = 0; x < ctx->w_lcu; x++)
+            {
+                rcore->ctu_plan[y * ctx->w_lcu + x] = (double)(XEVE_MIN((x + 1) << log2_ctu, ctx->w) - (x << log2_ctu)) *
+                                                      (XEVE_MIN((y + 1) << log2_ctu, ctx->h) - (y << log2_ctu));
+            }
+        }
+        sum = (double)ctx->w * ctx->h;
+    }
+
+    /* target of the frame from the second pass plan or from the bit estimator
+       once it has learned the slice type */
+    bit_estimator = (rcore->stype != SLICE_B) ? &rc->bit_estimator[rcore->stype] : &rc->bit_estimator[SLICE_I + rcore->sdepth];
+    rcore->row_target = 0;
+    if (rcore->plan_bits > 0)
+    {
+        rcore->row_target = rcore->plan_bits;
+    }
+    else if (bit_estimator->cnt >= 1.5 && rcore->cpx_frm > 0 && rcore->scene_type != SCENE_EX_LOW)
+    {
+        rcore->row_target = estimate_frame_bits(bit_estimator, qp_to_qf(qp), rcore->cpx_frm);
+    }
+
+    sum = ((rcore->row_target > 0) ? rcore->row_target : rc->bpf) / sum;
+    for (i = 0; i < (int)ctx->f_lcu; i++)
+    {
+        rcore->ctu_plan[i] *= sum;
+    }
+
+    /* the frame must fit into the space left in the buffer after draining */
+    drain = (ctx->param.rc_type == RC_CRF) ? rc->vbv_buf_size / rc->fps : rc->bpf;
+    rcore->row_max_bits = (rc->vbv_buf_size - XEVE_MAX(rc->vbv_buf_fullness, 0) + drain) * RC_ROW_VBV_MARGIN;
+}
+
+/* complexity weighted average of the qp offsets of the coded CTUs */
+static double rc_row_avg_dqp(XEVE_CTX *ctx)
+{
+    XEVE_RCORE * rcore = ctx->rcore;
+    double       sum = 0, dqp = 0;
+
+    for (int i = 0; i < (int)ctx->f_lcu; i++)
+    {
+        dqp += rcore->ctu_plan[i] * rcore->ctu_dqp[i];
+        sum += rcore->ctu_plan[i];
+    }
+    return (sum > 0) ? dqp / sum : 0;
+}
+
 void xeve_rc_update_frame(XEVE_CTX *ctx, XEVE_RC * rc, XEVE_RCORE * rcore)
 {
     s32    stype = rcore->stype;
@@ -1040,8 +1362,20 @@ void xeve_rc_update_frame(XEVE_CTX *ctx, XEVE_RC * rc, XEVE_RCORE * rcore)
 
     if (ctx->param.use_filler) bits -= (rcore->filler_byte << 3);
 
+    if (ctx->param.row_vbv)
+    {
+        /* the models are updated with the qp the rows were really coded at */
+        rcore->qp += rc_row_avg_dqp(ctx);
+    }
+
     rc->frame_bits += (int)bits;
 
+    if (rcore->plan_bits > 0)
+    {
+        rc->plan_bits += rcore->plan_bits;
+        rc->plan_real_bits += bits;
+    }
+
     double current_bitrate;
     rc->total_frames += 1;
 
@@ -1120,5 +1454,146 @@ int xeve_rc_get_qp(XEVE_CTX *ctx)
     ctx->rcore->sdepth = ctx->slice_depth;
     qp = xeve_rc_get_frame_qp(ctx);
 
+    if (ctx->param.row_vbv)
+    {
+        rc_row_plan(ctx, qp);
+    }
+
     return qp;
-}
\ No newline at end of file
+}
+
+void xeve_rc_write_stats(XEVE_CTX *ctx)
+{
+    XEVE_RCORE * rcore = ctx->rcore;
+    double       bits = rcore->real_bits;
+
+    if (ctx->rc->stats_fp == NULL)
+    {
+        return;
+    }
+    if (ctx->param.use_filler) bits -= (rcore->filler_byte << 3);
+
+    fprintf(ctx->rc->stats_fp, "in:%d type:%d depth:%d qp:%d bits:%.0f cpx:%d\n",
+            (int)ctx->pico->pic_icnt, ctx->slice_type, ctx->slice_depth, ctx->qp, bits, rcore->cpx_frm);
+}
+
+/* decide the qp of the CTU row starting at the current core position.
+   only CTUs whose completion is guaranteed by the WPP dependencies (row y-k
+   up to the k-th CTU of the tile, and the tiles coded before) are measured,
+   so the decision does not depend on the thread timing */
+void xeve_rc_row_qp(XEVE_CTX *ctx, XEVE_CORE *core)
+{
+    XEVE_RCORE * rcore = ctx->rcore;
+    XEVE_TILE  * tile = &ctx->tile[core->tile_idx];
+    int          x_tile = tile->ctba_rs_first % ctx->w_lcu;
+    int          y_tile = tile->ctba_rs_first / ctx->w_lcu;
+    int          y_row = core->y_lcu;
+    int          sync = tile->w_ctb > 1; /* single column tiles do not wait for the upper row */
+    int          lanes = ctx->parallel_rows;
+    double       scale[RC_ROW_DQP_MAX - RC_ROW_DQP_MIN + 1];
+    double       bits_done = 0, norm_done = 0, plan_done = 0, plan_fix = 0, plan_var = 0, plan_all = 0;
+    double       ratio, lim_hi, lim_lo;
+    int          qp_frm, qp, qp_min, qp_max, x, y, i;
+
+    /* bits of a CTU are inversely proportional to its qf */
+    for (i = 0; i <= RC_ROW_DQP_MAX - RC_ROW_DQP_MIN; i++)
+    {
+        scale[i] = pow(2.0, -(i + RC_ROW_DQP_MIN) / 8.4);
+    }
+
+    for (y = 0; y < ctx->h_lcu; y++)
+    {
+        for (x = 0; x < ctx->w_lcu; x++)
+        {
+            i = y * ctx->w_lcu + x;
+            plan_all += rcore->ctu_plan[i];
+
+            if (x >= x_tile && x < x_tile + tile->w_ctb && y >= y_tile && y < y_tile + tile->h_ctb)
+            {
+                /* a row is coded after the rows of its lane above it and
+                   with WPP one CTU behind the up-right CTU of the row above,
+                   anything else may still be in progress */
+                if (y >= y_row || (!sync && (y_row - y) % lanes))
+                {
+                    plan_var += rcore->ctu_plan[i];
+                    continue;
+                }
+                if (y > y_row - lanes && x - x_tile > y_row - y)
+                {
+                    /* still being coded with the qp of its row */
+                    plan_fix += rcore->ctu_plan[i] * scale[rcore->row_dqp[y] - RC_ROW_DQP_MIN];
+                    continue;
+                }
+            }
+            else if (rcore->ctu_bits[i] < 0)
+            {
+                plan_var += rcore->ctu_plan[i];
+                continue;
+            }
+
+            bits_done += rcore->ctu_bits[i];
+            norm_done += rcore->ctu_bits[i] / scale[rcore->ctu_dqp[i] - RC_ROW_DQP_MIN];
+            plan_done += rcore->ctu_plan[i];
+        }
+    }
+
+    /* correct the plan by the bits measured so far */
+    ratio = (norm_done + RC_ROW_PLAN_WEIGHT * plan_all) / (plan_done + RC_ROW_PLAN_WEIGHT * plan_all);
+    plan_fix *= ratio;
+    plan_var *= ratio;
+
+    qp_frm = tile->qp;
+    qp_min = XEVE_MAX(qp_frm + RC_ROW_DQP_MIN, XEVE_MAX(ctx->param.qp_min, RC_QP_MIN));
+    qp_max = XEVE_MIN(qp_frm + RC_ROW_DQP_MAX, XEVE_MIN(ctx->param.qp_max, RC_QP_MAX));
+    qp_min = XEVE_MIN(qp_min, qp_frm);
+    qp_max = XEVE_MAX(qp_max, qp_frm);
+
+    lim_hi = rcore->row_max_bits;
+    lim_lo = 0;
+    if (rcore->row_target > 0)
+    {
+        lim_hi = XEVE_MIN(lim_hi, rcore->row_target * 1.1);
+        lim_lo = XEVE_MIN(rcore->row_max_bits, rcore->row_target) * 0.8;
+    }
+
+    /* start from the upper row and move while the projected frame bits are
+       out of the limits */
+    y = (sync || lanes == 1) ? y_row - 1 : y_row - lanes;
+    qp = (y >= y_tile) ? qp_frm + rcore->row_dqp[y] : qp_frm;
+    qp = XEVE_CLIP3(qp_min, qp_max, qp);
+    if (bits_done + plan_fix + plan_var * scale[qp - qp_frm - RC_ROW_DQP_MIN] > lim_hi)
+    {
+        while (qp < qp_max && bits_done + plan_fix + plan_var * scale[qp - qp_frm - RC_ROW_DQP_MIN] > lim_hi)
+        {
+            qp++;
+        }
+    }
+    else
+    {
+        while (qp > qp_min && bits_done + plan_fix + plan_var * scale[qp - 1 - qp_frm - RC_ROW_DQP_MIN] < lim_lo)
+        {
+            qp--;
+        }
+    }
+
+    rcore->row_dqp[y_row] = (s8)(qp - qp_frm);
+    core->dqp_row = (s8)(qp - qp_frm);
+}
+
+void xeve_rc_row_update(XEVE_CTX *ctx, XEVE_CORE *core, int bits)
+{
+    int i = core->y_lcu * ctx->w_lcu + core->x_lcu;
+
+    ctx->rcore->ctu_bits[i] = bits;
+    ctx->rcore->ctu_dqp[i] = core->dqp_row;
+}
+
+/* bits written by the CABAC encoder so far, including the bits pending in
+   the engine */
+int xeve_rc_bsw_bits(XEVE_BSW *bs)
+{
+    XEVE_SBAC * sbac = GET_SBAC_ENC(bs);
+
+    return ((XEVE_BSW_GET_WRITE_BYTE(bs) + (int)sbac->stacked_ff + (int)sbac->is_pending_byte) << 3) +
+           (32 - bs->leftbits) + (8 - (int)sbac->code_bits);
+}
@@ -73,8 +73,6 @@ struct _XEVE_RC_PARAM
 *****************************************************************************/
 struct _XEVE_RCORE
 {
-    u16        * pred;
-
     /* qf value limitation parameter */
     double       qf_limit;
     /* offset btw I and P frame */
@@ -107,6 +105,18 @@ struct _XEVE_RCORE
     int          amortize_flag;
     int          amortized_frames;
     int          residue_cost;
+    /* bits planned by the second pass (restore for update) */
+    double       plan_bits;
+
+    /* CTU-row level rate control: planned bits at the frame qp, real bits
+       (-1 until coded) and qp offset of every CTU, qp offset of every row */
+    double     * ctu_plan;
+    s32        * ctu_bits;
+    s8         * ctu_dqp;
+    s8         * row_dqp;
+    /* target bits and VBV limit of the current frame for the row control */
+    double       row_target;
+    double       row_max_bits;
 };
 
 /*****************************************************************************
@@ -132,6 +142,25 @@ typedef struct _XEVE_RCM
     double       bpf_decayed;
 }XEVE_RCM;
 
+/*****************************************************************************
+* first pass statistics of a picture for multi-pass rate control
+*****************************************************************************/
+typedef struct _XEVE_RC_STAT
+{
+    /* slice type */
+    int          stype;
+    /* slice depth */
+    int          sdepth;
+    /* slice qp of the first pass */
+    double       qp;
+    /* bits of the first pass */
+    double       bits;
+    /* complexity from the frame analysis */
+    s32          cpx_frm;
+    /* qp allocated for the second pass */
+    double       qp_plan;
+} XEVE_RC_STAT;
+
 /*****************************************************************************
 * rate control structure
 *****************************************************************************/
@@ -183,6 +212,15 @@ struct _XEVE_RC
     int          scene_cut;
     double       basecplx;
 
+    /* multi-pass statistics file */
+    FILE         * stats_fp;
+    /* first pass statistics in input order (second pass) */
+    XEVE_RC_STAT * stats;
+    int            stats_cnt;
+    /* planned and real bits of the second pass pictures encoded so far */
+    double         plan_bits;
+    double         plan_real_bits;
+
     const XEVE_RC_PARAM * param;
 };
 
@@ -220,6 +258,14 @@ enum RC_TYPE
 #define RC_QP_MAX                   (MAX_QUANT - 1)
 #define RC_QP_MIN                   (MIN_QUANT + 1)
 
+/* qp offset range of a CTU row from the frame qp */
+#define RC_ROW_DQP_MIN              (-3)
+#define RC_ROW_DQP_MAX              12
+/* weight of the plan against the measured bits, in ratio of the frame plan */
+#define RC_ROW_PLAN_WEIGHT          0.1
+/* margin of the VBV space for the bits not measured by the row control */
+#define RC_ROW_VBV_MARGIN           0.9
+
 int  xeve_rc_create(XEVE_CTX * ctx);
 int  xeve_rc_delete(XEVE_CTX * ctx);
 s32  xeve_rc_set(XEVE_CTX *ctx);
@@ -227,4 +273,8 @@ s32  xeve_rc_rcore_set(XEVE_CTX * ctx);
 void xeve_rc_update_frame(XEVE_CTX *ctx, XEVE_RC * rc, XEVE_RCORE * rcore);
 s32  xeve_rc_get_frame_qp(XEVE_CTX *ctx);
 int  xeve_rc_get_qp(XEVE_CTX *ctx);
+void xeve_rc_write_stats(XEVE_CTX *ctx);
+void xeve_rc_row_qp(XEVE_CTX *ctx, XEVE_CORE *core);
+void xeve_rc_row_update(XEVE_CTX *ctx, XEVE_CORE *core, int bits);
+int  xeve_rc_bsw_bits(XEVE_BSW *bs);
 #endif
\ No newline at end of file
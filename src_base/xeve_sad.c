@@ -31,12 +31,6 @@
 #include "xeve_type.h"
 #include <math.h>
 
-
-const XEVE_FN_SAD  (* xeve_func_sad)[8];
-const XEVE_FN_SSD  (* xeve_func_ssd)[8];
-const XEVE_FN_DIFF (* xeve_func_diff)[8];
-const XEVE_FN_SATD  * xeve_func_satd;
-
 /* SAD for 16bit **************************************************************/
 int sad_16b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
 {
@@ -48,11 +48,6 @@ extern const XEVE_FN_SSD  xeve_tbl_ssd_16b[8][8];
 extern const XEVE_FN_DIFF xeve_tbl_diff_16b[8][8];
 extern const XEVE_FN_SATD xeve_tbl_satd_16b[1];
 
-extern const XEVE_FN_SAD  (* xeve_func_sad)[8];
-extern const XEVE_FN_SSD  (* xeve_func_ssd)[8];
-extern const XEVE_FN_DIFF (* xeve_func_diff)[8];
-extern const XEVE_FN_SATD (* xeve_func_satd);
-
 #define xeve_sad_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
         xeve_func_sad[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
 #define xeve_sad_bi_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
@@ -28,18 +28,61 @@
    POSSIBILITY OF SUCH DAMAGE.
 */
 
+#if !defined(WIN32) && !defined(WIN64) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L //for clock_gettime() and sched_yield()
+#endif
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "xeve_thread_pool.h"
 #if defined(WIN32) || defined(WIN64)
 #include <Windows.h>
 #include <process.h>
 #else
 #include <pthread.h>
+#include <sched.h>
+#include <time.h>
 #endif
 
 #define WINDOWS_MUTEX_SYNC 0
 
+//number of busy-wait iterations before waiting thread gives up its time slice
+#define SYNC_SPIN_CNT      256
+//number of time slice give-ups before waiting thread goes to sleep
+#define SYNC_YIELD_CNT     16
+
+#if defined(WIN32) || defined(WIN64)
+#define ATOMIC_LOAD(p)         InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+#define ATOMIC_STORE(p, v)     InterlockedExchange((volatile LONG *)(p), (v))
+#define ATOMIC_STORE_REL(p, v) InterlockedExchange((volatile LONG *)(p), (v))
+#define ATOMIC_INC(p)          InterlockedIncrement((volatile LONG *)(p))
+#define ATOMIC_DEC(p)          InterlockedDecrement((volatile LONG *)(p))
+#define ATOMIC_CAS(p, c, v)    InterlockedCompareExchange((volatile LONG *)(p), (v), (c))
+#define CPU_PAUSE()            YieldProcessor()
+#define THREAD_YIELD()         SwitchToThread()
+#else
+//acquire load pairs with release store, so data written before the flag is visible after the flag
+#define ATOMIC_LOAD(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+//sequentially consistent store/increment to order flag update and waiter count (see threadsafe_wait)
+#define ATOMIC_STORE(p, v)     __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+//release store for values also read without the lock that guards their updates
+#define ATOMIC_STORE_REL(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ATOMIC_INC(p)          __atomic_add_fetch((p), 1, __ATOMIC_SEQ_CST)
+#define ATOMIC_DEC(p)          __atomic_sub_fetch((p), 1, __ATOMIC_SEQ_CST)
+//stores v when *p equals c, returns the previous value in any case
+#define ATOMIC_CAS(p, c, v)    __sync_val_compare_and_swap((p), (c), (v))
+#if defined(__i386__) || defined(__x86_64__)
+#define CPU_PAUSE()            __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define CPU_PAUSE()            __asm__ __volatile__("yield" ::: "memory")
+#else
+#define CPU_PAUSE()
+#endif
+#define THREAD_YIELD()         sched_yield()
+#endif
+
+THREAD_LOCAL void * thread_owner = NULL;
+
 #if !defined(WIN32) && !defined(WIN64) 
 
 typedef struct _THREAD_CTX
@@ -54,6 +97,7 @@ typedef struct _THREAD_CTX
     //member field to run  a task                   
     THREAD_ENTRY task;
     void * t_arg;
+    void * t_owner; //thread_owner of the thread which assigned the task
     THREAD_STATUS t_status;
     THREAD_RESULT task_result;
     int thread_id;
@@ -64,6 +108,20 @@ typedef struct _syncobject
     pthread_mutex_t lmutex;
 }THREAD_MUTEX;
 
+typedef struct _THREAD_WAIT
+{
+    pthread_mutex_t lmutex;
+    pthread_cond_t  cond; //broadcasted whenever a flag is updated and somebody sleeps
+    volatile int    sleep_cnt; //number of threads sleeping on the condition
+}THREAD_WAIT;
+
+static int64_t get_time_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 void * xeve_run_worker_thread(void * arg)
 {
     /********************* main routine for thread pool worker thread *************************
@@ -102,11 +160,13 @@ void * xeve_run_worker_thread(void * arg)
 
         //run the routine
         //worker thread state is running with entry function and arg set
+        thread_owner = t_context->t_owner;
         t_context->task(t_context->t_arg);
 
         //signal the thread waiting on the result
         pthread_mutex_lock(&t_context->c_section);
         t_context->t_status = THREAD_SUSPENDED;
+        t_context->task_result = THREAD_SUCCESS;
         pthread_cond_signal(&t_context->r_event);
         pthread_mutex_unlock(&t_context->c_section);
     }
@@ -166,6 +226,7 @@ POOL_THREAD  xeve_create_worker_thread(THREAD_CONTROLLER * tc, int thread_id)
 
     thread_context->task = NULL;
     thread_context->t_arg = NULL;
+    thread_context->t_owner = NULL;
     thread_context->t_status = THREAD_SUSPENDED;
     thread_context->task_result = THREAD_INVALID_STATE;
     thread_context->thread_id = thread_id;
@@ -217,6 +278,7 @@ THREAD_RESULT xeve_assign_task_thread(POOL_THREAD thread_id, THREAD_ENTRY entry,
     t_context->t_status = THREAD_RUNNING;
     t_context->task = entry;
     t_context->t_arg = arg;
+    t_context->t_owner = thread_owner;
     //signal the worker thread to wake up and run the task
     pthread_cond_signal(&t_context->w_event);
     pthread_mutex_unlock(&t_context->c_section); //release the lock
@@ -341,6 +403,76 @@ int threadsafe_decrement(SYNC_OBJ sobj, volatile int * pcnt)
     return temp;
 }
 
+SYNC_OBJ get_wait_object()
+{
+    THREAD_WAIT * iwait = (THREAD_WAIT *)malloc(sizeof(THREAD_WAIT));
+    if (0 == iwait)
+    {
+        return 0; //failure case
+    }
+
+    if (pthread_mutex_init(&iwait->lmutex, NULL))
+    {
+        free(iwait);
+        return 0;
+    }
+    if (pthread_cond_init(&iwait->cond, NULL))
+    {
+        pthread_mutex_destroy(&iwait->lmutex);
+        free(iwait);
+        return 0;
+    }
+    iwait->sleep_cnt = 0;
+
+    return iwait;
+}
+
+THREAD_RESULT release_wait_object(SYNC_OBJ * wobj)
+{
+    THREAD_WAIT * iwait = (THREAD_WAIT *)(*wobj);
+
+    pthread_cond_destroy(&iwait->cond);
+    pthread_mutex_destroy(&iwait->lmutex);
+    free(iwait);
+    *wobj = NULL;
+
+    return THREAD_SUCCESS;
+}
+
+static void wait_object_sleep(THREAD_WAIT * iwait, volatile int * addr, int val)
+{
+    pthread_mutex_lock(&iwait->lmutex);
+    //sleep counter has to be visible before the flag is checked again,
+    //then signalling thread either sees the sleeper or the sleeper sees the new flag
+    ATOMIC_INC(&iwait->sleep_cnt);
+    while (ATOMIC_LOAD(addr) < val)
+    {
+        pthread_cond_wait(&iwait->cond, &iwait->lmutex);
+    }
+    ATOMIC_DEC(&iwait->sleep_cnt);
+    pthread_mutex_unlock(&iwait->lmutex);
+}
+
+static void wait_object_wakeup(THREAD_WAIT * iwait)
+{
+    if (ATOMIC_LOAD(&iwait->sleep_cnt) > 0)
+    {
+        pthread_mutex_lock(&iwait->lmutex);
+        pthread_cond_broadcast(&iwait->cond);
+        pthread_mutex_unlock(&iwait->lmutex);
+    }
+}
+
+static void sync_lock(THREAD_MUTEX * imutex)
+{
+    pthread_mutex_lock(&imutex->lmutex);
+}
+
+static void sync_unlock(THREAD_MUTEX * imutex)
+{
+    pthread_mutex_unlock(&imutex->lmutex);
+}
+
 #else
 typedef struct _THREAD_CTX
 {
@@ -353,6 +485,7 @@ typedef struct _THREAD_CTX
     //member field to run  a task
     THREAD_ENTRY task;
     void * t_arg;
+    void * t_owner; //thread_owner of the thread which assigned the task
     THREAD_STATUS t_status;
     THREAD_RESULT task_result;
     int thread_id;
@@ -369,6 +502,21 @@ typedef struct _THREAD_MUTEX
 
 }THREAD_MUTEX;
 
+typedef struct _THREAD_WAIT
+{
+    CRITICAL_SECTION   c_section;
+    CONDITION_VARIABLE cond; //broadcasted whenever a flag is updated and somebody sleeps
+    volatile LONG      sleep_cnt; //number of threads sleeping on the condition
+}THREAD_WAIT;
+
+static int64_t get_time_us()
+{
+    LARGE_INTEGER cnt, freq;
+    QueryPerformanceCounter(&cnt);
+    QueryPerformanceFrequency(&freq);
+    return (int64_t)(cnt.QuadPart * 1000000 / freq.QuadPart);
+}
+
 unsigned int __stdcall xeve_run_worker_thread(void * arg)
 {
     /********************* main routine for thread pool worker thread *************************
@@ -400,6 +548,7 @@ unsigned int __stdcall xeve_run_worker_thread(void * arg)
         LeaveCriticalSection(&t_context->c_section);
 
         //worker thread state is running with entry function and arg set
+        thread_owner = t_context->t_owner;
         t_context->task(t_context->t_arg);
 
         //change the state to suspended/waiting
@@ -450,6 +599,7 @@ POOL_THREAD  xeve_create_worker_thread(THREAD_CONTROLLER * tc, int thread_id)
     //intialize the state variables for the thread context object
     thread_context->task = NULL;
     thread_context->t_arg = NULL;
+    thread_context->t_owner = NULL;
     thread_context->t_status = THREAD_SUSPENDED;
     thread_context->task_result = THREAD_INVALID_STATE;
     thread_context->thread_id = thread_id;
@@ -503,6 +653,7 @@ THREAD_RESULT xeve_assign_task_thread(POOL_THREAD thread_id, THREAD_ENTRY entry,
     t_context->t_status = THREAD_RUNNING;
     t_context->task = entry;
     t_context->t_arg = arg;
+    t_context->t_owner = thread_owner;
     //signal the worker thread to wake up and run the task
     ResetEvent(t_context->r_event);
     SetEvent(t_context->w_event);
@@ -655,6 +806,74 @@ int threadsafe_decrement(SYNC_OBJ sobj, volatile int * pcnt)
 #endif
     return temp;
 }
+
+SYNC_OBJ get_wait_object()
+{
+    THREAD_WAIT * iwait = (THREAD_WAIT *)malloc(sizeof(THREAD_WAIT));
+    if (0 == iwait)
+    {
+        return 0; //failure case
+    }
+
+    InitializeCriticalSection(&iwait->c_section);
+    InitializeConditionVariable(&iwait->cond);
+    iwait->sleep_cnt = 0;
+
+    return iwait;
+}
+
+THREAD_RESULT release_wait_object(SYNC_OBJ * wobj)
+{
+    THREAD_WAIT * iwait = (THREAD_WAIT *)(*wobj);
+
+    DeleteCriticalSection(&iwait->c_section);
+    free(iwait);
+    *wobj = NULL;
+
+    return THREAD_SUCCESS;
+}
+
+static void wait_object_sleep(THREAD_WAIT * iwait, volatile int * addr, int val)
+{
+    EnterCriticalSection(&iwait->c_section);
+    //sleep counter has to be visible before the flag is checked again,
+    //then signalling thread either sees the sleeper or the sleeper sees the new flag
+    ATOMIC_INC(&iwait->sleep_cnt);
+    while (ATOMIC_LOAD(addr) < val)
+    {
+        SleepConditionVariableCS(&iwait->cond, &iwait->c_section, INFINITE);
+    }
+    ATOMIC_DEC(&iwait->sleep_cnt);
+    LeaveCriticalSection(&iwait->c_section);
+}
+
+static void wait_object_wakeup(THREAD_WAIT * iwait)
+{
+    if (ATOMIC_LOAD(&iwait->sleep_cnt) > 0)
+    {
+        EnterCriticalSection(&iwait->c_section);
+        WakeAllConditionVariable(&iwait->cond);
+        LeaveCriticalSection(&iwait->c_section);
+    }
+}
+
+static void sync_lock(THREAD_MUTEX * imutex)
+{
+#if WINDOWS_MUTEX_SYNC
+    WaitForSingleObject(imutex->lmutex, INFINITE);
+#else
+    EnterCriticalSection(&imutex->c_section);
+#endif
+}
+
+static void sync_unlock(THREAD_MUTEX * imutex)
+{
+#if WINDOWS_MUTEX_SYNC
+    ReleaseMutex(imutex->lmutex);
+#else
+    LeaveCriticalSection(&imutex->c_section);
+#endif
+}
 #endif
 
 THREAD_RESULT init_thread_controller(THREAD_CONTROLLER * tc, int maxtask)
@@ -686,20 +905,437 @@ THREAD_RESULT dinit_thread_controller(THREAD_CONTROLLER * tc)
 int spinlock_wait(volatile int * addr, int val)
 {
     int temp;
+    int spin = 0;
 
     while (1)
     {
-        temp = *addr; //thread safe volatile read
+        temp = ATOMIC_LOAD(addr);
         if (temp == val || temp == -1)
         {
             break;
         }
+        //back off, do not starve the thread which is going to update the value
+        if (spin < SYNC_SPIN_CNT)
+        {
+            CPU_PAUSE();
+            spin++;
+        }
+        else
+        {
+            THREAD_YIELD();
+        }
     }
     return temp;
 }
 
 void threadsafe_assign(volatile int * addr, int val)
 {
-    //thread safe volatile assign
-    *addr = val;
-}
\ No newline at end of file
+    //release store, all writes done before are visible to the thread reading the value
+    ATOMIC_STORE(addr, val);
+}
+
+int threadsafe_load(volatile int * addr)
+{
+    return ATOMIC_LOAD(addr);
+}
+
+int threadsafe_wait(SYNC_OBJ wobj, volatile int * addr, int val, int64_t * wait_time)
+{
+    int64_t start;
+    int i;
+
+    //fast path, dependency is already resolved
+    if (ATOMIC_LOAD(addr) >= val)
+    {
+        return 0;
+    }
+
+    start = wait_time ? get_time_us() : 0;
+
+    //spin for a short while, dependency usually gets resolved soon
+    for (i = 0; i < SYNC_SPIN_CNT; i++)
+    {
+        CPU_PAUSE();
+        if (ATOMIC_LOAD(addr) >= val)
+        {
+            goto DONE;
+        }
+    }
+
+    //give the time slice to other threads (e.g. under oversubscription)
+    for (i = 0; i < SYNC_YIELD_CNT || !wobj; i++)
+    {
+        THREAD_YIELD();
+        if (ATOMIC_LOAD(addr) >= val)
+        {
+            goto DONE;
+        }
+    }
+
+    //sleep until signalled
+    wait_object_sleep((THREAD_WAIT *)wobj, addr, val);
+
+DONE:
+    if (wait_time)
+    {
+        *wait_time += get_time_us() - start;
+    }
+    return 1;
+}
+
+void threadsafe_signal(SYNC_OBJ wobj, volatile int * addr, int val)
+{
+    ATOMIC_STORE(addr, val);
+    if (wobj)
+    {
+        wait_object_wakeup((THREAD_WAIT *)wobj);
+    }
+}
+//initial number of entries of a worker deque, grows on demand
+#define TASK_DEQUE_SIZE    64
+
+typedef struct _TASK_DEQUE
+{
+    SYNC_OBJ        lock;
+    THREAD_TASK  ** buf;
+    int             size;
+    volatile int    head; //oldest task, stolen by other workers
+    volatile int    tail; //newest task, taken by the owner
+}TASK_DEQUE;
+
+typedef struct _TASK_WORKER
+{
+    TASK_SCHEDULER * ts;
+    int              id;
+}TASK_WORKER;
+
+struct _TASK_SCHEDULER
+{
+    THREAD_CONTROLLER * tc;
+    POOL_THREAD       * pool;
+    int                 worker_cnt;
+    TASK_WORKER       * worker;
+    TASK_DEQUE        * deque;
+    //idle workers sleep on it until the event counter changes
+    SYNC_OBJ            wobj;
+    //increased whenever a task gets ready or the last pending task is finished
+    volatile int        event;
+    //submitted but unfinished tasks
+    volatile int        pending;
+    //workers have been started on the pool threads
+    int                 active;
+    //owner waits for completion, workers leave when nothing is pending
+    volatile int        closing;
+    volatile int        result;
+    //deque receiving the next submitted task
+    int                 next;
+};
+
+static THREAD_RESULT task_deque_push(TASK_DEQUE * dq, THREAD_TASK * task)
+{
+    THREAD_TASK ** buf;
+
+    sync_lock((THREAD_MUTEX *)dq->lock);
+    if (dq->tail == dq->size)
+    {
+        if (dq->head > 0)
+        {
+            memmove(dq->buf, dq->buf + dq->head, (dq->tail - dq->head) * sizeof(THREAD_TASK *));
+            //never let the unlocked check see an empty deque meanwhile
+            int cnt = dq->tail - dq->head;
+            ATOMIC_STORE_REL(&dq->head, 0);
+            ATOMIC_STORE_REL(&dq->tail, cnt);
+        }
+        else
+        {
+            buf = (THREAD_TASK **)realloc(dq->buf, dq->size * 2 * sizeof(THREAD_TASK *));
+            if (!buf)
+            {
+                sync_unlock((THREAD_MUTEX *)dq->lock);
+                return THREAD_OUT_OF_MEMORY;
+            }
+            dq->buf = buf;
+            dq->size *= 2;
+        }
+    }
+    dq->buf[dq->tail] = task;
+    ATOMIC_STORE_REL(&dq->tail, dq->tail + 1);
+    sync_unlock((THREAD_MUTEX *)dq->lock);
+
+    return THREAD_SUCCESS;
+}
+
+static THREAD_TASK * task_deque_pop(TASK_DEQUE * dq, int steal)
+{
+    THREAD_TASK * task = NULL;
+
+    //cheap check without the lock, empty deques are common while stealing.
+    //head and tail are only written with atomic stores under the lock
+    if (ATOMIC_LOAD(&dq->head) == ATOMIC_LOAD(&dq->tail))
+    {
+        return NULL;
+    }
+
+    sync_lock((THREAD_MUTEX *)dq->lock);
+    if (dq->head < dq->tail)
+    {
+        if (steal)
+        {
+            task = dq->buf[dq->head];
+            ATOMIC_STORE_REL(&dq->head, dq->head + 1);
+        }
+        else
+        {
+            task = dq->buf[dq->tail - 1];
+            ATOMIC_STORE_REL(&dq->tail, dq->tail - 1);
+        }
+        if (dq->head == dq->tail)
+        {
+            ATOMIC_STORE_REL(&dq->head, 0);
+            ATOMIC_STORE_REL(&dq->tail, 0);
+        }
+    }
+    sync_unlock((THREAD_MUTEX *)dq->lock);
+
+    return task;
+}
+
+static void task_notify(TASK_SCHEDULER * ts)
+{
+    ATOMIC_INC(&ts->event);
+    wait_object_wakeup((THREAD_WAIT *)ts->wobj);
+}
+
+static void task_run(TASK_SCHEDULER * ts, THREAD_TASK * task, int worker_id)
+{
+    THREAD_TASK * succ;
+    int ret, i;
+
+    ret = task->entry(task->arg, task->idx, worker_id);
+    if (ret != 0)
+    {
+        //tasks fail concurrently, the first failure is kept
+        ATOMIC_CAS(&ts->result, 0, ret);
+    }
+
+    for (i = 0; i < task->succ_cnt; i++)
+    {
+        succ = task->succ[i];
+        if (ATOMIC_DEC(&succ->dep_cnt) == 0)
+        {
+            //keep the successor on this worker, others will steal it if idle
+            if (task_deque_push(&ts->deque[worker_id], succ) == THREAD_SUCCESS)
+            {
+                task_notify(ts);
+            }
+            else
+            {
+                task_run(ts, succ, worker_id);
+            }
+        }
+    }
+
+    if (ATOMIC_DEC(&ts->pending) == 0)
+    {
+        task_notify(ts);
+    }
+}
+
+static THREAD_TASK * task_get(TASK_SCHEDULER * ts, int worker_id)
+{
+    THREAD_TASK * task;
+    int i;
+
+    task = task_deque_pop(&ts->deque[worker_id], 0);
+    for (i = 1; task == NULL && i < ts->worker_cnt; i++)
+    {
+        task = task_deque_pop(&ts->deque[(worker_id + i) % ts->worker_cnt], 1);
+    }
+    return task;
+}
+
+static int task_worker(void * arg)
+{
+    TASK_WORKER * worker = (TASK_WORKER *)arg;
+    TASK_SCHEDULER * ts = worker->ts;
+    THREAD_TASK * task;
+    int event;
+
+    while (1)
+    {
+        //read the event counter before looking for tasks, so a task made ready in between is not missed
+        event = ATOMIC_LOAD(&ts->event);
+        task = task_get(ts, worker->id);
+        if (task)
+        {
+            task_run(ts, task, worker->id);
+            continue;
+        }
+        if (ATOMIC_LOAD(&ts->closing) && ATOMIC_LOAD(&ts->pending) == 0)
+        {
+            break;
+        }
+        threadsafe_wait(ts->wobj, &ts->event, event + 1, NULL);
+    }
+    return THREAD_SUCCESS;
+}
+
+TASK_SCHEDULER * create_task_scheduler(THREAD_CONTROLLER * tc, POOL_THREAD * pool, int worker_cnt)
+{
+    TASK_SCHEDULER * ts;
+    int i;
+
+    ts = (TASK_SCHEDULER *)calloc(1, sizeof(TASK_SCHEDULER));
+    if (!ts)
+    {
+        return NULL;
+    }
+    ts->tc = tc;
+    ts->pool = pool;
+    ts->worker_cnt = worker_cnt;
+    ts->worker = (TASK_WORKER *)calloc(worker_cnt, sizeof(TASK_WORKER));
+    ts->deque = (TASK_DEQUE *)calloc(worker_cnt, sizeof(TASK_DEQUE));
+    ts->wobj = get_wait_object();
+    if (!ts->worker || !ts->deque || !ts->wobj)
+    {
+        goto TERROR;
+    }
+
+    for (i = 0; i < worker_cnt; i++)
+    {
+        ts->worker[i].ts = ts;
+        ts->worker[i].id = i;
+        ts->deque[i].size = TASK_DEQUE_SIZE;
+        ts->deque[i].buf = (THREAD_TASK **)malloc(TASK_DEQUE_SIZE * sizeof(THREAD_TASK *));
+        ts->deque[i].lock = get_synchronized_object();
+        if (!ts->deque[i].buf || !ts->deque[i].lock)
+        {
+            goto TERROR;
+        }
+    }
+    return ts;
+
+TERROR:
+    release_task_scheduler(&ts);
+    return NULL;
+}
+
+THREAD_RESULT release_task_scheduler(TASK_SCHEDULER ** ts)
+{
+    TASK_SCHEDULER * s = *ts;
+    int i;
+
+    if (!s)
+    {
+        return THREAD_INVALID_ARG;
+    }
+    if (s->active)
+    {
+        task_wait_all(s);
+    }
+    if (s->deque)
+    {
+        for (i = 0; i < s->worker_cnt; i++)
+        {
+            if (s->deque[i].lock)
+            {
+                release_synchornized_object(&s->deque[i].lock);
+            }
+            free(s->deque[i].buf);
+        }
+        free(s->deque);
+    }
+    if (s->wobj)
+    {
+        release_wait_object(&s->wobj);
+    }
+    free(s->worker);
+    free(s);
+    *ts = NULL;
+
+    return THREAD_SUCCESS;
+}
+
+void task_init(THREAD_TASK * task, TASK_ENTRY entry, void * arg, int task_idx)
+{
+    task->entry = entry;
+    task->arg = arg;
+    task->idx = task_idx;
+    task->dep_cnt = 1;
+    task->succ_cnt = 0;
+}
+
+THREAD_RESULT task_depend(THREAD_TASK * task, THREAD_TASK * pred)
+{
+    if (pred->succ_cnt >= TASK_MAX_SUCC)
+    {
+        return THREAD_INVALID_ARG;
+    }
+    pred->succ[pred->succ_cnt++] = task;
+    ATOMIC_INC(&task->dep_cnt);
+
+    return THREAD_SUCCESS;
+}
+
+THREAD_RESULT task_submit(TASK_SCHEDULER * ts, THREAD_TASK * task)
+{
+    THREAD_RESULT ret;
+    int i;
+
+    if (!ts->active)
+    {
+        //joining a worker which has not been started returns immediately
+        ts->active = 1;
+        for (i = 1; i < ts->worker_cnt; i++)
+        {
+            ret = ts->tc->run(ts->pool[i], task_worker, &ts->worker[i]);
+            if (ret != THREAD_SUCCESS)
+            {
+                return ret;
+            }
+        }
+    }
+
+    ATOMIC_INC(&ts->pending);
+    //drop the submission hold, the task is ready if it has no unfinished predecessors
+    if (ATOMIC_DEC(&task->dep_cnt) == 0)
+    {
+        ret = task_deque_push(&ts->deque[ts->next], task);
+        if (ret != THREAD_SUCCESS)
+        {
+            ATOMIC_DEC(&ts->pending);
+            return ret;
+        }
+        ts->next = (ts->next + 1) % ts->worker_cnt;
+        task_notify(ts);
+    }
+
+    return THREAD_SUCCESS;
+}
+
+int task_wait_all(TASK_SCHEDULER * ts)
+{
+    int ret, res, i;
+
+    if (ts->active)
+    {
+        ATOMIC_STORE(&ts->closing, 1);
+        task_notify(ts);
+
+        //owner thread is worker 0
+        task_worker(&ts->worker[0]);
+
+        for (i = 1; i < ts->worker_cnt; i++)
+        {
+            ts->tc->join(ts->pool[i], &res);
+        }
+        ts->active = 0;
+        ts->closing = 0;
+        ts->event = 0;
+        ts->next = 0;
+    }
+
+    ret = ATOMIC_LOAD(&ts->result);
+    ATOMIC_STORE(&ts->result, 0);
+    return ret;
+}
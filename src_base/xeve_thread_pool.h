@@ -31,11 +31,23 @@
 #ifndef _XEVE_THREAD_POOL_
 #define _XEVE_THREAD_POOL_
 
+#include <stdint.h>
+
 typedef void* POOL_THREAD;
 typedef int (*THREAD_ENTRY) (void * arg);
 typedef struct _THREAD_CONTROLLER THREAD_CONTROLLER;
 typedef void* SYNC_OBJ;
 
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+//object the calling thread works for (the encoder context), a task assigned by run() is executed with the thread_owner
+//of the thread which called run(), so every thread of an encoder instance sees the same owner
+extern THREAD_LOCAL void * thread_owner;
+
 /*****************************  Salient points  ****************************************************
 ******************************  Thread Controller object will create, run and destroy***************
 ******************************  threads. Thread Controller has to be initialised *******************
@@ -84,7 +96,54 @@ SYNC_OBJ get_synchronized_object();
 THREAD_RESULT release_synchornized_object(SYNC_OBJ * sobj); //sync object will be deleted
 int spinlock_wait(volatile int * addr, int val);
 void threadsafe_assign(volatile int * addr, int val);
+int threadsafe_load(volatile int * addr);
 int threadsafe_decrement(SYNC_OBJ sobj, volatile int * pcnt);
 
+/*** Create a wait object to resolve dependencies across threads (e.g. CTU rows of WPP). Waiting thread spins,****
+**** then yields its time slice and finally sleeps on the wait object until the flag reaches the value.************
+**** Flags have to be monotonically increasing and updated by threadsafe_signal() with the same wait object.******/
+
+SYNC_OBJ get_wait_object();
+THREAD_RESULT release_wait_object(SYNC_OBJ * wobj);
+//wait until *addr >= val, returns 0 if no wait was needed; waiting time in us is accumulated on wait_time, if given
+int threadsafe_wait(SYNC_OBJ wobj, volatile int * addr, int val, int64_t * wait_time);
+void threadsafe_signal(SYNC_OBJ wobj, volatile int * addr, int val);
+
+/*** Task scheduler runs a graph of tasks on the workers of a thread controller. Every worker owns a deque of ready****
+**** tasks; the owner takes the newest task and idle workers steal the oldest ones from the others. A task becomes ****
+**** ready when all its predecessors are finished. The thread which owns the scheduler is worker 0: submitted tasks***
+**** start on the other workers immediately and task_wait_all() makes the owner help until everything is finished.****
+**** Tasks which wait on each other's progress (e.g. CTU rows) must not outnumber the workers.**********************/
+
+#define TASK_MAX_SUCC      8
+
+typedef struct _TASK_SCHEDULER TASK_SCHEDULER;
+typedef struct _THREAD_TASK THREAD_TASK;
+//task_idx is given at task_init(), worker_id is in [0, worker_cnt) and unique among concurrently running tasks
+typedef int (*TASK_ENTRY) (void * arg, int task_idx, int worker_id);
+
+struct _THREAD_TASK
+{
+    TASK_ENTRY     entry;
+    void         * arg;
+    int            idx;
+    //number of unfinished predecessors, plus one until the task is submitted
+    volatile int   dep_cnt;
+    //tasks depending on this task
+    THREAD_TASK  * succ[TASK_MAX_SUCC];
+    int            succ_cnt;
+};
+
+//worker i > 0 runs on pool[i] of the thread controller
+TASK_SCHEDULER * create_task_scheduler(THREAD_CONTROLLER * tc, POOL_THREAD * pool, int worker_cnt);
+THREAD_RESULT release_task_scheduler(TASK_SCHEDULER ** ts);
+void task_init(THREAD_TASK * task, TASK_ENTRY entry, void * arg, int task_idx);
+//task will not start before pred is finished, has to be called before pred is submitted
+THREAD_RESULT task_depend(THREAD_TASK * task, THREAD_TASK * pred);
+//only the owner thread submits tasks, ready tasks are spread over the worker deques
+THREAD_RESULT task_submit(TASK_SCHEDULER * ts, THREAD_TASK * task);
+//run tasks on the owner thread until all submitted tasks are finished, returns the first non-zero task result
+int task_wait_all(TASK_SCHEDULER * ts);
+
 #endif
 
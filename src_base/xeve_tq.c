@@ -33,7 +33,6 @@
 
 #define QUANT(c, scale, offset, shift) ((s16)((((c)*(scale)) + (offset)) >> (shift)))
 
-const XEVE_TXB(*xeve_func_txb)[MAX_TR_LOG2];
 const int xeve_quant_scale[2][6] = { {26214, 23302, 20560, 18396, 16384, 14764},
                                      {26214, 23302, 20560, 18396, 16384, 14564} };
 
@@ -417,6 +416,63 @@ void xeve_init_err_scale(XEVE_CTX * ctx)
     }
 }
 
+/* uniform quantisation of a block in place; returns the number of non-zero
+   levels. the product is kept in 64 bits so that the non-square scale of the
+   main profile fits */
+int xeve_quant(s16 * coef, int num, int scale, s64 offset, int shift)
+{
+    int nnz = 0;
+    int i;
+    s64 lev;
+
+    for(i = 0; i < num; i++)
+    {
+        lev = (s64)XEVE_ABS(coef[i]) * scale;
+        lev = (s16)((lev + offset) >> shift);
+        coef[i] = (s16)XEVE_SIGN_SET(lev, XEVE_SIGN_GET(coef[i]));
+        nnz += !!(coef[i]);
+    }
+    return nnz;
+}
+
+u32 xeve_coef_abs_max(s16 * coef, int num)
+{
+    u32 max = 0;
+    int i;
+
+    for(i = 0; i < num; i++)
+    {
+        max = XEVE_MAX(max, (u32)XEVE_ABS(coef[i]));
+    }
+    return max;
+}
+
+/* first stage of the RDOQ: scaled level, rounded level and distortion of the
+   uncoded coefficient for every position in raster order; returns the number
+   of non-zero rounded levels */
+int xeve_rdoq_est_level(s16 * src, s16 * level, s32 * level_double, s64 * err0, int num, int q_value, int q_bits, s64 err_scale, s64 * err0_sum)
+{
+    const s32 max_level_double = XEVE_INT32_MAX - (1 << (q_bits - 1));
+    int nnz = 0;
+    int i;
+    s64 err;
+    s64 sum = 0;
+    s32 ld;
+
+    for(i = 0; i < num; i++)
+    {
+        ld = (s32)XEVE_MIN((s64)XEVE_ABS(src[i]) * q_value, (s64)max_level_double);
+        level_double[i] = ld;
+        level[i] = (s16)XEVE_MIN(MAX_TX_VAL, (ld + (1 << (q_bits - 1))) >> q_bits);
+        err = ((s64)ld * err_scale) >> ERR_SCALE_PRECISION_BITS;
+        err0[i] = err * err;
+        sum += err0[i];
+        nnz += !!level[i];
+    }
+    *err0_sum = sum;
+    return nnz;
+}
+
 static __inline s64 get_ic_rate_cost_rl(u32 abs_level, u32 run, s32 ctx_run, u32 ctx_level, s64 lambda, XEVE_CORE * core)
 {
     s32 rate;
@@ -458,15 +514,14 @@ static __inline s64 get_ic_rate_cost_rl(u32 abs_level, u32 run, s32 ctx_run, u32
     return (s64)GET_I_COST(rate, lambda);
 }
 
-static __inline u32 get_coded_level_rl(s64* rd64_uncoded_cost, s64* rd64_coded_cost, s64 level_double, u32 max_abs_level,
+static __inline u32 get_coded_level_rl(s64* rd64_uncoded_cost, s64* rd64_coded_cost, s64 level_double, s64 err0, u32 max_abs_level,
                                        u32 run, u16 ctx_run, u16 ctx_level, s32 q_bits, s64 err_scale, s64 lambda, XEVE_CORE * core)
 {
     u32 best_abs_level = 0;
-    s64 err1 = (level_double * err_scale) >> ERR_SCALE_PRECISION_BITS;
     u32 min_abs_level;
     u32 abs_level;
 
-    *rd64_uncoded_cost = err1 * err1;
+    *rd64_uncoded_cost = err0;
     *rd64_coded_cost = *rd64_uncoded_cost + get_ic_rate_cost_rl(0, run, ctx_run, ctx_level, lambda, core);
 
     min_abs_level = (max_abs_level > 1 ? max_abs_level - 1 : 1);
@@ -504,13 +559,14 @@ int xeve_rdoq_run_length_cc(u8 qp, double d_lambda, u8 is_intra, s16 *src_coef,
     const int ctx_last = (ch_type == Y_C) ? 0 : 1;
     const int q_bits = QUANT_SHIFT + tr_shift + (qp / 6);
     int nnz = 0;
-    int sum_all = 0;
     u32 scan_pos;
+    u32 last_scan_pos;
     u32 run;
     u32 prev_level;
     u32 best_last_idx_p1 = 0;
     s16 tmp_coef[MAX_TR_DIM];
-    s64 tmp_level_double[MAX_TR_DIM];
+    s32 tmp_level_double[MAX_TR_DIM];
+    s64 tmp_err0[MAX_TR_DIM];
     s16 tmp_dst_coef[MAX_TR_DIM];
     const s64 lambda = (s64)(d_lambda * (double)(1 << SCALE_BITS) + 0.5);
     s64 err_scale = core->ctx->err_scale[qp_rem][log2_size - 1];
@@ -519,41 +575,23 @@ int xeve_rdoq_run_length_cc(u8 qp, double d_lambda, u8 is_intra, s16 *src_coef,
     s64 d64_coded_cost = 0;
     s64 d64_uncoded_cost = 0;       
     s64 d64_block_uncoded_cost = 0;
-    s64 err;
 
     /* ===== quantization ===== */
-    for (scan_pos = 0; scan_pos < max_num_coef; scan_pos++)
-    {
-        u32 blk_pos = scan[scan_pos];
-        s64 level_double = src_coef[blk_pos];
-        u32 max_abs_level;
-        s8 lower_int;
-        s64 temp_level;
+    nnz = xeve_func_rdoq_est_level(src_coef, tmp_coef, tmp_level_double, tmp_err0, max_num_coef, q_value, q_bits, err_scale, &d64_block_uncoded_cost);
 
-        temp_level = ((s64)XEVE_ABS(src_coef[blk_pos]) * (s64)q_value);
-
-        level_double = (int)XEVE_MIN(((s64)temp_level), (s64)XEVE_INT32_MAX - (s64)(1 << (q_bits - 1)));
-        tmp_level_double[blk_pos] = level_double;
-        max_abs_level = (u32)(level_double >> q_bits);
-        lower_int = ((level_double - ((s64)max_abs_level << q_bits)) < (s64)(1 << (q_bits - 1))) ? 1 : 0;
-
-        if (!lower_int)
-        {
-            max_abs_level++;
-        }
-
-        err = (level_double * err_scale) >> ERR_SCALE_PRECISION_BITS;
-        d64_block_uncoded_cost += err * err;
-        tmp_coef[blk_pos] = src_coef[blk_pos] > 0 ? (s16)max_abs_level : -(s16)(max_abs_level);
-        sum_all += max_abs_level;
-    }
-
-    xeve_mset(dst_tmp, 0, sizeof(s16)*max_num_coef);
-
-    if (sum_all == 0)
+    if (nnz == 0)
     {       
+        xeve_mset(dst_tmp, 0, sizeof(s16)*max_num_coef);
         return nnz;
     }
+    nnz = 0;
+
+    /* positions after the last rounded level cannot end up coded */
+    last_scan_pos = max_num_coef - 1;
+    while(tmp_coef[scan[last_scan_pos]] == 0)
+    {
+        last_scan_pos--;
+    }
 
     if (!is_intra && ch_type == Y_C)
     {
@@ -582,15 +620,15 @@ int xeve_rdoq_run_length_cc(u8 qp, double d_lambda, u8 is_intra, s16 *src_coef,
     run = 0;
     prev_level = 6;
 
-    for (scan_pos = 0; scan_pos < max_num_coef; scan_pos++)
+    for (scan_pos = 0; scan_pos <= last_scan_pos; scan_pos++)
     {
         u32 blk_pos = scan[scan_pos];
         u32 level;
         int ctx_run = core->ctx->fn_rdoq_set_ctx_cc(core, ch_type, prev_level);
         int ctx_level = ctx_run;
 
-        level = get_coded_level_rl(&d64_uncoded_cost, &d64_coded_cost, tmp_level_double[blk_pos], XEVE_ABS(tmp_coef[blk_pos]), run, ctx_run, ctx_level, q_bits, err_scale, lambda,  core);
-        tmp_dst_coef[blk_pos] = tmp_coef[blk_pos] < 0 ? -(s32)(level) : level;
+        level = get_coded_level_rl(&d64_uncoded_cost, &d64_coded_cost, tmp_level_double[blk_pos], tmp_err0[blk_pos], tmp_coef[blk_pos], run, ctx_run, ctx_level, q_bits, err_scale, lambda,  core);
+        tmp_dst_coef[blk_pos] = src_coef[blk_pos] < 0 ? -(s32)(level) : level;
         d64_base_cost -= d64_uncoded_cost;
         d64_base_cost += d64_coded_cost;
 
@@ -618,26 +656,146 @@ int xeve_rdoq_run_length_cc(u8 qp, double d_lambda, u8 is_intra, s16 *src_coef,
     }
 
     /* ===== clean uncoded coeficients ===== */
-    for (scan_pos = 0; scan_pos < max_num_coef; scan_pos++)
+    xeve_mset(dst_tmp, 0, sizeof(s16)*max_num_coef);
+    for (scan_pos = 0; scan_pos < best_last_idx_p1; scan_pos++)
     {
         u32 blk_pos = scan[scan_pos];
 
-        if (scan_pos < best_last_idx_p1)
+        if (tmp_dst_coef[blk_pos])
         {
-            if (tmp_dst_coef[blk_pos])
-            {
-                nnz++;
-            }
+            nnz++;
         }
-        else
+        dst_tmp[blk_pos] = tmp_dst_coef[blk_pos];
+    }
+
+    return nnz;
+}
+
+#define FAST_RDOQ_INTRA_RND_OFST  201 //171
+#define FAST_RDOQ_INTER_RND_OFST  153 //85
+
+/* largest magnitude of an entry, largest squared norm and largest L1 norm of
+   a row of xeve_tbl_tm2 to xeve_tbl_tm64 */
+static const int xeve_tbl_tm_max[MAX_TR_LOG2] = { 64, 84, 89, 90, 90, 90 };
+static const s64 xeve_tbl_tm_norm2[MAX_TR_LOG2] = { 8192, 16562, 33124, 66248, 132496, 264992 };
+static const int xeve_tbl_tm_l1[MAX_TR_LOG2] = { 128, 256, 512, 1024, 2048, 4096 };
+
+s64 xeve_resi_ssd_sad(s16 * resi, int num, s64 * sad)
+{
+    s64 ssd = 0;
+    s32 abs_sum = 0;
+    int i;
+
+    for(i = 0; i < num; i++)
+    {
+        ssd += resi[i] * resi[i];
+        abs_sum += XEVE_ABS(resi[i]);
+    }
+    *sad = abs_sum;
+    return ssd;
+}
+
+/* tells whether no coefficient of the transform of a residual block with the
+   given sum of squares and of absolute values can exceed c_max in magnitude.
+   a coefficient is the inner product of the residual with a product of two
+   matrix rows, so it is bounded by the product of the row norms times the
+   L2 norm of the residual, and by the product of the largest entries times
+   its L1 norm. iqt selects the two stage transform that rounds (and stores
+   in 16 bits) after the first stage */
+int xeve_tq_zero_block(s64 ssd, s64 sad, int log2_w, int log2_h, int shift1, int shift2, int iqt, int c_max)
+{
+    double lim, x1;
+    double sad_bound = (double)xeve_tbl_tm_max[log2_w - 1] * xeve_tbl_tm_max[log2_h - 1] * sad;
+    double ssd_bound = (double)xeve_tbl_tm_norm2[log2_w - 1] * xeve_tbl_tm_norm2[log2_h - 1] * ssd;
+
+    /* the coefficients are stored in 16 bits */
+    c_max = XEVE_MIN(c_max, 32766);
+    if(c_max < 0)
+    {
+        return 0;
+    }
+
+    if(iqt)
+    {
+        if(shift1 <= 0)
         {
-            tmp_dst_coef[blk_pos] = 0;
+            return 0;
         }
+        /* each first stage value is off by at most one half after rounding
+           and must not wrap in 16 bits */
+        x1 = XEVE_MIN((double)xeve_tbl_tm_max[log2_w - 1] * sad, sqrt((double)xeve_tbl_tm_norm2[log2_w - 1] * ssd));
+        if(x1 / (1 << shift1) + 1 >= 32767)
+        {
+            return 0;
+        }
+        lim = ((c_max + 0.5) * (1 << shift2) - 0.5 * xeve_tbl_tm_l1[log2_h - 1]) * (1 << shift1);
+    }
+    else
+    {
+        lim = (c_max + 0.5) * ((s64)1 << (shift1 + shift2));
+    }
+    /* keep clear of the rounding of the floating point products */
+    lim *= 0.999999;
 
-        dst_tmp[blk_pos] = tmp_dst_coef[blk_pos];
+    return lim > 0 && (sad_bound < lim || ssd_bound < lim * lim);
+}
+
+/* largest coefficient magnitude that the quantisation of xeve_quant_nnz()
+   turns into zero. ns_quant tells that the quantisation without RDOQ scales
+   non-square blocks as well, which the main profile does */
+int xeve_quant_zero_max(u8 qp, int log2_cuw, int log2_cuh, u16 scale, int slice_type, int bit_depth, int use_rdoq, int ns_quant)
+{
+    const int ns = ((log2_cuw + log2_cuh) & 1) && (use_rdoq || ns_quant);
+    const int ns_shift = ns ? 7 : 0;
+    const int ns_scale = ns ? 181 : 1;
+    int log2_size = (log2_cuw + log2_cuh) >> 1;
+    int shift = QUANT_SHIFT + MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size + ns_shift + (qp / 6);
+    s64 offset;
+
+    if(use_rdoq)
+    {
+        offset = (s64)((slice_type == SLICE_I) ? FAST_RDOQ_INTRA_RND_OFST : FAST_RDOQ_INTER_RND_OFST) << (s64)(shift - 9);
+    }
+    else
+    {
+        offset = (s64)((slice_type == SLICE_I) ? 171 : 85) << (s64)(shift - 9);
     }
+    return (int)XEVE_MIN(((((s64)1 << shift) - offset) - 1) / ((s64)scale * ns_scale), XEVE_INT32_MAX);
+}
 
-    return nnz;
+/* tells whether every transform block of log2_w_sub x log2_h_sub samples of
+   a residual block of log2_w x log2_h samples quantises to zero */
+int xeve_tq_zero_resi(s16 * resi, int log2_w, int log2_h, int log2_w_sub, int log2_h_sub, int bit_depth, int iqt, int c_max)
+{
+    int shift1 = xeve_get_transform_shift(log2_w_sub, 0, bit_depth);
+    int shift2 = xeve_get_transform_shift(log2_h_sub, 1, bit_depth);
+    int stride = 1 << log2_w;
+    int i, j, x, y;
+
+    for(j = 0; j < (1 << log2_h); j += (1 << log2_h_sub))
+    {
+        for(i = 0; i < stride; i += (1 << log2_w_sub))
+        {
+            s16 * r = resi + j * stride + i;
+            s64   ssd = 0;
+            s64   sad = 0;
+
+            for(y = 0; y < (1 << log2_h_sub); y++)
+            {
+                for(x = 0; x < (1 << log2_w_sub); x++)
+                {
+                    ssd += r[x] * r[x];
+                    sad += XEVE_ABS(r[x]);
+                }
+                r += stride;
+            }
+            if(!xeve_tq_zero_block(ssd, sad, log2_w_sub, log2_h_sub, shift1, shift2, iqt, c_max))
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
 }
 
 static int xeve_quant_nnz(u8 qp, double lambda, int is_intra, s16 * coef, int log2_cuw, int log2_cuh, u16 scale, int ch_type
@@ -647,36 +805,22 @@ static int xeve_quant_nnz(u8 qp, double lambda, int is_intra, s16 * coef, int lo
 
     if(use_rdoq)
     {
-        s64 lev;
         s64 offset;
-        int i;
         int shift;
         int tr_shift;
         int log2_size = (log2_cuw + log2_cuh) >> 1;
         const int ns_shift = ((log2_cuw + log2_cuh) & 1) ? 7 : 0;
         const int ns_scale = ((log2_cuw + log2_cuh) & 1) ? 181 : 1;
         s64 zero_coeff_threshold;
-        BOOL is_coded = 0;
 
         tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size + ns_shift;
         shift = QUANT_SHIFT + tr_shift + (qp / 6);
 
-#define FAST_RDOQ_INTRA_RND_OFST  201 //171
-#define FAST_RDOQ_INTER_RND_OFST  153 //85
         offset = (s64)((slice_type == SLICE_I) ? FAST_RDOQ_INTRA_RND_OFST : FAST_RDOQ_INTER_RND_OFST) << (s64)(shift - 9);
         zero_coeff_threshold = ((s64)1 << (s64)shift) - offset;
 
-        for(i = 0; i < (1 << (log2_cuw + log2_cuh)); i++)
-        {
-            lev = (s64)XEVE_ABS(coef[i]) * (s64)scale * ns_scale;
-            if(lev >= zero_coeff_threshold)
-            {
-                is_coded = 1;
-                break;
-            }
-        }
-
-        if(!is_coded)
+        /* the block is coded if its largest coefficient passes the threshold */
+        if((s64)xeve_func_coef_abs_max(coef, 1 << (log2_cuw + log2_cuh)) * (s64)scale * ns_scale < zero_coeff_threshold)
         {
             xeve_mset(coef, 0, sizeof(coef[0])*((s64)1 << (log2_cuw + log2_cuh)));
             return nnz;
@@ -689,28 +833,17 @@ static int xeve_quant_nnz(u8 qp, double lambda, int is_intra, s16 * coef, int lo
     }
     else
     {
-        s32 lev;
         s32 offset;
-        int sign;
-        int i;
         int shift;
         int tr_shift;
         int log2cuwh_sum = log2_cuw + log2_cuh;
         int log2_size = log2cuwh_sum >> 1;
-        int cuwh = (1 << (log2cuwh_sum));
 
         tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size;
         shift = QUANT_SHIFT + tr_shift + (qp / 6);
         offset = (s32)((slice_type == SLICE_I) ? 171 : 85) << (s32)(shift - 9);
 
-        for (i = 0; i < cuwh; i++)
-        {
-            sign = XEVE_SIGN_GET(coef[i]);
-            lev = (s32)XEVE_ABS(coef[i]) * (s32)scale; // coeff is in 10 bit and scale is in 16 bit, so product should fit in 32 bit precision
-            lev = (s16)((lev + offset) >> shift);
-            coef[i] = (s16)XEVE_SIGN_SET(lev, sign);
-            nnz += !!(coef[i]);
-        }
+        nnz = xeve_func_quant(coef, 1 << log2cuwh_sum, scale, offset, shift);
     }
 
     return nnz;
@@ -718,6 +851,17 @@ static int xeve_quant_nnz(u8 qp, double lambda, int is_intra, s16 * coef, int lo
 
 static int xeve_tq_nnz(u8 qp, double lambda, s16 * coef, int log2_cuw, int log2_cuh, u16 scale, int slice_type, int ch_type, int is_intra, XEVE_CORE * core, int bit_depth, int rdoq)
 {
+    s64 ssd, sad;
+
+    /* skip transform and quantisation of residuals that cannot survive them */
+    ssd = xeve_resi_ssd_sad(coef, 1 << (log2_cuw + log2_cuh), &sad);
+    if(xeve_tq_zero_block(ssd, sad, log2_cuw, log2_cuh, xeve_get_transform_shift(log2_cuw, 0, bit_depth), xeve_get_transform_shift(log2_cuh, 1, bit_depth), 0
+                        , xeve_quant_zero_max(qp, log2_cuw, log2_cuh, scale, slice_type, bit_depth, rdoq, 0)))
+    {
+        xeve_mset(coef, 0, sizeof(s16) * ((s64)1 << (log2_cuw + log2_cuh)));
+        return 0;
+    }
+
     xeve_trans(coef, log2_cuw, log2_cuh, bit_depth);
     return xeve_quant_nnz(qp, lambda, is_intra, coef, log2_cuw, log2_cuh, scale, ch_type, slice_type, core, bit_depth, rdoq);
 }
@@ -795,3 +939,27 @@ int xeve_sub_block_tq(XEVE_CTX * ctx, XEVE_CORE * core, s16 coef[N_C][MAX_CU_DIM
 
     return (nnz[Y_C] + nnz[U_C] + nnz[V_C]);
 }
+
+int xeve_sub_block_tq_zero(XEVE_CTX * ctx, XEVE_CORE * core, s16 resi[N_C][MAX_CU_DIM], int log2_cuw, int log2_cuh, int slice_type)
+{
+    int log2_w_sub = (log2_cuw > MAX_TR_LOG2) ? MAX_TR_LOG2 : log2_cuw;
+    int log2_h_sub = (log2_cuh > MAX_TR_LOG2) ? MAX_TR_LOG2 : log2_cuh;
+    int w_shift = ctx->param.cs_w_shift;
+    int h_shift = ctx->param.cs_h_shift;
+    int bit_depth = ctx->sps.bit_depth_luma_minus8 + 8;
+    u8 qp[N_C] = { core->qp_y, core->qp_u, core->qp_v };
+    int c, ws, hs, scale;
+
+    for(c = 0; c < (ctx->sps.chroma_format_idc ? N_C : 1); c++)
+    {
+        ws = c ? w_shift : 0;
+        hs = c ? h_shift : 0;
+        scale = xeve_quant_scale[ctx->param.tool_iqt][qp[c] % 6];
+        if(!xeve_tq_zero_resi(resi[c], log2_cuw - ws, log2_cuh - hs, log2_w_sub - ws, log2_h_sub - hs, bit_depth, 0
+                            , xeve_quant_zero_max(qp[c], log2_w_sub - ws, log2_h_sub - hs, scale, slice_type, bit_depth, ctx->param.rdoq, 0)))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
@@ -43,7 +43,14 @@ int xeve_rdoq_set_ctx_cc(XEVE_CORE * core, int ch_type, int prev_level);
 int xeve_sub_block_tq(XEVE_CTX * ctx, XEVE_CORE * core, s16 coef[N_C][MAX_CU_DIM], int log2_cuw, int log2_cuh, int slice_type, int nnz[N_C], int is_intra, int run_stats);
 int xeve_rdoq_run_length_cc(u8 qp, double d_lambda, u8 is_intra, s16 *src_coef, s16 *dst_tmp, int log2_cuw, int log2_cuh, int ch_type, XEVE_CORE * core, int bit_depth);
 void xeve_init_err_scale(XEVE_CTX * ctx);
-extern const XEVE_TXB(*xeve_func_txb)[MAX_TR_LOG2];
+int xeve_quant(s16 * coef, int num, int scale, s64 offset, int shift);
+u32 xeve_coef_abs_max(s16 * coef, int num);
+s64 xeve_resi_ssd_sad(s16 * resi, int num, s64 * sad);
+int xeve_tq_zero_block(s64 ssd, s64 sad, int log2_w, int log2_h, int shift1, int shift2, int iqt, int c_max);
+int xeve_quant_zero_max(u8 qp, int log2_cuw, int log2_cuh, u16 scale, int slice_type, int bit_depth, int use_rdoq, int ns_quant);
+int xeve_tq_zero_resi(s16 * resi, int log2_w, int log2_h, int log2_w_sub, int log2_h_sub, int bit_depth, int iqt, int c_max);
+int xeve_sub_block_tq_zero(XEVE_CTX * ctx, XEVE_CORE * core, s16 resi[N_C][MAX_CU_DIM], int log2_cuw, int log2_cuh, int slice_type);
+int xeve_rdoq_est_level(s16 * src, s16 * level, s32 * level_double, s64 * err0, int num, int q_value, int q_bits, s64 err_scale, s64 * err0_sum);
 void tx_pb2b(void* src, void* dst, int shift, int line, int step);
 void tx_pb4b(void* src, void* dst, int shift, int line, int step);
 void tx_pb8b(void* src, void* dst, int shift, int line, int step);
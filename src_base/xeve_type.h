@@ -37,6 +37,7 @@
 #ifndef ARM
 #include "xeve_sad_sse.h"
 #include "xeve_sad_avx.h"
+#include "xeve_sad_avx512.h"
 #else
 #include "xeve_sad_neon.h"
 #endif
@@ -154,6 +155,7 @@ typedef struct _XEVE_MODE
  * pre-defined structure
  *****************************************************************************/
 typedef struct _XEVE_CTX XEVE_CTX;
+typedef struct _XEVE_FUNC XEVE_FUNC;
 typedef struct _XEVE_ALF XEVE_ALF;
 typedef struct _XEVE_CORE XEVE_CORE;
 typedef struct _XEVE_IBC_HASH XEVE_IBC_HASH;
@@ -166,6 +168,9 @@ typedef struct _XEVE_RC XEVE_RC;
  *****************************************************************************/
 typedef void (*XEVE_ITXB)(void* coef, void* t, int shift, int line, int step);
 typedef void(*XEVE_TXB)(void* coef, void* t, int shift, int line, int step);
+typedef int (*XEVE_QUANT)(s16 * coef, int num, int scale, s64 offset, int shift);
+typedef u32 (*XEVE_COEF_ABS_MAX)(s16 * coef, int num);
+typedef int (*XEVE_RDOQ_EST_LEVEL)(s16 * src, s16 * level, s32 * level_double, s64 * err0, int num, int q_value, int q_bits, s64 err_scale, s64 * err0_sum);
 
 /* forecast information */
 typedef struct _XEVE_FCST
@@ -176,6 +181,18 @@ typedef struct _XEVE_FCST
     int                   h_blk;
     int                   f_blk;
 
+    /* input picture under analysis */
+    struct _XEVE_PICO   * pico;
+    /* threads of the asynchronous lookahead (param.lookahead_threads),
+       [0] runs the analysis and the others are the block row workers */
+    POOL_THREAD         * thread_pool;
+    TASK_SCHEDULER      * sched;
+    THREAD_TASK         * task;
+    SYNC_OBJ              sync_wait;
+    /* number of finished blocks in every block row */
+    volatile s32        * sync_row;
+    /* analysis is running on thread_pool[0] */
+    int                   busy;
 }XEVE_FCST;
 
 typedef struct _QP_ADAPT_PARAM
@@ -211,6 +228,9 @@ typedef struct _XEVE_SPIC_INFO
     /* decided slice depth by forecast */
     s32                     slice_depth;
 
+    /* mini-GOP size decided by forecast for the GOP ending at this anchor */
+    s32                     mgop_size;
+
     /* complexity type
        0 : normal
        1 : slow scene  (ex: close up, outpocusing scene)
@@ -331,6 +351,7 @@ typedef struct _XEVE_PRED_INTER_COMP
 
 } XEVE_PRED_INTER_COMP;
 
+typedef struct _XEVE_ME_CACHE XEVE_ME_CACHE;
 typedef struct _XEVE_PINTER XEVE_PINTER;
 struct _XEVE_PINTER
 {
@@ -437,9 +458,13 @@ struct _XEVE_PINTER
     int                 skip_merge_cand_num;
     int                 me_complexity;
     s64                 best_ssd;
+    /* residual of the best SKIP candidate of the current CU quantises to zero */
+    int                 early_skip;
     const s16        (* mc_l_coeff)[8];
     const s16        (* mc_c_coeff)[4];
     const XEVE_PRED_INTER_COMP * me_opt;
+    /* best MVs of the motion searches in the current CTU, NULL when not used */
+    XEVE_ME_CACHE     * me_cache;
     /* ME function (Full-ME or Fast-ME) */
     u32 (*fn_me)(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2_cuh, s8 *refi, int lidx, s16 mvp[MV_D], s16 mv[MV_D], int bi, int bit_depth_luma);
     /* AFFINE ME function (Gradient-ME) */
@@ -637,6 +662,8 @@ struct _XEVE_CORE
     int                lcu_num;
     /*QP for current encoding CU. Used to derive Luma and chroma qp*/
     u8                 qp;
+    /* qp offset of the current CTU row from the row level rate control */
+    s8                 dqp_row;
     u8                 cu_qp_delta_code;
     u8                 cu_qp_delta_is_coded;
     u8                 cu_qp_delta_code_mode;
@@ -723,6 +750,8 @@ struct _XEVE_CORE
     int                tile_idx;
     XEVE_CTX         * ctx;
     int                thread_cnt;
+    /* accumulated time (us) this thread waited for the CTU dependencies */
+    s64                wait_time;
     TREE_CONS          tree_cons; //!< Tree status
     u8                 ctx_flags[NUM_CNID];
     int                split_mode_child[4];
@@ -825,6 +854,8 @@ struct _XEVE_CTX
     /* ignored pictures for force slice count (unavailable pictures cnt in gop,\
     only used for bumping process) */
     u8                 force_ignored_cnt;
+    /* mini-GOP size of the GOP being encoded (adaptive GOP) */
+    int                mgop_size;
     /* initial frame return number(delayed input count) due to B picture or Forecast */
     u32                frm_rnum;
     /* current encoding slice number in one picture */
@@ -904,17 +935,32 @@ struct _XEVE_CTX
     /* bs_tbuf byte size for one tile */
     int                bs_tbuf_size;
     THREAD_CONTROLLER * tc;
-    POOL_THREAD        thread_pool[XEVE_MAX_THREADS];
+    POOL_THREAD      * thread_pool;
     int                parallel_rows;
     volatile s32     * sync_flag;
+    /* number of deblocked LCUs in each LCU row of the current tile */
+    volatile s32     * sync_dbk;
+    /* LCU rows of the picture are deblocked by the CTU analysis lanes */
+    int                loop_filter_pipe;
+    /* borders of the reconstruction are expanded LCU row by LCU row behind the deblocking */
+    int                expand_pipe;
     SYNC_OBJ           sync_block;
+    /* wait object for the CTU dependencies */
+    SYNC_OBJ           sync_wait;
+    /* task scheduler running on the thread pool */
+    TASK_SCHEDULER   * sched;
+    /* tasks of the current parallel stage (tiles or CTU row lanes) */
+    THREAD_TASK      * task;
+    /* per-thread contexts (param.threads entries) */
     /* address of core structure */
-    XEVE_CORE        * core[XEVE_MAX_THREADS];
-    XEVE_BSW           bs[XEVE_MAX_THREADS];
-    XEVE_SBAC          sbac_enc[XEVE_MAX_THREADS];
-    XEVE_MODE          mode[XEVE_MAX_THREADS];
-    XEVE_PINTRA        pintra[XEVE_MAX_THREADS];
-    XEVE_PINTER        pinter[XEVE_MAX_THREADS];
+    XEVE_CORE       ** core;
+    XEVE_BSW         * bs;
+    XEVE_SBAC        * sbac_enc;
+    XEVE_MODE        * mode;
+    XEVE_PINTRA      * pintra;
+    XEVE_PINTER      * pinter;
+    /* storage of qp_prev_eco of all tiles */
+    u8               * tile_qp_prev_eco;
 
 
     /* qp table */
@@ -934,7 +980,7 @@ struct _XEVE_CTX
     int   (*fn_enc_pic)(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat);
     int   (*fn_enc_pic_finish)(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat);
     int   (*fn_push)(XEVE_CTX * ctx, XEVE_IMGB * img);
-    int   (*fn_deblock)(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int filter_across_boundary, XEVE_CORE * core);
+    int   (*fn_deblock)(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int y_lcu, int filter_across_boundary, XEVE_CORE * core);
     void  (*fn_picbuf_expand)(XEVE_CTX * ctx, XEVE_PIC * pic);
     int   (*fn_get_inbuf)(XEVE_CTX * ctx, XEVE_IMGB ** img);
     /* mode decision functions */
@@ -972,6 +1018,7 @@ struct _XEVE_CTX
     void  (*fn_eco_sbac_reset)(XEVE_SBAC *sbac, u8 slice_type, u8 slice_qp, int sps_cm_init_flag);
     void  (*fn_itdp)(XEVE_CTX * ctx, XEVE_CORE * core, s16 coef[N_C][MAX_CU_DIM], int nnz_sub[N_C][MAX_SUB_TB_NUM]);
     int   (*fn_tq)(XEVE_CTX * ctx, XEVE_CORE * core, s16 coef[N_C][MAX_CU_DIM], int log2_cuw, int log2_cuh, int slice_type, int nnz[N_C], int is_intra, int run_stats);
+    int   (*fn_tq_zero)(XEVE_CTX * ctx, XEVE_CORE * core, s16 resi[N_C][MAX_CU_DIM], int log2_cuw, int log2_cuh, int slice_type);
     int   (*fn_rdoq_set_ctx_cc)(XEVE_CORE * core, int ch_type, int prev_level);
     void  (*fn_recon)(XEVE_CTX * ctx, XEVE_CORE * core, s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth);
     void  (*fn_deblock_unit)(XEVE_CTX * ctx, XEVE_PIC * pic, int x, int y, int cuw, int cuh, int is_hor_edge, XEVE_CORE * core, int boundary_filtering);
@@ -979,7 +1026,8 @@ struct _XEVE_CTX
     int   (*fn_set_tile_info)(XEVE_CTX * ctx);
     void  (*fn_deblock_tree)(XEVE_CTX * ctx, XEVE_PIC * pic, int x, int y, int cuw, int cuh, int cud, int cup, int is_hor_edge, TREE_CONS tree_cons, XEVE_CORE * core, int boundary_filtering);
     void  (*fn_pic_flt)(XEVE_CTX * ctx, XEVE_IMGB * img);
-    const XEVE_ITXB(*fn_itxb)[MAX_TR_LOG2];
+    /* kernels selected by xeve_platform_init_func() */
+    const XEVE_FUNC  * func;
     /* platform specific data, if needed */
     void             * pf;
 
@@ -1009,6 +1057,7 @@ typedef struct _ALF_SLICE_PARAM ALF_SLICE_PARAM;
 #include "xeve_fcst.h"
 #include "xeve_mode.h"
 #include "xeve_pred.h"
+#include "xeve_me_cache.h"
 #include "xeve_rc.h"
 #include "xeve_tq.h"
 #include "xeve_df.h"
@@ -1019,11 +1068,64 @@ typedef struct _ALF_SLICE_PARAM ALF_SLICE_PARAM;
 #ifndef ARM
 #include "xeve_itdq_sse.h"
 #include "xeve_itdq_avx.h"
+#include "xeve_tq_sse.h"
 #include "xeve_tq_avx.h"
+#include "xeve_tq_avx512.h"
+#include "xeve_itdq_avx512.h"
+#include "xeve_df_sse.h"
+#include "xeve_util_sse.h"
+#include "xeve_util_avx.h"
 #else
 #include "xeve_itdq_neon.h"
 #include "xeve_tq_neon.h"
+#include "xeve_util_neon.h"
 #endif
 #include "xeve_enc.h"
 
+/*****************************************************************************
+ * optimized kernels of an encoder instance
+ *
+ * one immutable table per instruction set; the context points to the one it
+ * selected. kernels are called through the context the calling thread works
+ * for (thread_owner), which is set on every API call and passed on to the
+ * threads of the instance, so instances can use different instruction sets.
+ *****************************************************************************/
+struct _XEVE_FUNC
+{
+    const XEVE_FN_SAD    (*sad)[8];
+    const XEVE_FN_SSD    (*ssd)[8];
+    const XEVE_FN_DIFF   (*diff)[8];
+    const XEVE_FN_SATD    *satd;
+    const XEVE_MC_L      (*mc_l)[2];
+    const XEVE_MC_C      (*mc_c)[2];
+    XEVE_AVG_NO_CLIP       average_no_clip;
+    const XEVE_ITXB      (*itxb)[MAX_TR_LOG2];
+    const XEVE_TXB       (*txb)[MAX_TR_LOG2];
+    XEVE_QUANT             quant;
+    XEVE_COEF_ABS_MAX      coef_abs_max;
+    XEVE_RDOQ_EST_LEVEL    rdoq_est_level;
+    const XEVE_DBK       (*dbk)[2];
+    XEVE_PLANE_SHL         plane_shl_8b;
+    XEVE_PLANE_SHL         plane_shl_16b;
+    XEVE_PLANE_EXPAND_LR   plane_expand_lr;
+};
+
+#define XEVE_FUNC_CUR             (((XEVE_CTX *)thread_owner)->func)
+
+#define xeve_func_sad             (XEVE_FUNC_CUR->sad)
+#define xeve_func_ssd             (XEVE_FUNC_CUR->ssd)
+#define xeve_func_diff            (XEVE_FUNC_CUR->diff)
+#define xeve_func_satd            (XEVE_FUNC_CUR->satd)
+#define xeve_func_mc_l            (XEVE_FUNC_CUR->mc_l)
+#define xeve_func_mc_c            (XEVE_FUNC_CUR->mc_c)
+#define xeve_func_average_no_clip (XEVE_FUNC_CUR->average_no_clip)
+#define xeve_func_txb             (XEVE_FUNC_CUR->txb)
+#define xeve_func_quant           (XEVE_FUNC_CUR->quant)
+#define xeve_func_coef_abs_max    (XEVE_FUNC_CUR->coef_abs_max)
+#define xeve_func_rdoq_est_level  (XEVE_FUNC_CUR->rdoq_est_level)
+#define xeve_func_dbk             (XEVE_FUNC_CUR->dbk)
+#define xeve_func_plane_shl_8b    (XEVE_FUNC_CUR->plane_shl_8b)
+#define xeve_func_plane_shl_16b   (XEVE_FUNC_CUR->plane_shl_16b)
+#define xeve_func_plane_expand_lr (XEVE_FUNC_CUR->plane_expand_lr)
+
 #endif /* _XEVE_TYPE_H_ */
@@ -186,11 +186,44 @@ void xeve_picbuf_free(XEVE_PIC *pic)
         xeve_mfree(pic->map_unrefined_mv);
         xeve_mfree(pic->map_refi);
         xeve_mfree(pic->map_dqp_lah);
+        xeve_mfree(pic->buf_spel);
         xeve_mfree(pic);
     }
 }
 
-static void picbuf_expand(pel *a, int s, int w, int h, int exp)
+void xeve_plane_shl_8b(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift)
+{
+    u8 *s = (u8 *)src;
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j++)
+        {
+            dst[j] = (pel)(s[j] << shift);
+        }
+        s += s_src;
+        dst += s_dst;
+    }
+}
+
+void xeve_plane_shl_16b(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift)
+{
+    u16 *s = (u16 *)src;
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j++)
+        {
+            dst[j] = (pel)(s[j] << shift);
+        }
+        s += s_src;
+        dst += s_dst;
+    }
+}
+
+void xeve_plane_expand_lr(pel *a, int s, int w, int h, int exp)
 {
     int i, j;
     pel pixel;
@@ -225,36 +258,134 @@ static void picbuf_expand(pel *a, int s, int w, int h, int exp)
         dst += s;
         src += s;
     }
+}
 
-    /* upper */
-    src = a - exp;
-    dst = a - exp - (exp * s);
+/* expands lines [y, y + rows) to the left and right, and the picture
+   to the top or bottom when the lines include the first or last line */
+static void picbuf_expand(pel *a, int s, int w, int h, int y, int rows, int exp)
+{
+    int i;
+    pel *src, *dst;
 
-    for(i = 0; i < exp; i++)
+    xeve_func_plane_expand_lr(a + y * s, s, w, rows, exp);
+
+    /* upper */
+    if(y == 0)
     {
-        xeve_mcpy(dst, src, s*sizeof(pel));
-        dst += s;
+        src = a - exp;
+        dst = a - exp - (exp * s);
+
+        for(i = 0; i < exp; i++)
+        {
+            xeve_mcpy(dst, src, s*sizeof(pel));
+            dst += s;
+        }
     }
 
     /* below */
-    src = a + ((h - 1)*s) - exp;
-    dst = a + ((h - 1)*s) - exp + s;
-
-    for(i = 0; i < exp; i++)
+    if(y + rows == h)
     {
-        xeve_mcpy(dst, src, s*sizeof(pel));
-        dst += s;
+        src = a + ((h - 1)*s) - exp;
+        dst = a + ((h - 1)*s) - exp + s;
+
+        for(i = 0; i < exp; i++)
+        {
+            xeve_mcpy(dst, src, s*sizeof(pel));
+            dst += s;
+        }
     }
 }
 
+void xeve_picbuf_expand_rows(XEVE_PIC *pic, int y, int rows, int exp_l, int exp_c, int chroma_format_idc)
+{
+    int sft_h, y_c;
+
+    rows = XEVE_MIN(y + rows, pic->h_l) - y;
+    picbuf_expand(pic->y, pic->s_l, pic->w_l, pic->h_l, y, rows, exp_l);
+    if(chroma_format_idc)
+    {
+        sft_h = XEVE_GET_CHROMA_H_SHIFT(chroma_format_idc);
+        y_c = y >> sft_h;
+        /* the sub-picture of the forecast has no chroma planes (h_c is 0) */
+        rows = XEVE_MIN((y + rows) >> sft_h, pic->h_c) - y_c;
+        if(rows > 0)
+        {
+            picbuf_expand(pic->u, pic->s_c, pic->w_c, pic->h_c, y_c, rows, exp_c);
+            picbuf_expand(pic->v, pic->s_c, pic->w_c, pic->h_c, y_c, rows, exp_c);
+        }
+    }
+}
 
 void xeve_picbuf_expand(XEVE_PIC *pic, int exp_l, int exp_c, int chroma_format_idc)
 {
-    picbuf_expand(pic->y, pic->s_l, pic->w_l, pic->h_l, exp_l);
-    if(chroma_format_idc)
+    xeve_picbuf_expand_rows(pic, 0, pic->h_l, exp_l, exp_c, chroma_format_idc);
+}
+
+int xeve_picbuf_spel_alloc(XEVE_PIC *pic, int level)
+{
+    /* half-pel phases only, or all of the quarter-pel phases */
+    int    cnt = (level == 1) ? 3 : 15;
+    int    size = pic->imgb->bsize[0];
+    int    i, k;
+
+    if(pic->buf_spel != NULL)
     {
-        picbuf_expand(pic->u, pic->s_c, pic->w_c, pic->h_c, exp_c);
-        picbuf_expand(pic->v, pic->s_c, pic->w_c, pic->h_c, exp_c);
+        return XEVE_OK;
+    }
+
+    pic->buf_spel = xeve_malloc_fast(size * cnt);
+    xeve_assert_rv(pic->buf_spel != NULL, XEVE_ERR_OUT_OF_MEMORY);
+
+    for(i = 1, k = 0; i < 16; i++)
+    {
+        if(level == 1 && (i & 0x5))
+        {
+            continue;
+        }
+        pic->spel[i] = (pel *)((u8 *)pic->buf_spel + size * k++) + (pic->y - pic->buf_y);
+    }
+    return XEVE_OK;
+}
+
+void xeve_picbuf_spel_build(XEVE_PIC *pic, int y, int rows, const s16(*mc_l_coeff)[8], int bit_depth)
+{
+    int x0 = SPEL_PLANE_MARGIN - pic->pad_l;
+    int x1 = pic->w_l + pic->pad_l - SPEL_PLANE_MARGIN;
+    int y0 = y;
+    int y1 = XEVE_MIN(y + rows, pic->h_l);
+    int i, j, k, x, h, dx, dy;
+
+    /* the planes cover the padding above the first and below the last line */
+    if(y0 == 0)
+    {
+        y0 = SPEL_PLANE_MARGIN - pic->pad_l;
+    }
+    if(y1 == pic->h_l)
+    {
+        y1 = pic->h_l + pic->pad_l - SPEL_PLANE_MARGIN;
+    }
+
+    for(k = 1; k < 16; k++)
+    {
+        if(pic->spel[k] == NULL)
+        {
+            continue;
+        }
+        dx = (k & 3) << 2;
+        dy = (k >> 2) << 2;
+
+        for(i = y0; i < y1; i += h)
+        {
+            h = XEVE_MIN(MAX_CU_SIZE, y1 - i);
+            for(j = x0; j < x1; j += MAX_CU_SIZE)
+            {
+                /* the last block overlaps the previous one instead of being narrower,
+                   which keeps the width in the range of the MC kernels */
+                x = XEVE_MIN(j, x1 - MAX_CU_SIZE);
+                xeve_mc_l(dx, dy, pic->y, (x << 4) | dx, (i << 4) | dy, pic->s_l, pic->s_l,
+                          pic->spel[k] + i * pic->s_l + x, MAX_CU_SIZE, h, bit_depth, mc_l_coeff);
+            }
+        }
     }
 }
 
@@ -1568,25 +1699,12 @@ static int imgb_release(XEVE_IMGB * imgb)
 
 static void imgb_cpy_shift_left_8b(XEVE_IMGB * imgb_dst, XEVE_IMGB * imgb_src, int shift)
 {
-    int i, j, k;
-
-    unsigned char * s;
-    short         * d;
+    int i;
 
     for (i = 0; i < imgb_dst->np; i++)
     {
-        s = imgb_src->a[i];
-        d = imgb_dst->a[i];
-
-        for (j = 0; j < imgb_src->h[i]; j++)
-        {
-            for (k = 0; k < imgb_src->w[i]; k++)
-            {
-                d[k] = (short)(s[k] << shift);
-            }
-            s = s + imgb_src->s[i];
-            d = (short*)(((unsigned char *)d) + imgb_dst->s[i]);
-        }
+        xeve_func_plane_shl_8b(imgb_src->a[i], imgb_src->s[i], (pel *)imgb_dst->a[i], imgb_dst->s[i] >> 1,
+                               imgb_src->w[i], imgb_src->h[i], shift);
     }
 }
 
@@ -1642,25 +1760,12 @@ static void imgb_cpy_plane(XEVE_IMGB * dst, XEVE_IMGB * src)
 
 static void imgb_cpy_shift_left(XEVE_IMGB *dst, XEVE_IMGB *src, int shift)
 {
-    int i, j, k;
-
-    unsigned short * s;
-    unsigned short * d;
+    int i;
 
     for (i = 0; i < dst->np; i++)
     {
-        s = src->a[i];
-        d = dst->a[i];
-
-        for (j = 0; j < src->h[i]; j++)
-        {
-            for (k = 0; k < src->w[i]; k++)
-            {
-                d[k] = (unsigned short)(s[k] << shift);
-            }
-            s = (short*)(((unsigned char *)s) + src->s[i]);
-            d = (short*)(((unsigned char *)d) + dst->s[i]);
-        }
+        xeve_func_plane_shl_16b(src->a[i], src->s[i] >> 1, (pel *)dst->a[i], dst->s[i] >> 1,
+                                src->w[i], src->h[i], shift);
     }
 }
 
@@ -1843,11 +1948,15 @@ static unsigned long long __xgetbv(unsigned int i)
 #endif
 #define GET_CPU_INFO(A,B) ((B[((A >> 5) & 0x03)] >> (A & 0x1f)) & 1)
 
-int xeve_check_cpu_info()
+/* returns the supported instruction sets as (avx512 << 3) | (avx2 << 2) |
+   (sse << 1) | avx, limited to the ones allowed by isa (XEVE_ISA_*) */
+int xeve_check_cpu_info(int isa)
 {
     int support_sse  = 0;
     int support_avx  = 0;
     int support_avx2 = 0;
+    int support_avx512 = 0;
+    int allowed;
     int cpu_info[4]  = { 0 };
     __cpuid(cpu_info, 0);
     int id_cnt = cpu_info[0];
@@ -1867,11 +1976,25 @@ int xeve_check_cpu_info()
             {
                 __cpuid(cpu_info, 7);
                 support_avx2 = support_avx && GET_CPU_INFO(XEVE_CPU_INFO_AVX2, cpu_info);
+                /* opmask and upper halves of zmm0-15 and zmm16-31 */
+                support_avx512 = support_avx2 && ((xcr_feature_mask & 0xE6) == 0xE6) &&
+                                 GET_CPU_INFO(XEVE_CPU_INFO_AVX512F, cpu_info) &&
+                                 GET_CPU_INFO(XEVE_CPU_INFO_AVX512DQ, cpu_info) &&
+                                 GET_CPU_INFO(XEVE_CPU_INFO_AVX512BW, cpu_info) &&
+                                 GET_CPU_INFO(XEVE_CPU_INFO_AVX512VL, cpu_info);
             }
         }
     }
 
-    return (support_sse << 1) | support_avx | (support_avx2 << 2);
+    switch (isa)
+    {
+    case XEVE_ISA_C:    allowed = 0x0; break;
+    case XEVE_ISA_SSE:  allowed = 0x2; break;
+    case XEVE_ISA_AVX2: allowed = 0x7; break;
+    default:            allowed = 0xF; break;
+    }
+
+    return ((support_sse << 1) | support_avx | (support_avx2 << 2) | (support_avx512 << 3)) & allowed;
 }
 #endif
 
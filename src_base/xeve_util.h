@@ -88,11 +88,22 @@ operation: if(sign == 0) return val, else if(sign == 1) return -val */
 #define XEVE_GET_CHROMA_W_SHIFT(chroma_format_idc) ((chroma_format_idc == 0) ? 1 : (chroma_format_idc == 1) ? 1 : (chroma_format_idc == 2) ? 1 : 0)
 #define XEVE_GET_CHROMA_H_SHIFT(chroma_format_idc) ((chroma_format_idc == 0) ? 1 : (chroma_format_idc == 1) ? 1 : 0)
 
+/* input sample conversion and reference border expansion, strides in samples */
+typedef void (*XEVE_PLANE_SHL)(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift);
+typedef void (*XEVE_PLANE_EXPAND_LR)(pel *a, int s, int w, int h, int exp);
+
+void xeve_plane_shl_8b(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift);
+void xeve_plane_shl_16b(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift);
+void xeve_plane_expand_lr(pel *a, int s, int w, int h, int exp);
+
 u16  xeve_get_avail_inter(int x_scu, int y_scu, int w_scu, int h_scu, int scup, int cuw, int cuh, u32 *map_scu, u8* map_tidx);
 u16  xeve_get_avail_intra(int x_scu, int y_scu, int w_scu, int h_scu, int scup, int log2_cuw, int log2_cuh, u32 *map_scu, u8* map_tidx);
 XEVE_PIC* xeve_picbuf_alloc(int w, int h, int pad_l, int pad_c, int bit_depth, int *err, int chroma_format_idc);
 void xeve_picbuf_free(XEVE_PIC *pic);
 void xeve_picbuf_expand(XEVE_PIC *pic, int exp_l, int exp_c, int chroma_format_idc);
+void xeve_picbuf_expand_rows(XEVE_PIC *pic, int y, int rows, int exp_l, int exp_c, int chroma_format_idc);
+int  xeve_picbuf_spel_alloc(XEVE_PIC *pic, int level);
+void xeve_picbuf_spel_build(XEVE_PIC *pic, int y, int rows, const s16(*mc_l_coeff)[8], int bit_depth);
 void xeve_poc_derivation(XEVE_SPS sps, int tid, XEVE_POC *poc);
 void xeve_picbuf_rc_free(XEVE_PIC *pic);
 void xeve_check_motion_availability(int scup, int cuw, int cuh, int w_scu, int h_scu, int neb_addr[MAX_NUM_POSSIBLE_SCAND], int valid_flag[MAX_NUM_POSSIBLE_SCAND], u32 *map_scu, u16 avail_lr, int num_mvp, int is_ibc, u8 * map_tidx);
@@ -181,8 +192,12 @@ void xeve_imgb_garbage_free(XEVE_IMGB * imgb);
 #define XEVE_CPU_INFO_OSXSAVE  0x5B // ((2 << 5) | 27)
 #define XEVE_CPU_INFO_AVX      0x5C // ((2 << 5) | 28)
 #define XEVE_CPU_INFO_AVX2     0x25 // ((1 << 5) |  5)
+#define XEVE_CPU_INFO_AVX512F  0x30 // ((1 << 5) | 16)
+#define XEVE_CPU_INFO_AVX512DQ 0x31 // ((1 << 5) | 17)
+#define XEVE_CPU_INFO_AVX512BW 0x3E // ((1 << 5) | 30)
+#define XEVE_CPU_INFO_AVX512VL 0x3F // ((1 << 5) | 31)
 
-int  xeve_check_cpu_info();
+int  xeve_check_cpu_info(int isa);
 
 void xeve_copy_chroma_qp_mapping_params(XEVE_CHROMA_TABLE *dst, XEVE_CHROMA_TABLE *src);
 void xeve_update_core_loc_param(XEVE_CTX * ctx, XEVE_CORE * core);
@@ -0,0 +1,179 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+#include "xevem_alf_avx.h"
+
+#if X86_SSE
+#define ALF_STAT_GROUP         4
+
+typedef struct _ALF_STAT_ACC
+{
+    s64 E[MAX_NUM_ALF_LUMA_COEFF][16];
+    s64 y[16];
+    s64 pix_acc;
+} ALF_STAT_ACC;
+
+/* add the int32 products gathered for one pixel group to the class accumulator */
+static __inline void alf_stat_flush_avx(ALF_STAT_ACC * acc, __m256i e32[MAX_NUM_ALF_LUMA_COEFF][2], __m256i y32[2], int num_coef)
+{
+    __m256i a;
+    int k, h;
+
+    for(k = 0; k < num_coef; k++)
+    {
+        for(h = 0; h < 2; h++)
+        {
+            a = _mm256_loadu_si256((__m256i*)(acc->E[k] + h * 8));
+            a = _mm256_add_epi64(a, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(e32[k][h])));
+            _mm256_storeu_si256((__m256i*)(acc->E[k] + h * 8), a);
+            a = _mm256_loadu_si256((__m256i*)(acc->E[k] + h * 8 + 4));
+            a = _mm256_add_epi64(a, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(e32[k][h], 1)));
+            _mm256_storeu_si256((__m256i*)(acc->E[k] + h * 8 + 4), a);
+        }
+    }
+    for(h = 0; h < 2; h++)
+    {
+        a = _mm256_loadu_si256((__m256i*)(acc->y + h * 8));
+        a = _mm256_add_epi64(a, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(y32[h])));
+        _mm256_storeu_si256((__m256i*)(acc->y + h * 8), a);
+        a = _mm256_loadu_si256((__m256i*)(acc->y + h * 8 + 4));
+        a = _mm256_add_epi64(a, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(y32[h], 1)));
+        _mm256_storeu_si256((__m256i*)(acc->y + h * 8 + 4), a);
+    }
+}
+
+/*
+ * Products are gathered in 32 bits over at most ALF_STAT_GROUP pixels of the
+ * same class and widened to 64 bits per class. All values are integers well
+ * below 2^53, so adding the class totals to the double covariance once per
+ * block gives exactly the same result as the per-pixel C accumulation.
+ */
+void xeve_alf_get_blk_stats_avx(int ch, ALF_COVARIANCE * alf_cov, const ALF_FILTER_SHAPE * shape, ALF_CLASSIFIER ** classifier, pel * org0, const int org_stride, pel * rec0, const int rec_stride, const int x, const int y, const int width, const int height)
+{
+    ALF_STAT_ACC acc[MAX_NUM_ALF_CLASSES];
+    u8 used[MAX_NUM_ALF_CLASSES] = { 0 };
+    ALIGNED_32(int E_local[16]);
+    __m256i e32[MAX_NUM_ALF_LUMA_COEFF][2];
+    __m256i y32[2];
+    __m256i el[2];
+    const int num_coef = shape->num_coef;
+    const int half = shape->filterLength >> 1;
+    pel * rec = rec0 + y * rec_stride + x;
+    pel * org = org0 + y * org_stride + x;
+    int x2 = ch ? (x << 1) : x;
+    int y2 = ch ? (y << 1) : y;
+    int num_classes = classifier ? MAX_NUM_ALF_CLASSES : 1;
+    int i, j, k, l, n, class_idx;
+
+    for(i = 0; i < height; i++)
+    {
+        j = 0;
+        while(j < width)
+        {
+            ALF_CLASSIFIER cl = classifier ? classifier[y2 + i][x2 + j] : 0;
+            int trans_idx = cl & 0x03;
+            int pix_acc = 0;
+
+            class_idx = (cl >> 2) & 0x1F;
+            for(k = 0; k < num_coef; k++)
+            {
+                e32[k][0] = e32[k][1] = _mm256_setzero_si256();
+            }
+            y32[0] = y32[1] = _mm256_setzero_si256();
+
+            for(n = 0; n < ALF_STAT_GROUP && j < width; n++, j++)
+            {
+                if(n && classifier && classifier[y2 + i][x2 + j] != cl)
+                {
+                    break;
+                }
+
+                int y_local = org[j] - rec[j];
+                __m256i yv = _mm256_set1_epi32(y_local);
+
+                _mm256_store_si256((__m256i*)E_local, _mm256_setzero_si256());
+                _mm256_store_si256((__m256i*)(E_local + 8), _mm256_setzero_si256());
+                xeve_alf_clac_covariance(E_local, rec + j, rec_stride, shape->pattern, half, trans_idx);
+                el[0] = _mm256_load_si256((__m256i*)E_local);
+                el[1] = _mm256_load_si256((__m256i*)(E_local + 8));
+
+                for(k = 0; k < num_coef; k++)
+                {
+                    __m256i ek = _mm256_set1_epi32(E_local[k]);
+                    e32[k][0] = _mm256_add_epi32(e32[k][0], _mm256_mullo_epi32(ek, el[0]));
+                    e32[k][1] = _mm256_add_epi32(e32[k][1], _mm256_mullo_epi32(ek, el[1]));
+                }
+                y32[0] = _mm256_add_epi32(y32[0], _mm256_mullo_epi32(yv, el[0]));
+                y32[1] = _mm256_add_epi32(y32[1], _mm256_mullo_epi32(yv, el[1]));
+                pix_acc += y_local * y_local;
+            }
+
+            if(!used[class_idx])
+            {
+                xeve_mset(&acc[class_idx], 0, sizeof(ALF_STAT_ACC));
+                used[class_idx] = 1;
+            }
+            alf_stat_flush_avx(&acc[class_idx], e32, y32, num_coef);
+            acc[class_idx].pix_acc += pix_acc;
+        }
+        org += org_stride;
+        rec += rec_stride;
+    }
+
+    for(class_idx = 0; class_idx < num_classes; class_idx++)
+    {
+        if(used[class_idx])
+        {
+            for(k = 0; k < num_coef; k++)
+            {
+                for(l = k; l < num_coef; l++)
+                {
+                    alf_cov[class_idx].E[k][l] += (double)acc[class_idx].E[k][l];
+                }
+                alf_cov[class_idx].y[k] += (double)acc[class_idx].y[k];
+            }
+            alf_cov[class_idx].pix_acc += (double)acc[class_idx].pix_acc;
+        }
+        for(k = 1; k < num_coef; k++)
+        {
+            for(l = 0; l < k; l++)
+            {
+                alf_cov[class_idx].E[k][l] = alf_cov[class_idx].E[l][k];
+            }
+        }
+    }
+}
+#endif /* X86_SSE */
@@ -0,0 +1,67 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+#include "xevem_ibc_hash_avx.h"
+
+#if X86_SSE
+/* The software table of xeve_ibc_hash_crc32_16bit() is the reflected CRC32C
+   (Castagnoli) without pre/post inversion, which is what the SSE4.2 crc32
+   instruction computes. Feeding the little-endian 16-bit samples four at a
+   time gives the same key as the byte-wise loop. */
+u32 xeve_ibc_hash_block_key_avx(const pel * y, const int s_l, const pel * u, const pel * v, const int s_c)
+{
+    // 0x1FF is just an initial value
+    u64 crc = 0x1FF;
+    u32 c;
+    int i;
+
+    for(i = 0; i < MIN_CU_SIZE; i++)
+    {
+        crc = _mm_crc32_u64(crc, (u64)_mm_cvtsi128_si64(_mm_loadl_epi64((__m128i*)(y + i * s_l))));
+    }
+
+    c = (u32)crc;
+    for(i = 0; i < (MIN_CU_SIZE >> 1); i++)
+    {
+        c = _mm_crc32_u32(c, (u32)u[i * s_c] | ((u32)u[i * s_c + 1] << 16));
+    }
+    for(i = 0; i < (MIN_CU_SIZE >> 1); i++)
+    {
+        c = _mm_crc32_u32(c, (u32)v[i * s_c] | ((u32)v[i * s_c + 1] << 16));
+    }
+    return c;
+}
+#endif /* X86_SSE */
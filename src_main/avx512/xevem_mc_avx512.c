@@ -0,0 +1,183 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_def.h"
+#include "xevem_mc.h"
+#include "xevem_mc_sse.h"
+#include "xevem_mc_avx512.h"
+
+#if X86_SSE
+/* blocks narrower than this are left to the SSE kernels */
+#define MC_AVX512_MIN_W         16
+
+/****************************************************************************
+ * motion compensation for luma
+ ****************************************************************************/
+
+static void mc_dmvr_l_n0_avx512(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+{
+    int dx = gmv_x & 15;
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_mc_dmvr_l_n0_sse(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth);
+        return;
+    }
+
+    ref = ref - 3;
+    xeve_mc_filter_horz_avx512(ref, s_ref, pred, s_pred, xevem_tbl_mc_l_coeff[dx], 8, w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+}
+
+static void mc_dmvr_l_0n_avx512(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+{
+    int dy = gmv_y & 15;
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_mc_dmvr_l_0n_sse(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth);
+        return;
+    }
+
+    ref = ref - (3 * s_ref);
+    xeve_mc_filter_vert_avx512(ref, s_ref, pred, s_pred, xevem_tbl_mc_l_coeff[dy], 8, w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+}
+
+static void mc_dmvr_l_nn_avx512(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+{
+    s16 buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*MAX_CU_SIZE];
+    int dx = gmv_x & 15;
+    int dy = gmv_y & 15;
+    int shift1 = XEVE_MIN(4, bit_depth - 8);
+    int shift2 = XEVE_MAX(8, 20 - bit_depth);
+    int offset1 = 0;
+    int offset2 = (1 << (shift2 - 1));
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_mc_dmvr_l_nn_sse(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth);
+        return;
+    }
+
+    ref = ref - (3 * s_ref + 3);
+    xeve_mc_filter_horz_avx512(ref, s_ref, buf, w, xevem_tbl_mc_l_coeff[dx], 8, w, (h + 7), min, max, offset1, shift1, 0);
+    xeve_mc_filter_vert_avx512(buf, w, pred, s_pred, xevem_tbl_mc_l_coeff[dy], 8, w, h, min, max, offset2, shift2, 1);
+}
+
+static void bl_mc_l_n0_avx512(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+{
+    int dx = gmv_x & 15;
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_bl_mc_l_n0_sse(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth);
+        return;
+    }
+
+    ref += (gmv_y >> 4) * s_ref + (gmv_x >> 4);
+    xeve_mc_filter_horz_avx512(ref, s_ref, pred, s_pred, xeve_tbl_bl_mc_l_coeff[dx], 2, w, h, min, max, MAC_ADD_N0, MAC_SFT_N0, 1);
+}
+
+static void bl_mc_l_0n_avx512(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth)
+{
+    int dy = gmv_y & 15;
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_bl_mc_l_0n_sse(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth);
+        return;
+    }
+
+    ref += (gmv_y >> 4) * s_ref + (gmv_x >> 4);
+    xeve_mc_filter_vert_avx512(ref, s_ref, pred, s_pred, xeve_tbl_bl_mc_l_coeff[dy], 2, w, h, min, max, MAC_ADD_0N, MAC_SFT_0N, 1);
+}
+
+static void bl_mc_l_nn_avx512(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
+{
+    s16 buf[(MAX_CU_SIZE + OPT_MC_BI_PAD * 2 + MC_IBUF_PAD_L)*(MAX_CU_SIZE + OPT_MC_BI_PAD * 2 + MC_IBUF_PAD_L)];
+    int dx = gmv_x & 15;
+    int dy = gmv_y & 15;
+    int shift1 = XEVE_MIN(4, bit_depth - 8);
+    int shift2 = XEVE_MAX(8, 20 - bit_depth);
+    int offset1 = 0;
+    int offset2 = (1 << (shift2 - 1));
+    int max = ((1 << bit_depth) - 1);
+    int min = 0;
+
+    if(w < MC_AVX512_MIN_W)
+    {
+        xeve_bl_mc_l_nn_sse(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth);
+        return;
+    }
+
+    ref += (gmv_y >> 4) * s_ref + (gmv_x >> 4);
+    xeve_mc_filter_horz_avx512(ref, s_ref, buf, w, xeve_tbl_bl_mc_l_coeff[dx], 2, w, (h + 1), min, max, offset1, shift1, 0);
+    xeve_mc_filter_vert_avx512(buf, w, pred, s_pred, xeve_tbl_bl_mc_l_coeff[dy], 2, w, h, min, max, offset2, shift2, 1);
+}
+
+const XEVEM_MC xeve_tbl_dmvr_mc_l_avx512[2][2] =
+{
+    {
+        xeve_mc_dmvr_l_00_sse, /* dx == 0 && dy == 0 */
+        mc_dmvr_l_0n_avx512    /* dx == 0 && dy != 0 */
+    },
+    {
+        mc_dmvr_l_n0_avx512,   /* dx != 0 && dy == 0 */
+        mc_dmvr_l_nn_avx512    /* dx != 0 && dy != 0 */
+    }
+};
+
+/* luma and chroma will remain the same */
+const XEVEM_MC xeve_tbl_bl_mc_l_avx512[2][2] =
+{
+    {
+        xeve_bl_mc_l_00_sse,
+        bl_mc_l_0n_avx512
+    },
+    {
+        bl_mc_l_n0_avx512,
+        bl_mc_l_nn_avx512
+    }
+};
+#endif /* X86_SSE */
@@ -0,0 +1,373 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+#include "xevem_alf_sse.h"
+
+#if X86_SSE
+#define ALF_LAP_PAIR_W         ((CLASSIFICATION_BLK_SIZE + 4) >> 1)
+
+/* |2 * a - b - c| + |2 * d - e - f| for eight 16-bit lanes */
+#define ALF_LAP2(a, b, c, d, e, f) \
+    _mm_add_epi16(_mm_abs_epi16(_mm_sub_epi16(_mm_slli_epi16(a, 1), _mm_add_epi16(b, c))), \
+                  _mm_abs_epi16(_mm_sub_epi16(_mm_slli_epi16(d, 1), _mm_add_epi16(e, f))))
+
+static __inline void alf_lap_row_sse(int lap[NUM_DIRECTIONS][ALF_LAP_PAIR_W + 4], const pel * base, const int s, int width)
+{
+    const __m128i ones = _mm_set1_epi16(1);
+    __m128i c, cl, cr, d, dl, dr, u, ul, ur, u2, u2l, u2r, v;
+    int j;
+
+    /* each lane is one pixel of the row pair, madd with ones sums
+       horizontal pixel pairs into the entry of the C classifier */
+    for(j = 0; j + 8 <= width; j += 8)
+    {
+        const pel * p = base + j;
+
+        c   = _mm_loadu_si128((__m128i*)(p));
+        cl  = _mm_loadu_si128((__m128i*)(p - 1));
+        cr  = _mm_loadu_si128((__m128i*)(p + 1));
+        d   = _mm_loadu_si128((__m128i*)(p - s));
+        dl  = _mm_loadu_si128((__m128i*)(p - s - 1));
+        dr  = _mm_loadu_si128((__m128i*)(p - s + 1));
+        u   = _mm_loadu_si128((__m128i*)(p + s));
+        ul  = _mm_loadu_si128((__m128i*)(p + s - 1));
+        ur  = _mm_loadu_si128((__m128i*)(p + s + 1));
+        u2  = _mm_loadu_si128((__m128i*)(p + 2 * s));
+        u2l = _mm_loadu_si128((__m128i*)(p + 2 * s - 1));
+        u2r = _mm_loadu_si128((__m128i*)(p + 2 * s + 1));
+
+        v = ALF_LAP2(c, d, u, u, c, u2);
+        _mm_storeu_si128((__m128i*)(lap[VER] + (j >> 1)), _mm_madd_epi16(v, ones));
+        v = ALF_LAP2(c, cr, cl, u, ur, ul);
+        _mm_storeu_si128((__m128i*)(lap[HOR] + (j >> 1)), _mm_madd_epi16(v, ones));
+        v = ALF_LAP2(c, dl, ur, u, cl, u2r);
+        _mm_storeu_si128((__m128i*)(lap[DIAG0] + (j >> 1)), _mm_madd_epi16(v, ones));
+        v = ALF_LAP2(c, ul, dr, u, u2l, cr);
+        _mm_storeu_si128((__m128i*)(lap[DIAG1] + (j >> 1)), _mm_madd_epi16(v, ones));
+    }
+    if(j < width)
+    {
+        const pel * p = base + j;
+
+        c   = _mm_loadl_epi64((__m128i*)(p));
+        cl  = _mm_loadl_epi64((__m128i*)(p - 1));
+        cr  = _mm_loadl_epi64((__m128i*)(p + 1));
+        d   = _mm_loadl_epi64((__m128i*)(p - s));
+        dl  = _mm_loadl_epi64((__m128i*)(p - s - 1));
+        dr  = _mm_loadl_epi64((__m128i*)(p - s + 1));
+        u   = _mm_loadl_epi64((__m128i*)(p + s));
+        ul  = _mm_loadl_epi64((__m128i*)(p + s - 1));
+        ur  = _mm_loadl_epi64((__m128i*)(p + s + 1));
+        u2  = _mm_loadl_epi64((__m128i*)(p + 2 * s));
+        u2l = _mm_loadl_epi64((__m128i*)(p + 2 * s - 1));
+        u2r = _mm_loadl_epi64((__m128i*)(p + 2 * s + 1));
+
+        v = ALF_LAP2(c, d, u, u, c, u2);
+        _mm_storel_epi64((__m128i*)(lap[VER] + (j >> 1)), _mm_madd_epi16(v, ones));
+        v = ALF_LAP2(c, cr, cl, u, ur, ul);
+        _mm_storel_epi64((__m128i*)(lap[HOR] + (j >> 1)), _mm_madd_epi16(v, ones));
+        v = ALF_LAP2(c, dl, ur, u, cl, u2r);
+        _mm_storel_epi64((__m128i*)(lap[DIAG0] + (j >> 1)), _mm_madd_epi16(v, ones));
+        v = ALF_LAP2(c, ul, dr, u, u2l, cr);
+        _mm_storel_epi64((__m128i*)(lap[DIAG1] + (j >> 1)), _mm_madd_epi16(v, ones));
+    }
+}
+
+static __inline __m128i alf_lap_sum_sse(int lap[ALF_LAP_PAIR_W][NUM_DIRECTIONS][ALF_LAP_PAIR_W + 4], int i, int j, int dir)
+{
+    __m128i s;
+
+    s = _mm_loadu_si128((__m128i*)(lap[i][dir] + j));
+    s = _mm_add_epi32(s, _mm_loadu_si128((__m128i*)(lap[i + 1][dir] + j)));
+    s = _mm_add_epi32(s, _mm_loadu_si128((__m128i*)(lap[i + 2][dir] + j)));
+    s = _mm_add_epi32(s, _mm_loadu_si128((__m128i*)(lap[i + 3][dir] + j)));
+    return s;
+}
+
+void alf_derive_classification_blk_sse(ALF_CLASSIFIER ** classifier, const pel * src_luma, const int src_stride, const AREA * blk, const int shift, int bit_depth)
+{
+    static const int th[16] = { 0, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4 };
+    static const int trans_tbl[8] = { 0, 1, 0, 2, 2, 3, 1, 3 };
+    const int stride = src_stride;
+    const int max_act = 15;
+    const int height = blk->height + 4;
+    const int width = blk->width + 4;
+    const int pos_x = blk->x;
+    const int pos_y = blk->y;
+    int laplacian[ALF_LAP_PAIR_W][NUM_DIRECTIONS][ALF_LAP_PAIR_W + 4];
+    int sum[4];
+    int i, j;
+
+    /* laplacian[i][dir][j] holds the 2x2 activity of the C classifier
+       entry laplacian[dir][2 * i][2 * j] */
+    for(i = 0; i < height; i += 2)
+    {
+        alf_lap_row_sse(laplacian[i >> 1], src_luma + (pos_y - 2 + i) * stride + pos_x - 2, stride, width);
+    }
+
+    for(i = 0; i < blk->height; i += 4)
+    {
+        for(j = 0; j < blk->width; j += 4)
+        {
+            __m128i v, h, d0, d1;
+            int sum_v, sum_h, sum_d0, sum_d1;
+            int main_dir, sec_dir, dir_temp_hv, dir_temp_d;
+            int hv1, hv0, d1s, d0s, hvd1, hvd0;
+            int activity, class_idx, trans_idx, direction_strength;
+
+            v  = alf_lap_sum_sse(laplacian, i >> 1, j >> 1, VER);
+            h  = alf_lap_sum_sse(laplacian, i >> 1, j >> 1, HOR);
+            d0 = alf_lap_sum_sse(laplacian, i >> 1, j >> 1, DIAG0);
+            d1 = alf_lap_sum_sse(laplacian, i >> 1, j >> 1, DIAG1);
+            v = _mm_hadd_epi32(_mm_hadd_epi32(v, h), _mm_hadd_epi32(d0, d1));
+            _mm_storeu_si128((__m128i*)sum, v);
+
+            sum_v  = sum[0];
+            sum_h  = sum[1];
+            sum_d0 = sum[2];
+            sum_d1 = sum[3];
+
+            activity = XEVE_CLIP3(0, max_act, (sum_v + sum_h) >> (bit_depth - 2));
+            class_idx = th[activity];
+
+            if(sum_v > sum_h)
+            {
+                hv1 = sum_v;
+                hv0 = sum_h;
+                dir_temp_hv = 1;
+            }
+            else
+            {
+                hv1 = sum_h;
+                hv0 = sum_v;
+                dir_temp_hv = 3;
+            }
+            if(sum_d0 > sum_d1)
+            {
+                d1s = sum_d0;
+                d0s = sum_d1;
+                dir_temp_d = 0;
+            }
+            else
+            {
+                d1s = sum_d1;
+                d0s = sum_d0;
+                dir_temp_d = 2;
+            }
+            if(d1s * hv0 > hv1 * d0s)
+            {
+                hvd1 = d1s;
+                hvd0 = d0s;
+                main_dir = dir_temp_d;
+                sec_dir = dir_temp_hv;
+            }
+            else
+            {
+                hvd1 = hv1;
+                hvd0 = hv0;
+                main_dir = dir_temp_hv;
+                sec_dir = dir_temp_d;
+            }
+
+            direction_strength = 0;
+            if(hvd1 > 2 * hvd0)
+            {
+                direction_strength = 1;
+            }
+            if(hvd1 * 2 > 9 * hvd0)
+            {
+                direction_strength = 2;
+            }
+            if(direction_strength)
+            {
+                class_idx += (((main_dir & 0x1) << 1) + direction_strength) * 5;
+            }
+            trans_idx = trans_tbl[main_dir * 2 + (sec_dir >> 1)];
+
+            u32 cls4 = (((class_idx << 2) + trans_idx) & 0xFF) * 0x01010101;
+            ALF_CLASSIFIER * cl = classifier[i + pos_y] + j + pos_x;
+            xeve_mcpy(cl, &cls4, 4);
+            cl = classifier[i + pos_y + 1] + j + pos_x;
+            xeve_mcpy(cl, &cls4, 4);
+            cl = classifier[i + pos_y + 2] + j + pos_x;
+            xeve_mcpy(cl, &cls4, 4);
+            cl = classifier[i + pos_y + 3] + j + pos_x;
+            xeve_mcpy(cl, &cls4, 4);
+        }
+    }
+}
+
+/* interleave two 4-lane tap sums and multiply with a coefficient pair */
+#define ALF_MADD_PAIR(t0, t1, c01) \
+    _mm_madd_epi16(_mm_unpacklo_epi16(t0, t1), c01)
+
+#define ALF_COEF_PAIR(c0, c1) \
+    _mm_set1_epi32((int)(((u32)(u16)(c1) << 16) | (u16)(c0)))
+
+#define ALF_TAP4(p, a, b) \
+    _mm_add_epi16(_mm_loadl_epi64((__m128i*)((p) + (a))), _mm_loadl_epi64((__m128i*)((p) + (b))))
+
+void alf_filter_blk_7_sse(ALF_CLASSIFIER ** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const AREA * blk, const u8 comp_id, short * filter_set, const CLIP_RANGE * clip_range)
+{
+    static const int l[4][MAX_NUM_ALF_LUMA_COEFF] = {
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 },
+        { 9, 4, 10, 8, 1, 5, 11, 7, 3, 0, 2, 6, 12 },
+        { 0, 3, 2, 1, 8, 7, 6, 5, 4, 9, 10, 11, 12 },
+        { 9, 8, 10, 4, 3, 7, 11, 5, 1, 0, 2, 6, 12 }
+    };
+    const int s = src_stride;
+    const __m128i offset = _mm_set1_epi32(1 << 8);
+    const __m128i vmin = _mm_set1_epi32(clip_range->min);
+    const __m128i vmax = _mm_set1_epi32(clip_range->max);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i c01, c23, c45, c67, c89, c1011, c12;
+    __m128i t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, sum;
+    int i, j, ii;
+
+    CHECK(blk->y % 4, "Wrong start_h in filtering");
+    CHECK(blk->x % 4, "Wrong start_w in filtering");
+    CHECK(blk->height % 4, "Wrong end_h in filtering");
+    CHECK(blk->width % 4, "Wrong end_w in filtering");
+
+    for(i = 0; i < blk->height; i += 4)
+    {
+        ALF_CLASSIFIER * alf_class = classifier[blk->y + i] + blk->x;
+
+        for(j = 0; j < blk->width; j += 4)
+        {
+            ALF_CLASSIFIER cl = alf_class[j];
+            const int * tr = l[cl & 0x03];
+            short * coef = filter_set + ((cl >> 2) & 0x1F) * MAX_NUM_ALF_LUMA_COEFF;
+
+            c01   = ALF_COEF_PAIR(coef[tr[0]], coef[tr[1]]);
+            c23   = ALF_COEF_PAIR(coef[tr[2]], coef[tr[3]]);
+            c45   = ALF_COEF_PAIR(coef[tr[4]], coef[tr[5]]);
+            c67   = ALF_COEF_PAIR(coef[tr[6]], coef[tr[7]]);
+            c89   = ALF_COEF_PAIR(coef[tr[8]], coef[tr[9]]);
+            c1011 = ALF_COEF_PAIR(coef[tr[10]], coef[tr[11]]);
+            c12   = ALF_COEF_PAIR(coef[tr[12]], 0);
+
+            for(ii = 0; ii < 4; ii++)
+            {
+                const pel * p = rec_src + (i + ii) * s + j;
+
+                t0  = ALF_TAP4(p, 3 * s, -3 * s);
+                t1  = ALF_TAP4(p, 2 * s + 1, -2 * s - 1);
+                t2  = ALF_TAP4(p, 2 * s, -2 * s);
+                t3  = ALF_TAP4(p, 2 * s - 1, -2 * s + 1);
+                t4  = ALF_TAP4(p, s + 2, -s - 2);
+                t5  = ALF_TAP4(p, s + 1, -s - 1);
+                t6  = ALF_TAP4(p, s, -s);
+                t7  = ALF_TAP4(p, s - 1, -s + 1);
+                t8  = ALF_TAP4(p, s - 2, -s + 2);
+                t9  = ALF_TAP4(p, 3, -3);
+                t10 = ALF_TAP4(p, 2, -2);
+                t11 = ALF_TAP4(p, 1, -1);
+                t12 = _mm_loadl_epi64((__m128i*)p);
+
+                sum = ALF_MADD_PAIR(t0, t1, c01);
+                sum = _mm_add_epi32(sum, ALF_MADD_PAIR(t2, t3, c23));
+                sum = _mm_add_epi32(sum, ALF_MADD_PAIR(t4, t5, c45));
+                sum = _mm_add_epi32(sum, ALF_MADD_PAIR(t6, t7, c67));
+                sum = _mm_add_epi32(sum, ALF_MADD_PAIR(t8, t9, c89));
+                sum = _mm_add_epi32(sum, ALF_MADD_PAIR(t10, t11, c1011));
+                sum = _mm_add_epi32(sum, ALF_MADD_PAIR(t12, zero, c12));
+
+                sum = _mm_srai_epi32(_mm_add_epi32(sum, offset), 9);
+                sum = _mm_min_epi32(_mm_max_epi32(sum, vmin), vmax);
+                _mm_storel_epi64((__m128i*)(rec_dst + (i + ii) * dst_stride + j), _mm_packs_epi32(sum, sum));
+            }
+        }
+    }
+}
+
+void alf_filter_blk_5_sse(ALF_CLASSIFIER ** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const AREA * blk, const u8 comp_id, short * filter_set, const CLIP_RANGE * clip_range)
+{
+    const int s = src_stride;
+    const short * coef = filter_set;
+    const __m128i offset = _mm_set1_epi32(1 << 8);
+    const __m128i vmin = _mm_set1_epi32(clip_range->min);
+    const __m128i vmax = _mm_set1_epi32(clip_range->max);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c01 = ALF_COEF_PAIR(coef[0], coef[1]);
+    const __m128i c23 = ALF_COEF_PAIR(coef[2], coef[3]);
+    const __m128i c45 = ALF_COEF_PAIR(coef[4], coef[5]);
+    const __m128i c6  = ALF_COEF_PAIR(coef[6], 0);
+    __m128i t0, t1, t2, t3, t4, t5, t6, sum;
+    int i, j;
+
+    for(i = 0; i < blk->height; i++)
+    {
+        const pel * src = rec_src + i * s;
+        pel * dst = rec_dst + i * dst_stride;
+
+        for(j = 0; j + 4 <= blk->width; j += 4)
+        {
+            const pel * p = src + j;
+
+            t0 = ALF_TAP4(p, 2 * s, -2 * s);
+            t1 = ALF_TAP4(p, s + 1, -s - 1);
+            t2 = ALF_TAP4(p, s, -s);
+            t3 = ALF_TAP4(p, s - 1, -s + 1);
+            t4 = ALF_TAP4(p, 2, -2);
+            t5 = ALF_TAP4(p, 1, -1);
+            t6 = _mm_loadl_epi64((__m128i*)p);
+
+            sum = ALF_MADD_PAIR(t0, t1, c01);
+            sum = _mm_add_epi32(sum, ALF_MADD_PAIR(t2, t3, c23));
+            sum = _mm_add_epi32(sum, ALF_MADD_PAIR(t4, t5, c45));
+            sum = _mm_add_epi32(sum, ALF_MADD_PAIR(t6, zero, c6));
+
+            sum = _mm_srai_epi32(_mm_add_epi32(sum, offset), 9);
+            sum = _mm_min_epi32(_mm_max_epi32(sum, vmin), vmax);
+            _mm_storel_epi64((__m128i*)(dst + j), _mm_packs_epi32(sum, sum));
+        }
+        for(; j < blk->width; j++)
+        {
+            const pel * p = src + j;
+            int val = coef[0] * (p[2 * s] + p[-2 * s])
+                    + coef[1] * (p[s + 1] + p[-s - 1])
+                    + coef[2] * (p[s] + p[-s])
+                    + coef[3] * (p[s - 1] + p[-s + 1])
+                    + coef[4] * (p[2] + p[-2])
+                    + coef[5] * (p[1] + p[-1])
+                    + coef[6] * p[0];
+
+            dst[j] = clip_pel((val + (1 << 8)) >> 9, *clip_range);
+        }
+    }
+}
+#endif /* X86_SSE */
@@ -0,0 +1,312 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+#include "xevem_df_sse.h"
+
+#if X86_SSE
+/* one 32-bit lane per line of the edge; p[i]/q[i] are the i-th samples
+   away from the edge as in deblock_scu_line_luma() */
+#define DBK_ABS_LT(a, b, th)   _mm_cmpgt_epi32(th, _mm_abs_epi32(_mm_sub_epi32(a, b)))
+#define DBK_CLIP(v, lo, hi)    _mm_min_epi32(_mm_max_epi32(v, lo), hi)
+
+static int dbk_addb_luma_sse(__m128i p[DBF_LENGTH], __m128i q[DBF_LENGTH], u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi32((1 << (bit_depth_minus8 + 8)) - 1);
+    const __m128i valpha = _mm_set1_epi32(alpha);
+    const __m128i vbeta = _mm_set1_epi32(beta);
+    __m128i apply, ap, aq, po[3], qo[3];
+    int i;
+
+    apply = _mm_and_si128(DBK_ABS_LT(p[0], q[0], valpha), _mm_and_si128(DBK_ABS_LT(p[1], p[0], vbeta), DBK_ABS_LT(q[1], q[0], vbeta)));
+    if(!_mm_movemask_epi8(apply))
+    {
+        return 0;
+    }
+    ap = DBK_ABS_LT(p[0], p[2], vbeta);
+    aq = DBK_ABS_LT(q[0], q[2], vbeta);
+
+    if(bs == DBF_ADDB_BS_INTRA_STRONG)
+    {
+        __m128i strong = DBK_ABS_LT(p[0], q[0], _mm_set1_epi32((alpha >> 2) + 2));
+        __m128i sp = _mm_and_si128(ap, strong);
+        __m128i sq = _mm_and_si128(aq, strong);
+        __m128i two = _mm_set1_epi32(2), four = _mm_set1_epi32(4);
+        __m128i t, s0, s1, s2, w0;
+
+        /* p side */
+        t  = _mm_add_epi32(_mm_add_epi32(p[1], p[0]), q[0]);
+        s0 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_add_epi32(p[2], _mm_slli_epi32(t, 1)), q[1]), four), 3);
+        s1 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(p[2], t), two), 2);
+        s2 = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(p[3], 1), _mm_mullo_epi32(p[2], _mm_set1_epi32(3))), t);
+        s2 = _mm_srai_epi32(_mm_add_epi32(s2, four), 3);
+        w0 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(p[1], 1), p[0]), q[1]), two), 2);
+        po[0] = _mm_blendv_epi8(w0, s0, sp);
+        po[1] = _mm_blendv_epi8(p[1], s1, sp);
+        po[2] = _mm_blendv_epi8(p[2], s2, sp);
+
+        /* q side */
+        t  = _mm_add_epi32(_mm_add_epi32(q[1], q[0]), p[0]);
+        s0 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_add_epi32(q[2], _mm_slli_epi32(t, 1)), p[1]), four), 3);
+        s1 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(q[2], t), two), 2);
+        s2 = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(q[3], 1), _mm_mullo_epi32(q[2], _mm_set1_epi32(3))), t);
+        s2 = _mm_srai_epi32(_mm_add_epi32(s2, four), 3);
+        w0 = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(q[1], 1), q[0]), p[1]), two), 2);
+        qo[0] = _mm_blendv_epi8(w0, s0, sq);
+        qo[1] = _mm_blendv_epi8(q[1], s1, sq);
+        qo[2] = _mm_blendv_epi8(q[2], s2, sq);
+    }
+    else
+    {
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i vc1 = _mm_set1_epi32(c1);
+        const __m128i nc1 = _mm_set1_epi32(-c1);
+        const int shift = XEVE_MAX(0, (bit_depth_minus8 + 8) - 9);
+        __m128i c0, d0, d1;
+
+        /* c0 = c1 + ((ap + aq) << shift) */
+        c0 = _mm_add_epi32(_mm_and_si128(ap, one), _mm_and_si128(aq, one));
+        c0 = _mm_add_epi32(vc1, _mm_sll_epi32(c0, _mm_cvtsi32_si128(shift)));
+
+        d0 = _mm_add_epi32(_mm_slli_epi32(_mm_sub_epi32(q[0], p[0]), 2), _mm_sub_epi32(p[1], q[1]));
+        d0 = _mm_srai_epi32(_mm_add_epi32(d0, _mm_set1_epi32(4)), 3);
+        d0 = DBK_CLIP(d0, _mm_sub_epi32(zero, c0), c0);
+        po[0] = DBK_CLIP(_mm_add_epi32(p[0], d0), zero, max);
+        qo[0] = DBK_CLIP(_mm_sub_epi32(q[0], d0), zero, max);
+
+        d1 = _mm_mullo_epi32(_mm_add_epi32(_mm_add_epi32(p[2], p[0]), q[0]), _mm_set1_epi32(3));
+        d1 = _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(d1, _mm_slli_epi32(p[1], 3)), q[1]), 4);
+        po[1] = _mm_blendv_epi8(p[1], _mm_add_epi32(p[1], DBK_CLIP(d1, nc1, vc1)), ap);
+
+        d1 = _mm_mullo_epi32(_mm_add_epi32(_mm_add_epi32(q[2], q[0]), p[0]), _mm_set1_epi32(3));
+        d1 = _mm_srai_epi32(_mm_sub_epi32(_mm_sub_epi32(d1, _mm_slli_epi32(q[1], 3)), p[1]), 4);
+        qo[1] = _mm_blendv_epi8(q[1], _mm_add_epi32(q[1], DBK_CLIP(d1, nc1, vc1)), aq);
+
+        po[2] = p[2];
+        qo[2] = q[2];
+    }
+
+    for(i = 0; i < 3; i++)
+    {
+        p[i] = _mm_blendv_epi8(p[i], DBK_CLIP(po[i], zero, max), apply);
+        q[i] = _mm_blendv_epi8(q[i], DBK_CLIP(qo[i], zero, max), apply);
+    }
+    return 1;
+}
+
+static int dbk_addb_chroma_sse(__m128i p[DBF_LENGTH_CHROMA], __m128i q[DBF_LENGTH_CHROMA], u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi32((1 << (bit_depth_minus8 + 8)) - 1);
+    const __m128i vbeta = _mm_set1_epi32(beta);
+    __m128i apply, po, qo;
+
+    /* chroma edges have two lines */
+    apply = _mm_and_si128(DBK_ABS_LT(p[0], q[0], _mm_set1_epi32(alpha)), _mm_and_si128(DBK_ABS_LT(p[1], p[0], vbeta), DBK_ABS_LT(q[1], q[0], vbeta)));
+    apply = _mm_and_si128(apply, _mm_set_epi32(0, 0, -1, -1));
+    if(!_mm_movemask_epi8(apply))
+    {
+        return 0;
+    }
+
+    if(bs == DBF_ADDB_BS_INTRA_STRONG)
+    {
+        const __m128i two = _mm_set1_epi32(2);
+
+        po = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(p[1], 1), p[0]), q[1]), two), 2);
+        qo = _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(q[1], 1), q[0]), p[1]), two), 2);
+    }
+    else
+    {
+        const __m128i vc0 = _mm_set1_epi32(c0);
+        __m128i d0;
+
+        d0 = _mm_add_epi32(_mm_slli_epi32(_mm_sub_epi32(q[0], p[0]), 2), _mm_sub_epi32(p[1], q[1]));
+        d0 = _mm_srai_epi32(_mm_add_epi32(d0, _mm_set1_epi32(4)), 3);
+        d0 = DBK_CLIP(d0, _mm_sub_epi32(zero, vc0), vc0);
+        po = _mm_add_epi32(p[0], d0);
+        qo = _mm_sub_epi32(q[0], d0);
+    }
+
+    p[0] = _mm_blendv_epi8(p[0], DBK_CLIP(po, zero, max), apply);
+    q[0] = _mm_blendv_epi8(q[0], DBK_CLIP(qo, zero, max), apply);
+    return 1;
+}
+
+#define DBK_LOAD4(buf)         _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(buf)))
+#define DBK_STORE4(buf, v)     _mm_storel_epi64((__m128i*)(buf), _mm_packs_epi32(v, v))
+
+static void deblock_scu_addb_hor_luma_sse(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8)
+{
+    __m128i p[DBF_LENGTH], q[DBF_LENGTH];
+    int i;
+
+    if(!bs)
+    {
+        return;
+    }
+    for(i = 0; i < DBF_LENGTH; i++)
+    {
+        q[i] = DBK_LOAD4(buf + i * stride);
+        p[i] = DBK_LOAD4(buf - (i + 1) * stride);
+    }
+    if(dbk_addb_luma_sse(p, q, bs, alpha, beta, c1, bit_depth_minus8))
+    {
+        for(i = 0; i < 3; i++)
+        {
+            DBK_STORE4(buf + i * stride, q[i]);
+            DBK_STORE4(buf - (i + 1) * stride, p[i]);
+        }
+    }
+}
+
+static void deblock_scu_addb_ver_luma_sse(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c1, int bit_depth_minus8)
+{
+    __m128i p[DBF_LENGTH], q[DBF_LENGTH];
+    __m128i r0, r1, r2, r3, t0, t1, t2, t3;
+
+    if(!bs)
+    {
+        return;
+    }
+
+    /* 4 lines of 8 pels (p3..q3) transposed into one register per column */
+    r0 = _mm_loadu_si128((__m128i*)(buf - 4));
+    r1 = _mm_loadu_si128((__m128i*)(buf + stride - 4));
+    r2 = _mm_loadu_si128((__m128i*)(buf + 2 * stride - 4));
+    r3 = _mm_loadu_si128((__m128i*)(buf + 3 * stride - 4));
+
+    t0 = _mm_unpacklo_epi16(r0, r1);
+    t1 = _mm_unpacklo_epi16(r2, r3);
+    t2 = _mm_unpackhi_epi16(r0, r1);
+    t3 = _mm_unpackhi_epi16(r2, r3);
+    r0 = _mm_unpacklo_epi32(t0, t1);
+    r1 = _mm_unpackhi_epi32(t0, t1);
+    r2 = _mm_unpacklo_epi32(t2, t3);
+    r3 = _mm_unpackhi_epi32(t2, t3);
+
+    p[3] = _mm_cvtepi16_epi32(r0);
+    p[2] = _mm_cvtepi16_epi32(_mm_srli_si128(r0, 8));
+    p[1] = _mm_cvtepi16_epi32(r1);
+    p[0] = _mm_cvtepi16_epi32(_mm_srli_si128(r1, 8));
+    q[0] = _mm_cvtepi16_epi32(r2);
+    q[1] = _mm_cvtepi16_epi32(_mm_srli_si128(r2, 8));
+    q[2] = _mm_cvtepi16_epi32(r3);
+    q[3] = _mm_cvtepi16_epi32(_mm_srli_si128(r3, 8));
+
+    if(dbk_addb_luma_sse(p, q, bs, alpha, beta, c1, bit_depth_minus8))
+    {
+        r0 = _mm_packs_epi32(p[3], p[2]);
+        r1 = _mm_packs_epi32(p[1], p[0]);
+        r2 = _mm_packs_epi32(q[0], q[1]);
+        r3 = _mm_packs_epi32(q[2], q[3]);
+
+        t0 = _mm_unpacklo_epi16(r0, r1);
+        t1 = _mm_unpackhi_epi16(r0, r1);
+        t2 = _mm_unpacklo_epi16(r2, r3);
+        t3 = _mm_unpackhi_epi16(r2, r3);
+        r0 = _mm_unpacklo_epi16(t0, t1);
+        r1 = _mm_unpackhi_epi16(t0, t1);
+        r2 = _mm_unpacklo_epi16(t2, t3);
+        r3 = _mm_unpackhi_epi16(t2, t3);
+
+        _mm_storeu_si128((__m128i*)(buf - 4), _mm_unpacklo_epi64(r0, r2));
+        _mm_storeu_si128((__m128i*)(buf + stride - 4), _mm_unpackhi_epi64(r0, r2));
+        _mm_storeu_si128((__m128i*)(buf + 2 * stride - 4), _mm_unpacklo_epi64(r1, r3));
+        _mm_storeu_si128((__m128i*)(buf + 3 * stride - 4), _mm_unpackhi_epi64(r1, r3));
+    }
+}
+
+static void deblock_scu_addb_hor_chroma_sse(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8)
+{
+    __m128i p[DBF_LENGTH_CHROMA], q[DBF_LENGTH_CHROMA];
+    int t;
+
+    if(!bs)
+    {
+        return;
+    }
+    p[1] = DBK_LOAD4(buf - 2 * stride);
+    p[0] = DBK_LOAD4(buf - stride);
+    q[0] = DBK_LOAD4(buf);
+    q[1] = DBK_LOAD4(buf + stride);
+
+    if(dbk_addb_chroma_sse(p, q, bs, alpha, beta, c0, bit_depth_minus8))
+    {
+        t = _mm_cvtsi128_si32(_mm_packs_epi32(p[0], p[0]));
+        xeve_mcpy(buf - stride, &t, sizeof(int));
+        t = _mm_cvtsi128_si32(_mm_packs_epi32(q[0], q[0]));
+        xeve_mcpy(buf, &t, sizeof(int));
+    }
+}
+
+static void deblock_scu_addb_ver_chroma_sse(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c0, int bit_depth_minus8)
+{
+    __m128i p[DBF_LENGTH_CHROMA], q[DBF_LENGTH_CHROMA];
+    __m128i r0, r1;
+    int t;
+
+    if(!bs)
+    {
+        return;
+    }
+
+    /* 2 lines of 4 pels (p1, p0, q0, q1) */
+    r0 = _mm_unpacklo_epi16(_mm_loadl_epi64((__m128i*)(buf - 2)), _mm_loadl_epi64((__m128i*)(buf + stride - 2)));
+    p[1] = _mm_cvtepi16_epi32(r0);
+    p[0] = _mm_cvtepi16_epi32(_mm_srli_si128(r0, 4));
+    q[0] = _mm_cvtepi16_epi32(_mm_srli_si128(r0, 8));
+    q[1] = _mm_cvtepi16_epi32(_mm_srli_si128(r0, 12));
+
+    if(dbk_addb_chroma_sse(p, q, bs, alpha, beta, c0, bit_depth_minus8))
+    {
+        /* p0 and q0 of the two lines interleaved: p0 q0 | p0 q0 */
+        r1 = _mm_unpacklo_epi16(_mm_packs_epi32(p[0], p[0]), _mm_packs_epi32(q[0], q[0]));
+        t = _mm_cvtsi128_si32(r1);
+        xeve_mcpy(buf - 1, &t, sizeof(int));
+        t = _mm_cvtsi128_si32(_mm_srli_si128(r1, 4));
+        xeve_mcpy(buf + stride - 1, &t, sizeof(int));
+    }
+}
+
+const XEVEM_DBK_ADDB xevem_tbl_dbk_addb_sse[2][2] =
+{
+    /* horizontal edge: luma, chroma */
+    { deblock_scu_addb_hor_luma_sse, deblock_scu_addb_hor_chroma_sse },
+    /* vertical edge: luma, chroma */
+    { deblock_scu_addb_ver_luma_sse, deblock_scu_addb_ver_chroma_sse }
+};
+#endif /* X86_SSE */
@@ -0,0 +1,253 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+#include "xevem_ipred_sse.h"
+
+#if X86_SSE
+#define ADI_4T_FILTER_BITS          7
+#define ADI_4T_FILTER_OFFSET        (1 << (ADI_4T_FILTER_BITS - 1))
+/* samples read past a run of reference samples by the last 8-sample load */
+#define IPRED_REF_MARGIN            8
+/* the reference line of a run, displaced by up to three times the block size */
+#define IPRED_REF_LEN               (MAX_CU_SIZE * 4 + IPRED_REF_MARGIN * 2)
+
+/* ref[k - lo] = src[k] for lo <= k < hi, where k is clipped to [-1, pos_max] in
+   the same way as the C kernels clip the sample positions */
+static void ipred_ref_line(pel *ref, const pel *src, int lo, int hi, int pos_max)
+{
+    int k = lo;
+
+    for(; k < XEVE_MIN(hi, -1); k++)
+    {
+        ref[k - lo] = src[-1];
+    }
+    if(k <= pos_max && k < hi)
+    {
+        xeve_mcpy(ref + k - lo, src + k, (XEVE_MIN(hi, pos_max + 1) - k) * sizeof(pel));
+        k = XEVE_MIN(hi, pos_max + 1);
+    }
+    for(; k < hi; k++)
+    {
+        ref[k - lo] = src[pos_max];
+    }
+}
+
+/* 4-tap filter of 8 samples, r[i] * c0 + r[i + 1] * c1 + r[i + 2] * c2 + r[i + 3] * c3 */
+static __m128i ipred_filt8(const pel *r, __m128i c01, __m128i c23, __m128i max)
+{
+    const __m128i off = _mm_set1_epi32(ADI_4T_FILTER_OFFSET);
+    __m128i s0 = _mm_loadu_si128((const __m128i *)r);
+    __m128i s1 = _mm_loadu_si128((const __m128i *)(r + 1));
+    __m128i s2 = _mm_loadu_si128((const __m128i *)(r + 2));
+    __m128i s3 = _mm_loadu_si128((const __m128i *)(r + 3));
+    __m128i lo, hi;
+
+    lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(s0, s1), c01), _mm_madd_epi16(_mm_unpacklo_epi16(s2, s3), c23));
+    hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(s0, s1), c01), _mm_madd_epi16(_mm_unpackhi_epi16(s2, s3), c23));
+    lo = _mm_srai_epi32(_mm_add_epi32(lo, off), ADI_4T_FILTER_BITS);
+    hi = _mm_srai_epi32(_mm_add_epi32(hi, off), ADI_4T_FILTER_BITS);
+
+    return _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128()), max);
+}
+
+/* run of n samples (a multiple of 4) filtered with the taps f[0..3], in the
+   reverse order when rev is set */
+static void ipred_filt_run(pel *dst, const pel *r, int n, const int *f, int rev, __m128i max)
+{
+    __m128i c01, c23;
+    int i;
+
+    if(rev)
+    {
+        c01 = _mm_set1_epi32((f[2] << 16) | f[3]);
+        c23 = _mm_set1_epi32((f[0] << 16) | f[1]);
+    }
+    else
+    {
+        c01 = _mm_set1_epi32((f[1] << 16) | f[0]);
+        c23 = _mm_set1_epi32((f[3] << 16) | f[2]);
+    }
+
+    for(i = 0; i + 8 <= n; i += 8)
+    {
+        _mm_storeu_si128((__m128i *)(dst + i), ipred_filt8(r + i, c01, c23, max));
+    }
+    if(i < n)
+    {
+        _mm_storel_epi64((__m128i *)(dst + i), ipred_filt8(r + i, c01, c23, max));
+    }
+}
+
+/* dst[j * w + i] = src[i * h + j], w and h are multiples of 4 */
+static void ipred_transpose(pel *dst, const pel *src, int w, int h)
+{
+    __m128i r0, r1, r2, r3, t0, t1;
+    int i, j;
+
+    for(i = 0; i < w; i += 4)
+    {
+        for(j = 0; j < h; j += 4)
+        {
+            r0 = _mm_loadl_epi64((const __m128i *)(src + (i + 0) * h + j));
+            r1 = _mm_loadl_epi64((const __m128i *)(src + (i + 1) * h + j));
+            r2 = _mm_loadl_epi64((const __m128i *)(src + (i + 2) * h + j));
+            r3 = _mm_loadl_epi64((const __m128i *)(src + (i + 3) * h + j));
+            t0 = _mm_unpacklo_epi16(r0, r1);
+            t1 = _mm_unpacklo_epi16(r2, r3);
+            r0 = _mm_unpacklo_epi32(t0, t1);
+            r1 = _mm_unpackhi_epi32(t0, t1);
+            _mm_storel_epi64((__m128i *)(dst + (j + 0) * w + i), r0);
+            _mm_storeh_pd((double *)(dst + (j + 1) * w + i), _mm_castsi128_pd(r0));
+            _mm_storel_epi64((__m128i *)(dst + (j + 2) * w + i), r1);
+            _mm_storeh_pd((double *)(dst + (j + 3) * w + i), _mm_castsi128_pd(r1));
+        }
+    }
+}
+
+/* modes less than IPD_VER: every row is a run over the upper samples */
+static void ipred_ang_less_ver_no_right_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int ipm, int bit_depth)
+{
+    const int * mt = xevem_tbl_ipred_dxdy[ipm];
+    const __m128i max = _mm_set1_epi16((1 << bit_depth) - 1);
+    pel ref[IPRED_REF_LEN];
+    int t_dx, offset, j;
+
+    if(w < 4 || h < 4)
+    {
+        ipred_ang_less_ver_no_right(src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+        return;
+    }
+
+    /* positions x - 1 to x + 2 with x = i + t_dx */
+    ipred_ref_line(ref, src_up, -1, w + ((h * mt[0]) >> 10) + 2 + IPRED_REF_MARGIN, w + h - 1);
+
+    for(j = 0; j < h; j++)
+    {
+        t_dx = ((j + 1) * mt[0]) >> 10;
+        offset = (((j + 1) * mt[0]) >> 5) - (t_dx << 5);
+        ipred_filt_run(dst, ref + t_dx, w, xevem_tbl_ipred_adi[offset], 0, max);
+        dst += w;
+    }
+}
+
+/* modes greater than IPD_HOR: every column is a run over the left samples */
+static void ipred_ang_gt_hor_no_right_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int ipm, int bit_depth)
+{
+    const int * mt = xevem_tbl_ipred_dxdy[ipm];
+    const __m128i max = _mm_set1_epi16((1 << bit_depth) - 1);
+    pel ref[IPRED_REF_LEN];
+    pel col[MAX_CU_DIM];
+    int t_dy, offset, i;
+
+    if(w < 4 || h < 4)
+    {
+        ipred_ang_gt_hor_no_right(src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+        return;
+    }
+
+    /* positions y - 1 to y + 2 with y = j + t_dy */
+    ipred_ref_line(ref, src_le, -1, h + ((w * mt[1]) >> 10) + 2 + IPRED_REF_MARGIN, w + h - 1);
+
+    for(i = 0; i < w; i++)
+    {
+        t_dy = ((i + 1) * mt[1]) >> 10;
+        offset = (((i + 1) * mt[1]) >> 5) - (t_dy << 5);
+        ipred_filt_run(col + i * h, ref + t_dy, h, xevem_tbl_ipred_adi[offset], 0, max);
+    }
+    ipred_transpose(dst, col, w, h);
+}
+
+/* modes between IPD_VER and IPD_HOR: the samples below the projection of the
+   corner come from the left samples as columns, the others from the upper
+   samples as rows */
+static void ipred_ang_no_right_sse(pel *src_le, pel *src_up, pel *src_ri, u16 avail_lr, pel *dst, int w, int h, int ipm, int bit_depth)
+{
+    const int * mt = xevem_tbl_ipred_dxdy[ipm];
+    const __m128i max = _mm_set1_epi16((1 << bit_depth) - 1);
+    pel ref_le[IPRED_REF_LEN];
+    pel ref_up[IPRED_REF_LEN];
+    pel col[MAX_CU_DIM];
+    pel row[MAX_CU_SIZE + IPRED_REF_MARGIN];
+    int t_dx, t_dy, offset, i, j, i0;
+
+    if(w < 4 || h < 4)
+    {
+        ipred_ang_no_right(src_le, src_up, src_ri, avail_lr, dst, w, h, ipm, bit_depth);
+        return;
+    }
+
+    /* positions y + 1 to y - 2 with y = j - t_dy, where t_dy is at most h for
+       the rows which are taken from the left samples */
+    ipred_ref_line(ref_le, src_le, -h - 2, h + 1 + IPRED_REF_MARGIN, w + h - 1);
+    /* positions x + 1 to x - 2 with x = i - t_dx, where x is at least -1 for
+       the columns which are taken from the upper samples */
+    ipred_ref_line(ref_up, src_up, -3, w + 4 + IPRED_REF_MARGIN, w + h - 1);
+
+    for(i = 0; i < w; i++)
+    {
+        t_dy = ((i + 1) * mt[1]) >> 10;
+        offset = (((i + 1) * mt[1]) >> 5) - (t_dy << 5);
+        ipred_filt_run(col + i * h, ref_le + h - XEVE_MIN(t_dy, h), h, xevem_tbl_ipred_adi[offset], 1, max);
+    }
+    ipred_transpose(dst, col, w, h);
+
+    i0 = 0;
+    for(j = 0; j < h; j++)
+    {
+        /* first column whose projection of the corner is below this row */
+        while(i0 < w && (((i0 + 1) * mt[1]) >> 10) <= j)
+        {
+            i0++;
+        }
+        if(i0 < w)
+        {
+            t_dx = ((j + 1) * mt[0]) >> 10;
+            offset = (((j + 1) * mt[0]) >> 5) - (t_dx << 5);
+            xeve_assert(i0 - t_dx >= -1);
+            ipred_filt_run(row, ref_up + 1 + i0 - t_dx, (w - i0 + 3) & ~3, xevem_tbl_ipred_adi[offset], 1, max);
+            xeve_mcpy(dst + i0, row, (w - i0) * sizeof(pel));
+        }
+        dst += w;
+    }
+}
+
+const XEVE_INTRA_PRED_ANG xeve_tbl_intra_pred_ang_sse[3][2] =
+{
+    {ipred_ang_less_ver_no_right_sse, ipred_ang_less_ver_on_right},
+    {ipred_ang_gt_hor_no_right_sse, ipred_ang_gt_hor_on_right},
+    {ipred_ang_no_right_sse, ipred_ang_only_right},
+};
+#endif /* X86_SSE */
@@ -165,7 +165,7 @@ ERR:
     return ret;
 }
 
-static int xevem_ctu_mt_core(void * arg)
+static int xevem_ctu_mt_core(void * arg, int task_idx, int worker_id)
 {
     assert(arg != NULL);
 
@@ -189,6 +189,7 @@ static int xevem_ctu_mt_core(void * arg)
     xeve_update_core_loc_param_mt(ctx, core);
 
     int bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
+    int ctu_bits = 0;
 
     /* LCU encoding loop */
     while (ctx->tile[i].f_ctb > 0)
@@ -196,7 +197,13 @@ static int xevem_ctu_mt_core(void * arg)
         if (core->y_lcu != sp_y_lcu && core->x_lcu < (sp_x_lcu + ctx->tile[core->tile_idx].w_ctb - 1))
         {
             /* up-right CTB */
-            spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + 1], THREAD_TERMINATED);
+            threadsafe_wait(ctx->sync_wait, &ctx->sync_flag[core->lcu_num - ctx->w_lcu + 1], THREAD_TERMINATED, &core->wait_time);
+        }
+
+        if (ctx->param.row_vbv && core->x_lcu == sp_x_lcu)
+        {
+            /* qp of the CTU row from the bits of the rows above */
+            xeve_rc_row_qp(ctx, core);
         }
 
         /* initialize structures *****************************************/
@@ -223,9 +230,18 @@ static int xevem_ctu_mt_core(void * arg)
             /* entropy coding ************************************************/
             int split_mode_child[4];
             int split_allow[6] = { 0, 0, 0, 0, 0, 1 };
+            if (ctx->param.row_vbv)
+            {
+                ctu_bits = xeve_rc_bsw_bits(bs);
+            }
             ret = xevem_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0, 1, NO_SPLIT
                               , split_mode_child, 0, split_allow, 0, 0, 0, xeve_get_default_tree_cons(), bs);
             bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
+
+            if (ctx->param.row_vbv)
+            {
+                xeve_rc_row_update(ctx, core, xeve_rc_bsw_bits(bs) - ctu_bits);
+            }
         }
 #if GRAB_STAT
         xeve_stat_set_enc_state(FALSE);
@@ -233,9 +249,15 @@ static int xevem_ctu_mt_core(void * arg)
 #endif
         xeve_assert_rv(ret == XEVE_OK, ret);
 
-        threadsafe_assign(&ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
+        threadsafe_signal(ctx->sync_wait, &ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
         threadsafe_decrement(ctx->sync_block, (volatile s32 *)&ctx->tile[i].f_ctb);
 
+        if (ctx->loop_filter_pipe)
+        {
+            ret = xevem_loop_filter_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+        }
+
         core->lcu_num = xeve_mt_get_next_ctu_num(ctx, core, ctx->parallel_rows);
         if (core->lcu_num == -1)
             break;
@@ -244,51 +266,102 @@ static int xevem_ctu_mt_core(void * arg)
 }
 
 
-static int xevem_tile_mt_core(void * arg)
+static int xevem_tile_mt_core(void * arg, int tile_idx, int worker_id)
 {
-    XEVE_CORE * core = (XEVE_CORE *)arg;
-    XEVE_CTX  * ctx = core->ctx;
-    int i;
-    int res, ret;
-    int temp_store_total_ctb = ctx->tile[core->tile_idx].f_ctb;
-    int parallel_task = ctx->tile_cnt == 1 ? ((ctx->param.threads > ctx->tile[core->tile_idx].h_ctb) ?
-                                             ctx->tile[core->tile_idx].h_ctb : ctx->param.threads): 1;
-    ctx->parallel_rows = parallel_task;
-    ctx->tile[core->tile_idx].qp = ctx->sh->qp;
-    for (i = 0; i < ctx->param.threads; i++)
-    {
-        ctx->tile[core->tile_idx].qp_prev_eco[i] = ctx->sh->qp;
-    }
+    XEVE_CTX  * ctx = (XEVE_CTX *)arg;
+    XEVE_CORE * core = ctx->core[worker_id];
+    int ret;
+    int temp_store_total_ctb = ctx->tile[tile_idx].f_ctb;
+
+    /* tile may run on any worker, so the core is set up from the slice rather than from another core */
+    core->qp_y = ctx->sh->qp + 6 * ctx->sps.bit_depth_luma_minus8;
+    core->qp_u = ctx->qp_chroma_dynamic[0][ctx->sh->qp_u] + 6 * ctx->sps.bit_depth_chroma_minus8;
+    core->qp_v = ctx->qp_chroma_dynamic[1][ctx->sh->qp_v] + 6 * ctx->sps.bit_depth_chroma_minus8;
+    core->tile_idx = tile_idx;
+    core->x_lcu = ((ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu);
+    core->y_lcu = ((ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu);
+    core->lcu_num = core->y_lcu * ctx->w_lcu + core->x_lcu;
+    xevem_init_core_mt(ctx, tile_idx, core, worker_id);
+    core->thread_cnt = worker_id;
 
-    for (int thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++)
-    {
-        ctx->core[thread_cnt]->tile_idx = core->tile_idx;
-        ctx->core[thread_cnt]->x_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) % ctx->w_lcu);               //entry point lcu's x location
-        ctx->core[thread_cnt]->y_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) / ctx->w_lcu) + thread_cnt; // entry point lcu's y location
-        ctx->core[thread_cnt]->lcu_num = ctx->core[thread_cnt]->y_lcu * ctx->w_lcu + ctx->core[thread_cnt]->x_lcu;
+    ret = xevem_ctu_mt_core((void*)core, tile_idx, worker_id);
 
-        xevem_init_core_mt(ctx, core->tile_idx, core, thread_cnt);
+    ctx->tile[tile_idx].f_ctb = temp_store_total_ctb;
 
-        ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-        ctx->tc->run(ctx->thread_pool[thread_cnt], xevem_ctu_mt_core, (void*)ctx->core[thread_cnt]);
-    }
+    return ret;
+}
 
-    core->x_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) % ctx->w_lcu);
-    core->y_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) / ctx->w_lcu);
-    core->lcu_num = core->y_lcu * ctx->w_lcu + core->x_lcu;
+static int xevem_tile_eco_mt_core(void * arg, int tile_pos, int worker_id)
+{
+    XEVE_CTX             * ctx = (XEVE_CTX *)arg;
+    XEVE_CORE            * core = ctx->core[worker_id];
+    XEVE_SH              * sh = ctx->sh;
+    XEVE_ALF_SLICE_PARAM * alf_slice_param = &(sh->alf_sh_param);
+    XEVE_SBAC            * sbac;
+    XEVE_BSW               bs;
+    int                    split_mode_child[4];
+    int                    split_allow[6] = { 0, 0, 0, 0, 0, 1 };
+    int                    i = sh->tile_order[tile_pos];
+    int                    sp_x_lcu = ctx->tile[i].ctba_rs_first % ctx->w_lcu;
+    int                    ctb_cnt_in_tile = ctx->tile[i].f_ctb;
+    int                    ret;
+
+    /* tile is coded into its own buffer with the CABAC engine of the worker */
+    xeve_bsw_init(&bs, ctx->bs_tbuf[i], ctx->bs_tbuf_size, NULL);
+    bs.pdata[1] = &ctx->sbac_enc[worker_id];
+    sbac = GET_SBAC_ENC(&bs);
+    ctx->fn_eco_sbac_reset(sbac, sh->slice_type, sh->qp, ctx->sps.tool_cm_init);
+
+    core->ctx = ctx;
+    core->tile_idx = i;
+    core->thread_cnt = worker_id;
+    ctx->tile[i].qp_prev_eco[worker_id] = sh->qp;
+
+    core->x_lcu = sp_x_lcu;
+    core->y_lcu = ctx->tile[i].ctba_rs_first / ctx->w_lcu;
+    xeve_update_core_loc_param(ctx, core);
+
+    while (ctb_cnt_in_tile > 0) // LCU level CABAC loop
+    {
+        if ((alf_slice_param->is_ctb_alf_on) && (sh->alf_on))
+        {
+            XEVE_TRACE_COUNTER;
+            XEVE_TRACE_STR("Usage of ALF: ");
+            xeve_sbac_encode_bin((int)(*(alf_slice_param->alf_ctb_flag + core->lcu_num)), sbac, sbac->ctx.alf_ctb_flag, &bs);
+            XEVE_TRACE_INT((int)(*(alf_slice_param->alf_ctb_flag + core->lcu_num)));
+            XEVE_TRACE_STR("\n");
+        }
+        if ((sh->alfChromaMapSignalled) && (sh->alf_on))
+        {
+            xeve_sbac_encode_bin((int)(*(alf_slice_param->alf_ctb_chroma_flag + core->lcu_num)), sbac, sbac->ctx.alf_ctb_flag, &bs);
+        }
+        if ((sh->alfChroma2MapSignalled) && (sh->alf_on))
+        {
+            xeve_sbac_encode_bin((int)(*(alf_slice_param->alf_ctb_chroma2_flag + core->lcu_num)), sbac, sbac->ctx.alf_ctb_flag, &bs);
+        }
 
-    xevem_ctu_mt_core(arg);
+        ret = xevem_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0, 1, NO_SPLIT
+                           , split_mode_child, 0, split_allow, 0, 0, 0, xeve_get_default_tree_cons(), &bs);
+        xeve_assert_rv(ret == XEVE_OK, ret);
 
-    for (int thread_cnt1 = 1; thread_cnt1 < parallel_task; thread_cnt1++)
-    {
-        ctx->tc->join(ctx->thread_pool[thread_cnt1], &res);
-        if (XEVE_FAILED(res))
+        /* prepare next step *********************************************/
+        core->x_lcu++;
+        if (core->x_lcu >= sp_x_lcu + ctx->tile[i].w_ctb)
         {
-            ret = res;
+            core->x_lcu = sp_x_lcu;
+            core->y_lcu++;
         }
+        xeve_update_core_loc_param(ctx, core);
+        ctb_cnt_in_tile--;
     }
 
-    ctx->tile[core->tile_idx].f_ctb = temp_store_total_ctb;
+    xeve_eco_tile_end_flag(&bs, 1);
+    xeve_sbac_finish(&bs);
+    xeve_bsw_deinit(&bs);
+
+    ctx->tile[i].bs_size = XEVE_BSW_GET_WRITE_BYTE(&bs);
+    ctx->tile[i].bin_cnt = sbac->bin_counter;
+    sh->entry_point_offset_minus1[tile_pos] = ctx->tile[i].bs_size - 1;
 
     return XEVE_OK;
 }
@@ -303,10 +376,6 @@ int xevem_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
     XEVE_APS_GEN * aps_dra;
     int            ret;
     u32            i, j;
-    int            split_mode_child[4];
-    int            split_allow[6] = { 0, 0, 0, 0, 0, 1 };
-    int            ctb_cnt_in_tile = 0;
-    int            col_bd = 0;
     int            num_slice_in_pic = ctx->param.num_slice_in_pic;
     u8           * tiles_in_slice;
     u16            total_tiles_in_slice;
@@ -381,6 +450,15 @@ int xevem_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
 
         ctx->fn_mode_analyze_frame(ctx);
 
+        /* IBC references unfiltered samples anywhere in the search range of the picture */
+        xeve_loop_filter_pipe_init(ctx, !ctx->sps.ibc_flag);
+        if (ctx->sps.tool_alf)
+        {
+            ((XEVEM_CTX *)ctx)->enc_alf->ctu_stats_pipe = ctx->loop_filter_pipe;
+            /* ALF filters the deblocked picture afterwards, so the borders are expanded at the end */
+            ctx->expand_pipe = 0;
+        }
+
         /* slice layer encoding loop */
         core->x_lcu = core->y_lcu = 0;
         core->x_pel = core->y_pel = 0;
@@ -421,57 +499,59 @@ int xevem_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
         core->dqp_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2].prev_qp = ctx->sh->qp;
 
         /* Tile wise encoding with in a slice */
-        u32 k = 0;
         total_tiles_in_slice = sh->num_tiles_in_slice;
-        THREAD_CONTROLLER * tc;
-        int res;
-        i = 0;
-        tc = ctx->tc;
-        int parallel_task = 1;
-        int thread_cnt = 0, thread_cnt1 = 0;;
-        int task_completed = 0;
-
-        //Code for CTU parallel encoding
-        while (total_tiles_in_slice)
+
+        for (i = 0; i < total_tiles_in_slice; i++)
         {
-            parallel_task = (ctx->param.threads > total_tiles_in_slice) ? total_tiles_in_slice : ctx->param.threads;
-            for (thread_cnt = 0; (thread_cnt < parallel_task - 1); thread_cnt++)
+            ctx->tile[tiles_in_slice[i]].qp = ctx->sh->qp;
+            for (j = 0; j < (u32)ctx->param.threads; j++)
             {
-                i = tiles_in_slice[thread_cnt + task_completed];
-
-                ctx->tile[i].qp = ctx->sh->qp;
-                for (j = 0; j < (u32)ctx->param.threads; j++)
-                {
-                    ctx->tile[i].qp_prev_eco[j] = ctx->sh->qp;
-                }
-                ctx->core[thread_cnt]->tile_idx = i;
-                xevem_init_core_mt(ctx, i, core, thread_cnt);
-                ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-                tc->run(ctx->thread_pool[thread_cnt], xevem_tile_mt_core, (void*)ctx->core[thread_cnt]);
+                ctx->tile[tiles_in_slice[i]].qp_prev_eco[j] = ctx->sh->qp;
             }
+        }
 
-            i = tiles_in_slice[thread_cnt + task_completed];
-            ctx->tile[i].qp = ctx->sh->qp;
-            ctx->core[thread_cnt]->tile_idx = i;
+        if (ctx->tile_cnt == 1)
+        {
+            //Code for CTU parallel encoding, one task per lane of CTU rows
+            int tile_idx = tiles_in_slice[0];
+            int temp_store_total_ctb = ctx->tile[tile_idx].f_ctb;
+            int parallel_task = (ctx->param.threads > ctx->tile[tile_idx].h_ctb) ? ctx->tile[tile_idx].h_ctb : ctx->param.threads;
+            ctx->parallel_rows = parallel_task;
 
-            for (j = 0; j < (u32)ctx->param.threads; j++)
+            for (int thread_cnt = 0; thread_cnt < parallel_task; thread_cnt++)
             {
-                ctx->tile[i].qp_prev_eco[j] = ctx->sh->qp;
+                ctx->core[thread_cnt]->tile_idx = tile_idx;
+                ctx->core[thread_cnt]->x_lcu = ((ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu);               //entry point lcu's x location
+                ctx->core[thread_cnt]->y_lcu = ((ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu) + thread_cnt; // entry point lcu's y location
+                ctx->core[thread_cnt]->lcu_num = ctx->core[thread_cnt]->y_lcu * ctx->w_lcu + ctx->core[thread_cnt]->x_lcu;
+
+                xevem_init_core_mt(ctx, tile_idx, core, thread_cnt);
+
+                ctx->core[thread_cnt]->thread_cnt = thread_cnt;
+                task_init(&ctx->task[thread_cnt], xevem_ctu_mt_core, (void*)ctx->core[thread_cnt], thread_cnt);
+                ret = task_submit(ctx->sched, &ctx->task[thread_cnt]);
+                xeve_assert_rv(ret == THREAD_SUCCESS, XEVE_ERR_UNKNOWN);
             }
 
-            xevem_init_core_mt(ctx, i, core, thread_cnt);
-            ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-            xevem_tile_mt_core((void*)ctx->core[thread_cnt]);
-            for (thread_cnt1 = 0; thread_cnt1 < parallel_task - 1; thread_cnt1++)
+            ret = task_wait_all(ctx->sched);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+
+            ctx->tile[tile_idx].f_ctb = temp_store_total_ctb;
+        }
+        else
+        {
+            //Code for tile parallel encoding, tiles are picked up by whichever worker gets idle first
+            ctx->parallel_rows = 1;
+
+            for (i = 0; i < total_tiles_in_slice; i++)
             {
-                tc->join(ctx->thread_pool[thread_cnt1], &res);
-                if (XEVE_FAILED(res))
-                {
-                    ret = res;
-                }
+                task_init(&ctx->task[i], xevem_tile_mt_core, (void*)ctx, tiles_in_slice[i]);
+                ret = task_submit(ctx->sched, &ctx->task[i]);
+                xeve_assert_rv(ret == THREAD_SUCCESS, XEVE_ERR_UNKNOWN);
             }
-            total_tiles_in_slice -= parallel_task;
-            task_completed += parallel_task;
+
+            ret = task_wait_all(ctx->sched);
+            xeve_assert_rv(ret == XEVE_OK, ret);
         }
     }//End of mode decision
 
@@ -518,10 +598,6 @@ int xevem_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
 
         xeve_bsw_init_slice(&ctx->bs[0], (u8*)curr_temp, bitb->bsize, NULL);
 
-        XEVE_SBAC* t_sbac;
-        t_sbac = GET_SBAC_ENC(bs);
-        t_sbac->bin_counter = 0;
-
         unsigned int bin_counts_in_units = 0;
         unsigned int num_bytes_in_units = 0;
 
@@ -551,6 +627,31 @@ int xevem_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
             aps_dra->signal_flag = 0;
         }
 
+        /* entropy coding, each tile into its own buffer in parallel */
+        for (i = 0; i < ctx->f_scu; i++)
+        {
+            MCU_CLR_COD(ctx->map_scu[i]);
+        }
+        ctx->sh->qp_prev_eco = ctx->sh->qp;
+
+#if GRAB_STAT
+        xeve_stat_set_enc_state(FALSE);
+#endif
+        for (i = 0; i < total_tiles_in_slice; i++)
+        {
+#if ENC_DEC_TRACE
+            /* keep the trace in bitstream order */
+            ret = xevem_tile_eco_mt_core((void*)ctx, i, 0);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+#else
+            task_init(&ctx->task[i], xevem_tile_eco_mt_core, (void*)ctx, i);
+            ret = task_submit(ctx->sched, &ctx->task[i]);
+            xeve_assert_rv(ret == THREAD_SUCCESS, XEVE_ERR_UNKNOWN);
+#endif
+        }
+        ret = task_wait_all(ctx->sched);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+
         u8* size_field = bs->cur;
         u8* cur_tmp = bs->cur;
 
@@ -558,126 +659,23 @@ int xevem_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
         ret = xeve_eco_nalu(bs, &ctx->nalu);
         xeve_assert_rv(ret == XEVE_OK, ret);
 
-        /* Encode slice header */
+        /* Encode slice header, entry points are already known from the tile buffers */
         sh->num_ctb = ctx->f_lcu;
-        XEVE_BSW bs_sh;
-        xeve_mcpy(&bs_sh, bs, sizeof(XEVE_BSW));
-#if TRACE_HLS
-        s32 tmp_fp_point = ftell(fp_trace);
-#endif
         ret = ctx->fn_eco_sh(bs, &ctx->sps, &ctx->pps, sh, ctx->nalu.nal_unit_type_plus1 - 1);
         xeve_assert_rv(ret == XEVE_OK, ret);
 
+        /* Concatenate tile bitstreams in tile order of the slice */
+        for (i = 0; i < total_tiles_in_slice; i++)
+        {
+            j = tiles_in_slice[i];
+            ret = xeve_bsw_write_byte_array(bs, ctx->bs_tbuf[j], ctx->tile[j].bs_size);
+            xeve_assert_rv(ret == XEVE_OK, XEVE_ERR_UNKNOWN);
+            bin_counts_in_units += ctx->tile[j].bin_cnt;
+        }
         core->x_lcu = core->y_lcu = 0;
         core->x_pel = core->y_pel = 0;
         core->lcu_num = 0;
         ctx->lcu_cnt = ctx->f_lcu;
-        for(i = 0; i < ctx->f_scu; i++)
-        {
-            MCU_CLR_COD(ctx->map_scu[i]);
-        }
-        ctx->sh->qp_prev_eco = ctx->sh->qp;
-
-#if GRAB_STAT
-        xeve_stat_set_enc_state(FALSE);
-#endif
-        /* Tile level encoding for a slice */
-        /* Tile wise encoding with in a slice */
-        int k = 0;
-        total_tiles_in_slice = sh->num_tiles_in_slice;
-        while (total_tiles_in_slice)
-        {
-            int i = tiles_in_slice[k++];
-            ctx->tile[i].qp = ctx->sh->qp;
-            ctx->tile[i].qp_prev_eco[core->thread_cnt] = ctx->sh->qp;
-            core->tile_idx = i;
-
-            /* CABAC Initialize for each Tile */
-            ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
-
-            /*Set entry point for each Tile in the tile Slice*/
-            core->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu; //entry point lcu's x location
-            core->y_lcu = (ctx->tile[i].ctba_rs_first) / ctx->w_lcu; // entry point lcu's y location
-            ctb_cnt_in_tile = ctx->tile[i].f_ctb; //Total LCUs in the current tile
-            xeve_update_core_loc_param(ctx, core);
-
-            XEVE_BSW bs_beg;
-            bs_beg.cur = bs->cur;
-            bs_beg.leftbits = bs->leftbits;
-
-            col_bd = 0;
-            if (i% ctx->param.tile_columns)
-            {
-                int temp = i - 1;
-                while (temp >= 0)
-                {
-                    col_bd += ctx->tile[temp].w_ctb;
-                    if (!(temp%ctx->param.tile_columns)) break;
-                    temp--;
-                }
-            }
-            else
-            {
-                col_bd = 0;
-            }
-
-            while (1) // LCU level CABAC loop
-            {
-                XEVE_ALF_SLICE_PARAM * alf_slice_param = &(ctx->sh->alf_sh_param);
-                if ((alf_slice_param->is_ctb_alf_on) && (sh->alf_on))
-                {
-                    XEVE_SBAC *sbac;
-                    sbac = GET_SBAC_ENC(bs);
-                    XEVE_TRACE_COUNTER;
-                    XEVE_TRACE_STR("Usage of ALF: ");
-                    xeve_sbac_encode_bin((int)(*(alf_slice_param->alf_ctb_flag + core->lcu_num)), sbac, sbac->ctx.alf_ctb_flag, bs);
-                    XEVE_TRACE_INT((int)(*(alf_slice_param->alf_ctb_flag + core->lcu_num)));
-                    XEVE_TRACE_STR("\n");
-                }
-                if ((ctx->sh->alfChromaMapSignalled) && (ctx->sh->alf_on))
-                {
-                    XEVE_SBAC *sbac;
-                    sbac = GET_SBAC_ENC(bs);
-                    xeve_sbac_encode_bin((int)(*(alf_slice_param->alf_ctb_chroma_flag + core->lcu_num)), sbac, sbac->ctx.alf_ctb_flag, bs);
-                }
-                if ((ctx->sh->alfChroma2MapSignalled) && (ctx->sh->alf_on))
-                {
-                    XEVE_SBAC *sbac;
-                    sbac = GET_SBAC_ENC(bs);
-                    xeve_sbac_encode_bin((int)(*(alf_slice_param->alf_ctb_chroma2_flag + core->lcu_num)), sbac, sbac->ctx.alf_ctb_flag, bs);
-                }
-
-                ret = xevem_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0, 1, NO_SPLIT
-                                      , split_mode_child, 0, split_allow, 0, 0, 0, xeve_get_default_tree_cons(), bs);
-                xeve_assert_rv(ret == XEVE_OK, ret);
-                /* prepare next step *********************************************/
-                core->x_lcu++;
-                if (core->x_lcu >= ctx->tile[i].w_ctb + col_bd)
-                {
-                    core->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu;
-                    core->y_lcu++;
-                }
-
-                xeve_update_core_loc_param(ctx, core);
-                ctb_cnt_in_tile--;
-                ctx->lcu_cnt--; //To be updated properly in case of multicore
-
-                /* end_of_picture_flag */
-                if (ctb_cnt_in_tile == 0)
-                {
-                    xeve_eco_tile_end_flag(bs, 1);
-                    xeve_sbac_finish(bs);
-                    break;
-                }
-            } //End of LCU encoding loop in a tile
-
-            XEVE_SBAC* tmp_sbac;
-            tmp_sbac = GET_SBAC_ENC(bs);
-            bin_counts_in_units += tmp_sbac->bin_counter;
-            total_tiles_in_slice--;
-
-            sh->entry_point_offset_minus1[k - 1] = (u32)((bs)->cur - bs_beg.cur - 4 + (4 - (bs->leftbits >> 3)) + (bs_beg.leftbits >> 3) - 1);
-        } // End to tile encoding loop in a slice
 
         num_bytes_in_units = (int)(bs->cur - cur_tmp) - 4;
 
@@ -707,18 +705,6 @@ int xevem_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
         xeve_bsw_deinit(bs);
         xeve_eco_nal_unit_len(size_field, (int)(bs->cur - cur_tmp) - 4);
         curr_temp = bs->cur;
-
-        /* slice header re-writing */
-#if TRACE_HLS
-        s32 tmp_fp_point2 = ftell(fp_trace);
-        fseek(fp_trace, tmp_fp_point, SEEK_SET);
-#endif
-        ret = ctx->fn_eco_sh(&bs_sh, &ctx->sps, &ctx->pps, sh, ctx->nalu.nal_unit_type_plus1 - 1);
-        xeve_assert_rv(ret == XEVE_OK, ret);
-        xeve_bsw_deinit(&bs_sh);
-#if TRACE_HLS
-        fseek(fp_trace, tmp_fp_point2, SEEK_SET);
-#endif
         /* Bit-stream writing (END) */
 
     }  // End of slice loop
@@ -750,6 +736,9 @@ XEVE xeve_create(XEVE_CDSC * cdsc, int * err)
     ctx = (XEVE_CTX*)xevem_ctx_alloc();
     xeve_assert_gv(ctx != NULL, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
 
+    /* kernels are dispatched through the context the calling thread works for */
+    thread_owner = ctx;
+
     /* set default value for encoding parameter */
     xeve_mcpy(&ctx->param, &(cdsc->param), sizeof(XEVE_PARAM));
     ret = xevem_set_init_param(ctx, &ctx->param);
@@ -789,7 +778,8 @@ ERR:
             xeve_platform_deinit(ctx);
         }
         xeve_delete_bs_buf(ctx);
-        xeve_ctx_free(ctx);
+        xevem_ctx_free(ctx);
+        thread_owner = NULL;
     }
     if(err) *err = ret;
     return NULL;
@@ -800,6 +790,7 @@ void xeve_delete(XEVE id)
     XEVE_CTX * ctx;
 
     XEVE_ID_TO_CTX_R(id, ctx);
+    thread_owner = ctx;
 
 #if ENC_DEC_TRACE
     fclose(fp_trace);
@@ -823,14 +814,17 @@ void xeve_delete(XEVE id)
     }
 
     xeve_delete_bs_buf(ctx);
-    xeve_ctx_free(ctx);
+    xevem_ctx_free(ctx);
+    thread_owner = NULL;
 }
 
 int xeve_encode(XEVE id, XEVE_BITB * bitb, XEVE_STAT * stat)
 {
     XEVE_CTX * ctx;
+    int        ret;
 
     XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
+    thread_owner = ctx;
     xeve_assert_rv(ctx->fn_enc, XEVE_ERR_UNEXPECTED);
 
     /* bumping - check whether input pictures are remaining or not in pico_buf[] */
@@ -838,12 +832,11 @@ int xeve_encode(XEVE id, XEVE_BITB * bitb, XEVE_STAT * stat)
     {
         return XEVE_OK_NO_MORE_FRM;
     }
-    if(!FORCE_OUT(ctx))
+    if (ctx->param.use_fcst && FORCE_OUT(ctx))
     {
-        if (ctx->param.use_fcst)
-        {
-            xeve_forecast_fixed_gop(ctx);
-        }
+        /* the last pictures are coded with the analysis of the last push */
+        ret = xeve_fcst_sync(ctx);
+        xeve_assert_rv(ret == XEVE_OK, ret);
     }
     /* store input picture and return if needed */
     if(XEVE_OK_OUT_NOT_AVAILABLE == xeve_check_frame_delay(ctx))
@@ -860,11 +853,28 @@ int xeve_encode(XEVE id, XEVE_BITB * bitb, XEVE_STAT * stat)
 int xeve_push(XEVE id, XEVE_IMGB * img)
 {
     XEVE_CTX * ctx;
+    int        ret;
 
     XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
+    thread_owner = ctx;
     xeve_assert_rv(ctx->fn_push, XEVE_ERR_UNEXPECTED);
 
-    return ctx->fn_push(ctx, img);
+    if (ctx->param.use_fcst)
+    {
+        /* the picture buffers read by the running analysis are reused by the push */
+        ret = xeve_fcst_sync(ctx);
+        xeve_assert_rv(ret == XEVE_OK, ret);
+    }
+
+    ret = ctx->fn_push(ctx, img);
+    xeve_assert_rv(ret == XEVE_OK, ret);
+
+    if (ctx->param.use_fcst)
+    {
+        /* analyse the pushed picture, ahead of the encoder with lookahead threads */
+        ret = xeve_fcst_run(ctx);
+    }
+    return ret;
 }
 
 int xeve_config(XEVE id, int cfg, void * buf, int * size)
@@ -874,6 +884,7 @@ int xeve_config(XEVE id, int cfg, void * buf, int * size)
     XEVE_IMGB     * imgb;
 
     XEVE_ID_TO_CTX_RV(id, ctx, XEVE_ERR_INVALID_ARGUMENT);
+    thread_owner = ctx;
 
     switch(cfg)
     {
@@ -1032,6 +1043,14 @@ int xeve_config(XEVE id, int cfg, void * buf, int * size)
             xeve_assert_rv(*size == sizeof(int), XEVE_ERR_INVALID_ARGUMENT);
             *((int *)buf) = XEVE_PROFILE_MAIN;
             break;
+        case XEVE_CFG_GET_THREAD_WAIT_TIME:
+            xeve_assert_rv(*size >= (int)sizeof(long long) * ctx->param.threads, XEVE_ERR_INVALID_ARGUMENT);
+            for (t0 = 0; t0 < ctx->param.threads; t0++)
+            {
+                ((long long *)buf)[t0] = (long long)ctx->core[t0]->wait_time;
+            }
+            *size = (int)sizeof(long long) * ctx->param.threads;
+            break;
         case XEVE_CFG_GET_BPS:
             xeve_assert_rv(*size == sizeof(int), XEVE_ERR_INVALID_ARGUMENT);
             if (ctx->rc != NULL)
@@ -1271,6 +1290,7 @@ int xeve_param_check(const XEVE_PARAM* param)
         if (param->ibc_flag     == 1) { xeve_trace("IBC cannot be on in base profile\n"); ret = -1; }
         if (param->tool_rpl     == 1) { xeve_trace("RPL cannot be on in base profile\n"); ret = -1; }
         if (param->tool_pocs    == 1) { xeve_trace("POCS cannot be on in base profile\n"); ret = -1; }
+        if (param->adaptive_gop == 1) { xeve_trace("Adaptive GOP cannot be on in base profile\n"); ret = -1; }
     }
     else
     {
@@ -1311,6 +1331,33 @@ int xeve_param_check(const XEVE_PARAM* param)
         if (param->framework_suco_min > param->framework_suco_max) { xeve_trace("Minimum SUCO size cannot be greater than Maximum SUCO size\n"); ret = -1; }
     }
 
+    if (param->pass < 0 || param->pass > 2) { xeve_trace("Rate control pass should be 0, 1 or 2\n"); ret = -1; }
+    if (param->pass > 0)
+    {
+        if (param->stats[0] == '\0') { xeve_trace("Multi-pass rate control needs a stats file\n"); ret = -1; }
+        if (param->rc_type == XEVE_RC_CQP) { xeve_trace("Multi-pass rate control cannot be used with CQP\n"); ret = -1; }
+        if (param->pass == 2 && param->rc_type != XEVE_RC_ABR) { xeve_trace("Second pass of rate control needs ABR\n"); ret = -1; }
+    }
+    if (param->row_vbv != 0 && param->row_vbv != 1) { xeve_trace("Row VBV should be 0 or 1\n"); ret = -1; }
+    if (param->cu_qp_delta_area < 6) { xeve_trace("CU QP delta area should not be less than 6\n"); ret = -1; }
+    if (param->row_vbv && param->rc_type == XEVE_RC_CQP) { xeve_trace("Row VBV cannot be used with CQP\n"); ret = -1; }
+    if (param->row_vbv && !param->cabac_refine) { xeve_trace("Row VBV needs CABAC refinement to measure the CTU bits\n"); ret = -1; }
+    if (param->lookahead_threads < 0) { xeve_trace("Lookahead threads should not be negative\n"); ret = -1; }
+    if (param->isa < XEVE_ISA_AUTO || param->isa > XEVE_ISA_AVX512) { xeve_trace("Instruction set should be in the range of 0 to 4\n"); ret = -1; }
+    if (param->me_spel_plane < 0 || param->me_spel_plane > 2) { xeve_trace("Sub-pel ME planes should be 0, 1 or 2\n"); ret = -1; }
+    if (param->me_cache != 0 && param->me_cache != 1) { xeve_trace("ME cache should be 0 or 1\n"); ret = -1; }
+    if (param->early_skip != 0 && param->early_skip != 1) { xeve_trace("Early SKIP should be 0 or 1\n"); ret = -1; }
+    if (param->scenecut < 0 || param->scenecut > 100) { xeve_trace("Scene cut should be in the range of 0 to 100\n"); ret = -1; }
+    if (param->scenecut && param->closed_gop) { xeve_trace("Scene cut cannot be used with closed GOP\n"); ret = -1; }
+    if (param->adaptive_gop != 0 && param->adaptive_gop != 1) { xeve_trace("Adaptive GOP should be 0 or 1\n"); ret = -1; }
+    if (param->adaptive_gop)
+    {
+        if (param->bframes != 7 && param->bframes != 15) { xeve_trace("Adaptive GOP needs 7 or 15 B pictures\n"); ret = -1; }
+        if (param->closed_gop) { xeve_trace("Adaptive GOP cannot be used with closed GOP\n"); ret = -1; }
+        if (param->disable_hgop) { xeve_trace("Adaptive GOP needs the hierarchical GOP\n"); ret = -1; }
+        if (!param->tool_rpl || !param->tool_pocs || param->rpl_extern) { xeve_trace("Adaptive GOP needs RPL and POCS with the predefined RPLs\n"); ret = -1; }
+    }
+
     if (XEVE_CS_GET_FORMAT(param->cs) != XEVE_CF_YCBCR400)
     {
         int pic_m = 2;
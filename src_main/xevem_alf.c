@@ -33,8 +33,83 @@
    POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include "xevem_type.h"
 #include "xevem_alf.h"
 
+
+/* stage of the ALF encoder spread over the task scheduler: run() is called
+   for every job in [0, job_cnt), lane l takes the jobs l, l + lanes, ... in order */
+typedef struct _ALF_MT_STAGE ALF_MT_STAGE;
+struct _ALF_MT_STAGE
+{
+    XEVE_ALF          * enc_alf;
+    void             (* run)(ALF_MT_STAGE * stage, int job, int lane);
+    int                 job_cnt;
+    int                 lanes;
+    /* arguments of the stage */
+    YUV               * org_yuv;
+    YUV               * rec_yuv;
+    ALF_COVARIANCE    * frame_cov;
+    ALF_COVARIANCE   ** ctb_cov;
+    u8                * ctb_enable_flags;
+    ALF_SLICE_PARAM   * alf_slice_param;
+    u8                  comp_id;
+    int                 shape_idx;
+    int                 num_classes;
+    int                 num_coef;
+    int                 x_l, x_r, y_l, y_r;
+    /* scratch buffers of the lanes */
+    void              * lane_buf;
+};
+
+/* scratch buffers of a lane filtering CTBs */
+typedef struct _ALF_MT_LANE
+{
+    pel                 buf_l[(MAX_CU_SIZE + MAX_ALF_FILTER_LENGTH - 1) * (MAX_CU_SIZE + MAX_ALF_FILTER_LENGTH - 1)];
+    pel                 buf_cb[((MAX_CU_SIZE >> 1) + MAX_ALF_FILTER_LENGTH - 1) * ((MAX_CU_SIZE >> 1) + MAX_ALF_FILTER_LENGTH - 1)];
+    pel                 buf_cr[((MAX_CU_SIZE >> 1) + MAX_ALF_FILTER_LENGTH - 1) * ((MAX_CU_SIZE >> 1) + MAX_ALF_FILTER_LENGTH - 1)];
+    ALF_CLASSIFIER    * classifier[MAX_CU_SIZE];
+    ALF_CLASSIFIER      classes[MAX_CU_SIZE * MAX_CU_SIZE];
+} ALF_MT_LANE;
+
+static int alf_mt_lanes(XEVE_CTX * ctx, int job_cnt)
+{
+    return XEVE_MAX(1, XEVE_MIN(ctx->param.threads, job_cnt));
+}
+
+static int alf_mt_lane(void * arg, int task_idx, int worker_id)
+{
+    ALF_MT_STAGE * stage = (ALF_MT_STAGE *)arg;
+
+    for (int job = task_idx; job < stage->job_cnt; job += stage->lanes)
+    {
+        stage->run(stage, job, task_idx);
+    }
+    return XEVE_OK;
+}
+
+static void alf_mt_run(ALF_MT_STAGE * stage)
+{
+    XEVE_CTX * ctx = stage->enc_alf->ctx;
+    int        ret;
+
+    stage->lanes = alf_mt_lanes(ctx, stage->job_cnt);
+    if (stage->lanes == 1)
+    {
+        alf_mt_lane(stage, 0, 0);
+        return;
+    }
+    /* jobs of a stage are independent, the lanes do not wait on each other */
+    for (int i = 0; i < stage->lanes; i++)
+    {
+        task_init(&ctx->task[i], alf_mt_lane, (void*)stage, i);
+        ret = task_submit(ctx->sched, &ctx->task[i]);
+        xeve_assert(ret == THREAD_SUCCESS);
+    }
+    ret = task_wait_all(ctx->sched);
+    xeve_assert(ret == XEVE_OK);
+}
+
 void alf_init(ADAPTIVE_LOOP_FILTER * alf, int bit_depth)
 {
     alf->clip_ranges.comp[0] = (CLIP_RANGE) { .min = 0, .max = (1 << bit_depth) - 1, .bd = bit_depth, .n = 0 };
@@ -48,9 +123,9 @@ void alf_init(ADAPTIVE_LOOP_FILTER * alf, int bit_depth)
         alf->ctu_enable_flag[compIdx] = NULL;
     }
 
-    alf->derive_classification_blk = alf_derive_classification_blk;
-    alf->filter_5x5_blk = alf_filter_blk_5;
-    alf->filter_7x7_blk = alf_filter_blk_7;
+    alf->derive_classification_blk = xevem_func_alf_classify;
+    alf->filter_5x5_blk = xevem_func_alf_filter_5;
+    alf->filter_7x7_blk = xevem_func_alf_filter_7;
 }
 
 void alf_init_filter_shape(ALF_FILTER_SHAPE* filter_shape, int size)
@@ -142,19 +217,21 @@ void alf_copy_and_extend_tile(pel* tmp_yuv, const int s, const pel* rec, const i
  */
 void alf_copy_and_extend( pel* tmp_yuv, const int s, const pel* rec, const int s2, const int w, const int h, const int m )
 {
+    alf_copy_and_extend_rows(tmp_yuv, s, rec, s2, w, h, 0, h, m);
+} // <-- end of copy and extend
 
-//copy
-    for (int j = 0; j < h; j++)
-    {
-        xeve_mcpy(tmp_yuv + j * s, rec + j * s2, sizeof(pel) * w);
-    }
-
-//extend
+/*
+ * same as alf_copy_and_extend() for lines y to y + h_rows - 1 of the picture,
+ * top and bottom margins are extended with the first and the last lines
+ */
+void alf_copy_and_extend_rows(pel* tmp_yuv, const int s, const pel* rec, const int s2, const int w, const int h, const int y, const int h_rows, const int m)
+{
+    pel * p = tmp_yuv + y * s;
 
-    pel * p = tmp_yuv;
-// do left and right margins
-    for (int y = 0; y < h; y++)
+    //copy and extend left and right margins
+    for (int j = 0; j < h_rows; j++)
     {
+        xeve_mcpy(p, rec + (y + j) * s2, sizeof(pel) * w);
         for (int x = 0; x < m; x++)
         {
             *(p - m + x) = p[0];
@@ -163,23 +240,26 @@ void alf_copy_and_extend( pel* tmp_yuv, const int s, const pel* rec, const int s
         p += s;
     }
 
-// p is now the (0,height) (bottom left of image within bigger picture
-    p -= (s + m);
-// p is now the (-margin, height-1)
-    for (int y = 0; y < m; y++)
+    if (y + h_rows == h)
     {
-        xeve_mcpy(p + (y + 1) * s, p, sizeof(pel) * (w + (m << 1)));
+        // p is now the (-margin, height-1)
+        p = tmp_yuv + (h - 1) * s - m;
+        for (int j = 0; j < m; j++)
+        {
+            xeve_mcpy(p + (j + 1) * s, p, sizeof(pel) * (w + (m << 1)));
+        }
     }
 
-// pi is still (-marginX, height-1)
-    p -= ((h - 1) * s);
-// pi is now (-marginX, 0)
-    for (int y = 0; y < 3; y++)
+    if (y == 0)
     {
-        xeve_mcpy(p - (y + 1) * s, p, sizeof(pel) * (w + (m << 1)));
+        // p is now (-marginX, 0)
+        p = tmp_yuv - m;
+        for (int j = 0; j < 3; j++)
+        {
+            xeve_mcpy(p - (j + 1) * s, p, sizeof(pel) * (w + (m << 1)));
+        }
     }
-
-} // <-- end of copy and extend
+}
 
 int alf_get_max_golomb_idx( ALF_FILTER_TYPE filter_type )
 {
@@ -418,16 +498,6 @@ int alf_create(ADAPTIVE_LOOP_FILTER * alf, const int pic_width, const int pic_he
     alf->temp_buf1 = (pel*)malloc(((pic_width >> 1) + (7 * alf->num_ctu_in_widht))*((pic_height >> 1) + (7 * alf->num_ctu_in_height)) * sizeof(pel)); // for chroma just left for unification
     alf->temp_buf2 = (pel*)malloc(((pic_width >> 1) + (7 * alf->num_ctu_in_widht))*((pic_height >> 1) + (7 * alf->num_ctu_in_height)) * sizeof(pel));
     }
-    alf->classifier_mt = (ALF_CLASSIFIER**)malloc(MAX_CU_SIZE * XEVE_MAX_THREADS * sizeof(ALF_CLASSIFIER*));
-    if (alf->classifier_mt)
-    {
-        for (int i = 0; i < MAX_CU_SIZE * XEVE_MAX_THREADS; i++)
-        {
-            alf->classifier_mt[i] = (ALF_CLASSIFIER*)malloc(MAX_CU_SIZE * sizeof(ALF_CLASSIFIER));
-            xeve_mset(alf->classifier_mt[i], 0, MAX_CU_SIZE * sizeof(ALF_CLASSIFIER));
-        }
-    }
-
     // Classification
     alf->classifier = (ALF_CLASSIFIER**)malloc(pic_height * sizeof(ALF_CLASSIFIER*));
     xeve_assert_gv(alf->classifier, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
@@ -458,16 +528,6 @@ void alf_destroy(ADAPTIVE_LOOP_FILTER * alf)
         free(alf->classifier);
         alf->classifier = NULL;
     }
-    if (alf->classifier_mt)
-    {
-        for (int i = 0; i < MAX_CU_SIZE * XEVE_MAX_THREADS; i++)
-        {
-            free(alf->classifier_mt[i]);
-            alf->classifier_mt[i] = NULL;
-        }
-        free(alf->classifier_mt);
-        alf->classifier_mt = NULL;
-    }
 }
 
 void alf_derive_classification(ADAPTIVE_LOOP_FILTER * alf, ALF_CLASSIFIER** classifier, const pel * src_luma, const int src_luma_stride, const AREA * blk)
@@ -483,7 +543,7 @@ void alf_derive_classification(ADAPTIVE_LOOP_FILTER * alf, ALF_CLASSIFIER** clas
         {
             int w = XEVE_MIN(j + CLASSIFICATION_BLK_SIZE, width) - j;
             AREA area = { j, i, w, h };
-            alf_derive_classification_blk(classifier, src_luma, src_luma_stride, &area, alf->input_bit_depth[LUMA_CH] + 4, alf->input_bit_depth[LUMA_CH]);
+            alf->derive_classification_blk(classifier, src_luma, src_luma_stride, &area, alf->input_bit_depth[LUMA_CH] + 4, alf->input_bit_depth[LUMA_CH]);
         }
     }
 }
@@ -1395,6 +1455,11 @@ int xeve_alf_create(XEVE_ALF * enc_alf, const int pic_widht, const int pic_heigh
     enc_alf->ctu_enable_flag_temp_luma = (u8 *)malloc(N_C * alf->num_ctu_in_pic * sizeof(u8));
     xeve_mset(enc_alf->ctu_enable_flag_temp_luma, 0, N_C * alf->num_ctu_in_pic * sizeof(u8));
 
+    enc_alf->ctu_dist_unfilter = (double *)xeve_malloc(alf->num_ctu_in_pic * sizeof(double));
+    xeve_assert_gv(enc_alf->ctu_dist_unfilter, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+    enc_alf->ctu_cost_on = (double *)xeve_malloc(alf->num_ctu_in_pic * sizeof(double));
+    xeve_assert_gv(enc_alf->ctu_cost_on, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
     for (int comp_id = 0; comp_id < N_C; comp_id++)
     {
         enc_alf->ctu_enable_flag_temp[comp_id] = (u8*)xeve_malloc(sizeof(u8)*alf->num_ctu_in_pic);
@@ -1478,6 +1543,10 @@ void xeve_alf_destroy(XEVE_ALF * enc_alf)
     xeve_mfree(enc_alf->ctu_enable_flag_temp_luma);
 
     enc_alf->ctu_enable_flag_temp_luma = NULL;
+    xeve_mfree(enc_alf->ctu_dist_unfilter);
+    enc_alf->ctu_dist_unfilter = NULL;
+    xeve_mfree(enc_alf->ctu_cost_on);
+    enc_alf->ctu_cost_on = NULL;
 
     for (int comp_id = 0; comp_id < N_C; comp_id++)
     {
@@ -1549,6 +1618,15 @@ void xeve_alf_destroy(XEVE_ALF * enc_alf)
 }
 
 
+static void alf_derive_classification_row(ALF_MT_STAGE * stage, int job, int lane)
+{
+    ADAPTIVE_LOOP_FILTER * alf = &stage->enc_alf->alf;
+    int y_pos = stage->y_l + job * alf->max_cu_height;
+    AREA blk = { stage->x_l, y_pos, stage->x_r - stage->x_l, XEVE_MIN(alf->max_cu_height, stage->y_r - y_pos) };
+
+    alf_derive_classification(alf, alf->classifier, stage->rec_yuv->yuv[Y_C], stage->rec_yuv->s[Y_C], &blk);
+}
+
 void xeve_alf_process(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, const double *lambdas, ALF_SLICE_PARAM* alf_slice_param)
 {
     XEVE_CTX* ctx = (XEVE_CTX*)(cs->ctx);
@@ -1610,41 +1688,59 @@ void xeve_alf_process(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, const double *l
     int  x_l, x_r, y_l, y_r, w_tile, h_tile;
     int col_bd = 0;
 
-    for (int slice_num = 0; slice_num < ctx->param.num_slice_in_pic; slice_num++)
+    if (enc_alf->ctu_stats_pipe)
     {
-        ctx->sh = &ctx->sh_array[slice_num];
+        // classes and CTB stats were derived along with the CTU analysis
+        xeve_alf_derive_stats_frame(enc_alf);
+    }
+    else
+    {
+        for (int slice_num = 0; slice_num < ctx->param.num_slice_in_pic; slice_num++)
+        {
+            ctx->sh = &ctx->sh_array[slice_num];
 
-        u32 k = 0;
-        int tile_idx = 0;
-        int total_tiles_in_slice = ctx->sh->num_tiles_in_slice;
-        while (total_tiles_in_slice)
+            u32 k = 0;
+            int tile_idx = 0;
+            int total_tiles_in_slice = ctx->sh->num_tiles_in_slice;
+            while (total_tiles_in_slice)
+            {
+                tile_idx = ctx->sh->tile_order[k++];
+                int x_loc = ((ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu);
+                int y_loc = ((ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu);
+                x_l = x_loc << ctx->log2_max_cuwh; //entry point CTB's x location
+                y_l = y_loc << ctx->log2_max_cuwh; //entry point CTB's y location
+                x_r = x_l + ((int)(ctx->tile[tile_idx].w_ctb) << ctx->log2_max_cuwh);
+                y_r = y_l + ((int)(ctx->tile[tile_idx].h_ctb) << ctx->log2_max_cuwh);
+                w_tile = x_r > ((int)ctx->w_scu << MIN_CU_LOG2) ? ((int)ctx->w_scu << MIN_CU_LOG2) - x_l : x_r - x_l;
+                h_tile = y_r > ((int)ctx->h_scu << MIN_CU_LOG2) ? ((int)ctx->h_scu << MIN_CU_LOG2) - y_l : y_r - y_l;
+                pel * rec_temp_y_tile = rec_tmp_y + x_l + y_l * s;
+                pel * rec_y_tile = rec_y + x_l + y_l * rec_stride;
+                alf_copy_and_extend_tile(rec_temp_y_tile, s, rec_y_tile, rec_stride, w_tile, h_tile, m);
+
+                ALF_MT_STAGE stage;
+                xeve_mset(&stage, 0, sizeof(ALF_MT_STAGE));
+                stage.enc_alf = enc_alf;
+                stage.run = alf_derive_classification_row;
+                stage.job_cnt = ctx->tile[tile_idx].h_ctb;
+                stage.rec_yuv = &rec_temp;
+                stage.x_l = x_l;
+                stage.x_r = x_l + w_tile;
+                stage.y_l = y_l;
+                stage.y_r = y_l + h_tile;
+                alf_mt_run(&stage);
+                total_tiles_in_slice--;
+            }
+        }
+        alf_copy_and_extend(rec_tmp_y, s, rec_y, rec_stride, w, h, m);
+        if(ctx->sps.chroma_format_idc)
         {
-            tile_idx = ctx->sh->tile_order[k++];
-            int x_loc = ((ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu);
-            int y_loc = ((ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu);
-            x_l = x_loc << ctx->log2_max_cuwh; //entry point CTB's x location
-            y_l = y_loc << ctx->log2_max_cuwh; //entry point CTB's y location
-            x_r = x_l + ((int)(ctx->tile[tile_idx].w_ctb) << ctx->log2_max_cuwh);
-            y_r = y_l + ((int)(ctx->tile[tile_idx].h_ctb) << ctx->log2_max_cuwh);
-            w_tile = x_r > ((int)ctx->w_scu << MIN_CU_LOG2) ? ((int)ctx->w_scu << MIN_CU_LOG2) - x_l : x_r - x_l;
-            h_tile = y_r > ((int)ctx->h_scu << MIN_CU_LOG2) ? ((int)ctx->h_scu << MIN_CU_LOG2) - y_l : y_r - y_l;
-            pel * rec_temp_y_tile = rec_tmp_y + x_l + y_l * s;
-            pel * rec_y_tile = rec_y + x_l + y_l * rec_stride;
-            alf_copy_and_extend_tile(rec_temp_y_tile, s, rec_y_tile, rec_stride, w_tile, h_tile, m);
-            AREA blk = { x_l, y_l, w_tile, h_tile };
-            alf_derive_classification(alf, alf->classifier, rec_tmp_y, s, &blk);
-            total_tiles_in_slice--;
+            alf_copy_and_extend(rec_tmp_u, s1, rec_u, pir_rec->s_c, (w >> 1), (h >> 1), m);
+            alf_copy_and_extend(ref_tmp_v, s1, rec_v, pir_rec->s_c, (w >> 1), (h >> 1), m);
         }
-    }
-    alf_copy_and_extend(rec_tmp_y, s, rec_y, rec_stride, w, h, m);
-    if(ctx->sps.chroma_format_idc)
-    {
-        alf_copy_and_extend(rec_tmp_u, s1, rec_u, pir_rec->s_c, (w >> 1), (h >> 1), m);
-        alf_copy_and_extend(ref_tmp_v, s1, rec_v, pir_rec->s_c, (w >> 1), (h >> 1), m);
-    }
 
-    // get CTB stats for filtering
-    xeve_alf_derive_stats_filtering(enc_alf, &org_yuv, &rec_temp);
+        // get CTB stats for filtering
+        xeve_alf_derive_stats_filtering(enc_alf, &org_yuv, &rec_temp);
+    }
 
     // derive filter (luma)
     xeve_alf_encode(enc_alf, cs, alf_slice_param, LUMA_CH);
@@ -1761,6 +1857,22 @@ void xeve_alf_process(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, const double *l
     }
 }
 
+static void alf_derive_ctb_dist_row(ALF_MT_STAGE * stage, int y_lcu, int lane)
+{
+    XEVE_ALF * enc_alf = stage->enc_alf;
+    ADAPTIVE_LOOP_FILTER * alf = &enc_alf->alf;
+    int ctu_idx = y_lcu * alf->num_ctu_in_widht;
+
+    for (int x_lcu = 0; x_lcu < alf->num_ctu_in_widht; x_lcu++, ctu_idx++)
+    {
+        ALF_COVARIANCE * cov = enc_alf->alf_cov[stage->comp_id][stage->shape_idx][ctu_idx];
+        double dist_unfilter_ctu = xeve_alf_get_unfiltered_dist(cov, stage->num_classes);
+
+        enc_alf->ctu_dist_unfilter[ctu_idx] = dist_unfilter_ctu;
+        enc_alf->ctu_cost_on[ctu_idx] = dist_unfilter_ctu + xeve_alf_get_filtered_dist(enc_alf, cov, stage->num_classes, enc_alf->alf_slice_param_temp.num_luma_filters - 1, stage->num_coef);
+    }
+}
+
 double xeve_alf_derive_ctb_enable_flags(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, const int input_shape_idx, u8 comp_id, const int num_classes, const int num_coef, double* dist_unfilter, BOOL rec_coef)
 {
 
@@ -1789,11 +1901,21 @@ double xeve_alf_derive_ctb_enable_flags(XEVE_ALF * enc_alf, CODING_STRUCTURE * c
         }
     }
 
+    ALF_MT_STAGE stage;
+    xeve_mset(&stage, 0, sizeof(ALF_MT_STAGE));
+    stage.enc_alf = enc_alf;
+    stage.run = alf_derive_ctb_dist_row;
+    stage.job_cnt = alf->num_ctu_in_height;
+    stage.comp_id = comp_id;
+    stage.shape_idx = input_shape_idx;
+    stage.num_classes = num_classes;
+    stage.num_coef = num_coef;
+    alf_mt_run(&stage);
+
     for (int ctu_idx = 0; ctu_idx < alf->num_ctu_in_pic; ctu_idx++)
     {
-        double dist_unfilter_ctu = xeve_alf_get_unfiltered_dist(enc_alf->alf_cov[comp_id][input_shape_idx][ctu_idx], num_classes);
-        double cost_on = 0;
-        cost_on = dist_unfilter_ctu + xeve_alf_get_filtered_dist(enc_alf, enc_alf->alf_cov[comp_id][input_shape_idx][ctu_idx], num_classes, enc_alf->alf_slice_param_temp.num_luma_filters - 1, num_coef);
+        double dist_unfilter_ctu = enc_alf->ctu_dist_unfilter[ctu_idx];
+        double cost_on = enc_alf->ctu_cost_on[ctu_idx];
         alf->ctu_enable_flag[comp_id][ctu_idx] = 0;
         double costOff = dist_unfilter_ctu;
 
@@ -2059,266 +2181,274 @@ void tile_boundary_check(int* avail_left, int* avail_right, int* avail_top, int*
     }
 }
 
-int xeve_alf_recon(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, ALF_SLICE_PARAM* alf_slice_param, const pel * org_unit_buf, const int org_stride
-                  , pel * rec_ext_buf, const int rec_stride, const u8 comp_id, int tile_idx, int col_bd)
+static void alf_recon_ctu_row(ALF_MT_STAGE * stage, int job, int lane)
 {
-    int ret;
+    XEVE_ALF * enc_alf = stage->enc_alf;
     ADAPTIVE_LOOP_FILTER * alf = &enc_alf->alf;
-    int x_l, x_r, y_l, y_r;
-    pel* buffer_l = NULL;
-    pel* buffer_cb = NULL;
-    pel* buffer_cr = NULL;
-
-    const u8 channel = comp_id == Y_C ? LUMA_CH : CHROMA_CH;
-    u8 is_luma = channel == LUMA_CH ? 1 : 0;
-
-    alf_recon_coef(alf, alf_slice_param, channel, FALSE, is_luma);
-    XEVE_CTX* ctx = (XEVE_CTX*)(cs->ctx);
+    XEVE_CTX* ctx = enc_alf->ctx;
     XEVE_PIC* rec_pic = PIC_MODE(ctx);
-    pel * rec_buf = NULL;
-
-    int x_loc = ((ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu);
-    int y_loc = ((ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu);
-    x_l = x_loc << ctx->log2_max_cuwh; //entry point lcu's x location
-    y_l = y_loc << ctx->log2_max_cuwh; // entry point lcu's y location
-    x_r = x_l + ((int)(ctx->tile[tile_idx].w_ctb) << ctx->log2_max_cuwh);
-    y_r = y_l + ((int)(ctx->tile[tile_idx].h_ctb) << ctx->log2_max_cuwh);
-    x_r = x_r > ((int)ctx->w_scu << MIN_CU_LOG2) ? ((int)ctx->w_scu << MIN_CU_LOG2) : x_r;
-    y_r = y_r > ((int)ctx->h_scu << MIN_CU_LOG2) ? ((int)ctx->h_scu << MIN_CU_LOG2) : y_r;
-
-    switch (comp_id)
-    {
-    case Y_C:
-        rec_buf = rec_pic->y;
-        break;
-    case U_C:
-        rec_buf = rec_pic->u;
-        break;
-    case V_C:
-        rec_buf = rec_pic->v;
-        break;
-    default:
-        assert(0);
-    }
+    ALF_MT_LANE * scratch = (ALF_MT_LANE *)stage->lane_buf + lane;
+    const u8 comp_id = stage->comp_id;
+    u8 is_luma = comp_id == Y_C ? 1 : 0;
+    pel * rec_buf = comp_id == Y_C ? rec_pic->y : (comp_id == U_C ? rec_pic->u : rec_pic->v);
+    pel * rec_ext_buf = stage->rec_yuv->yuv[comp_id];
+    const int rec_stride = stage->rec_yuv->s[comp_id];
+    int x_l = stage->x_l;
+    int x_r = stage->x_r;
+    int y_l = stage->y_l;
+    int y_r = stage->y_r;
 
     const int m = MAX_ALF_FILTER_LENGTH >> 1;
     int l_zero_offset = (MAX_CU_SIZE + m + m) * m + m;
     int l_stride = MAX_CU_SIZE + 2 * m;
-    buffer_l = (pel*)xeve_malloc(sizeof(pel) * (MAX_CU_SIZE + 2 * m) * (MAX_CU_SIZE + 2 * m));
-    xeve_assert_gv(buffer_l, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
-    xeve_mset(buffer_l, 0, sizeof(pel) * (MAX_CU_SIZE + 2 * m) * (MAX_CU_SIZE + 2 * m));
-    pel *tmp_buffer = buffer_l + l_zero_offset;
+    pel *tmp_buffer = scratch->buf_l + l_zero_offset;
     int l_zero_offset_chroma = ((MAX_CU_SIZE >> 1) + m + m) * m + m;
     int l_stride_chroma = (MAX_CU_SIZE >> 1) + m + m;
-    buffer_cb = (pel*)xeve_malloc(sizeof(pel) * ((MAX_CU_SIZE >> 1) + 2 * m) *((MAX_CU_SIZE >> 1) + 2 * m));
-    xeve_assert_gv(buffer_cb, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
-    buffer_cr = (pel*)xeve_malloc(sizeof(pel) * ((MAX_CU_SIZE >> 1) + 2 * m) *((MAX_CU_SIZE >> 1) + 2 * m));
-    xeve_assert_gv(buffer_cr, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
-    xeve_mset(buffer_cb, 0, sizeof(pel) * ((MAX_CU_SIZE >> 1) + 2 * m) *((MAX_CU_SIZE >> 1) + 2 * m));
-    xeve_mset(buffer_cr, 0, sizeof(pel) * ((MAX_CU_SIZE >> 1) + 2 * m) *((MAX_CU_SIZE >> 1) + 2 * m));
-    pel *tmp_buffer_cb = buffer_cb + l_zero_offset_chroma;
-    pel *tmp_buffer_cr = buffer_cr + l_zero_offset_chroma;
+    pel *tmp_buffer_cb = scratch->buf_cb + l_zero_offset_chroma;
+    pel *tmp_buffer_cr = scratch->buf_cr + l_zero_offset_chroma;
 
-    if (alf_slice_param->enable_flag[comp_id])
+    const int chroma_scale_x = is_luma ? 0 : 1;
+    const int chroma_scale_y = is_luma ? 0 : 1; //getComponentScaleY(comp_id, rec_buf.chromaFormat);
+    ALF_FILTER_TYPE filter_type = comp_id == Y_C ? ALF_FILTER_7 : ALF_FILTER_5;
+    short* coeff = comp_id == Y_C ? alf->coef_final : stage->alf_slice_param->chroma_coef;
+    int y_pos = y_l + job * ctx->max_cuwh;
+
+    for (int x_pos = x_l; x_pos < x_r; x_pos += ctx->max_cuwh)
     {
-        const int chroma_scale_x = is_luma ? 0 : 1;
-        const int chroma_scale_y = is_luma ? 0 : 1; //getComponentScaleY(comp_id, rec_buf.chromaFormat);
-        int ctu_idx = (x_loc)+(y_loc)* ctx->w_lcu;
+        int ctu_idx = (x_pos >> ctx->log2_max_cuwh) + (y_pos >> ctx->log2_max_cuwh) * ctx->w_lcu;
 
-        ALF_FILTER_TYPE filter_type = comp_id == Y_C ? ALF_FILTER_7 : ALF_FILTER_5;
-        short* coeff = comp_id == Y_C ? alf->coef_final : alf_slice_param->chroma_coef;
-        for (int y_pos = y_l; y_pos < y_r; y_pos += ctx->max_cuwh)
+        const int width = (x_pos + ctx->max_cuwh > rec_pic->w_l) ? (rec_pic->w_l - x_pos) : ctx->max_cuwh;
+        const int height = (y_pos + ctx->max_cuwh > rec_pic->h_l) ? (rec_pic->h_l - y_pos) : ctx->max_cuwh;
+
+        int avail_left, avail_right, avail_top, avail_bottom;
+        avail_left = avail_right = avail_top = avail_bottom = 1;
+        if (!(ctx->pps.loop_filter_across_tiles_enabled_flag))
+        {
+            tile_boundary_check(&avail_left, &avail_right, &avail_top, &avail_bottom, width, height, x_pos, y_pos, x_l, x_r, y_l, y_r);
+        }
+        else
+        {
+            tile_boundary_check(&avail_left, &avail_right, &avail_top, &avail_bottom, width, height, x_pos, y_pos,
+                                0, ctx->sps.pic_width_in_luma_samples - 1, 0, ctx->sps.pic_height_in_luma_samples - 1);
+        }
+        if (comp_id == Y_C)
         {
-            for (int x_pos = x_l; x_pos < x_r; x_pos += ctx->max_cuwh)
+            for (int i = m; i < height + m; i++)
             {
-                const int width = (x_pos + ctx->max_cuwh > rec_pic->w_l) ? (rec_pic->w_l - x_pos) : ctx->max_cuwh;
-                const int height = (y_pos + ctx->max_cuwh > rec_pic->h_l) ? (rec_pic->h_l - y_pos) : ctx->max_cuwh;
-
-                int avail_left, avail_right, avail_top, avail_bottom;
-                avail_left = avail_right = avail_top = avail_bottom = 1;
-                if (!(ctx->pps.loop_filter_across_tiles_enabled_flag))
+                int dst_pos = i * l_stride - l_zero_offset;
+                int src_pos_offset = x_pos + y_pos * rec_stride;
+                int stride = (width == ctx->max_cuwh ? l_stride : width + m + m);
+                xeve_mcpy(tmp_buffer + dst_pos + m, rec_ext_buf + src_pos_offset + (i - m) * rec_stride, sizeof(pel) * (stride - 2 * m));
+                for (int j = 0; j < m; j++)
                 {
-                    tile_boundary_check(&avail_left, &avail_right, &avail_top, &avail_bottom, width, height, x_pos, y_pos, x_l, x_r, y_l, y_r);
+                    if (avail_left)
+                        tmp_buffer[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
+                    else
+                        tmp_buffer[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
+                    if (avail_right)
+                        tmp_buffer[dst_pos + j + width + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + width + j];
+                    else
+                        tmp_buffer[dst_pos + j + width + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + width - j - 2];
                 }
+            }
+            for (int i = 0; i < m; i++)
+            {
+                int dst_pos = i * l_stride - l_zero_offset;
+                int src_pos_offset = x_pos + y_pos * rec_stride;
+                int stride = (width == ctx->max_cuwh ? l_stride : width + m + m);
+                if (avail_top)
+                    xeve_mcpy(tmp_buffer + dst_pos, rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m, sizeof(pel) * stride);
                 else
+                    xeve_mcpy(tmp_buffer + dst_pos, tmp_buffer + dst_pos + (2 * m - 2 * i) * l_stride, sizeof(pel) * stride);
+            }
+            for (int i = height + m; i < height + m + m; i++)
+            {
+                int dst_pos = i * l_stride - l_zero_offset;
+                int src_pos_offset = x_pos + y_pos * rec_stride;
+                int stride = (width == ctx->max_cuwh ? l_stride : width + m + m);
+                if (avail_bottom)
+                    xeve_mcpy(tmp_buffer + dst_pos, rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m, sizeof(pel) * stride);
+                else
+                    xeve_mcpy(tmp_buffer + dst_pos, tmp_buffer + dst_pos - (2 * (i - height - m) + 2) * l_stride, sizeof(pel) * stride);
+            }
+        }
+        else if (comp_id == U_C && ctx->sps.chroma_format_idc)
+        {
+            for (int i = m; i < ((height >> 1) + m); i++)
+            {
+                int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
+                int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                xeve_mcpy(tmp_buffer_cb + dst_pos + m, rec_ext_buf + src_pos_offset + (i - m) * rec_stride, sizeof(pel) * (stride - 2 * m));
+                for (int j = 0; j < m; j++)
                 {
-                    tile_boundary_check(&avail_left, &avail_right, &avail_top, &avail_bottom, width, height, x_pos, y_pos,
-                                        0, ctx->sps.pic_width_in_luma_samples - 1, 0, ctx->sps.pic_height_in_luma_samples - 1);
+                    if (avail_left)
+                        tmp_buffer_cb[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
+                    else
+                        tmp_buffer_cb[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
+                    if (avail_right)
+                        tmp_buffer_cb[dst_pos + j + (width >> 1) + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) + j];
+                    else
+                        tmp_buffer_cb[dst_pos + j + (width >> 1) + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) - j - 2];
                 }
-                if (comp_id == Y_C)
+            }
+
+            for (int i = 0; i < m; i++)
+            {
+                int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
+                int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                if (avail_top)
+                    xeve_mcpy(tmp_buffer_cb + dst_pos, rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m, sizeof(pel) * stride);
+                else
+                    xeve_mcpy(tmp_buffer_cb + dst_pos, tmp_buffer_cb + dst_pos + (2 * m - 2 * i) * l_stride_chroma, sizeof(pel) * stride);
+            }
+
+            for (int i = ((height >> 1) + m); i < ((height >> 1) + m + m); i++)
+            {
+                int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
+                int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                if (avail_bottom)
+                    xeve_mcpy(tmp_buffer_cb + dst_pos, rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m, sizeof(pel) * stride);
+                else
+                    xeve_mcpy(tmp_buffer_cb + dst_pos, tmp_buffer_cb + dst_pos - (2 * (i - (height >> 1) - m) + 2) * l_stride_chroma, sizeof(pel) * stride);
+            }
+        }
+        else if(ctx->sps.chroma_format_idc)
+        {
+            for (int i = m; i < ((height >> 1) + m); i++)
+            {
+                int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
+                int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                xeve_mcpy(tmp_buffer_cr + dst_pos + m, rec_ext_buf + src_pos_offset + (i - m) * rec_stride, sizeof(pel) * (stride - 2 * m));
+                for (int j = 0; j < m; j++)
                 {
-                    for (int i = m; i < height + m; i++)
-                    {
-                        int dst_pos = i * l_stride - l_zero_offset;
-                        int src_pos_offset = x_pos + y_pos * rec_stride;
-                        int stride = (width == ctx->max_cuwh ? l_stride : width + m + m);
-                        xeve_mcpy(tmp_buffer + dst_pos + m, rec_ext_buf + src_pos_offset + (i - m) * rec_stride, sizeof(pel) * (stride - 2 * m));
-                        for (int j = 0; j < m; j++)
-                        {
-                            if (avail_left)
-                                tmp_buffer[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
-                            else
-                                tmp_buffer[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
-                            if (avail_right)
-                                tmp_buffer[dst_pos + j + width + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + width + j];
-                            else
-                                tmp_buffer[dst_pos + j + width + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + width - j - 2];
-                        }
-                    }
-                    for (int i = 0; i < m; i++)
-                    {
-                        int dst_pos = i * l_stride - l_zero_offset;
-                        int src_pos_offset = x_pos + y_pos * rec_stride;
-                        int stride = (width == ctx->max_cuwh ? l_stride : width + m + m);
-                        if (avail_top)
-                            xeve_mcpy(tmp_buffer + dst_pos, rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m, sizeof(pel) * stride);
-                        else
-                            xeve_mcpy(tmp_buffer + dst_pos, tmp_buffer + dst_pos + (2 * m - 2 * i) * l_stride, sizeof(pel) * stride);
-                    }
-                    for (int i = height + m; i < height + m + m; i++)
-                    {
-                        int dst_pos = i * l_stride - l_zero_offset;
-                        int src_pos_offset = x_pos + y_pos * rec_stride;
-                        int stride = (width == ctx->max_cuwh ? l_stride : width + m + m);
-                        if (avail_bottom)
-                            xeve_mcpy(tmp_buffer + dst_pos, rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m, sizeof(pel) * stride);
-                        else
-                            xeve_mcpy(tmp_buffer + dst_pos, tmp_buffer + dst_pos - (2 * (i - height - m) + 2) * l_stride, sizeof(pel) * stride);
-                    }
+                    if (avail_left)
+                        tmp_buffer_cr[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
+                    else
+                        tmp_buffer_cr[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
+                    if (avail_right)
+                        tmp_buffer_cr[dst_pos + j + (width >> 1) + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) + j];
+                    else
+                        tmp_buffer_cr[dst_pos + j + (width >> 1) + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) - j - 2];
                 }
-                else if (comp_id == U_C && ctx->sps.chroma_format_idc)
-                {
-                    for (int i = m; i < ((height >> 1) + m); i++)
-                    {
-                        int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        xeve_mcpy(tmp_buffer_cb + dst_pos + m, rec_ext_buf + src_pos_offset + (i - m) * rec_stride, sizeof(pel) * (stride - 2 * m));
-                        for (int j = 0; j < m; j++)
-                        {
-                            if (avail_left)
-                                tmp_buffer_cb[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
-                            else
-                                tmp_buffer_cb[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
-                            if (avail_right)
-                                tmp_buffer_cb[dst_pos + j + (width >> 1) + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) + j];
-                            else
-                                tmp_buffer_cb[dst_pos + j + (width >> 1) + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) - j - 2];
-                        }
-                    }
+            }
 
-                    for (int i = 0; i < m; i++)
-                    {
-                        int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        if (avail_top)
-                            xeve_mcpy(tmp_buffer_cb + dst_pos, rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m, sizeof(pel) * stride);
-                        else
-                            xeve_mcpy(tmp_buffer_cb + dst_pos, tmp_buffer_cb + dst_pos + (2 * m - 2 * i) * l_stride_chroma, sizeof(pel) * stride);
-                    }
+            for (int i = 0; i < m; i++)
+            {
+                int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
+                int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                if (avail_top)
+                    xeve_mcpy(tmp_buffer_cr + dst_pos, rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m, sizeof(pel) * stride);
+                else
+                    xeve_mcpy(tmp_buffer_cr + dst_pos, tmp_buffer_cr + dst_pos + (2 * m - 2 * i) * l_stride_chroma, sizeof(pel) * stride);
+            }
 
-                    for (int i = ((height >> 1) + m); i < ((height >> 1) + m + m); i++)
-                    {
-                        int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        if (avail_bottom)
-                            xeve_mcpy(tmp_buffer_cb + dst_pos, rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m, sizeof(pel) * stride);
-                        else
-                            xeve_mcpy(tmp_buffer_cb + dst_pos, tmp_buffer_cb + dst_pos - (2 * (i - (height >> 1) - m) + 2) * l_stride_chroma, sizeof(pel) * stride);
-                    }
-                }
-                else if(ctx->sps.chroma_format_idc)
-                {
-                    for (int i = m; i < ((height >> 1) + m); i++)
-                    {
-                        int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        xeve_mcpy(tmp_buffer_cr + dst_pos + m, rec_ext_buf + src_pos_offset + (i - m) * rec_stride, sizeof(pel) * (stride - 2 * m));
-                        for (int j = 0; j < m; j++)
-                        {
-                            if (avail_left)
-                                tmp_buffer_cr[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride - m + j];
-                            else
-                                tmp_buffer_cr[dst_pos + j] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + m - j];
-                            if (avail_right)
-                                tmp_buffer_cr[dst_pos + j + (width >> 1) + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) + j];
-                            else
-                                tmp_buffer_cr[dst_pos + j + (width >> 1) + m] = rec_ext_buf[src_pos_offset + (i - m) * rec_stride + (width >> 1) - j - 2];
-                        }
-                    }
+            for (int i = ((height >> 1) + m); i < ((height >> 1) + m + m); i++)
+            {
+                int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
+                int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
+                int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
+                if (avail_bottom)
+                    xeve_mcpy(tmp_buffer_cr + dst_pos, rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m, sizeof(pel) * stride);
+                else
+                    xeve_mcpy(tmp_buffer_cr + dst_pos, tmp_buffer_cr + dst_pos - (2 * (i - (height >> 1) - m) + 2) * l_stride_chroma, sizeof(pel) * stride);
+            }
+        }
+        AREA blk = { 0, 0, width >> chroma_scale_x, height >> chroma_scale_y };
 
-                    for (int i = 0; i < m; i++)
-                    {
-                        int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        if (avail_top)
-                            xeve_mcpy(tmp_buffer_cr + dst_pos, rec_ext_buf + src_pos_offset - (m - i) * rec_stride - m, sizeof(pel) * stride);
-                        else
-                            xeve_mcpy(tmp_buffer_cr + dst_pos, tmp_buffer_cr + dst_pos + (2 * m - 2 * i) * l_stride_chroma, sizeof(pel) * stride);
-                    }
+        if (alf->ctu_enable_flag[comp_id][ctu_idx])
+        {
+            int stride = is_luma ? rec_pic->s_l : rec_pic->s_c;
 
-                    for (int i = ((height >> 1) + m); i < ((height >> 1) + m + m); i++)
-                    {
-                        int dst_pos = i * l_stride_chroma - l_zero_offset_chroma;
-                        int src_pos_offset = (x_pos >> 1) + (y_pos >> 1) * rec_stride;
-                        int stride = (width == ctx->max_cuwh ? l_stride_chroma : (width >> 1) + m + m);
-                        if (avail_bottom)
-                            xeve_mcpy(tmp_buffer_cr + dst_pos, rec_ext_buf + src_pos_offset + (i - m) * rec_stride - m, sizeof(pel) * stride);
-                        else
-                            xeve_mcpy(tmp_buffer_cr + dst_pos, tmp_buffer_cr + dst_pos - (2 * (i - (height >> 1) - m) + 2) * l_stride_chroma, sizeof(pel) * stride);
-                    }
+            if (filter_type == ALF_FILTER_5)
+            {
+                if (comp_id == U_C)
+                {
+                    enc_alf->alf.filter_5x5_blk(scratch->classifier, rec_buf + (x_pos >> 1) + (y_pos >> 1) * rec_pic->s_c, rec_pic->s_c, tmp_buffer_cb, l_stride_chroma, &blk, comp_id, coeff, &(alf->clip_ranges.comp[(int)comp_id]));
                 }
-                AREA blk = { 0, 0, width >> chroma_scale_x, height >> chroma_scale_y };
-
-                if (alf->ctu_enable_flag[comp_id][ctu_idx])
+                else
                 {
-                    int stride = is_luma ? rec_pic->s_l : rec_pic->s_c;
-
-                    if (filter_type == ALF_FILTER_5)
-                    {
-                        if (comp_id == U_C)
-                        {
-                            enc_alf->alf.filter_5x5_blk(alf->classifier, rec_buf + (x_pos >> 1) + (y_pos >> 1) * rec_pic->s_c, rec_pic->s_c, tmp_buffer_cb, l_stride_chroma, &blk, comp_id, coeff, &(alf->clip_ranges.comp[(int)comp_id]));
-                        }
-                        else
-                        {
-                            enc_alf->alf.filter_5x5_blk(alf->classifier, rec_buf + (x_pos >> 1) + (y_pos >> 1) * rec_pic->s_c, rec_pic->s_c, tmp_buffer_cr, l_stride_chroma, &blk, comp_id, coeff, &(alf->clip_ranges.comp[(int)comp_id]));
-                        }
-                    }
-                    else if (filter_type == ALF_FILTER_7)
-                    {
-                        alf_derive_classification(alf, alf->classifier, tmp_buffer, l_stride, &blk);
-                        enc_alf->alf.filter_7x7_blk(alf->classifier, rec_buf + x_pos + y_pos * (rec_pic->s_l), rec_pic->s_l, tmp_buffer, l_stride, &blk, comp_id, coeff, &(alf->clip_ranges.comp[(int)comp_id]));
-                    }
-                    else
-                    {
-                        CHECK(0, "Wrong ALF filter type");
-                    }
+                    enc_alf->alf.filter_5x5_blk(scratch->classifier, rec_buf + (x_pos >> 1) + (y_pos >> 1) * rec_pic->s_c, rec_pic->s_c, tmp_buffer_cr, l_stride_chroma, &blk, comp_id, coeff, &(alf->clip_ranges.comp[(int)comp_id]));
                 }
+            }
+            else if (filter_type == ALF_FILTER_7)
+            {
+                alf_derive_classification(alf, scratch->classifier, tmp_buffer, l_stride, &blk);
+                enc_alf->alf.filter_7x7_blk(scratch->classifier, rec_buf + x_pos + y_pos * (rec_pic->s_l), rec_pic->s_l, tmp_buffer, l_stride, &blk, comp_id, coeff, &(alf->clip_ranges.comp[(int)comp_id]));
+            }
+            else
+            {
+                CHECK(0, "Wrong ALF filter type");
+            }
+        }
+    }
+}
 
-                x_loc++;
+int xeve_alf_recon(XEVE_ALF * enc_alf, CODING_STRUCTURE * cs, ALF_SLICE_PARAM* alf_slice_param, const pel * org_unit_buf, const int org_stride
+                  , pel * rec_ext_buf, const int rec_stride, const u8 comp_id, int tile_idx, int col_bd)
+{
+    int ret;
+    ADAPTIVE_LOOP_FILTER * alf = &enc_alf->alf;
+    int x_l, x_r, y_l, y_r;
+    ALF_MT_LANE * lane_buf = NULL;
 
-                if (x_loc >= ctx->tile[tile_idx].w_ctb + col_bd)
-                {
-                    x_loc = ((ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu);
-                    y_loc++;
-                }
-                ctu_idx = x_loc + y_loc * ctx->w_lcu;
+    const u8 channel = comp_id == Y_C ? LUMA_CH : CHROMA_CH;
+    u8 is_luma = channel == LUMA_CH ? 1 : 0;
+
+    alf_recon_coef(alf, alf_slice_param, channel, FALSE, is_luma);
+    XEVE_CTX* ctx = (XEVE_CTX*)(cs->ctx);
+
+    int x_loc = ((ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu);
+    int y_loc = ((ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu);
+    x_l = x_loc << ctx->log2_max_cuwh; //entry point lcu's x location
+    y_l = y_loc << ctx->log2_max_cuwh; // entry point lcu's y location
+    x_r = x_l + ((int)(ctx->tile[tile_idx].w_ctb) << ctx->log2_max_cuwh);
+    y_r = y_l + ((int)(ctx->tile[tile_idx].h_ctb) << ctx->log2_max_cuwh);
+    x_r = x_r > ((int)ctx->w_scu << MIN_CU_LOG2) ? ((int)ctx->w_scu << MIN_CU_LOG2) : x_r;
+    y_r = y_r > ((int)ctx->h_scu << MIN_CU_LOG2) ? ((int)ctx->h_scu << MIN_CU_LOG2) : y_r;
+
+    if (alf_slice_param->enable_flag[comp_id])
+    {
+        YUV rec_ext;
+        ALF_MT_STAGE stage;
+
+        rec_ext.yuv[comp_id] = rec_ext_buf;
+        rec_ext.s[comp_id] = rec_stride;
+
+        /* LCU rows of the tile are filtered in parallel, the lanes have own CTB buffers and classes */
+        xeve_mset(&stage, 0, sizeof(ALF_MT_STAGE));
+        stage.enc_alf = enc_alf;
+        stage.run = alf_recon_ctu_row;
+        stage.job_cnt = ctx->tile[tile_idx].h_ctb;
+        stage.rec_yuv = &rec_ext;
+        stage.alf_slice_param = alf_slice_param;
+        stage.comp_id = comp_id;
+        stage.x_l = x_l;
+        stage.x_r = x_r;
+        stage.y_l = y_l;
+        stage.y_r = y_r;
+
+        int lanes = alf_mt_lanes(ctx, stage.job_cnt);
+        lane_buf = (ALF_MT_LANE *)xeve_malloc(sizeof(ALF_MT_LANE) * lanes);
+        xeve_assert_gv(lane_buf, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+        xeve_mset(lane_buf, 0, sizeof(ALF_MT_LANE) * lanes);
+        for (int i = 0; i < lanes; i++)
+        {
+            for (int j = 0; j < MAX_CU_SIZE; j++)
+            {
+                lane_buf[i].classifier[j] = lane_buf[i].classes + j * MAX_CU_SIZE;
             }
         }
+        stage.lane_buf = lane_buf;
+        alf_mt_run(&stage);
     }
-    xeve_mfree(buffer_l);
-    xeve_mfree(buffer_cb);
-    xeve_mfree(buffer_cr);
+    xeve_mfree(lane_buf);
     return 0;
 ERR:
-    xeve_mfree(buffer_l);
-    xeve_mfree(buffer_cb);
-    xeve_mfree(buffer_cr);
     return -1;
 }
 
@@ -3680,116 +3810,197 @@ void xeve_alf_get_frame_stats(XEVE_ALF * enc_alf, u8 comp_id, int input_shape_id
     }
 }
 
-void xeve_alf_get_frame_stat(XEVE_ALF * enc_alf, ALF_COVARIANCE* frame_cov, ALF_COVARIANCE** ctb_cov, u8* ctb_enable_flags, const int num_classes)
+static void alf_get_frame_stat_class(ALF_MT_STAGE * stage, int j, int lane)
 {
-    ADAPTIVE_LOOP_FILTER * alf = &enc_alf->alf;
+    ADAPTIVE_LOOP_FILTER * alf = &stage->enc_alf->alf;
     for (int i = 0; i < alf->num_ctu_in_pic; i++)
     {
-        if (ctb_enable_flags[i])
+        if (stage->ctb_enable_flags[i])
         {
-            for (int j = 0; j < num_classes; j++)
-            {
-                alf_cov_add(&frame_cov[j], &ctb_cov[i][j]);
-            }
+            alf_cov_add(&stage->frame_cov[j], &stage->ctb_cov[i][j]);
         }
     }
 }
 
-void xeve_alf_derive_stats_filtering(XEVE_ALF * enc_alf, YUV * org_yuv, YUV * rec_yuv)
+void xeve_alf_get_frame_stat(XEVE_ALF * enc_alf, ALF_COVARIANCE* frame_cov, ALF_COVARIANCE** ctb_cov, u8* ctb_enable_flags, const int num_classes)
+{
+    ALF_MT_STAGE stage;
+
+    /* classes are summed up in parallel, each one in raster order of the CTBs */
+    xeve_mset(&stage, 0, sizeof(ALF_MT_STAGE));
+    stage.enc_alf = enc_alf;
+    stage.run = alf_get_frame_stat_class;
+    stage.job_cnt = num_classes;
+    stage.frame_cov = frame_cov;
+    stage.ctb_cov = ctb_cov;
+    stage.ctb_enable_flags = ctb_enable_flags;
+    alf_mt_run(&stage);
+}
+
+static void alf_derive_stats_ctu_row(XEVE_ALF * enc_alf, YUV * org_yuv, YUV * rec_yuv, int y_pos)
 {
     ADAPTIVE_LOOP_FILTER * alf = &enc_alf->alf;
-    int ctu_rs_addr = 0;
+    int ctu_rs_addr = (y_pos / alf->max_cu_height) * alf->num_ctu_in_widht;
     const int num_comp = (alf->chroma_format == 1) ? N_C : 1;
-    // init CTU stats buffers
-    for (u8 comp_id = 0; comp_id < num_comp; comp_id++)
+
+    for (int x_pos = 0; x_pos < alf->pic_width; x_pos += alf->max_cu_width)
     {
-        const int num_classes = comp_id == Y_C ? MAX_NUM_ALF_CLASSES : 1;
-        const u8 channel = comp_id == Y_C ? LUMA_CH : CHROMA_CH;
-        const int size = channel == LUMA_CH ? 2 : 1;
+        const int width = (x_pos + alf->max_cu_width > alf->pic_width) ? (alf->pic_width - x_pos) : alf->max_cu_width;
+        const int height = (y_pos + alf->max_cu_height > alf->pic_height) ? (alf->pic_height - y_pos) : alf->max_cu_height;
 
-        for (int shape = 0; shape != size; shape++)
+        for (u8 comp_id = 0; comp_id < num_comp; comp_id++)
         {
-            for (int class_idx = 0; class_idx < num_classes; class_idx++)
+            //for 4:2:0 only
+            int width2 = 0, height2 = 0, x_pos2 = 0, y_pos2 = 0;
+            if (comp_id > 0) {
+                width2 = width >> 1;
+                height2 = height >> 1;
+                x_pos2 = x_pos >> 1;
+                y_pos2 = y_pos >> 1;
+            }
+            else
+            {
+                width2 = width;
+                height2 = height;
+                x_pos2 = x_pos;
+                y_pos2 = y_pos;
+            }
+
+            int  rec_stride = rec_yuv->s[comp_id];
+            pel* rec = rec_yuv->yuv[comp_id];
+
+            int  org_stride = org_yuv->s[comp_id];
+            pel* org = org_yuv->yuv[comp_id];
+
+            u8 ch_type = (comp_id == Y_C) ? LUMA_CH : CHROMA_CH;
+            const int size = (ch_type == LUMA_CH) ? 2 : 1;
+            const int num_classes = comp_id == Y_C ? MAX_NUM_ALF_CLASSES : 1;
+
+            for (int shape = 0; shape != size; shape++)
             {
-                for (int ctu_idx = 0; ctu_idx < alf->num_ctu_in_pic; ctu_idx++)
+                for (int class_idx = 0; class_idx < num_classes; class_idx++)
                 {
-                    alf_cov_reset(&enc_alf->alf_cov[comp_id][shape][ctu_idx][class_idx]);
+                    alf_cov_reset(&enc_alf->alf_cov[comp_id][shape][ctu_rs_addr][class_idx]);
                 }
+                xevem_func_alf_blk_stats((int)ch_type, enc_alf->alf_cov[comp_id][shape][ctu_rs_addr], &alf->filter_shapes[ch_type][shape]
+                            , comp_id ? NULL : alf->classifier, org, org_stride, rec, rec_stride, x_pos2, y_pos2, width2, height2);
             }
         }
+        ctu_rs_addr++;
     }
+}
 
-    // init Frame stats buffers
-    for (u8 comp_id = 0; comp_id < num_comp; comp_id++)
-    {
-        const int num_classes = (comp_id == LUMA_CH) ? MAX_NUM_ALF_CLASSES : 1;
-        const int size = (comp_id == LUMA_CH) ? 2 : 1;
+static void alf_derive_stats_ctu_row_job(ALF_MT_STAGE * stage, int y_lcu, int lane)
+{
+    alf_derive_stats_ctu_row(stage->enc_alf, stage->org_yuv, stage->rec_yuv, y_lcu * stage->enc_alf->alf.max_cu_height);
+}
 
-        for (int shape = 0; shape != size; shape++)
-        {
-            for (int class_idx = 0; class_idx < num_classes; class_idx++)
-            {
-                alf_cov_reset(&enc_alf->alf_cov_frame[comp_id][shape][class_idx]);
-            }
-        }
+static void alf_derive_stats_frame_cov(ALF_MT_STAGE * stage, int job, int lane)
+{
+    XEVE_ALF * enc_alf = stage->enc_alf;
+    u8         comp_id = Y_C;
+    int        shape = job / MAX_NUM_ALF_CLASSES;
+    int        class_idx = job % MAX_NUM_ALF_CLASSES;
+
+    if (job >= 2 * MAX_NUM_ALF_CLASSES)
+    {
+        comp_id = (u8)(job - 2 * MAX_NUM_ALF_CLASSES + 1);
+        shape = 0;
+        class_idx = 0;
     }
 
-    for (int y_pos = 0; y_pos < alf->pic_height; y_pos += alf->max_cu_height)
+    ALF_COVARIANCE * frame_cov = &enc_alf->alf_cov_frame[comp_id][shape][class_idx];
+    alf_cov_reset(frame_cov);
+
+    // sum up CTU stats in raster order
+    for (int ctu_rs_addr = 0; ctu_rs_addr < enc_alf->alf.num_ctu_in_pic; ctu_rs_addr++)
     {
-        for (int x_pos = 0; x_pos < alf->pic_width; x_pos += alf->max_cu_width)
-        {
-            const int width = (x_pos + alf->max_cu_width > alf->pic_width) ? (alf->pic_width - x_pos) : alf->max_cu_width;
-            const int height = (y_pos + alf->max_cu_height > alf->pic_height) ? (alf->pic_height - y_pos) : alf->max_cu_height;
+        alf_cov_add(frame_cov, &enc_alf->alf_cov[comp_id][shape][ctu_rs_addr][class_idx]);
+    }
+}
 
-            for (u8 comp_id = 0; comp_id < num_comp; comp_id++)
-            {
-                //for 4:2:0 only
-                int width2 = 0, height2 = 0, x_pos2 = 0, y_pos2 = 0;
-                if (comp_id > 0) {
-                    width2 = width >> 1;
-                    height2 = height >> 1;
-                    x_pos2 = x_pos >> 1;
-                    y_pos2 = y_pos >> 1;
-                }
-                else
-                {
-                    width2 = width;
-                    height2 = height;
-                    x_pos2 = x_pos;
-                    y_pos2 = y_pos;
-                }
+void xeve_alf_derive_stats_frame(XEVE_ALF * enc_alf)
+{
+    ADAPTIVE_LOOP_FILTER * alf = &enc_alf->alf;
+    const int num_comp = (alf->chroma_format == 1) ? N_C : 1;
+    ALF_MT_STAGE stage;
+
+    /* one job per frame covariance: both luma shapes of every class, then the chroma components */
+    xeve_mset(&stage, 0, sizeof(ALF_MT_STAGE));
+    stage.enc_alf = enc_alf;
+    stage.run = alf_derive_stats_frame_cov;
+    stage.job_cnt = 2 * MAX_NUM_ALF_CLASSES + num_comp - 1;
+    alf_mt_run(&stage);
+}
 
-                int  rec_stride = rec_yuv->s[comp_id];
-                pel* rec = rec_yuv->yuv[comp_id];
+void xeve_alf_derive_stats_filtering(XEVE_ALF * enc_alf, YUV * org_yuv, YUV * rec_yuv)
+{
+    ALF_MT_STAGE stage;
+
+    /* CTB stats of the LCU rows are independent */
+    xeve_mset(&stage, 0, sizeof(ALF_MT_STAGE));
+    stage.enc_alf = enc_alf;
+    stage.run = alf_derive_stats_ctu_row_job;
+    stage.job_cnt = enc_alf->alf.num_ctu_in_height;
+    stage.org_yuv = org_yuv;
+    stage.rec_yuv = rec_yuv;
+    alf_mt_run(&stage);
+
+    xeve_alf_derive_stats_frame(enc_alf);
+}
 
-                int  org_stride = org_yuv->s[comp_id];
-                pel* org = org_yuv->yuv[comp_id];
+static void alf_derive_stats_row(XEVE_ALF * enc_alf, YUV * org_yuv, YUV * rec_yuv, int y_pos)
+{
+    ADAPTIVE_LOOP_FILTER * alf = &enc_alf->alf;
+    AREA blk = { 0, y_pos, alf->pic_width, XEVE_MIN(alf->max_cu_height, alf->pic_height - y_pos) };
 
-                u8 ch_type = (comp_id == Y_C) ? LUMA_CH : CHROMA_CH;
-                const int size = (ch_type == LUMA_CH) ? 2 : 1;
+    alf_derive_classification(alf, alf->classifier, rec_yuv->yuv[Y_C], rec_yuv->s[Y_C], &blk);
+    alf_derive_stats_ctu_row(enc_alf, org_yuv, rec_yuv, y_pos);
+}
 
-                for (int shape = 0; shape != size; shape++)
-                {
-                    xeve_alf_get_blk_stats((int)ch_type, enc_alf->alf_cov[comp_id][shape][ctu_rs_addr], &alf->filter_shapes[ch_type][shape]
-                              , comp_id ? NULL : alf->classifier, org, org_stride, rec, rec_stride, x_pos2, y_pos2, width2, height2);
+void xeve_alf_derive_stats_row(XEVE_ALF * enc_alf, XEVE_CTX * ctx, int y_lcu)
+{
+    ADAPTIVE_LOOP_FILTER * alf = &enc_alf->alf;
+    XEVE_PIC * pic_org = PIC_ORIG(ctx);
+    XEVE_PIC * pic_rec = PIC_MODE(ctx);
+    const int  h = pic_rec->h_l;
+    const int  w = pic_rec->w_l;
+    const int  m = MAX_ALF_FILTER_LENGTH >> 1;
+    const int  s = w + m + m;
+    const int  s1 = (w >> 1) + m + m;
+    const int  y = y_lcu * alf->max_cu_height;
+    const int  h_row = XEVE_MIN(alf->max_cu_height, h - y);
+    YUV        org_yuv, rec_temp;
 
-                    const int num_classes = comp_id == Y_C ? MAX_NUM_ALF_CLASSES : 1;
+    org_yuv.yuv[0] = pic_org->y;  org_yuv.s[0] = pic_org->s_l;
+    org_yuv.yuv[1] = pic_org->u;  org_yuv.s[1] = pic_org->s_c;
+    org_yuv.yuv[2] = pic_org->v;  org_yuv.s[2] = pic_org->s_c;
+    rec_temp.yuv[0] = alf->temp_buf + s * m + m;    rec_temp.s[0] = s;
+    rec_temp.yuv[1] = alf->temp_buf1 + s1 * m + m;  rec_temp.s[1] = s1;
+    rec_temp.yuv[2] = alf->temp_buf2 + s1 * m + m;  rec_temp.s[2] = s1;
 
-                    for (int class_idx = 0; class_idx < num_classes; class_idx++)
-                    {
-                        alf_cov_add(&enc_alf->alf_cov_frame[comp_id][shape][class_idx], &enc_alf->alf_cov[comp_id][shape][ctu_rs_addr][class_idx]);
-                    }
-                }
-            }
-            ctu_rs_addr++;
-        }
+    alf_copy_and_extend_rows(rec_temp.yuv[0], s, pic_rec->y, pic_rec->s_l, w, h, y, h_row, m);
+    if (ctx->sps.chroma_format_idc)
+    {
+        alf_copy_and_extend_rows(rec_temp.yuv[1], s1, pic_rec->u, pic_rec->s_c, (w >> 1), (h >> 1), (y >> 1), (h_row >> 1), m);
+        alf_copy_and_extend_rows(rec_temp.yuv[2], s1, pic_rec->v, pic_rec->s_c, (w >> 1), (h >> 1), (y >> 1), (h_row >> 1), m);
+    }
+
+    /* filter support of an LCU row reaches into the rows above and below */
+    if (y_lcu > 0)
+    {
+        alf_derive_stats_row(enc_alf, &org_yuv, &rec_temp, y - alf->max_cu_height);
+    }
+    if (y + h_row == h)
+    {
+        alf_derive_stats_row(enc_alf, &org_yuv, &rec_temp, y);
     }
 }
 
 void xeve_alf_get_blk_stats(int ch, ALF_COVARIANCE* alf_cov, const ALF_FILTER_SHAPE* shape, ALF_CLASSIFIER** classifier, pel* org0
                           , const int org_stride, pel* rec0, const int rec_stride, const int x, const int y, const int width, const int height)
 {
-    static int E_local[MAX_NUM_ALF_LUMA_COEFF];
+    int E_local[MAX_NUM_ALF_LUMA_COEFF];
     int trans_idx = 0;
     int class_idx = 0;
     pel * rec = rec0 + y * rec_stride + x;
@@ -249,7 +249,6 @@ struct _ADAPTIVE_LOOP_FILTER
     int                 num_ctu_in_height;
     int                 num_ctu_in_pic;
     ALF_CLASSIFIER   ** classifier;
-    ALF_CLASSIFIER   ** classifier_mt;
     int                 chroma_format;
     int                 last_ras_poc;
     BOOL                pending_ras_init;
@@ -269,6 +268,7 @@ void alf_destroy(ADAPTIVE_LOOP_FILTER * alf);
 void alf_init(ADAPTIVE_LOOP_FILTER * alf, int bit_depth);
 void alf_copy_and_extend_tile(pel* tmp_yuv, const int s, const pel* rec_yuv, const int s2, const int w, const int h, const int m);
 void alf_copy_and_extend(pel* tmp_yuv, const int s, const pel* rec_yuv, const int s2, const int w, const int h, const int m);
+void alf_copy_and_extend_rows(pel* tmp_yuv, const int s, const pel* rec_yuv, const int s2, const int w, const int h, const int y, const int h_rows, const int m);
 void alf_init_filter_shape(ALF_FILTER_SHAPE * filter_shape, int size);
 int  alf_get_max_golomb_idx(ALF_FILTER_TYPE filter_type);
 void alf_recon_coef(ADAPTIVE_LOOP_FILTER * alf, ALF_SLICE_PARAM* alf_slice_param, int channel, const BOOL is_rdo, const BOOL is_re_do);
@@ -330,8 +330,20 @@ struct _XEVE_ALF
     int                    k_min_tab[MAX_NUM_ALF_LUMA_COEFF];
     int                    bits_coef_scan[MAX_SCAN_VAL][MAX_EXP_GOLOMB];
     short                  filter_indices[MAX_NUM_ALF_CLASSES][MAX_NUM_ALF_CLASSES];
+    /* classes and CTB stats of the current picture are derived by the CTU analysis lanes */
+    BOOL                   ctu_stats_pipe;
+    /* encoder context whose task scheduler runs the parallel stages */
+    XEVE_CTX             * ctx;
+    /* per-CTB distortions of the CTB enable flag decision */
+    double               * ctu_dist_unfilter;
+    double               * ctu_cost_on;
 };
 
+typedef void (*XEVEM_ALF_CLASSIFY)(ALF_CLASSIFIER ** classifier, const pel * src_luma, const int src_stride, const AREA * blk, const int shift, int bit_depth);
+typedef void (*XEVEM_ALF_FILTER)(ALF_CLASSIFIER ** classifier, pel * rec_dst, const int dst_stride, const pel * rec_src, const int src_stride, const AREA * blk, const u8 comp_id, short * filter_set, const CLIP_RANGE * clip_range);
+typedef void (*XEVEM_ALF_BLK_STATS)(int ch, ALF_COVARIANCE * alf_cov, const ALF_FILTER_SHAPE * shape, ALF_CLASSIFIER ** classifier, pel * org, const int org_stride, pel * rec, const int rec_stride, const int x, const int y, const int width, const int height);
+
+
 int        xevem_alf_aps(XEVE_CTX * ctx, XEVE_PIC * pic, XEVE_SH* sh, XEVE_APS* aps);
 XEVE_ALF * xeve_alf_create_buf(int bit_depth);
 void       xeve_alf_delete_buf(XEVE_ALF * enc_alf);
@@ -375,6 +387,8 @@ void       xeve_alf_merge_classes(ALF_COVARIANCE* cov, ALF_COVARIANCE* cov_merge
 void       xeve_alf_get_frame_stats(XEVE_ALF * enc_alf, u8 channel, int input_shape_idx);
 void       xeve_alf_get_frame_stat(XEVE_ALF * enc_alf, ALF_COVARIANCE* frame_cov, ALF_COVARIANCE** ctb_cov, u8* ctb_enable_flags, const int num_classes);
 void       xeve_alf_derive_stats_filtering(XEVE_ALF * enc_alf, YUV * orgYuv, YUV * rec);
+void       xeve_alf_derive_stats_frame(XEVE_ALF * enc_alf);
+void       xeve_alf_derive_stats_row(XEVE_ALF * enc_alf, XEVE_CTX * ctx, int y_lcu);
 void       xeve_alf_get_blk_stats(int ch, ALF_COVARIANCE* alf_cov, const ALF_FILTER_SHAPE* shape, ALF_CLASSIFIER** classifier, pel* org, const int org_stride, pel* rec, const int rec_stride, const int x, const int y, const int width, const int height);
 void       xeve_alf_clac_covariance(int *ELocal, const pel *rec, const int stride, const int *filter_pattern, const int half_filter_length, const int trans_idx);
 double     xeve_alf_clac_err(ALF_COVARIANCE* cov);
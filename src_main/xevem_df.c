@@ -33,6 +33,7 @@
    POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include "xevem_type.h"
 #include "xevem_df.h"
 
 #define DEFAULT_INTRA_TC_OFFSET             2
@@ -543,6 +544,15 @@ static void deblock_scu_addb_hor_chroma(pel *buf, int stride, u8 bs, u16 alpha,
     }
 }
 
+const XEVEM_DBK_ADDB xevem_tbl_dbk_addb[2][2] =
+{
+    /* horizontal edge: luma, chroma */
+    { deblock_scu_addb_hor_luma, deblock_scu_addb_hor_chroma },
+    /* vertical edge: luma, chroma */
+    { deblock_scu_addb_ver_luma, deblock_scu_addb_ver_chroma }
+};
+
+
 static u32* deblock_set_coded_block(u32* map_scu, int w, int h, int w_scu)
 {
     int i, j;
@@ -643,7 +653,7 @@ static void deblock_addb_cu_hor(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, in
 
             if(xeve_check_luma(tree_cons))
             {
-                deblock_scu_addb_hor_luma(y + t, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8);
+                xevem_func_dbk_addb[0][0](y + t, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8);
             }
             if(xeve_check_chroma(tree_cons) && chroma_format_idc)
             {
@@ -656,7 +666,7 @@ static void deblock_addb_cu_hor(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, in
                 c1 = xevem_addb_clip_tbl[indexA][bs_cur];
                 c0 = (c1 + 1) << XEVE_MAX(0, (bit_depth_chroma - 9));
 
-                deblock_scu_addb_hor_chroma(u + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
+                xevem_func_dbk_addb[0][1](u + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
 
                 int qp_v = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
                 indexA = get_index(qp_chroma_dynamic[1][qp_v], pic->pic_deblock_alpha_offset);
@@ -665,7 +675,7 @@ static void deblock_addb_cu_hor(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, in
                 beta = xevem_addb_beta_tbl[indexB] << bitdepth_scale;
                 c1 = xevem_addb_clip_tbl[indexA][bs_cur];
                 c0 = (c1 + 1) << XEVE_MAX(0, (bit_depth_chroma - 9));
-                deblock_scu_addb_hor_chroma(v + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
+                xevem_func_dbk_addb[0][1](v + t, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
             }
         }
     }
@@ -719,7 +729,7 @@ static void deblock_addb_cu_ver_yuv(XEVE_PIC *pic, int x_pel, int y_pel, int log
                 beta = xevem_addb_beta_tbl[indexB] << bitdepth_scale;
                 c1 = xevem_addb_clip_tbl[indexA][bs_cur] << XEVE_MAX(0, (bit_depth_luma - 9));
 
-                deblock_scu_addb_ver_luma(y, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8);
+                xevem_func_dbk_addb[1][0](y, s_l, bs_cur, alpha, beta, c1, bit_depth_luma - 8);
             }
             if(xeve_check_chroma(tree_cons) && chroma_format_idc)
             {
@@ -734,7 +744,7 @@ static void deblock_addb_cu_ver_yuv(XEVE_PIC *pic, int x_pel, int y_pel, int log
                 c1 = xevem_addb_clip_tbl[indexA][bs_cur];
                 c0 = (c1 + 1) << XEVE_MAX(0, (bit_depth_chroma - 9));
 
-                deblock_scu_addb_ver_chroma(u, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
+                xevem_func_dbk_addb[1][1](u, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
 
                 int qp_v = XEVE_CLIP3(-6 * (bit_depth_chroma - 8), 57, qp + pic->pic_qp_v_offset);
                 indexA = get_index(qp_chroma_dynamic[1][qp_v], pic->pic_deblock_alpha_offset);
@@ -746,7 +756,7 @@ static void deblock_addb_cu_ver_yuv(XEVE_PIC *pic, int x_pel, int y_pel, int log
                 c1 = xevem_addb_clip_tbl[indexA][bs_cur];
                 c0 = (c1 + 1) << XEVE_MAX(0, (bit_depth_chroma - 9));
 
-                deblock_scu_addb_ver_chroma(v, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
+                xevem_func_dbk_addb[1][1](v, s_c, bs_cur, alpha, beta, c0, bit_depth_chroma - 8);
             }
 
             y += (s_l << MIN_CU_LOG2);
@@ -955,11 +965,6 @@ void xevem_deblock_tree(XEVE_CTX * ctx, XEVE_PIC * pic, int x, int y, int cuw, i
 
     core->tree_cons = tree_cons;
 
-    pic->pic_deblock_alpha_offset = ctx->sh->sh_deblock_alpha_offset;
-    pic->pic_deblock_beta_offset = ctx->sh->sh_deblock_beta_offset;
-    pic->pic_qp_u_offset = ctx->sh->qp_u_offset;
-    pic->pic_qp_v_offset = ctx->sh->qp_v_offset;
-
     lcu_num = (x >> ctx->log2_max_cuwh) + (y >> ctx->log2_max_cuwh) * ctx->w_lcu;
     xeve_get_split_mode(&split_mode, cud, cup, cuw, cuh, ctx->max_cuwh, ctx->map_cu_data[lcu_num].split_mode);
     xeve_get_suco_flag(&suco_flag, cud, cup, cuw, cuh, ctx->max_cuwh, ctx->map_cu_data[lcu_num].suco_flag);
@@ -1024,21 +1029,25 @@ void xevem_deblock_tree(XEVE_CTX * ctx, XEVE_PIC * pic, int x, int y, int cuw, i
     core->tree_cons = tree_cons;
 }
 
-int xevem_deblock(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int filter_across_boundary , XEVE_CORE * core)
+int xevem_deblock(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int y_lcu, int filter_across_boundary, XEVE_CORE * core)
 {
     int i, j;
-    int x_l, x_r, y_l, y_r, l_scu, r_scu, t_scu, b_scu;
+    int x_l, x_r, y_l, l_scu, r_scu, t_scu, b_scu;
     u32 k1;
     int scu_in_lcu_wh = 1 << (ctx->log2_max_cuwh - MIN_CU_LOG2);
-    int boundary_filtering = 0;
+
+    if (!filter_across_boundary)
+    {
+        return xeve_deblock(ctx, pic, tile_idx, y_lcu, filter_across_boundary, core);
+    }
+
     x_l = (ctx->tile[tile_idx].ctba_rs_first) % ctx->w_lcu; //entry point lcu's x location
     y_l = (ctx->tile[tile_idx].ctba_rs_first) / ctx->w_lcu; // entry point lcu's y location
     x_r = x_l + ctx->tile[tile_idx].w_ctb;
-    y_r = y_l + ctx->tile[tile_idx].h_ctb;
     l_scu = x_l * scu_in_lcu_wh;
     r_scu = XEVE_CLIP3(0, ctx->w_scu, x_r*scu_in_lcu_wh);
-    t_scu = y_l * scu_in_lcu_wh;
-    b_scu = XEVE_CLIP3(0, ctx->h_scu, y_r*scu_in_lcu_wh);
+    t_scu = y_lcu * scu_in_lcu_wh;
+    b_scu = XEVE_CLIP3(0, ctx->h_scu, (y_lcu + 1)*scu_in_lcu_wh);
 
     for (j = t_scu; j < b_scu; j++)
     {
@@ -1057,13 +1066,18 @@ int xevem_deblock(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int filter_acros
         }
     }
 
-    /* horizontal filtering */
-    for (j = y_l; j < y_r; j++)
+    /* edges across tiles depend on the tile order, so vertical and horizontal edges are filtered in separate passes */
+    for (i = x_l; i < x_r; i++)
     {
-        for (i = x_l; i < x_r; i++)
+        if (core->deblock_is_hor && y_lcu > y_l)
+        {
+            threadsafe_wait(ctx->sync_wait, &ctx->sync_dbk[y_lcu - 1], i - x_l + 1, &core->wait_time);
+        }
+        ctx->fn_deblock_tree(ctx, pic, (i << ctx->log2_max_cuwh), (y_lcu << ctx->log2_max_cuwh), ctx->max_cuwh, ctx->max_cuwh, 0, 0, core->deblock_is_hor
+                           , xeve_get_default_tree_cons(), core, filter_across_boundary);
+        if (core->deblock_is_hor)
         {
-            ctx->fn_deblock_tree(ctx, pic, (i << ctx->log2_max_cuwh), (j << ctx->log2_max_cuwh), ctx->max_cuwh, ctx->max_cuwh, 0, 0, core->deblock_is_hor
-                               , xeve_get_default_tree_cons(), core, filter_across_boundary);
+            threadsafe_signal(ctx->sync_wait, &ctx->sync_dbk[y_lcu], i - x_l + 1);
         }
     }
 
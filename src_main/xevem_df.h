@@ -38,7 +38,13 @@
 
 #include "xevem_type.h"
 
-int  xevem_deblock(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int filter_across_boundary, XEVE_CORE * core);
+/* ADDB filtering of the lines of one SCU edge */
+typedef void (*XEVEM_DBK_ADDB)(pel *buf, int stride, u8 bs, u16 alpha, u8 beta, u8 c, int bit_depth_minus8);
+
+/* [horizontal/vertical edge][luma/chroma] */
+extern const XEVEM_DBK_ADDB xevem_tbl_dbk_addb[2][2];
+
+int  xevem_deblock(XEVE_CTX * ctx, XEVE_PIC * pic, int tile_idx, int y_lcu, int filter_across_boundary, XEVE_CORE * core);
 void xevem_deblock_unit(XEVE_CTX * ctx, XEVE_PIC * pic, int x, int y, int cuw, int cuh, int is_hor_edge, XEVE_CORE * core, int boundary_filtering);
 void xevem_deblock_cu_hor(XEVE_PIC *pic, int x_pel, int y_pel, int cuw, int cuh, u32 *map_scu, s8(*map_refi)[REFP_NUM], s16(*map_mv)[REFP_NUM][MV_D]
                         , int w_scu, int log2_max_cuwh, XEVE_REFP(*refp)[REFP_NUM], int ats_inter_mode, TREE_CONS tree_cons, u8* map_tidx
@@ -33,12 +33,15 @@
    POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include "xevem_type.h"
 #include "xevem_ibc_hash.h"
 #include "xeve_pred.h"
 
+
 XEVE_IBC_HASH * xeve_ibc_hash_create(XEVE_CTX * ctx, int pic_width, int pic_height)
 {
     XEVE_IBC_HASH * ibc_hash = (XEVE_IBC_HASH*)xeve_malloc(sizeof(XEVE_IBC_HASH));
+    xeve_mset(ibc_hash, 0, sizeof(XEVE_IBC_HASH));
     xeve_ibc_hash_init(ctx, ibc_hash, pic_width, pic_height);
 
     return (XEVE_IBC_HASH *)ibc_hash;
@@ -47,6 +50,7 @@ XEVE_IBC_HASH * xeve_ibc_hash_create(XEVE_CTX * ctx, int pic_width, int pic_heig
 int xeve_ibc_hash_init(XEVE_CTX * ctx, XEVE_IBC_HASH * ibc_hash, const int pic_width, const int pic_height)
 {
     int ret;
+    ibc_hash->ctx = ctx;
     ibc_hash->search_range_4small_blk = ctx->param.ibc_hash_search_range_4smallblk;
 
     ibc_hash->max_hash_cand = ctx->param.ibc_hash_search_max_cand;
@@ -64,11 +68,25 @@ int xeve_ibc_hash_init(XEVE_CTX * ctx, XEVE_IBC_HASH * ibc_hash, const int pic_w
         ibc_hash->map_pos_to_hash[n] = ibc_hash->map_pos_to_hash[n - 1] + pic_width;
     }
 
-    ibc_hash->hash_table_size = pic_width * pic_height;//1 << 16;
+    /* open addressing with linear probing. every 4x4 position may have a key
+       of its own on noisy content, so the table gets twice as many slots as
+       there are samples, rounded up to a power of two, which keeps at most
+       half of the slots taken and the probes short. at 16 bytes a slot this
+       is 32 to 64 bytes per luma sample, 256 MB at 3840x2160, on top of the
+       16 bytes per sample of map_pos_to_hash. the table is only allocated
+       when ibc_hash_search_flag is set */
+    ibc_hash->hash_table_size = 1;
+    while (ibc_hash->hash_table_size < 2 * (u32)(pic_width * pic_height))
+    {
+        ibc_hash->hash_table_size <<= 1;
+    }
+    ibc_hash->hash_table_mask = ibc_hash->hash_table_size - 1;
     ibc_hash->map_hash_to_pos = (HASH_KEY_NODE *)xeve_malloc(sizeof(HASH_KEY_NODE) * ibc_hash->hash_table_size);
+    xeve_assert_gv(ibc_hash->map_hash_to_pos, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
     xeve_mset(ibc_hash->map_hash_to_pos, 0, sizeof(HASH_KEY_NODE) * ibc_hash->hash_table_size);
-    ibc_hash->map_hash_to_pos_used = (u8 *)xeve_malloc(sizeof(u8) * ibc_hash->hash_table_size);
-    xeve_mset(ibc_hash->map_hash_to_pos_used, 0, sizeof(u8) * ibc_hash->hash_table_size);
+    ibc_hash->used_slot = (u32 *)xeve_malloc(sizeof(u32) * pic_width * pic_height);
+    xeve_assert_gv(ibc_hash->used_slot, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+    ibc_hash->used_cnt = 0;
 
     return XEVE_OK;
 ERR:
@@ -89,24 +107,17 @@ void xeve_ibc_hash_destroy(XEVE_IBC_HASH * ibc_hash)
 
     if (ibc_hash->map_hash_to_pos != NULL)
     {
-        HASH_KEY_NODE * tmp, *cur;
-
-        for (u32 i = 0; i < ibc_hash->hash_table_size; i++)
-        {
-            tmp = ibc_hash->map_hash_to_pos[i].next;
-            while (tmp != NULL)
-            {
-                cur = tmp;
-                tmp = tmp->next;
-                xeve_mfree(cur);
-            }
-        }
         xeve_mfree(ibc_hash->map_hash_to_pos);
     }
 
-    if (ibc_hash->map_hash_to_pos_used != NULL)
+    if (ibc_hash->used_slot != NULL)
     {
-        xeve_mfree(ibc_hash->map_hash_to_pos_used);
+        xeve_mfree(ibc_hash->used_slot);
+    }
+
+    if (ibc_hash->cand_pos != NULL)
+    {
+        xeve_mfree(ibc_hash->cand_pos);
     }
 
     xeve_mfree(ibc_hash);
@@ -114,119 +125,111 @@ void xeve_ibc_hash_destroy(XEVE_IBC_HASH * ibc_hash)
 
 void xeve_ibc_hash_clear(XEVE_IBC_HASH * ibc_hash)
 {
-    xeve_mset(ibc_hash->map_pos_to_hash[0], 0, sizeof(POS_NODE) * ibc_hash->pic_width * ibc_hash->pic_height);
-    if (ibc_hash->map_hash_to_pos != NULL)
+    /* every position is rewritten by the next build, only the taken slots need a reset */
+    for (u32 i = 0; i < ibc_hash->used_cnt; i++)
     {
-        HASH_KEY_NODE * tmp, *cur;
-
-        for (u32 i = 0; i < ibc_hash->hash_table_size; i++)
-        {
-            tmp = ibc_hash->map_hash_to_pos[i].next;
-            while (tmp != NULL)
-            {
-                cur = tmp;
-                tmp = tmp->next;
-                xeve_mfree(cur);
-            }
-        }
+        ibc_hash->map_hash_to_pos[ibc_hash->used_slot[i]].size = 0;
     }
-    xeve_mset(ibc_hash->map_hash_to_pos, 0, sizeof(HASH_KEY_NODE) * ibc_hash->hash_table_size);
-    xeve_mset(ibc_hash->map_hash_to_pos_used, 0, sizeof(u8) * ibc_hash->hash_table_size);
+    ibc_hash->used_cnt = 0;
 }
 
+/* positions are put at the head of the list of their key, the build inserts
+   them in reverse raster order to get raster ordered lists */
 void xeve_ibc_hash_insert(XEVE_IBC_HASH * ibc_hash, u32 key, u16 x, u16 y)
 {
-    HASH_KEY_NODE ** tmp_key_node = NULL;
-    u32 tmp_key = key % ibc_hash->hash_table_size;
-
-    HASH_KEY_NODE * tmp_node = ibc_hash->map_hash_to_pos + tmp_key;
-    tmp_key_node = &tmp_node;
+    u32 slot = key & ibc_hash->hash_table_mask;
+    HASH_KEY_NODE * node = ibc_hash->map_hash_to_pos + slot;
+    POS_NODE * pos = &ibc_hash->map_pos_to_hash[y][x];
 
-    if (ibc_hash->map_hash_to_pos_used[tmp_key])
+    while (node->size && node->key != key)
     {
-        while (*tmp_key_node != NULL && (*tmp_key_node)->key != key)
-        {
-            tmp_key_node = &(*tmp_key_node)->next;
-        }
-
-        if (*tmp_key_node == NULL)
-        {
-            *tmp_key_node = (HASH_KEY_NODE*)xeve_malloc(sizeof(HASH_KEY_NODE));
-            (*tmp_key_node)->key = key;
-            (*tmp_key_node)->next = NULL;
-            (*tmp_key_node)->pos = NULL;
-            (*tmp_key_node)->size = 0;
-        }
+        slot = (slot + 1) & ibc_hash->hash_table_mask;
+        node = ibc_hash->map_hash_to_pos + slot;
     }
-    else
+
+    if (node->size == 0)
     {
-        ibc_hash->map_hash_to_pos_used[tmp_key] = 1;
-        (*tmp_key_node)->key = key;
+        node->key = key;
+        node->pos = NULL;
+        ibc_hash->used_slot[ibc_hash->used_cnt++] = slot;
     }
 
-    (*tmp_key_node)->size++;
+    node->size++;
+    pos->next = node->pos;
+    node->pos = pos;
+}
+
+typedef struct _IBC_HASH_ROWS
+{
+    XEVE_IBC_HASH   * ibc_hash;
+    const XEVE_PIC  * pic;
+    int               lanes;
+} IBC_HASH_ROWS;
 
-    POS_NODE ** tmp_pos_node = &(*tmp_key_node)->pos;
-    if ((*tmp_key_node)->pos == NULL)
+static void ibc_hash_build_row(XEVE_IBC_HASH * ibc_hash, const XEVE_PIC * pic, int y)
+{
+    const int chroma_scaling_x = 1;
+    const int chroma_scaling_y = 1;
+    const int y_stride = pic->s_l;
+    const int c_stride = pic->s_c;
+    const pel * pic_y = pic->y + y * y_stride;
+    const pel * pic_u = pic->u + (y >> chroma_scaling_y) * c_stride;
+    const pel * pic_v = pic->v + (y >> chroma_scaling_y) * c_stride;
+    POS_NODE  * pos = ibc_hash->map_pos_to_hash[y];
+
+    for (int x = 0; x + MIN_CU_SIZE <= pic->w_l; x++)
     {
-        (*tmp_key_node)->pos = &ibc_hash->map_pos_to_hash[y][x];
-        (*tmp_key_node)->pos_end = &ibc_hash->map_pos_to_hash[y][x];
+        int chroma_x = x >> chroma_scaling_x;
+
+        pos[x].key = xevem_func_ibc_hash_key(pic_y + x, y_stride, pic_u + chroma_x, pic_v + chroma_x, c_stride);
+        pos[x].x = x;
+        pos[x].y = y;
     }
-    else
+}
+
+static int ibc_hash_build_rows(void * arg, int task_idx, int worker_id)
+{
+    IBC_HASH_ROWS * rows = (IBC_HASH_ROWS *)arg;
+
+    for (int y = task_idx; y + MIN_CU_SIZE <= rows->pic->h_l; y += rows->lanes)
     {
-        (*tmp_key_node)->pos_end->next = &ibc_hash->map_pos_to_hash[y][x];
-        (*tmp_key_node)->pos_end = (*tmp_key_node)->pos_end->next;
+        ibc_hash_build_row(rows->ibc_hash, rows->pic, y);
     }
+    return XEVE_OK;
 }
 
 void xeve_ibc_hash_build(XEVE_IBC_HASH * ibc_hash, const XEVE_PIC* pic)
 {
-    int y_stride = 0;
-    int c_stride = 0;
-    int width = 0;
-    int height = 0;
-    const int chroma_scaling_x = 1;
-    const int chroma_scaling_y = 1;
-    const int chroma_min_w = MIN_CU_SIZE >> chroma_scaling_x;
-    const int chroma_min_h = MIN_CU_SIZE >> chroma_scaling_y;
-    const pel* pic_y = NULL;
-    const pel* pic_u = NULL;
-    const pel* pic_v = NULL;
-
-    width = pic->w_l;
-    height = pic->h_l;
+    XEVE_CTX * ctx = ibc_hash->ctx;
+    IBC_HASH_ROWS rows;
+    int ret;
 
-    y_stride = pic->s_l;
-    c_stride = pic->s_c;
+    /* block keys of the picture rows are independent, spread them over the workers */
+    rows.ibc_hash = ibc_hash;
+    rows.pic = pic;
+    rows.lanes = XEVE_MAX(1, XEVE_MIN(ctx->param.threads, pic->h_l - MIN_CU_SIZE + 1));
 
-    POSITION pos;
-    for (pos.y = 0; pos.y + MIN_CU_SIZE <= height; pos.y++)
+    if (rows.lanes == 1)
     {
-        // row pointer
-        pic_y = pic->y + pos.y * y_stride;
-
-        int chroma_y = pos.y >> chroma_scaling_y;
-        pic_u = pic->u + chroma_y * c_stride;
-        pic_v = pic->v + chroma_y * c_stride;
+        ibc_hash_build_rows(&rows, 0, 0);
+    }
+    else
+    {
+        for (int i = 0; i < rows.lanes; i++)
+        {
+            task_init(&ctx->task[i], ibc_hash_build_rows, (void*)&rows, i);
+            ret = task_submit(ctx->sched, &ctx->task[i]);
+            xeve_assert(ret == THREAD_SUCCESS);
+        }
+        ret = task_wait_all(ctx->sched);
+        xeve_assert(ret == XEVE_OK);
+    }
 
-        for (pos.x = 0; pos.x + MIN_CU_SIZE <= width; pos.x++)
+    for (int y = pic->h_l - MIN_CU_SIZE; y >= 0; y--)
+    {
+        for (int x = pic->w_l - MIN_CU_SIZE; x >= 0; x--)
         {
-            // 0x1FF is just an initial value
-            unsigned int hash_value = 0x1FF;
-
-            // luma part
-            hash_value = xeve_ibc_hash_calc_block_key(&pic_y[pos.x], y_stride, MIN_CU_SIZE, MIN_CU_SIZE, hash_value);
-
-            // chroma part
-            int chroma_x = pos.x >> chroma_scaling_x;
-            hash_value = xeve_ibc_hash_calc_block_key(&pic_u[chroma_x], c_stride, chroma_min_w, chroma_min_h, hash_value);
-            hash_value = xeve_ibc_hash_calc_block_key(&pic_v[chroma_x], c_stride, chroma_min_w, chroma_min_h, hash_value);
-
-            // hash table
-            ibc_hash->map_pos_to_hash[pos.y][pos.x].key = hash_value;
-            ibc_hash->map_pos_to_hash[pos.y][pos.x].x = pos.x;
-            ibc_hash->map_pos_to_hash[pos.y][pos.x].y = pos.y;
-            xeve_ibc_hash_insert(ibc_hash, hash_value, pos.x, pos.y);
+            xeve_ibc_hash_insert(ibc_hash, ibc_hash->map_pos_to_hash[y][x].key, x, y);
         }
     }
 }
@@ -492,13 +495,27 @@ unsigned int xeve_ibc_hash_calc_block_key(const pel* pel, const int stride, cons
     return crc;
 }
 
+u32 xeve_ibc_hash_block_key(const pel * y, const int s_l, const pel * u, const pel * v, const int s_c)
+{
+    // 0x1FF is just an initial value
+    u32 crc = 0x1FF;
+
+    crc = xeve_ibc_hash_calc_block_key(y, s_l, MIN_CU_SIZE, MIN_CU_SIZE, crc);
+    crc = xeve_ibc_hash_calc_block_key(u, s_c, MIN_CU_SIZE >> 1, MIN_CU_SIZE >> 1, crc);
+    crc = xeve_ibc_hash_calc_block_key(v, s_c, MIN_CU_SIZE >> 1, MIN_CU_SIZE >> 1, crc);
+    return crc;
+}
+
 HASH_KEY_NODE * xeve_ibc_hash_get_key_node(XEVE_IBC_HASH * ibc_hash, u32 key)
 {
-    u32 tmp_key = key % ibc_hash->hash_table_size;
-    HASH_KEY_NODE * tmp_key_node = &ibc_hash->map_hash_to_pos[tmp_key];
-    while (tmp_key_node->key != key)
+    u32 slot = key & ibc_hash->hash_table_mask;
+    HASH_KEY_NODE * tmp_key_node = &ibc_hash->map_hash_to_pos[slot];
+
+    /* a free slot (size 0) ends the probe sequence of an unknown key */
+    while (tmp_key_node->size && tmp_key_node->key != key)
     {
-        tmp_key_node = tmp_key_node->next;
+        slot = (slot + 1) & ibc_hash->hash_table_mask;
+        tmp_key_node = &ibc_hash->map_hash_to_pos[slot];
     }
 
     return tmp_key_node;
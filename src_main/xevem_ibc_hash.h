@@ -52,27 +52,33 @@ typedef struct _POS_NODE
     u16 x, y;
 }POS_NODE;
 
+/* slot of the open-addressed key table, size == 0 marks a free slot */
 typedef struct _HASH_KEY_NODE
 {
     u32 key;
     u32 size;
     POS_NODE * pos;
-    POS_NODE * pos_end;
-    struct _HASH_KEY_NODE * next;
 }HASH_KEY_NODE;
 
+/* key of the 4x4 luma and 2x2 chroma blocks at one position */
+typedef u32 (*XEVEM_IBC_HASH_KEY)(const pel * y, const int s_l, const pel * u, const pel * v, const int s_c);
+
 struct _XEVE_IBC_HASH
 {
+    XEVE_CTX * ctx;
     int     pic_width;
     int     pic_height;
     int     search_range_4small_blk;
     u32     hash_table_size;
+    u32     hash_table_mask;
     u32     max_hash_cand;
     u32     cand_num;
 
     POS_NODE     ** map_pos_to_hash;
     HASH_KEY_NODE * map_hash_to_pos;
-    u8            * map_hash_to_pos_used;
+    /* slots taken since the last clear */
+    u32           * used_slot;
+    u32             used_cnt;
     POS_NODE      * cand_pos;
 };
 
@@ -89,5 +95,6 @@ int               xeve_ibc_hash_hit_ratio(XEVE_CTX* ctx, XEVE_IBC_HASH* p, int c
 HASH_KEY_NODE  *  xeve_ibc_hash_get_key_node(XEVE_IBC_HASH * ibc_hash, u32 key);
 u32               xeve_ibc_hash_calc_block_key(const pel* pel, const int stride, const int width, const int height, unsigned int crc);
 u32               xeve_ibc_hash_crc32_16bit(u32 crc, const pel pel);
+u32               xeve_ibc_hash_block_key(const pel * y, const int s_l, const pel * u, const pel * v, const int s_c);
 
 #endif // __XEVE_IBC_HASH__
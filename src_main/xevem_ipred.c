@@ -36,8 +36,6 @@
 #include "xevem_type.h"
 
 
-const XEVE_INTRA_PRED_ANG (*xeve_func_intra_pred_ang)[2];
-
 void xevem_get_nbr(int x, int y, int cuw, int cuh, pel *src, int s_src, u16 avail_cu, pel nb[N_C][N_REF][MAX_CU_SIZE * 3], int scup, u32 * map_scu
                  , int w_scu, int h_scu, int ch_type, int constrained_intra_pred, u8 * map_tidx, int bit_depth, int chroma_format_idc)
 {
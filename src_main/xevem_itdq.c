@@ -34,9 +34,9 @@
 */
 
 #include <math.h>
+#include "xevem_type.h"
 #include "xevem_itdq.h"
 
-const XEVE_ITX(*xeve_func_itx)[MAX_TR_LOG2];
 
 const XEVE_INV_TRANS xeve_itrans_map_tbl[16][5] =
 {
@@ -44,7 +44,6 @@ const XEVE_INV_TRANS xeve_itrans_map_tbl[16][5] =
     { NULL, xeve_itrans_ats_intra_DST7_B4, xeve_itrans_ats_intra_DST7_B8, xeve_itrans_ats_intra_DST7_B16, xeve_itrans_ats_intra_DST7_B32 },
 };
 
-const XEVE_INV_TRANS (*xeve_func_itrans)[5];
 
 void xeve_itrans_ats_intra(s16 *coef, int log2_cuw, int log2_cuh, u8 ats_mode, int skip_w, int skip_h, int bit_depth);
 void xeve_it_MxN_ats_intra(s16 *coef, int tuw, int tuh, int bit_depth, const int max_log2_tr_dynamic_range, u8 ats_intra_tridx, int skip_w, int skip_h);
@@ -605,8 +604,8 @@ static void xeve_itrans(XEVE_CTX * ctx, s16 *coef, int log2_cuw, int log2_cuh, i
     else
     {
         s32 tb[MAX_TR_DIM]; /* temp buffer */
-        (*ctx->fn_itxb)[log2_cuh - 1](coef, tb, 0, 1 << log2_cuw, 0);
-        (*ctx->fn_itxb)[log2_cuw - 1](tb, coef, (ITX_SHIFT1 + ITX_SHIFT2(bit_depth)), 1 << log2_cuh, 1);
+        (*ctx->func->itxb)[log2_cuh - 1](coef, tb, 0, 1 << log2_cuw, 0);
+        (*ctx->func->itxb)[log2_cuw - 1](tb, coef, (ITX_SHIFT1 + ITX_SHIFT2(bit_depth)), 1 << log2_cuh, 1);
     }
 }
 
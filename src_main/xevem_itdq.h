@@ -38,7 +38,6 @@
 
 #include "xevem_type.h"
 
-extern const XEVE_INV_TRANS (*xeve_func_itrans)[5];
 extern const XEVE_INV_TRANS xeve_itrans_map_tbl[16][5];
 
 void xevem_itdq(XEVE_CTX* ctx, XEVE_CORE* core, s16 coef[N_C][MAX_CU_DIM], int nnz_sub[N_C][MAX_SUB_TB_NUM]);
@@ -58,6 +57,5 @@ void itx_pb16(s16* src, s16* dst, int shift, int line);
 void itx_pb32(s16* src, s16* dst, int shift, int line);
 void itx_pb64(s16* src, s16* dst, int shift, int line);
 
-extern const XEVE_ITX(*xeve_func_itx)[MAX_TR_LOG2];
 extern const XEVE_ITX xeve_tbl_itx[MAX_TR_LOG2];
 #endif /* _XEVEM_ITDQ_H_ */
@@ -37,13 +37,6 @@
 #include <assert.h>
 
 
-const XEVEM_MC (*xevem_func_dmvr_mc_l)[2];
-const XEVEM_MC (*xevem_func_dmvr_mc_c)[2];
-const XEVEM_MC     (*xevem_func_bl_mc_l)[2];
-XEVE_AFFINE_H_SOBEL_FLT xevem_func_aff_h_sobel_flt;
-XEVE_AFFINE_V_SOBEL_FLT xevem_func_aff_v_sobel_flt;
-XEVE_AFFINE_EQUAL_COEF  xevem_func_aff_eq_coef_comp;
-
 const s16 xevem_tbl_mc_l_coeff[16][8] =
 {
     {  0, 0,   0, 64,  0,   0,  0,  0 },
@@ -321,7 +314,7 @@ void xeve_bl_mc_l_0n(pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel
 
 void xeve_bl_mc_l_nn(s16 *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, s16 *pred, int w, int h, int bit_depth)
 {
-    s16         buf[(MAX_CU_SIZE + MC_IBUF_PAD_L)*(MAX_CU_SIZE + MC_IBUF_PAD_L)];
+    s16         buf[(MAX_CU_SIZE + OPT_MC_BI_PAD * 2 + MC_IBUF_PAD_L)*(MAX_CU_SIZE + OPT_MC_BI_PAD * 2 + MC_IBUF_PAD_L)];
     s16        *b;
     int         i, j, dx, dy;
     s32         pt;
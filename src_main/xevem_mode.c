@@ -1456,7 +1456,7 @@ static double mode_coding_tree_main(XEVE_CTX *ctx, XEVE_CORE *core, int x0, int
         check_min_cu = ctx->param.min_cu_inter;
     }
 
-    set_lambda(ctx, core, ctx->sh, ctx->tile[core->tile_idx].qp);
+    set_lambda(ctx, core, ctx->sh, ctx->tile[core->tile_idx].qp + core->dqp_row);
 
     if (ctx->sps.chroma_format_idc != 0 && ctx->sps.sps_btt_flag && log2_cuw == 2 && log2_cuh == 2 &&
         (xeve_check_luma(core->tree_cons) || xeve_check_all(core->tree_cons)) && ctx->sps.tool_admvp)
@@ -1478,7 +1478,7 @@ static double mode_coding_tree_main(XEVE_CTX *ctx, XEVE_CORE *core, int x0, int
     core->bef_data_idx = bef_data_idx;
     if (ctx->pps.cu_qp_delta_enabled_flag)
     {
-        bef_data_idx = (!!(qp - ctx->tile[core->tile_idx].qp) << 2) | bef_data_idx;
+        bef_data_idx = (!!(qp - (ctx->tile[core->tile_idx].qp + core->dqp_row)) << 2) | bef_data_idx;
         core->bef_data_idx = bef_data_idx;
     }
     SBAC_LOAD(core->s_curr_before_split[log2_cuw - 2][log2_cuh - 2], core->s_curr_best[log2_cuw - 2][log2_cuh - 2]);
@@ -2140,10 +2140,6 @@ static int xevem_mode_init_mt(XEVE_CTX *ctx, int thread_idx)
             ret = mctx->fn_pibc_init_tile(ctx, thread_idx);
             xeve_assert_rv(ret == XEVE_OK, ret);
         }
-        if (ctx->param.ibc_hash_search_flag)
-        {
-            xeve_ibc_hash_rebuild(mctx->ibc_hash, PIC_ORIG(ctx));
-        }
     }
 
     return XEVE_OK;
@@ -2301,7 +2297,7 @@ static int mode_analyze_lcu_main(XEVE_CTX *ctx, XEVE_CORE *core)
 
     /* decide mode */
     mode_coding_tree_main(ctx, core, core->x_pel, core->y_pel, 0, ctx->log2_max_cuwh, ctx->log2_max_cuwh, 0, mi, 1
-                        , 0, ctx->tile[core->tile_idx].qp, xeve_get_default_tree_cons() );
+                        , 0, ctx->tile[core->tile_idx].qp + core->dqp_row, xeve_get_default_tree_cons() );
 
 #if TRACE_ENC_CU_DATA_CHECK
     h = w = 1 << (ctx->log2_max_cuwh - MIN_CU_LOG2);
@@ -2508,6 +2504,18 @@ void xeve_split_tbl_init(XEVE_CTX *ctx)
     ctx->split_check[BLOCK_TT][IDX_MIN] = ctx->param.framework_tris_min;
 }
 
+static int mode_analyze_frame_main(XEVE_CTX *ctx)
+{
+    XEVEM_CTX * mctx = (XEVEM_CTX *)ctx;
+
+    /* the hash index covers the whole picture, build it once before the tiles are started */
+    if (ctx->param.ibc_flag && ctx->param.ibc_hash_search_flag)
+    {
+        xeve_ibc_hash_rebuild(mctx->ibc_hash, PIC_ORIG(ctx));
+    }
+    return XEVE_OK;
+}
+
 void xeve_mode_create_main(XEVE_CTX *ctx)
 {
     /* set function addresses */
@@ -2516,6 +2524,7 @@ void xeve_mode_create_main(XEVE_CTX *ctx)
     ctx->fn_mode_copy_to_cu_data = copy_to_cu_data_main;
     ctx->fn_mode_reset_intra = mode_reset_intra_main;
     ctx->fn_mode_post_lcu = mode_post_lcu_main;
+    ctx->fn_mode_analyze_frame = mode_analyze_frame_main;
     ctx->fn_mode_analyze_lcu = mode_analyze_lcu_main;
     ctx->fn_mode_rdo_dbk_map_set = xeve_mode_rdo_dbk_map_set;
     ctx->fn_mode_rdo_bit_cnt_intra_dir = xeve_rdo_bit_cnt_intra_dir_main;
@@ -423,6 +423,31 @@ void select_assign_rpl_for_sh(XEVE_CTX *ctx, XEVE_SH *sh)
     {
         ctx->slice_type = ctx->param.inter_slice_type;
     }
+
+    //For a mini-GOP shorter than the GOP of the SPS candidates (adaptive GOP), signal the predefined RPLs of the mini-GOP size in the SH
+    if (ctx->mgop_size < ctx->param.gop_size)
+    {
+        int mgop_idx = XEVE_LOG2(ctx->mgop_size) - 2;
+        int pocIdx = ctx->param.keyint > 0 ? ctx->poc.poc_val % ctx->param.keyint : ctx->poc.poc_val;
+        pocIdx = (pocIdx % ctx->mgop_size == 0) ? ctx->mgop_size : pocIdx % ctx->mgop_size;
+
+        for (int i = 0; i < ctx->mgop_size; i++)
+        {
+            if (pocIdx == pre_define_rpls[1][mgop_idx][0][i].poc)
+            {
+                sh->rpl_l0 = pre_define_rpls[1][mgop_idx][0][i];
+                sh->rpl_l1 = pre_define_rpls[1][mgop_idx][1][i];
+                break;
+            }
+        }
+        sh->rpl_l0.poc = sh->rpl_l1.poc = ctx->poc.poc_val;
+        sh->rpl_l0.ref_pic_active_num = XEVE_MIN(ctx->param.me_ref_num, sh->rpl_l0.ref_pic_active_num);
+        sh->rpl_l1.ref_pic_active_num = XEVE_MIN(ctx->param.me_ref_num, sh->rpl_l1.ref_pic_active_num);
+        sh->rpl_l0_idx = sh->rpl_l1_idx = -1;
+        sh->ref_pic_list_sps_flag[0] = sh->ref_pic_list_sps_flag[1] = 0;
+        return;
+    }
+
     //Copy RPL0 from the candidate in SPS to this SH
     sh->rpl_l0.poc = ctx->poc.poc_val;
     if (sh->rpl_l0_idx != -1)
@@ -880,21 +880,20 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2
 static u32 me_spel_pattern(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx
                          , s16 gmvp[MV_D], s16 mvi[MV_D], s16 mv[MV_D], int bi, int bit_depth_luma)
 {
-    pel     *org, *ref, *pred;
+    pel     *org, *pred;
+    XEVE_PIC *ref_pic;
     s16     *org_bi;
     u32      cost, cost_best = XEVE_UINT32_MAX;
     s16      mv_x, mv_y, cx, cy;
     int      lidx_r = (lidx == REFP_0) ? REFP_1 : REFP_0;
-    int      i, mv_bits, cuw, cuh, s_org, s_ref, best_mv_bits;
+    int      i, mv_bits, cuw, cuh, s_org, s_pred, best_mv_bits;
 
     s_org = pi->s_o[Y_C];
     org = pi->o[Y_C] + x + y * pi->s_o[Y_C];
-    s_ref = pi->refp[refi][lidx].pic->s_l;
-    ref = pi->refp[refi][lidx].pic->y;
+    ref_pic = pi->refp[refi][lidx].pic;
     cuw = 1 << log2_cuw;
     cuh = 1 << log2_cuh;
     org_bi = pi->org_bi;
-    pred = pi->pred_buf;
     best_mv_bits = 0;
 
     /* make MV to be global coordinate */
@@ -924,17 +923,17 @@ static u32 me_spel_pattern(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2
         cost = MV_COST(pi, mv_bits);
 
         /* get the interpolated(predicted) image */
-        xeve_mc_l((mv_x << 2), (mv_y << 2), ref, (mv_x << 2), (mv_y << 2), s_ref, cuw, pred, cuw, cuh, bit_depth_luma, pi->mc_l_coeff);
+        pred = xeve_pinter_spel_pred(pi, ref_pic, mv_x, mv_y, cuw, cuh, &s_pred, bit_depth_luma);
 
         if(bi)
         {
             /* get sad */
-            cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+            cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, s_pred, bit_depth_luma);
         }
         else
         {
             /* get sad */
-            cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+            cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, s_pred, bit_depth_luma);
         }
 
         /* check if motion cost_best is less than minimum cost_best */
@@ -971,17 +970,17 @@ static u32 me_spel_pattern(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2
             cost = MV_COST(pi, mv_bits);
 
             /* get the interpolated(predicted) image */
-            xeve_mc_l((mv_x << 2), (mv_y << 2), ref, (mv_x << 2), (mv_y << 2), s_ref, cuw, pred, cuw, cuh, bit_depth_luma, pi->mc_l_coeff);
+            pred = xeve_pinter_spel_pred(pi, ref_pic, mv_x, mv_y, cuw, cuh, &s_pred, bit_depth_luma);
 
             if(bi)
             {
                 /* get sad */
-                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, cuw, bit_depth_luma);
+                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, pred, cuw, s_pred, bit_depth_luma);
             }
             else
             {
                 /* get sad */
-                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, cuw, bit_depth_luma);
+                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, pred, s_org, s_pred, bit_depth_luma);
             }
 
             /* check if motion cost_best is less than minimum cost_best */
@@ -1010,6 +1009,9 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
     s16 range[MV_RANGE_DIM][MV_D]; /* search range after clipping */
     s16 mvi[MV_D];
     s16 mvt[MV_D];
+    s16 mvs[MV_D]; /* MV seed from the motion search cache */
+    int seeded = 0;
+    s16 range_s[MV_RANGE_DIM][MV_D];
     u32 cost, cost_best = XEVE_UINT32_MAX;
     s8 ri = 0;  /* reference buffer index */
     int tmpstep = 0;
@@ -1039,7 +1041,15 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
     mvc[MV_Y] = XEVE_CLIP3(pi->min_clip[MV_Y], pi->max_clip[MV_Y], mvc[MV_Y]);
 
     get_range_ipel(pi, mvc, range, (bi != BI_NORMAL) ? 0 : 1, ri, lidx);
-    cost = me_ipel_diamond(pi, x, y, log2_cuw, log2_cuh, ri, lidx, range, gmvp, mvi, mvt, bi, &tmpstep, MAX_FIRST_SEARCH_STEP - pi->me_opt->max_first_search_step_th, bit_depth_luma);
+    /* a search of another CU shape over this area has left its best MV, which
+       is searched around as well. the search from the MV predictor then
+       stops as early as a refinement */
+    if(pi->me_cache && bi == BI_NON && pi->curr_mvr == 0 && xeve_me_cache_get_mv(pi->me_cache, x, y, log2_cuw, log2_cuh, lidx, ri, mvs))
+    {
+        seeded = 1;
+    }
+
+    cost = me_ipel_diamond(pi, x, y, log2_cuw, log2_cuh, ri, lidx, range, gmvp, mvi, mvt, bi, &tmpstep, seeded ? MAX_REFINE_SEARCH_STEP - pi->me_opt->max_refine_search_step_th : MAX_FIRST_SEARCH_STEP - pi->me_opt->max_first_search_step_th, bit_depth_luma);
 
     if(cost < cost_best)
     {
@@ -1056,6 +1066,33 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
         }
     }
 
+    /* search around the seed, unless the search from the MV predictor has
+       already come close to it */
+    if(seeded && (abs(mvs[MV_X] - mv[MV_X]) > (2 << 2) || abs(mvs[MV_Y] - mv[MV_Y]) > (2 << 2)))
+    {
+        mvi[MV_X] = mvs[MV_X] + (x << 2);
+        mvi[MV_Y] = mvs[MV_Y] + (y << 2);
+        mvc[MV_X] = XEVE_CLIP3(pi->min_clip[MV_X], pi->max_clip[MV_X], x + (mvs[MV_X] >> 2));
+        mvc[MV_Y] = XEVE_CLIP3(pi->min_clip[MV_Y], pi->max_clip[MV_Y], y + (mvs[MV_Y] >> 2));
+
+        get_range_ipel(pi, mvc, range_s, 0, ri, lidx);
+        cost = me_ipel_diamond(pi, x, y, log2_cuw, log2_cuh, ri, lidx, range_s, gmvp, mvi, mvt, bi, &tmpstep, MAX_REFINE_SEARCH_STEP - pi->me_opt->max_refine_search_step_th, bit_depth_luma);
+        if(cost < cost_best)
+        {
+            cost_best = cost;
+            mv[MV_X] = mvt[MV_X];
+            mv[MV_Y] = mvt[MV_Y];
+            if(abs(mvp[MV_X] - mv[MV_X]) < 2 && abs(mvp[MV_Y] - mv[MV_Y]) < 2)
+            {
+                beststep = 0;
+            }
+            else
+            {
+                beststep = tmpstep;
+            }
+        }
+    }
+
     int cost_init = XEVE_UINT32_MAX;
     /* Do raster search with best cost found so far */
     cost_init = cost_best;
@@ -1106,6 +1143,11 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
         }
     }
 
+    if(pi->me_cache && bi == BI_NON && pi->curr_mvr == 0)
+    {
+        xeve_me_cache_set_mv(pi->me_cache, x, y, log2_cuw, log2_cuh, lidx, ri, mv);
+    }
+
     if(pi->me_level > ME_LEV_IPEL && (pi->curr_mvr == 0 || pi->curr_mvr == 1))
     {
         /* sub-pel ME */
@@ -2986,6 +3028,14 @@ static double analyze_skip(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log
         }
     }
 
+    pi->early_skip = 0;
+    if(ctx->param.early_skip && cost_best < MAX_COST)
+    {
+        xeve_diff_pred(x, y, log2_cuw, log2_cuh, pi->pic_o, pi->pred[PRED_SKIP][0], pi->resi
+                     , ctx->sps.bit_depth_luma_minus8 + 8, ctx->sps.bit_depth_chroma_minus8 + 8, ctx->sps.chroma_format_idc);
+        pi->early_skip = ctx->fn_tq_zero(ctx, core, pi->resi, log2_cuw, log2_cuh, pi->slice_type);
+    }
+
     mcore->dmvr_flag = best_dmvr;
     return cost_best;
 }
@@ -4588,7 +4638,8 @@ static double pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, in
         xeve_mcpy(pi->nnz_sub_best[PRED_SKIP], core->nnz_sub, sizeof(int) * N_C * MAX_SUB_TB_NUM);
     }
 
-    cost = cost_inter[PRED_DIR] = analyze_merge(ctx, core, x, y, log2_cuw, log2_cuh);
+    /* keep a SKIP whose residual quantises to zero without trying the other modes */
+    cost = cost_inter[PRED_DIR] = pi->early_skip ? MAX_COST : analyze_merge(ctx, core, x, y, log2_cuw, log2_cuh);
     if(cost < cost_best)
     {
         core->cu_mode = MODE_DIR;
@@ -4609,7 +4660,7 @@ static double pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, in
         DQP_STORE(core->dqp_next_best[log2_cuw - 2][log2_cuh - 2], core->dqp_temp_best_merge);
     }
 
-    if(ctx->sps.tool_mmvd && ((pi->slice_type == SLICE_B) || (pi->slice_type == SLICE_P)))
+    if(ctx->sps.tool_mmvd && ((pi->slice_type == SLICE_B) || (pi->slice_type == SLICE_P)) && !pi->early_skip)
     {
         /* MMVD mode for merge */
         cost = cost_inter[PRED_DIR_MMVD] = analyze_merge_mmvd(ctx, core, x, y, log2_cuw, log2_cuh, real_mv);
@@ -4867,7 +4918,7 @@ static double pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, in
         }
     }
 
-    if(ctx->slice_depth < 4)
+    if(ctx->slice_depth < 4 && !pi->early_skip)
     {
         if(allow_affine && cuw >= 8 && cuh >= 8)
         {
@@ -5542,6 +5593,11 @@ int xevem_pinter_create(XEVE_CTX *ctx, int complexity)
             pi->mc_l_coeff = xevem_tbl_mc_l_coeff;
             pi->mc_c_coeff = xevem_tbl_mc_c_coeff;
         }
+        if(ctx->param.me_cache && pi->me_cache == NULL)
+        {
+            pi->me_cache = xeve_me_cache_create();
+            xeve_assert_rv(pi->me_cache != NULL, XEVE_ERR_OUT_OF_MEMORY);
+        }
     }
 
     return ctx->fn_pinter_set_complexity(ctx, complexity);
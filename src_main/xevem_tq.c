@@ -38,7 +38,6 @@
 
 #define QUANT(c, scale, offset, shift) ((s16)((((c)*(scale)) + (offset)) >> (shift)))
 
-const XEVE_TX(*xeve_func_tx)[MAX_TR_LOG2];
 
 void xeve_trans_DST7_B4(s16* block, s16* coeff, s32 shift, s32 line, int skip_line, int skip_line_2);
 void xeve_trans_DST7_B8(s16* block, s16* coeff, s32 shift, s32 line, int skip_line, int skip_line_2);
@@ -1060,9 +1059,8 @@ int xeve_rdoq_method_adcc(u8 qp, double d_lambda, u8 is_intra, s16 *src_coef, s1
     int delta_u[MAX_TR_DIM];
     s16 coef_dst[MAX_TR_DIM];
     
-    int sum_all = 0;
     int blk_pos;
-    s64 tmp_level_double[MAX_TR_DIM];
+    s32 tmp_level_double[MAX_TR_DIM];
 
     int num_nz = 0;
     int is_last_x = 0;
@@ -1080,36 +1078,16 @@ int xeve_rdoq_method_adcc(u8 qp, double d_lambda, u8 is_intra, s16 *src_coef, s1
     q_bits = QUANT_SHIFT + tr_shift + (qp / 6);
     scan = xeve_tbl_scan[log2_cuw - 1][log2_cuh - 1];
 
-    for (scan_pos = 0; scan_pos < max_num_coef; scan_pos++)
-    {
-        int max_abs_level;
-        s64 err;
-        s64 temp_level;
-        int level_double;
-        blk_pos = scan[scan_pos];
-        temp_level = ((s64)XEVE_ABS(src_coef[blk_pos]) * (s64)q_value);
-        level_double = (int)XEVE_MIN(((s64)temp_level), (s64)XEVE_INT32_MAX - (s64)(1 << (q_bits - 1)));
-        tmp_level_double[blk_pos] = (s64)level_double;
-        max_abs_level = XEVE_MIN(MAX_TX_VAL, ((level_double + ((int)1 << (q_bits - 1))) >> q_bits));
-        err = (s64)level_double;
-        err = (err * err_scale) >> ERR_SCALE_PRECISION_BITS;
-        pdcost_coeff0[blk_pos] = err * err;
-        dcost_block_uncoded += pdcost_coeff0[blk_pos];
-        coef_dst[blk_pos] = (s16)max_abs_level;
-        sum_all += max_abs_level;
-
-        if(max_abs_level != 0)
-        {
-            num_nz++;
-            last_pos_in_scan = scan_pos;
-            last_pos_in_raster_from_scan = blk_pos;
-        }
-    }
-    if(sum_all == 0)
+    num_nz = xeve_func_rdoq_est_level(src_coef, coef_dst, tmp_level_double, pdcost_coeff0, max_num_coef, q_value, q_bits, err_scale, &dcost_block_uncoded);
+    if(num_nz == 0)
     {
         xeve_mset(dst_tmp, 0, sizeof(s16) * max_num_coef);
         return 0;
     }
+
+    for(scan_pos = max_num_coef - 1; coef_dst[scan[scan_pos]] == 0; scan_pos--);
+    last_pos_in_scan = scan_pos;
+    last_pos_in_raster_from_scan = scan[scan_pos];
     
     last_scan_set = last_pos_in_scan >> cg_log2_size;
     scan_pos_last = last_pos_in_raster_from_scan;
@@ -1291,6 +1269,9 @@ int xeve_rdoq_method_adcc(u8 qp, double d_lambda, u8 is_intra, s16 *src_coef, s1
     return nnz;
 }
 
+#define FAST_RDOQ_INTRA_RND_OFST  201 //171
+#define FAST_RDOQ_INTER_RND_OFST  153 //85
+
 static int xeve_quant_nnz(u8 qp, double lambda, int is_intra, s16 * coef, int log2_cuw, int log2_cuh, u16 scale, int ch_type
                         , int slice_type, int sps_cm_init_flag, int tool_adcc, XEVE_CORE * core, int bit_depth, int use_rdoq)
 {
@@ -1298,36 +1279,21 @@ static int xeve_quant_nnz(u8 qp, double lambda, int is_intra, s16 * coef, int lo
 
     if(use_rdoq)
     {
-        s64 lev;
         s64 offset;
-        int i;
         int shift;
         int tr_shift;
         int log2_size = (log2_cuw + log2_cuh) >> 1;
         const int ns_shift = ((log2_cuw + log2_cuh) & 1) ? 7 : 0;
         const int ns_scale = ((log2_cuw + log2_cuh) & 1) ? 181 : 1;
         s64 zero_coeff_threshold;
-        BOOL is_coded = 0;
 
         tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size + ns_shift;
         shift = QUANT_SHIFT + tr_shift + (qp / 6);
 
-#define FAST_RDOQ_INTRA_RND_OFST  201 //171
-#define FAST_RDOQ_INTER_RND_OFST  153 //85
         offset = (s64)((slice_type == SLICE_I) ? FAST_RDOQ_INTRA_RND_OFST : FAST_RDOQ_INTER_RND_OFST) << (s64)(shift - 9);
         zero_coeff_threshold = ((s64)1 << (s64)shift) - offset;
 
-        for(i = 0; i < (1 << (log2_cuw + log2_cuh)); i++)
-        {
-            lev = (s64)XEVE_ABS(coef[i]) * (s64)scale * ns_scale;
-            if(lev >= zero_coeff_threshold)
-            {
-                is_coded = 1;
-                break;
-            }
-        }
-
-        if(!is_coded)
+        if((s64)xeve_func_coef_abs_max(coef, 1 << (log2_cuw + log2_cuh)) * (s64)scale * ns_scale < zero_coeff_threshold)
         {
             xeve_mset(coef, 0, sizeof(coef[0])*((s64)1 << (log2_cuw + log2_cuh)));
             return nnz;
@@ -1347,10 +1313,7 @@ static int xeve_quant_nnz(u8 qp, double lambda, int is_intra, s16 * coef, int lo
     }
     else
     {
-        s64 lev;
         s64 offset;
-        int sign;
-        int i;
         int shift;
         int tr_shift;
         int log2_size = (log2_cuw + log2_cuh) >> 1;
@@ -1361,14 +1324,7 @@ static int xeve_quant_nnz(u8 qp, double lambda, int is_intra, s16 * coef, int lo
         shift = QUANT_SHIFT + tr_shift + (qp / 6);
         offset = (s64)((slice_type == SLICE_I) ? 171 : 85) << (s64)(shift - 9);
 
-        for(i = 0; i < (1 << (log2_cuw + log2_cuh)); i++)
-        {
-            sign = XEVE_SIGN_GET(coef[i]);
-            lev = (s64)XEVE_ABS(coef[i]) * (s64)scale;
-            lev = (s16)(((s64)lev * ns_scale + offset) >> shift);
-            coef[i] = (s16)XEVE_SIGN_SET(lev, sign);
-            nnz += !!(coef[i]);
-        }
+        nnz = xeve_func_quant(coef, 1 << (log2_cuw + log2_cuh), scale * ns_scale, offset, shift);
     }
 
     return nnz;
@@ -1378,6 +1334,21 @@ static int xeve_quant_nnz(u8 qp, double lambda, int is_intra, s16 * coef, int lo
 static int xeve_tq_nnz(u8 qp, double lambda, s16 * coef, int log2_cuw, int log2_cuh, u16 scale, int slice_type, int ch_type, int is_intra, int sps_cm_init_flag, int iqt_flag
                      , u8 ats_intra_cu, u8 ats_mode, int tool_adcc, XEVE_CORE * core, int bit_depth, int rdoq)
 {
+    s64 ssd, sad;
+
+    /* skip transform and quantisation of residuals that cannot survive them;
+       the bound holds for the DCT-II only */
+    if(!ats_intra_cu)
+    {
+        ssd = xeve_resi_ssd_sad(coef, 1 << (log2_cuw + log2_cuh), &sad);
+        if(xeve_tq_zero_block(ssd, sad, log2_cuw, log2_cuh, xeve_get_transform_shift(log2_cuw, 0, bit_depth), xeve_get_transform_shift(log2_cuh, 1, bit_depth), iqt_flag
+                            , xeve_quant_zero_max(qp, log2_cuw, log2_cuh, scale, slice_type, bit_depth, rdoq, 1)))
+        {
+            xeve_mset(coef, 0, sizeof(s16) * ((s64)1 << (log2_cuw + log2_cuh)));
+            return 0;
+        }
+    }
+
     if (ats_intra_cu)
     {
         xeve_trans_ats_intra(coef, log2_cuw, log2_cuh, ats_intra_cu, ats_mode, bit_depth);
@@ -1493,3 +1464,32 @@ int xevem_sub_block_tq(XEVE_CTX * ctx, XEVE_CORE * core, s16 coef[N_C][MAX_CU_DI
 
     return (nnz[Y_C] + nnz[U_C] + nnz[V_C]);
 }
+
+int xevem_sub_block_tq_zero(XEVE_CTX * ctx, XEVE_CORE * core, s16 resi[N_C][MAX_CU_DIM], int log2_cuw, int log2_cuh, int slice_type)
+{
+    int run_stats  = xeve_get_run(RUN_L | RUN_CB | RUN_CR, core->tree_cons);
+    int log2_w_sub = (log2_cuw > MAX_TR_LOG2) ? MAX_TR_LOG2 : log2_cuw;
+    int log2_h_sub = (log2_cuh > MAX_TR_LOG2) ? MAX_TR_LOG2 : log2_cuh;
+    int w_shift    = ctx->param.cs_w_shift;
+    int h_shift    = ctx->param.cs_h_shift;
+    int bit_depth  = ctx->sps.bit_depth_luma_minus8 + 8;
+    u8  qp[N_C]    = { core->qp_y, core->qp_u, core->qp_v };
+    int c, ws, hs, scale;
+
+    for(c = 0; c < N_C; c++)
+    {
+        if(!((run_stats >> c) & 1) || (c && !ctx->sps.chroma_format_idc))
+        {
+            continue;
+        }
+        ws = c ? w_shift : 0;
+        hs = c ? h_shift : 0;
+        scale = xeve_quant_scale[ctx->param.tool_iqt][qp[c] % 6];
+        if(!xeve_tq_zero_resi(resi[c], log2_cuw - ws, log2_cuh - hs, log2_w_sub - ws, log2_h_sub - hs, bit_depth, ctx->sps.tool_iqt
+                            , xeve_quant_zero_max(qp[c], log2_w_sub - ws, log2_h_sub - hs, scale, slice_type, bit_depth, ctx->param.rdoq, 1)))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
@@ -116,15 +116,20 @@ typedef struct _XEVEM_CORE
  *
  * All have to be stored are in this structure.
  *****************************************************************************/
+typedef struct _XEVEM_FUNC XEVEM_FUNC;
+
 typedef struct _XEVEM_CTX
 {
     XEVE_CTX bctx;
 
+    /* main profile kernels selected by xevem_platform_init_func() */
+    const XEVEM_FUNC * func;
+
     DRA_CONTROL        dra_control;
     SIG_PARAM_DRA    * dra_array;
 
     /* ibc prediction analysis */
-    XEVE_PIBC          pibc[XEVE_MAX_THREADS];
+    XEVE_PIBC        * pibc;
     XEVE_IBC_HASH    * ibc_hash;
 
     int   (*fn_pibc_init_lcu)(XEVE_CTX * ctx, XEVE_CORE * core);
@@ -146,9 +151,9 @@ typedef struct _XEVEM_CTX
     u8               * map_ats_mode_v;
     u8               * map_ats_inter;
 
-    u32              * ats_inter_pred_dist[XEVE_MAX_THREADS];
-    u8               * ats_inter_info_pred[XEVE_MAX_THREADS];   //best-mode ats_inter info
-    u8               * ats_inter_num_pred[XEVE_MAX_THREADS];
+    u32             ** ats_inter_pred_dist;
+    u8              ** ats_inter_info_pred;   //best-mode ats_inter info
+    u8              ** ats_inter_num_pred;
 
 }XEVEM_CTX;
 
@@ -171,8 +176,51 @@ typedef struct _XEVEM_CTX
 #include "xevem_itdq_avx.h"
 #include "xevem_itdq_sse.h"
 #include "xevem_mc_sse.h"
+#include "xevem_mc_avx512.h"
 #endif
 #if GRAB_STAT
 #include "xevem_stat.h"
 #endif
+
+/*****************************************************************************
+ * optimized kernels of the main profile tools, see XEVE_FUNC
+ *****************************************************************************/
+struct _XEVEM_FUNC
+{
+    const XEVE_INV_TRANS      (*itrans)[5];
+    const XEVEM_MC            (*dmvr_mc_l)[2];
+    const XEVEM_MC            (*dmvr_mc_c)[2];
+    const XEVEM_MC            (*bl_mc_l)[2];
+    XEVE_AFFINE_H_SOBEL_FLT     aff_h_sobel_flt;
+    XEVE_AFFINE_V_SOBEL_FLT     aff_v_sobel_flt;
+    XEVE_AFFINE_EQUAL_COEF      aff_eq_coef_comp;
+    const XEVE_INTRA_PRED_ANG (*intra_pred_ang)[2];
+    const XEVE_TX             (*tx)[MAX_TR_LOG2];
+    const XEVE_ITX            (*itx)[MAX_TR_LOG2];
+    XEVEM_ALF_CLASSIFY          alf_classify;
+    XEVEM_ALF_FILTER            alf_filter_5;
+    XEVEM_ALF_FILTER            alf_filter_7;
+    XEVEM_ALF_BLK_STATS         alf_blk_stats;
+    const XEVEM_DBK_ADDB      (*dbk_addb)[2];
+    XEVEM_IBC_HASH_KEY          ibc_hash_key;
+};
+
+#define XEVEM_FUNC_CUR              (((XEVEM_CTX *)thread_owner)->func)
+
+#define xeve_func_itrans            (XEVEM_FUNC_CUR->itrans)
+#define xevem_func_dmvr_mc_l        (XEVEM_FUNC_CUR->dmvr_mc_l)
+#define xevem_func_dmvr_mc_c        (XEVEM_FUNC_CUR->dmvr_mc_c)
+#define xevem_func_bl_mc_l          (XEVEM_FUNC_CUR->bl_mc_l)
+#define xevem_func_aff_h_sobel_flt  (XEVEM_FUNC_CUR->aff_h_sobel_flt)
+#define xevem_func_aff_v_sobel_flt  (XEVEM_FUNC_CUR->aff_v_sobel_flt)
+#define xevem_func_aff_eq_coef_comp (XEVEM_FUNC_CUR->aff_eq_coef_comp)
+#define xeve_func_intra_pred_ang    (XEVEM_FUNC_CUR->intra_pred_ang)
+#define xeve_func_tx                (XEVEM_FUNC_CUR->tx)
+#define xeve_func_itx               (XEVEM_FUNC_CUR->itx)
+#define xevem_func_alf_classify     (XEVEM_FUNC_CUR->alf_classify)
+#define xevem_func_alf_filter_5     (XEVEM_FUNC_CUR->alf_filter_5)
+#define xevem_func_alf_filter_7     (XEVEM_FUNC_CUR->alf_filter_7)
+#define xevem_func_alf_blk_stats    (XEVEM_FUNC_CUR->alf_blk_stats)
+#define xevem_func_dbk_addb         (XEVEM_FUNC_CUR->dbk_addb)
+#define xevem_func_ibc_hash_key     (XEVEM_FUNC_CUR->ibc_hash_key)
 #endif /* _XEVE_TYPE_H_ */
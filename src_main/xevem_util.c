@@ -34,6 +34,13 @@
 */
 
 #include "xevem_util.h"
+#ifndef ARM
+#include "xevem_alf_sse.h"
+#include "xevem_alf_avx.h"
+#include "xevem_df_sse.h"
+#include "xevem_ipred_sse.h"
+#include "xevem_ibc_hash_avx.h"
+#endif
 
 #if GRAB_STAT
 #include "xevem_stat.h"
@@ -2884,6 +2891,17 @@ XEVEM_CTX * xevem_ctx_alloc(void)
     return ctx;
 }
 
+void xevem_ctx_free(XEVE_CTX * ctx)
+{
+    XEVEM_CTX * mctx = (XEVEM_CTX *)ctx;
+
+    xeve_mfree(mctx->pibc);
+    xeve_mfree(mctx->ats_inter_pred_dist);
+    xeve_mfree(mctx->ats_inter_info_pred);
+    xeve_mfree(mctx->ats_inter_num_pred);
+    xeve_ctx_free(ctx);
+}
+
 XEVEM_CORE * xevem_core_alloc(int chroma_format_idc)
 {
     XEVEM_CORE * mcore;
@@ -3597,11 +3615,19 @@ int xevem_ready(XEVE_CTX * ctx)
     {
         mctx->enc_alf = xeve_alf_create_buf(ctx->param.codec_bit_depth);
         xeve_alf_create(mctx->enc_alf, ctx->w, ctx->h, ctx->max_cuwh, ctx->max_cuwh, 5, ctx->param.chroma_format_idc, ctx->param.codec_bit_depth);
+        mctx->enc_alf->ctx = ctx;
     }
 
+    /* xeve_ready() releases its own buffers when it fails */
     if (xeve_ready(ctx) != XEVE_OK)
     {
-        goto ERR;
+        if (ctx->param.tool_alf)
+        {
+            xeve_alf_destroy(mctx->enc_alf);
+            xeve_alf_delete_buf(mctx->enc_alf);
+            mctx->enc_alf = NULL;
+        }
+        return XEVE_ERR;
     }
 
     if (ctx->param.tool_alf)
@@ -3906,6 +3932,51 @@ int xevem_loop_filter(XEVE_CTX * ctx, XEVE_CORE * core)
     return ret;
 }
 
+int xevem_loop_filter_lcu(XEVE_CTX * ctx, XEVE_CORE * core)
+{
+    XEVEM_CTX * mctx = (XEVEM_CTX *)ctx;
+    XEVE_TILE * tile = &ctx->tile[core->tile_num];
+    int         x_r = tile->ctba_rs_first % ctx->w_lcu + tile->w_ctb;
+    int         y_l = tile->ctba_rs_first / ctx->w_lcu;
+    int         y_lcu = core->y_lcu;
+    int         ret;
+
+    ret = xeve_loop_filter_lcu(ctx, core);
+    xeve_assert_rv(ret == XEVE_OK, ret);
+
+    /* ALF statistics are derived row by row at the end of the row */
+    if (!ctx->sps.tool_alf || !mctx->enc_alf->ctu_stats_pipe || core->x_lcu + 1 != x_r)
+    {
+        return XEVE_OK;
+    }
+
+    if (y_lcu > y_l)
+    {
+        /* the upper row is deblocked, so the rows above it are final. ALF buffer rows are filled
+           in order: the lane of the upper row marks the end of its ALF stage above the row count */
+        if (y_lcu - 1 > y_l)
+        {
+            threadsafe_wait(ctx->sync_wait, &ctx->sync_dbk[y_lcu - 2], tile->w_ctb + 1, &core->wait_time);
+        }
+        if (y_lcu - 2 >= y_l)
+        {
+            xeve_alf_derive_stats_row(mctx->enc_alf, ctx, y_lcu - 2);
+        }
+        threadsafe_signal(ctx->sync_wait, &ctx->sync_dbk[y_lcu - 1], tile->w_ctb + 1);
+    }
+
+    /* the lane of the last row finishes the picture */
+    if (y_lcu + 1 == y_l + tile->h_ctb)
+    {
+        for (int y = XEVE_MAX(y_l, y_lcu - 1); y <= y_lcu; y++)
+        {
+            xeve_alf_derive_stats_row(mctx->enc_alf, ctx, y);
+        }
+    }
+
+    return XEVE_OK;
+}
+
 void xevem_recon(XEVE_CTX * ctx, XEVE_CORE * core, s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth)
 {
     XEVEM_CORE *mcore = (XEVEM_CORE*)core;
@@ -3921,55 +3992,115 @@ void xevem_pic_filt(XEVE_CTX * ctx, XEVE_IMGB * img)
     }
 }
 
-void xevem_platform_init_func()
+#if X86_SSE
+static const XEVEM_FUNC xevem_func_avx512 =
 {
+    xeve_itrans_map_tbl_sse,
+    xeve_tbl_dmvr_mc_l_avx512,
+    xeve_tbl_dmvr_mc_c_sse,
+    xeve_tbl_bl_mc_l_avx512,
+    &xevem_scaled_horizontal_sobel_filter_sse,
+    &xevem_scaled_vertical_sobel_filter_sse,
+    &xevem_equal_coeff_computer_sse,
+    xeve_tbl_intra_pred_ang_sse,
+    &xeve_tbl_tx_avx,
+    &xeve_tbl_itx_avx,
+    &alf_derive_classification_blk_sse,
+    &alf_filter_blk_5_sse,
+    &alf_filter_blk_7_sse,
+    &xeve_alf_get_blk_stats_avx,
+    xevem_tbl_dbk_addb_sse,
+    &xeve_ibc_hash_block_key_avx
+};
+
+static const XEVEM_FUNC xevem_func_avx =
+{
+    xeve_itrans_map_tbl_sse,
+    xeve_tbl_dmvr_mc_l_sse,
+    xeve_tbl_dmvr_mc_c_sse,
+    xeve_tbl_bl_mc_l_sse,
+    &xevem_scaled_horizontal_sobel_filter_sse,
+    &xevem_scaled_vertical_sobel_filter_sse,
+    &xevem_equal_coeff_computer_sse,
+    xeve_tbl_intra_pred_ang_sse,
+    &xeve_tbl_tx_avx,
+    &xeve_tbl_itx_avx,
+    &alf_derive_classification_blk_sse,
+    &alf_filter_blk_5_sse,
+    &alf_filter_blk_7_sse,
+    &xeve_alf_get_blk_stats_avx,
+    xevem_tbl_dbk_addb_sse,
+    &xeve_ibc_hash_block_key_avx
+};
+
+static const XEVEM_FUNC xevem_func_sse =
+{
+    xeve_itrans_map_tbl_sse,
+    xeve_tbl_dmvr_mc_l_sse,
+    xeve_tbl_dmvr_mc_c_sse,
+    xeve_tbl_bl_mc_l_sse,
+    &xevem_scaled_horizontal_sobel_filter_sse,
+    &xevem_scaled_vertical_sobel_filter_sse,
+    &xevem_equal_coeff_computer_sse,
+    xeve_tbl_intra_pred_ang_sse,
+    &xeve_tbl_tx, /* to be updated */
+    &xeve_tbl_itx, /* to be updated */
+    &alf_derive_classification_blk_sse,
+    &alf_filter_blk_5_sse,
+    &alf_filter_blk_7_sse,
+    &xeve_alf_get_blk_stats,
+    xevem_tbl_dbk_addb_sse,
+    &xeve_ibc_hash_block_key
+};
+#endif
+
+static const XEVEM_FUNC xevem_func_c =
+{
+    xeve_itrans_map_tbl,
+    xevem_tbl_dmvr_mc_l,
+    xevem_tbl_dmvr_mc_c,
+    xevem_tbl_bl_mc_l,
+    &xevem_scaled_horizontal_sobel_filter,
+    &xevem_scaled_vertical_sobel_filter,
+    &xevem_equal_coeff_computer,
+    xeve_tbl_intra_pred_ang,
+    &xeve_tbl_tx,
+    &xeve_tbl_itx,
+    &alf_derive_classification_blk,
+    &alf_filter_blk_5,
+    &alf_filter_blk_7,
+    &xeve_alf_get_blk_stats,
+    xevem_tbl_dbk_addb,
+    &xeve_ibc_hash_block_key
+};
+
+void xevem_platform_init_func(XEVE_CTX * ctx)
+{
+    XEVEM_CTX * mctx = (XEVEM_CTX *)ctx;
 #if X86_SSE
-    int check_cpu, support_sse, support_avx, support_avx2;
-    check_cpu = xeve_check_cpu_info();
+    int check_cpu, support_sse, support_avx2, support_avx512;
+    check_cpu = xeve_check_cpu_info(ctx->param.isa);
 
     support_sse = (check_cpu >> 1) & 1;
-    support_avx = check_cpu & 1;
     support_avx2 = (check_cpu >> 2) & 1;
+    support_avx512 = (check_cpu >> 3) & 1;
 
-    if (support_avx2)
+    if (support_avx512)
     {
-        xeve_func_itrans = xeve_itrans_map_tbl_sse;
-        xevem_func_dmvr_mc_l = xeve_tbl_dmvr_mc_l_sse;
-        xevem_func_dmvr_mc_c = xeve_tbl_dmvr_mc_c_sse;
-        xevem_func_bl_mc_l = xeve_tbl_bl_mc_l_sse;
-        xevem_func_aff_h_sobel_flt = &xevem_scaled_horizontal_sobel_filter_sse;
-        xevem_func_aff_v_sobel_flt = &xevem_scaled_vertical_sobel_filter_sse;
-        xevem_func_aff_eq_coef_comp = &xevem_equal_coeff_computer_sse;
-        xeve_func_intra_pred_ang = xeve_tbl_intra_pred_ang; /* to be updated */
-        xeve_func_tx = &xeve_tbl_tx_avx;
-        xeve_func_itx = &xeve_tbl_itx_avx;
+        mctx->func = &xevem_func_avx512;
+    }
+    else if (support_avx2)
+    {
+        mctx->func = &xevem_func_avx;
     }
     else if (support_sse)
     {
-        xeve_func_itrans = xeve_itrans_map_tbl_sse;
-        xevem_func_dmvr_mc_l = xeve_tbl_dmvr_mc_l_sse;
-        xevem_func_dmvr_mc_c = xeve_tbl_dmvr_mc_c_sse;
-        xevem_func_bl_mc_l = xeve_tbl_bl_mc_l_sse;
-        xevem_func_aff_h_sobel_flt = &xevem_scaled_horizontal_sobel_filter_sse;
-        xevem_func_aff_v_sobel_flt = &xevem_scaled_vertical_sobel_filter_sse;
-        xevem_func_aff_eq_coef_comp = &xevem_equal_coeff_computer_sse;
-        xeve_func_intra_pred_ang = xeve_tbl_intra_pred_ang; /* to be updated */
-        xeve_func_tx = &xeve_tbl_tx; /* to be updated */
-        xeve_func_itx = &xeve_tbl_itx; /* to be updated */
+        mctx->func = &xevem_func_sse;
     }
     else
 #endif
     {
-        xeve_func_itrans = xeve_itrans_map_tbl;
-        xevem_func_dmvr_mc_l = xevem_tbl_dmvr_mc_l;
-        xevem_func_dmvr_mc_c = xevem_tbl_dmvr_mc_c;
-        xevem_func_bl_mc_l = xevem_tbl_bl_mc_l;
-        xevem_func_aff_h_sobel_flt = &xevem_scaled_horizontal_sobel_filter;
-        xevem_func_aff_v_sobel_flt = &xevem_scaled_vertical_sobel_filter;
-        xevem_func_aff_eq_coef_comp = &xevem_equal_coeff_computer;
-        xeve_func_intra_pred_ang = xeve_tbl_intra_pred_ang;
-        xeve_func_tx = &xeve_tbl_tx;
-        xeve_func_itx = &xeve_tbl_itx;
+        mctx->func = &xevem_func_c;
     }
 }
 
@@ -3977,10 +4108,28 @@ int xevem_platform_init(XEVE_CTX * ctx)
 {
     XEVEM_CTX * mctx = (XEVEM_CTX *)ctx;
     int         ret = XEVE_ERR_UNKNOWN;
+    int         size;
 
     ret = xeve_platform_init(ctx);
     xeve_assert_rv(XEVE_OK == ret, ret);
 
+    /* per-thread contexts of main profile tools */
+    size = sizeof(XEVE_PIBC) * ctx->param.threads;
+    mctx->pibc = (XEVE_PIBC *)xeve_malloc(size);
+    xeve_assert_rv(mctx->pibc, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(mctx->pibc, 0, size);
+    size = sizeof(u32 *) * ctx->param.threads;
+    mctx->ats_inter_pred_dist = (u32 **)xeve_malloc(size);
+    xeve_assert_rv(mctx->ats_inter_pred_dist, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(mctx->ats_inter_pred_dist, 0, size);
+    size = sizeof(u8 *) * ctx->param.threads;
+    mctx->ats_inter_info_pred = (u8 **)xeve_malloc(size);
+    xeve_assert_rv(mctx->ats_inter_info_pred, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(mctx->ats_inter_info_pred, 0, size);
+    mctx->ats_inter_num_pred = (u8 **)xeve_malloc(size);
+    xeve_assert_rv(mctx->ats_inter_num_pred, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(mctx->ats_inter_num_pred, 0, size);
+
     ret = xevem_pintra_create(ctx, 0);
     xeve_assert_rv(XEVE_OK == ret, ret);
 
@@ -4014,6 +4163,7 @@ int xevem_platform_init(XEVE_CTX * ctx)
     ctx->fn_rdo_intra_ext   = xevem_rdo_bit_cnt_intra_ext;
     ctx->fn_rdo_intra_ext_c = xevem_rdo_bit_cnt_intra_ext_c;
     ctx->fn_tq              = xevem_sub_block_tq;
+    ctx->fn_tq_zero         = xevem_sub_block_tq_zero;
     ctx->fn_rdoq_set_ctx_cc = xevem_rdoq_set_ctx_cc;
     ctx->fn_itdp            = xevem_itdq;
     ctx->fn_recon           = xevem_recon;
@@ -4026,7 +4176,7 @@ int xevem_platform_init(XEVE_CTX * ctx)
     mctx->fn_alf            = xevem_alf_aps;
 
     xeve_mode_create_main(ctx);
-    xevem_platform_init_func();
+    xevem_platform_init_func(ctx);
     return XEVE_OK;
 }
 
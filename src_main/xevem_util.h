@@ -106,6 +106,7 @@ void get_tu_size(u8 ats_inter_info, int log2_cuw, int log2_cuh, int* log2_tuw, i
 void set_cu_cbf_flags(u8 cbf_y, u8 ats_inter_info, int log2_cuw, int log2_cuh, u32 *map_scu, int w_scu);
 
 XEVEM_CTX  * xevem_ctx_alloc(void);
+void         xevem_ctx_free(XEVE_CTX * ctx);
 XEVEM_CORE * xevem_core_alloc(int chroma_format_idc);
 int  xevem_set_init_param(XEVE_CTX * ctx, XEVE_PARAM * param);
 void xevem_set_sps(XEVE_CTX * ctx, XEVE_SPS * sps);
@@ -120,9 +121,10 @@ int  xevem_header(XEVE_CTX * ctx);
 int  xevem_pic_prepare(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat);
 int  xevem_init_core_mt(XEVE_CTX * ctx, int tile_num, XEVE_CORE * core, int thread_cnt);
 int  xevem_loop_filter(XEVE_CTX * ctx, XEVE_CORE * core);
+int  xevem_loop_filter_lcu(XEVE_CTX * ctx, XEVE_CORE * core);
 void xevem_recon(XEVE_CTX * ctx, XEVE_CORE * core, s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, int bit_depth);
 void xevem_pic_filt(XEVE_CTX * ctx, XEVE_IMGB * img);
-void xevem_platform_init_func();
+void xevem_platform_init_func(XEVE_CTX * ctx);
 int  xevem_platform_init(XEVE_CTX * ctx);
 void xevem_platform_deinit(XEVE_CTX * ctx);
 int  xevem_encode_sps(XEVE_CTX * ctx);
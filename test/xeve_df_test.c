@@ -0,0 +1,111 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+#include "xeve_test.h"
+
+/* deblocking filter kernels of the baseline profile against the C ones */
+
+#define BLK                    16
+#define ITER                   10
+
+static pel buf[2][BLK * BLK];
+
+/* smooth content with a step across the edge in the middle of the block */
+static void fill_edge(int dir, int bit_depth, int mode)
+{
+    const int max = (1 << bit_depth) - 1;
+    const int step = xeve_test_rand_range(-64, 64) << (bit_depth - 8);
+    int i, j;
+
+    xeve_test_fill(buf[0], BLK, BLK, BLK, bit_depth, mode);
+    for(i = 0; i < BLK; i++)
+    {
+        for(j = 0; j < BLK; j++)
+        {
+            if((dir == 0 ? i : j) >= BLK / 2)
+            {
+                buf[0][i * BLK + j] = (pel)XEVE_CLIP3(0, max, buf[0][i * BLK + j] + step);
+            }
+        }
+    }
+    memcpy(buf[1], buf[0], sizeof(buf[0]));
+}
+
+int main(int argc, const char ** argv)
+{
+    static const char * dir_name[2] = { "hor", "ver" };
+    pel * edge[2] = { buf[0] + (BLK / 2) * BLK + BLK / 2, buf[1] + (BLK / 2) * BLK + BLK / 2 };
+    int bit_depth, dir, chroma_format_idc, st, qp, it;
+
+    if(!(xeve_check_cpu_info(XEVE_ISA_AUTO) & XEVE_TEST_CPU_SSE))
+    {
+        printf("SSE4.1 is not supported, test skipped\n");
+        return XEVE_TEST_SKIP;
+    }
+
+    for(bit_depth = 8; bit_depth <= 12; bit_depth += 2)
+    {
+        for(dir = 0; dir < 2; dir++)
+        {
+            /* every strength table: intra, coded, motion and no deblocking */
+            for(st = 0; st < 4; st++)
+            {
+                for(qp = 0; qp < 52; qp++)
+                {
+                    for(it = 0; it < ITER; it++)
+                    {
+                        fill_edge(dir, bit_depth, it & 3);
+                        xeve_tbl_dbk[dir][0](edge[0], qp, BLK, 1, xeve_tbl_df_st[st], bit_depth - 8, 1);
+                        xeve_tbl_dbk_sse[dir][0](edge[1], qp, BLK, 1, xeve_tbl_df_st[st], bit_depth - 8, 1);
+                        XEVE_TEST_CHECK(!memcmp(buf[0], buf[1], sizeof(buf[0])),
+                                        "luma %s: bd %d, table %d, qp %d, iteration %d\n", dir_name[dir], bit_depth, st, qp, it);
+
+                        for(chroma_format_idc = 1; chroma_format_idc <= 3; chroma_format_idc++)
+                        {
+                            fill_edge(dir, bit_depth, it & 3);
+                            xeve_tbl_dbk[dir][1](edge[0], qp, BLK, 0, xeve_tbl_df_st[st], bit_depth - 8, chroma_format_idc);
+                            xeve_tbl_dbk_sse[dir][1](edge[1], qp, BLK, 0, xeve_tbl_df_st[st], bit_depth - 8, chroma_format_idc);
+                            XEVE_TEST_CHECK(!memcmp(buf[0], buf[1], sizeof(buf[0])),
+                                            "chroma %s: bd %d, format %d, table %d, qp %d, iteration %d\n", dir_name[dir], bit_depth, chroma_format_idc, st, qp, it);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return xeve_test_report("xeve_df_test");
+}
@@ -0,0 +1,143 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+#include "xeve_test.h"
+
+/* inverse transform kernels of every x86 tier against the C ones, both
+   passes as xeve_itrans() runs them at 8, 10 and 12 bits */
+
+#define ITER                   8
+
+typedef struct _TEST_TIER
+{
+    const char      * name;
+    int               cpu;
+    const XEVE_ITXB * itxb;
+} TEST_TIER;
+
+static const TEST_TIER tiers[] =
+{
+    { "sse",    XEVE_TEST_CPU_SSE,    xeve_tbl_itxb_sse },
+    { "avx2",   XEVE_TEST_CPU_AVX2,   xeve_tbl_itxb_avx },
+    { "avx512", XEVE_TEST_CPU_AVX512, xeve_tbl_itxb_avx512 }
+};
+
+/* coefficients as the dequantisation produces them: the two pass DCT-II of
+   xeve_trans() on a residual block, rounded to the multiples of a random
+   quantisation step. the SIMD kernels compute in 32 bits, so they are only
+   exact on coefficients of real residuals */
+static void fill_coef(s16 * coef, int log2_w, int log2_h, int bit_depth, int mode)
+{
+    static s32 tb[MAX_TR_DIM];
+    const int num = 1 << (log2_w + log2_h);
+    const int step = 1 << xeve_test_rand_range(0, 8);
+    int i, c;
+
+    xeve_test_fill_resi(coef, log2_w, log2_h, bit_depth, mode);
+    xeve_tbl_txb[log2_w - 1](coef, tb, 0, 1 << log2_h, 0);
+    xeve_tbl_txb[log2_h - 1](tb, coef, xeve_get_transform_shift(log2_w, 0, bit_depth) + xeve_get_transform_shift(log2_h, 1, bit_depth), 1 << log2_w, 1);
+
+    for(i = 0; i < num; i++)
+    {
+        c = XEVE_MIN(32767, (abs(coef[i]) + step / 2) / step * step);
+        coef[i] = (s16)(coef[i] < 0 ? -c : c);
+    }
+}
+
+static void test_tier(const TEST_TIER * t)
+{
+    static s16 coef[MAX_TR_DIM];
+    static s32 mid[2][MAX_TR_DIM];
+    static s16 resi[2][MAX_TR_DIM];
+    int it, bit_depth, log2_w, log2_h, mode;
+
+    for(it = 0; it < ITER; it++)
+    {
+        for(bit_depth = 8; bit_depth <= 12; bit_depth += 2)
+        {
+            /* every block shape, so each kernel also runs on a number of
+               lines that is not a multiple of its vector width */
+            for(log2_w = 1; log2_w <= MAX_TR_LOG2; log2_w++)
+            {
+                for(log2_h = 1; log2_h <= MAX_TR_LOG2; log2_h++)
+                {
+                    for(mode = 0; mode < 5; mode++)
+                    {
+                        fill_coef(coef, log2_w, log2_h, bit_depth, mode);
+
+                        /* first pass from 16-bit coefficients to 32-bit intermediates */
+                        memset(mid, 0, sizeof(mid));
+                        xeve_tbl_itxb[log2_h - 1](coef, mid[0], 0, 1 << log2_w, 0);
+                        t->itxb[log2_h - 1](coef, mid[1], 0, 1 << log2_w, 0);
+                        XEVE_TEST_CHECK(!memcmp(mid[0], mid[1], sizeof(mid[0])),
+                                        "itxb %s first pass: %dx%d, mode %d, bd %d, iteration %d\n", t->name, 1 << log2_w, 1 << log2_h, mode, bit_depth, it);
+
+                        /* second pass from the intermediates to 16-bit residuals */
+                        memset(resi, 0, sizeof(resi));
+                        xeve_tbl_itxb[log2_w - 1](mid[0], resi[0], ITX_SHIFT1 + ITX_SHIFT2(bit_depth), 1 << log2_h, 1);
+                        t->itxb[log2_w - 1](mid[0], resi[1], ITX_SHIFT1 + ITX_SHIFT2(bit_depth), 1 << log2_h, 1);
+                        XEVE_TEST_CHECK(!memcmp(resi[0], resi[1], sizeof(resi[0])),
+                                        "itxb %s second pass: %dx%d, mode %d, bd %d, iteration %d\n", t->name, 1 << log2_w, 1 << log2_h, mode, bit_depth, it);
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, const char ** argv)
+{
+    int cpu = xeve_check_cpu_info(XEVE_ISA_AUTO);
+    int tested = 0;
+    int i;
+
+    for(i = 0; i < (int)(sizeof(tiers) / sizeof(tiers[0])); i++)
+    {
+        if(!(cpu & tiers[i].cpu))
+        {
+            printf("%s is not supported, not tested\n", tiers[i].name);
+            continue;
+        }
+        test_tier(&tiers[i]);
+        tested++;
+    }
+    if(!tested)
+    {
+        return XEVE_TEST_SKIP;
+    }
+
+    return xeve_test_report("xeve_itdq_test");
+}
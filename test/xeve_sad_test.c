@@ -0,0 +1,161 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+#include "xeve_test.h"
+
+/* SAD, SSD, residual, SATD and bi-prediction average kernels of every x86 tier
+   against the C ones */
+
+#define STRIDE1                300
+#define STRIDE2                290
+#define ITER                   20
+
+static pel org[STRIDE1 * 140];
+static pel cur[STRIDE1 * 140];
+static s16 out[2][140 * 140];
+
+typedef struct _TEST_TIER
+{
+    const char         * name;
+    int                  cpu;
+    const XEVE_FN_SAD   (* sad)[8];
+    const XEVE_FN_SSD   (* ssd)[8];
+    const XEVE_FN_DIFF  (* diff)[8];
+    const XEVE_FN_SATD   * satd;
+    void               (* avg)(s16 *src, s16 *ref, s16 *dst, int s_src, int s_ref, int s_dst, int wd, int ht);
+} TEST_TIER;
+
+static const TEST_TIER tiers[] =
+{
+    { "sse",    XEVE_TEST_CPU_SSE,    xeve_tbl_sad_16b_sse,    xeve_tbl_ssd_16b_sse,    xeve_tbl_diff_16b_sse,    xeve_tbl_satd_16b_sse,    xeve_average_16b_no_clip_sse },
+    { "avx2",   XEVE_TEST_CPU_AVX2,   xeve_tbl_sad_16b_avx,    xeve_tbl_ssd_16b_avx,    xeve_tbl_diff_16b_avx,    xeve_tbl_satd_16b_avx,    xeve_average_16b_no_clip_avx },
+    { "avx512", XEVE_TEST_CPU_AVX512, xeve_tbl_sad_16b_avx512, xeve_tbl_ssd_16b_avx512, xeve_tbl_diff_16b_avx512, xeve_tbl_satd_16b_avx512, xeve_average_16b_no_clip_avx512 }
+};
+
+static void test_tier(const TEST_TIER * t, int bit_depth)
+{
+    const int max = (1 << bit_depth) - 1;
+    int it, i, v, log2_w, log2_h;
+
+    for(it = 0; it < ITER; it++)
+    {
+        /* extreme values, then noise, then a prediction close to the original */
+        xeve_test_fill(org, STRIDE1, STRIDE1, 140, bit_depth, it < 2 ? 1 : 0);
+        for(i = 0; i < STRIDE1 * 140; i++)
+        {
+            /* XEVE_CLIP3() evaluates its value more than once */
+            v = (it & 1) ? xeve_test_rand_range(0, max) : org[i] + xeve_test_rand_range(-4, 4);
+            cur[i] = (pel)XEVE_CLIP3(0, max, v);
+        }
+
+        for(log2_w = 0; log2_w < 8; log2_w++)
+        {
+            for(log2_h = 0; log2_h < 8; log2_h++)
+            {
+                int w = 1 << log2_w;
+                int h = 1 << log2_h;
+                pel * o = org + 5;
+                pel * c = cur + 3;
+
+                if(w > 128 || h > 128)
+                {
+                    continue;
+                }
+
+                XEVE_TEST_CHECK(xeve_tbl_sad_16b[log2_w][log2_h](w, h, o, c, STRIDE1, STRIDE2, bit_depth) ==
+                                t->sad[log2_w][log2_h](w, h, o, c, STRIDE1, STRIDE2, bit_depth),
+                                "sad %s: %dx%d, bd %d, iteration %d\n", t->name, w, h, bit_depth, it);
+
+                if(t->ssd)
+                {
+                    XEVE_TEST_CHECK(xeve_tbl_ssd_16b[log2_w][log2_h](w, h, o, c, STRIDE1, STRIDE2, bit_depth) ==
+                                    t->ssd[log2_w][log2_h](w, h, o, c, STRIDE1, STRIDE2, bit_depth),
+                                    "ssd %s: %dx%d, bd %d, iteration %d\n", t->name, w, h, bit_depth, it);
+                }
+                if(t->diff)
+                {
+                    memset(out, 0, sizeof(out));
+                    xeve_tbl_diff_16b[log2_w][log2_h](w, h, o, c, STRIDE1, STRIDE2, w + 3, out[0], bit_depth);
+                    t->diff[log2_w][log2_h](w, h, o, c, STRIDE1, STRIDE2, w + 3, out[1], bit_depth);
+                    XEVE_TEST_CHECK(!memcmp(out[0], out[1], sizeof(out[0])),
+                                    "diff %s: %dx%d, bd %d, iteration %d\n", t->name, w, h, bit_depth, it);
+                }
+                /* the SIMD Hadamard kernels are written for 10-bit input at most */
+                if(t->satd && bit_depth <= 10 && log2_w >= 1 && log2_h >= 1 && log2_w <= 6 && log2_h <= 6)
+                {
+                    XEVE_TEST_CHECK(xeve_tbl_satd_16b[0](w, h, o, c, STRIDE1, STRIDE2, bit_depth) ==
+                                    t->satd[0](w, h, o, c, STRIDE1, STRIDE2, bit_depth),
+                                    "satd %s: %dx%d, bd %d, iteration %d\n", t->name, w, h, bit_depth, it);
+                }
+                if(t->avg && w >= 4)
+                {
+                    memset(out, 0, sizeof(out));
+                    xeve_average_16b_no_clip(o, c, out[0], STRIDE1, STRIDE2, w + 1, w, h);
+                    t->avg(o, c, out[1], STRIDE1, STRIDE2, w + 1, w, h);
+                    XEVE_TEST_CHECK(!memcmp(out[0], out[1], sizeof(out[0])),
+                                    "average %s: %dx%d, bd %d, iteration %d\n", t->name, w, h, bit_depth, it);
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, const char ** argv)
+{
+    int cpu = xeve_check_cpu_info(XEVE_ISA_AUTO);
+    int tested = 0;
+    int i, bit_depth;
+
+    for(i = 0; i < (int)(sizeof(tiers) / sizeof(tiers[0])); i++)
+    {
+        if(!(cpu & tiers[i].cpu))
+        {
+            printf("%s is not supported, not tested\n", tiers[i].name);
+            continue;
+        }
+        for(bit_depth = 8; bit_depth <= 12; bit_depth += 2)
+        {
+            test_tier(&tiers[i], bit_depth);
+        }
+        tested++;
+    }
+    if(!tested)
+    {
+        return XEVE_TEST_SKIP;
+    }
+
+    return xeve_test_report("xeve_sad_test");
+}
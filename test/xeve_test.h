@@ -0,0 +1,294 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _XEVE_TEST_H_
+#define _XEVE_TEST_H_
+
+/* helpers of the kernel tests, included after xeve_type.h or xevem_type.h */
+
+#include <stdio.h>
+#include <string.h>
+
+/* exit code of a test whose kernel tier is not supported by the CPU */
+#define XEVE_TEST_SKIP                  77
+
+/* bits returned by xeve_check_cpu_info() */
+#define XEVE_TEST_CPU_SSE               0x2
+#define XEVE_TEST_CPU_AVX2              0x4
+#define XEVE_TEST_CPU_AVX512            0x8
+
+/* number of mismatches printed before the remaining ones are only counted */
+#define XEVE_TEST_MAX_PRINT             16
+
+static unsigned int xeve_test_seed = 1;
+static int          xeve_test_cnt;
+static int          xeve_test_fail;
+
+/* own generator so that a failing case is reproduced with any C library */
+static __inline int xeve_test_rand(void)
+{
+    xeve_test_seed = xeve_test_seed * 1103515245 + 12345;
+    return (xeve_test_seed >> 16) & 0x7FFF;
+}
+
+/* random value in [min, max] */
+static __inline int xeve_test_rand_range(int min, int max)
+{
+    return min + (int)(((xeve_test_rand() << 15) | xeve_test_rand()) % (max - min + 1));
+}
+
+/* fills a picture area with bit_depth samples:
+   0 - uniform noise, 1 - extreme values only, 2 - gradient with little noise,
+   3 - flat */
+static void xeve_test_fill(pel * buf, int stride, int w, int h, int bit_depth, int mode)
+{
+    const int max = (1 << bit_depth) - 1;
+    const int base = xeve_test_rand_range(0, max);
+    const int gx = xeve_test_rand_range(-8, 8);
+    const int gy = xeve_test_rand_range(-8, 8);
+    int i, j, v;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j++)
+        {
+            switch(mode)
+            {
+            case 0:  v = xeve_test_rand_range(0, max); break;
+            case 1:  v = (xeve_test_rand() & 1) ? max : 0; break;
+            case 2:  v = base + gx * j + gy * i + xeve_test_rand_range(-2, 2); break;
+            default: v = base; break;
+            }
+            buf[i * stride + j] = (pel)XEVE_CLIP3(0, max, v);
+        }
+    }
+}
+
+#define XEVE_TEST_CHECK(cond, ...) \
+    do \
+    { \
+        xeve_test_cnt++; \
+        if(!(cond) && xeve_test_fail++ < XEVE_TEST_MAX_PRINT) \
+        { \
+            printf(__VA_ARGS__); \
+        } \
+    } while(0)
+
+/* row k of the DCT-II matrix of 2^log2_size points */
+static const s8 * xeve_test_tm(int log2_size, int k)
+{
+    switch(log2_size)
+    {
+    case 1:  return xeve_tbl_tm2[k];
+    case 2:  return xeve_tbl_tm4[k];
+    case 3:  return xeve_tbl_tm8[k];
+    case 4:  return xeve_tbl_tm16[k];
+    case 5:  return xeve_tbl_tm32[k];
+    default: return xeve_tbl_tm64[k];
+    }
+}
+
+/* fills a residual block of bit_depth samples:
+   0 - all at the largest magnitude, 1 - a single spike, 2 - uniform noise,
+   3 - the signs of a 2-D DCT basis function, 4 - a scaled 2-D DCT basis
+   function. the amplitude of 1 to 4 is log-uniform up to the largest one */
+static void xeve_test_fill_resi(s16 * resi, int log2_w, int log2_h, int bit_depth, int mode)
+{
+    const int max = (1 << bit_depth) - 1;
+    const int rnd = xeve_test_rand_range(1, 1 << xeve_test_rand_range(0, bit_depth));
+    const int amp = XEVE_MIN(max, rnd);
+    const s8 * tm_w = xeve_test_tm(log2_w, xeve_test_rand_range(0, (1 << log2_w) - 1));
+    const s8 * tm_h = xeve_test_tm(log2_h, xeve_test_rand_range(0, (1 << log2_h) - 1));
+    const int w = 1 << log2_w;
+    const int num = 1 << (log2_w + log2_h);
+    int i, b;
+
+    for(i = 0; i < num; i++)
+    {
+        b = tm_w[i % w] * tm_h[i / w];
+        switch(mode)
+        {
+        case 0:  resi[i] = (s16)((xeve_test_rand() & 1) ? max : -max); break;
+        case 1:  resi[i] = 0; break;
+        case 2:  resi[i] = (s16)xeve_test_rand_range(-amp, amp); break;
+        case 3:  resi[i] = (s16)(b > 0 ? amp : (b < 0 ? -amp : 0)); break;
+        default: resi[i] = (s16)((b * amp + (b < 0 ? -4096 : 4096)) / 8192); break;
+        }
+    }
+    if(mode == 1)
+    {
+        resi[xeve_test_rand_range(0, num - 1)] = (s16)((xeve_test_rand() & 1) ? amp : -amp);
+    }
+}
+
+/* forward transform as xeve_trans() of the profile does it */
+typedef void (*XEVE_TEST_TRANS)(s16 * coef, int log2_w, int log2_h, int iqt, int bit_depth);
+
+/* xeve_tq_zero_block() with the limit of xeve_quant_zero_max() may only call
+   a residual block zero when the transform and the quantisation of
+   xeve_quant_nnz() turn it into zero. checked on every size, qp, bit depth,
+   slice type and rdoq setting; ns_quant as for xeve_quant_zero_max() */
+static void xeve_test_zero_block(const char * name, XEVE_TEST_TRANS trans, int iqt, int ns_quant, int iter)
+{
+    static s16 resi[MAX_TR_DIM];
+    static s16 coef[MAX_TR_DIM];
+    static s16 tmp[MAX_TR_DIM];
+    int it, bit_depth, log2_w, log2_h, mode, qp, rdoq, slice, zero_cnt = 0;
+
+    for(it = 0; it < iter; it++)
+    {
+        for(bit_depth = 8; bit_depth <= 12; bit_depth += 2)
+        {
+            for(log2_w = 1; log2_w <= MAX_TR_LOG2; log2_w++)
+            {
+                for(log2_h = 1; log2_h <= MAX_TR_LOG2; log2_h++)
+                {
+                    const int num = 1 << (log2_w + log2_h);
+                    const int log2_size = (log2_w + log2_h) >> 1;
+                    const int shift1 = xeve_get_transform_shift(log2_w, 0, bit_depth);
+                    const int shift2 = xeve_get_transform_shift(log2_h, 1, bit_depth);
+
+                    for(mode = 0; mode < 5; mode++)
+                    {
+                        s64 ssd, sad, abs_max;
+
+                        xeve_test_fill_resi(resi, log2_w, log2_h, bit_depth, mode);
+                        ssd = xeve_resi_ssd_sad(resi, num, &sad);
+                        memcpy(coef, resi, num * sizeof(s16));
+                        trans(coef, log2_w, log2_h, iqt, bit_depth);
+                        abs_max = xeve_coef_abs_max(coef, num);
+
+                        for(qp = 0; qp <= 51; qp++)
+                        {
+                            for(rdoq = 0; rdoq < 2; rdoq++)
+                            {
+                                for(slice = 0; slice < 2; slice++)
+                                {
+                                    const int slice_type = slice ? SLICE_B : SLICE_I;
+                                    const int scale = xeve_quant_scale[iqt][qp % 6];
+                                    const int ns = ((log2_w + log2_h) & 1) && (rdoq || ns_quant);
+                                    const int shift = QUANT_SHIFT + MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size + (ns ? 7 : 0) + (qp / 6);
+                                    const s64 offset = (s64)(rdoq ? (slice ? 153 : 201) : (slice ? 85 : 171)) << (shift - 9);
+                                    const int c_max = xeve_quant_zero_max(qp, log2_w, log2_h, scale, slice_type, bit_depth, rdoq, ns_quant);
+                                    int zero;
+
+                                    if(!xeve_tq_zero_block(ssd, sad, log2_w, log2_h, shift1, shift2, iqt, c_max))
+                                    {
+                                        continue;
+                                    }
+                                    zero_cnt++;
+                                    if(rdoq)
+                                    {
+                                        /* early exit of xeve_quant_nnz() before the RDOQ */
+                                        zero = abs_max * scale * (ns ? 181 : 1) < ((s64)1 << shift) - offset;
+                                    }
+                                    else
+                                    {
+                                        memcpy(tmp, coef, num * sizeof(s16));
+                                        zero = xeve_quant(tmp, num, scale * (ns ? 181 : 1), offset, shift) == 0;
+                                    }
+                                    XEVE_TEST_CHECK(zero, "zero block %s: %dx%d, mode %d, bd %d, qp %d, rdoq %d, slice %d, iteration %d\n",
+                                                    name, 1 << log2_w, 1 << log2_h, mode, bit_depth, qp, rdoq, slice, it);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    /* the check is vacuous if no block is ever called zero */
+    XEVE_TEST_CHECK(zero_cnt > 0, "zero block %s: no block is called zero\n", name);
+}
+
+/* motion compensation as the tables of one kernel tier do it: runs the C
+   kernel when simd is 0 and the SIMD one otherwise */
+typedef void (*XEVE_TEST_MC)(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth, int simd);
+
+#define XEVE_TEST_MC_REF_S      320
+#define XEVE_TEST_MC_REF_H      240
+#define XEVE_TEST_MC_ORG        32
+#define XEVE_TEST_MC_MAX_W      (XEVE_TEST_MC_REF_S - XEVE_TEST_MC_ORG * 2)
+
+/* compares the C and the SIMD kernel on every width of widths[] and every
+   combination of zero and fractional motion at 8, 10 and 12 bits. the motion
+   vectors have frac_bits fractional bits and up to four samples of integer
+   motion, the heights are random powers of two up to max_h. the prediction
+   stride is wider than the block so that writes past a row are caught */
+static void xeve_test_mc(const char * name, XEVE_TEST_MC mc, int frac_bits, const int * widths, int num_w, int max_h, int iter)
+{
+    static pel ref[XEVE_TEST_MC_REF_S * XEVE_TEST_MC_REF_H];
+    static pel pred[2][(XEVE_TEST_MC_MAX_W + 3) * XEVE_TEST_MC_MAX_W];
+    pel * org = ref + XEVE_TEST_MC_ORG * XEVE_TEST_MC_REF_S + XEVE_TEST_MC_ORG;
+    const int frac_max = (1 << frac_bits) - 1;
+    int it, bit_depth, k, frac, w, h, s_pred, gmv_x, gmv_y;
+
+    for(it = 0; it < iter; it++)
+    {
+        for(bit_depth = 8; bit_depth <= 12; bit_depth += 2)
+        {
+            xeve_test_fill(ref, XEVE_TEST_MC_REF_S, XEVE_TEST_MC_REF_S, XEVE_TEST_MC_REF_H, bit_depth, it & 3);
+
+            for(k = 0; k < num_w; k++)
+            {
+                /* dx == 0 or not, dy == 0 or not */
+                for(frac = 0; frac < 4; frac++)
+                {
+                    w = widths[k];
+                    h = 4 << xeve_test_rand_range(0, 6);
+                    h = XEVE_MIN(max_h, h);
+                    s_pred = w + 3;
+                    gmv_x = xeve_test_rand_range(-4, 4) * (1 << frac_bits) + ((frac & 1) ? xeve_test_rand_range(1, frac_max) : 0);
+                    gmv_y = xeve_test_rand_range(-4, 4) * (1 << frac_bits) + ((frac & 2) ? xeve_test_rand_range(1, frac_max) : 0);
+
+                    memset(pred, 0x5A, sizeof(pred));
+                    mc(org, gmv_x, gmv_y, XEVE_TEST_MC_REF_S, s_pred, pred[0], w, h, bit_depth, 0);
+                    mc(org, gmv_x, gmv_y, XEVE_TEST_MC_REF_S, s_pred, pred[1], w, h, bit_depth, 1);
+                    XEVE_TEST_CHECK(!memcmp(pred[0], pred[1], sizeof(pred[0])),
+                                    "mc %s: %dx%d, mv (%d, %d), bd %d, iteration %d\n", name, w, h, gmv_x, gmv_y, bit_depth, it);
+                }
+            }
+        }
+    }
+}
+
+/* prints the result and returns the exit code of the test */
+static int xeve_test_report(const char * name)
+{
+    printf("%s: %d cases, %d mismatches\n", name, xeve_test_cnt, xeve_test_fail);
+    return xeve_test_fail ? 1 : 0;
+}
+
+#endif /* _XEVE_TEST_H_ */
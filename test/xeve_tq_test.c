@@ -0,0 +1,219 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <math.h>
+#include "xeve_type.h"
+#include "xeve_test.h"
+
+/* forward transform, quantisation and RDOQ level estimation kernels of every
+   x86 tier against the C ones, and the skip of the transform of zero blocks */
+
+#define ITER                   50
+
+typedef struct _TEST_TIER
+{
+    const char     * name;
+    int              cpu;
+    const XEVE_TXB * txb;
+    int           (* quant)(s16 * coef, int num, int scale, s64 offset, int shift);
+    u32           (* coef_abs_max)(s16 * coef, int num);
+    int           (* rdoq_est_level)(s16 * src, s16 * level, s32 * level_double, s64 * err0, int num, int q_value, int q_bits, s64 err_scale, s64 * err0_sum);
+} TEST_TIER;
+
+static const TEST_TIER tiers[] =
+{
+    { "sse",    XEVE_TEST_CPU_SSE,    xeve_tbl_txb_sse,    xeve_quant_sse, xeve_coef_abs_max_sse, xeve_rdoq_est_level_sse },
+    { "avx2",   XEVE_TEST_CPU_AVX2,   xeve_tbl_txb_avx,    xeve_quant_avx, xeve_coef_abs_max_avx, xeve_rdoq_est_level_avx },
+    { "avx512", XEVE_TEST_CPU_AVX512, xeve_tbl_txb_avx512, NULL,           NULL,                  NULL }
+};
+
+static void test_txb(const TEST_TIER * t)
+{
+    static s16 src[MAX_TR_DIM];
+    static s32 mid[2][MAX_TR_DIM];
+    static s16 dst[2][MAX_TR_DIM];
+    int it, i, log2_size, line;
+
+    for(it = 0; it < ITER; it++)
+    {
+        for(log2_size = 1; log2_size <= MAX_TR_LOG2; log2_size++)
+        {
+            for(line = 1; line <= MAX_TR_SIZE; line <<= 1)
+            {
+                const int size = 1 << log2_size;
+
+                /* saturated residuals first, then residuals of 12-bit content */
+                for(i = 0; i < size * line; i++)
+                {
+                    src[i] = (s16)(it < 10 ? ((xeve_test_rand() & 1) ? 32767 : -32768) * (xeve_test_rand() & 1) : xeve_test_rand_range(-2048, 2047));
+                }
+
+                /* first pass from 16-bit residuals to 32-bit intermediates */
+                memset(mid, 0, sizeof(mid));
+                xeve_tbl_txb[log2_size - 1](src, mid[0], 0, line, 0);
+                t->txb[log2_size - 1](src, mid[1], 0, line, 0);
+                XEVE_TEST_CHECK(!memcmp(mid[0], mid[1], sizeof(mid[0])),
+                                "txb %s first pass: size %d, %d lines, iteration %d\n", t->name, size, line, it);
+
+                /* second pass from the intermediates to 16-bit coefficients */
+                memset(dst, 0, sizeof(dst));
+                xeve_tbl_txb[log2_size - 1](mid[0], dst[0], 9, line, 1);
+                t->txb[log2_size - 1](mid[0], dst[1], 9, line, 1);
+                XEVE_TEST_CHECK(!memcmp(dst[0], dst[1], sizeof(dst[0])),
+                                "txb %s second pass: size %d, %d lines, iteration %d\n", t->name, size, line, it);
+            }
+        }
+    }
+}
+
+/* transform coefficients:
+   0 - saturated or zero, 1 - small and sparse, 2 - full range,
+   3 - low frequencies only */
+static void fill_coef(s16 * coef, int num, int mode)
+{
+    int i;
+
+    for(i = 0; i < num; i++)
+    {
+        switch(mode)
+        {
+        case 0:  coef[i] = (xeve_test_rand() & 1) ? 0 : ((xeve_test_rand() & 1) ? 32767 : -32768); break;
+        case 1:  coef[i] = (xeve_test_rand() % 3) ? 0 : (s16)xeve_test_rand_range(-32, 31); break;
+        case 2:  coef[i] = (s16)xeve_test_rand_range(-32768, 32767); break;
+        default: coef[i] = i > num / 4 ? 0 : (s16)xeve_test_rand_range(-1000, 1000); break;
+        }
+    }
+}
+
+/* parameters derived as in xeve_sub_block_tq() and the RDOQ of both profiles,
+   main = 1 for the scaling of the main profile non-square blocks */
+static void test_quant(const TEST_TIER * t)
+{
+    static s16 src[MAX_TR_DIM];
+    static s16 coef[2][MAX_TR_DIM];
+    static s32 level_double[2][MAX_TR_DIM];
+    static s64 err0[2][MAX_TR_DIM];
+    int it, log2_w, log2_h, main;
+
+    for(it = 0; it < ITER * 8; it++)
+    {
+        for(log2_w = 1; log2_w <= MAX_TR_LOG2; log2_w++)
+        {
+            for(log2_h = 1; log2_h <= MAX_TR_LOG2; log2_h++)
+            {
+                const int num = 1 << (log2_w + log2_h);
+                const int log2_size = (log2_w + log2_h) >> 1;
+                const int ns = (log2_w + log2_h) & 1;
+                const int ns_shift = ns ? 7 : 0;
+                const int ns_scale = ns ? 181 : 1;
+                const int bit_depth = 8 + 2 * ((it >> 2) % 3);
+                const int qp = xeve_test_rand_range(0, 51);
+                const int iqt = xeve_test_rand() & 1;
+                const int scale = xeve_quant_scale[iqt][qp % 6];
+                const int tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - log2_size;
+
+                fill_coef(src, num, it & 3);
+
+                XEVE_TEST_CHECK(xeve_coef_abs_max(src, num) == t->coef_abs_max(src, num),
+                                "coef_abs_max %s: %dx%d, iteration %d\n", t->name, 1 << log2_w, 1 << log2_h, it);
+
+                for(main = 0; main < 2; main++)
+                {
+                    const int shift = QUANT_SHIFT + tr_shift + (main ? ns_shift : 0) + (qp / 6);
+                    const s64 offset = (s64)((it & 8) ? 171 : 85) << (shift - 9);
+                    const int q_value = main ? (scale * ns_scale) >> ns_shift : (scale * ns_scale + (ns ? 1 << (ns_shift - 1) : 0)) >> ns_shift;
+                    const int q_bits = QUANT_SHIFT + tr_shift + (qp / 6);
+                    double err_scale = (double)(1 << SCALE_BITS) * pow(2.0, -tr_shift) / scale / (1 << (bit_depth - 8));
+                    s64 err0_sum[2] = { -1, -2 };
+                    int nnz[2];
+
+                    memcpy(coef[0], src, num * sizeof(s16));
+                    memcpy(coef[1], src, num * sizeof(s16));
+                    nnz[0] = xeve_quant(coef[0], num, scale * (main ? ns_scale : 1), offset, shift);
+                    nnz[1] = t->quant(coef[1], num, scale * (main ? ns_scale : 1), offset, shift);
+                    XEVE_TEST_CHECK(nnz[0] == nnz[1] && !memcmp(coef[0], coef[1], num * sizeof(s16)),
+                                    "quant %s: %dx%d, main %d, qp %d, bd %d, iteration %d\n", t->name, 1 << log2_w, 1 << log2_h, main, qp, bit_depth, it);
+
+                    memset(coef, 0x55, sizeof(coef));
+                    nnz[0] = xeve_rdoq_est_level(src, coef[0], level_double[0], err0[0], num, q_value, q_bits,
+                                                 (s64)(err_scale * (double)(1 << ERR_SCALE_PRECISION_BITS)), &err0_sum[0]);
+                    nnz[1] = t->rdoq_est_level(src, coef[1], level_double[1], err0[1], num, q_value, q_bits,
+                                               (s64)(err_scale * (double)(1 << ERR_SCALE_PRECISION_BITS)), &err0_sum[1]);
+                    XEVE_TEST_CHECK(nnz[0] == nnz[1] && err0_sum[0] == err0_sum[1] &&
+                                    !memcmp(coef[0], coef[1], num * sizeof(s16)) &&
+                                    !memcmp(level_double[0], level_double[1], num * sizeof(s32)) &&
+                                    !memcmp(err0[0], err0[1], num * sizeof(s64)),
+                                    "rdoq_est_level %s: %dx%d, main %d, qp %d, bd %d, iteration %d\n", t->name, 1 << log2_w, 1 << log2_h, main, qp, bit_depth, it);
+                }
+            }
+        }
+    }
+}
+
+/* two pass DCT-II of xeve_trans() */
+static void trans(s16 * coef, int log2_w, int log2_h, int iqt, int bit_depth)
+{
+    static s32 tb[MAX_TR_DIM];
+
+    xeve_tbl_txb[log2_w - 1](coef, tb, 0, 1 << log2_h, 0);
+    xeve_tbl_txb[log2_h - 1](tb, coef, xeve_get_transform_shift(log2_w, 0, bit_depth) + xeve_get_transform_shift(log2_h, 1, bit_depth), 1 << log2_w, 1);
+}
+
+int main(int argc, const char ** argv)
+{
+    int cpu = xeve_check_cpu_info(XEVE_ISA_AUTO);
+    int i;
+
+    for(i = 0; i < (int)(sizeof(tiers) / sizeof(tiers[0])); i++)
+    {
+        if(!(cpu & tiers[i].cpu))
+        {
+            printf("%s is not supported, not tested\n", tiers[i].name);
+            continue;
+        }
+        test_txb(&tiers[i]);
+        if(tiers[i].quant)
+        {
+            test_quant(&tiers[i]);
+        }
+    }
+
+    /* the skip of the transform of zero blocks, with the quantisation of
+       the baseline and of the main profile */
+    xeve_test_zero_block("base", trans, 0, 0, 4);
+    xeve_test_zero_block("main", trans, 0, 1, 4);
+
+    return xeve_test_report("xeve_tq_test");
+}
@@ -0,0 +1,150 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+#include "xeve_test.h"
+
+/* input conversion and horizontal padding kernels of every x86 tier against
+   the C ones */
+
+#define MAX_W                  150
+#define MAX_H                  8
+#define MAX_EXP                80
+#define STRIDE                 (MAX_EXP + MAX_W + MAX_EXP + 3)
+#define ITER                   20
+
+static u8  src8[MAX_H * STRIDE];
+static u16 src16[MAX_H * STRIDE];
+static pel buf[2][MAX_H * STRIDE];
+
+typedef struct _TEST_TIER
+{
+    const char * name;
+    int          cpu;
+    void      (* shl_8b)(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift);
+    void      (* shl_16b)(void *src, int s_src, pel *dst, int s_dst, int w, int h, int shift);
+    void      (* expand_lr)(pel *a, int s, int w, int h, int exp);
+} TEST_TIER;
+
+static const TEST_TIER tiers[] =
+{
+    { "sse",  XEVE_TEST_CPU_SSE,  xeve_plane_shl_8b_sse, xeve_plane_shl_16b_sse, xeve_plane_expand_lr_sse },
+    { "avx2", XEVE_TEST_CPU_AVX2, xeve_plane_shl_8b_avx, xeve_plane_shl_16b_avx, xeve_plane_expand_lr_avx }
+};
+
+/* odd widths and widths around the vector sizes of every tier */
+static const int widths[] = { 1, 3, 4, 7, 8, 9, 15, 16, 17, 31, 32, 33, 47, 48, 63, 64, 65, 97, 128, 149 };
+static const int exps[] = { 1, 3, 7, 8, 9, 15, 16, 17, 24, 31, 32, 33, 40, 80 };
+
+static void test_tier(const TEST_TIER * t)
+{
+    int it, i, k, w, h, exp, shift, bit_depth;
+
+    for(it = 0; it < ITER; it++)
+    {
+        for(k = 0; k < (int)(sizeof(widths) / sizeof(widths[0])); k++)
+        {
+            w = widths[k];
+            h = xeve_test_rand_range(1, MAX_H);
+
+            /* 8-bit input coded at 8, 10 and 12 bits */
+            for(shift = 0; shift <= 4; shift += 2)
+            {
+                for(i = 0; i < MAX_H * STRIDE; i++)
+                {
+                    src8[i] = (u8)xeve_test_rand_range(0, 255);
+                }
+                memset(buf, 0xA5, sizeof(buf));
+                xeve_plane_shl_8b(src8 + 1, STRIDE - 1, buf[0] + 3, STRIDE, w, h, shift);
+                t->shl_8b(src8 + 1, STRIDE - 1, buf[1] + 3, STRIDE, w, h, shift);
+                XEVE_TEST_CHECK(!memcmp(buf[0], buf[1], sizeof(buf[0])),
+                                "shl_8b %s: %dx%d, shift %d, iteration %d\n", t->name, w, h, shift, it);
+            }
+
+            /* 10-bit input coded at 10 and 12 bits, 12-bit input at 12 bits */
+            for(bit_depth = 10; bit_depth <= 12; bit_depth += 2)
+            {
+                for(shift = 0; shift <= 12 - bit_depth; shift += 2)
+                {
+                    for(i = 0; i < MAX_H * STRIDE; i++)
+                    {
+                        src16[i] = (u16)xeve_test_rand_range(0, (1 << bit_depth) - 1);
+                    }
+                    memset(buf, 0xA5, sizeof(buf));
+                    xeve_plane_shl_16b(src16 + 1, STRIDE - 1, buf[0] + 3, STRIDE, w, h, shift);
+                    t->shl_16b(src16 + 1, STRIDE - 1, buf[1] + 3, STRIDE, w, h, shift);
+                    XEVE_TEST_CHECK(!memcmp(buf[0], buf[1], sizeof(buf[0])),
+                                    "shl_16b %s: %dx%d, bd %d, shift %d, iteration %d\n", t->name, w, h, bit_depth, shift, it);
+                }
+            }
+
+            /* the samples outside the expanded area must stay untouched */
+            for(i = 0; i < (int)(sizeof(exps) / sizeof(exps[0])); i++)
+            {
+                exp = exps[i];
+                xeve_test_fill(buf[0], STRIDE, STRIDE, MAX_H, 10, it & 3);
+                memcpy(buf[1], buf[0], sizeof(buf[0]));
+                xeve_plane_expand_lr(buf[0] + MAX_EXP + 1, STRIDE, w, h, exp);
+                t->expand_lr(buf[1] + MAX_EXP + 1, STRIDE, w, h, exp);
+                XEVE_TEST_CHECK(!memcmp(buf[0], buf[1], sizeof(buf[0])),
+                                "expand_lr %s: %dx%d, exp %d, iteration %d\n", t->name, w, h, exp, it);
+            }
+        }
+    }
+}
+
+int main(int argc, const char ** argv)
+{
+    int cpu = xeve_check_cpu_info(XEVE_ISA_AUTO);
+    int tested = 0;
+    int i;
+
+    for(i = 0; i < (int)(sizeof(tiers) / sizeof(tiers[0])); i++)
+    {
+        if(!(cpu & tiers[i].cpu))
+        {
+            printf("%s is not supported, not tested\n", tiers[i].name);
+            continue;
+        }
+        test_tier(&tiers[i]);
+        tested++;
+    }
+    if(!tested)
+    {
+        return XEVE_TEST_SKIP;
+    }
+
+    return xeve_test_report("xeve_util_test");
+}
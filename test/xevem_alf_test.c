@@ -0,0 +1,277 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+#include "xevem_alf_sse.h"
+#include "xevem_alf_avx.h"
+#include "xeve_test.h"
+
+/* ALF classification, filtering and statistics kernels against the C ones */
+
+#define PIC_W                  96
+#define PIC_H                  96
+#define PAD                    8
+#define STRIDE                 (PIC_W + 2 * PAD)
+#define ITER                   200
+
+static pel             pic_buf[(PIC_H + 2 * PAD) * STRIDE];
+static pel             org_buf[(PIC_H + 2 * PAD) * STRIDE];
+static pel             dst_buf[2][(PIC_H + 2 * PAD) * STRIDE];
+static ALF_CLASSIFIER  cls_buf[2][PIC_H][PIC_W];
+static ALF_CLASSIFIER *cls[2][PIC_H];
+
+#define PIC(buf)               ((buf) + PAD * STRIDE + PAD)
+
+static void test_classification(int bit_depth)
+{
+    int it, i;
+
+    for(it = 0; it < ITER; it++)
+    {
+        AREA blk;
+
+        xeve_test_fill(pic_buf, STRIDE, STRIDE, PIC_H + 2 * PAD, bit_depth, it & 3);
+        blk.width = xeve_test_rand_range(1, CLASSIFICATION_BLK_SIZE / 4) * 4;
+        blk.height = xeve_test_rand_range(1, CLASSIFICATION_BLK_SIZE / 4) * 4;
+        blk.x = xeve_test_rand_range(0, (PIC_W - blk.width) / 4) * 4;
+        blk.y = xeve_test_rand_range(0, (PIC_H - blk.height) / 4) * 4;
+        memset(cls_buf, 0xAA, sizeof(cls_buf));
+
+        alf_derive_classification_blk(cls[0], PIC(pic_buf), STRIDE, &blk, bit_depth + 4, bit_depth);
+        alf_derive_classification_blk_sse(cls[1], PIC(pic_buf), STRIDE, &blk, bit_depth + 4, bit_depth);
+
+        for(i = 0; i < PIC_H; i++)
+        {
+            XEVE_TEST_CHECK(!memcmp(cls[0][i], cls[1][i], PIC_W),
+                            "classification: bd %d, %dx%d at (%d,%d), row %d\n", bit_depth, blk.width, blk.height, blk.x, blk.y, i);
+        }
+    }
+}
+
+static void test_filter(int bit_depth, int luma)
+{
+    short filter_set[MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF];
+    CLIP_RANGE clip_range;
+    int it, i, j;
+
+    clip_range.min = 0;
+    clip_range.max = (1 << bit_depth) - 1;
+    clip_range.bd = bit_depth;
+    clip_range.n = 0;
+
+    for(it = 0; it < ITER; it++)
+    {
+        AREA blk;
+        pel * src;
+
+        xeve_test_fill(pic_buf, STRIDE, STRIDE, PIC_H + 2 * PAD, bit_depth, it & 3);
+        for(i = 0; i < MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF; i++)
+        {
+            /* coefficients of 8 bits, extreme ones on some iterations */
+            filter_set[i] = (short)((it % 5 == 4) ? ((xeve_test_rand() & 1) ? 127 : -128) : xeve_test_rand_range(-128, 127));
+        }
+        for(i = 0; i < PIC_H; i++)
+        {
+            for(j = 0; j < PIC_W; j++)
+            {
+                /* classes change every 4x4 block as in the classification */
+                cls_buf[0][i][j] = (ALF_CLASSIFIER)((xeve_test_rand_range(0, MAX_NUM_ALF_CLASSES - 1) << 2) | (xeve_test_rand() & 3));
+                cls_buf[0][i][j] = cls_buf[0][i & ~3][j & ~3];
+            }
+        }
+
+        if(luma)
+        {
+            blk.width = xeve_test_rand_range(1, 16) * 4;
+            blk.height = xeve_test_rand_range(1, 16) * 4;
+            blk.x = xeve_test_rand_range(0, (PIC_W - blk.width) / 4) * 4;
+            blk.y = xeve_test_rand_range(0, (PIC_H - blk.height) / 4) * 4;
+        }
+        else
+        {
+            blk.width = xeve_test_rand_range(1, 40);
+            blk.height = xeve_test_rand_range(1, 40);
+            blk.x = xeve_test_rand_range(0, PIC_W - blk.width);
+            blk.y = xeve_test_rand_range(0, PIC_H - blk.height);
+        }
+        memset(dst_buf, 0, sizeof(dst_buf));
+        src = PIC(pic_buf) + blk.y * STRIDE + blk.x;
+
+        if(luma)
+        {
+            alf_filter_blk_7(cls[0], PIC(dst_buf[0]) + blk.y * STRIDE + blk.x, STRIDE, src, STRIDE, &blk, Y_C, filter_set, &clip_range);
+            alf_filter_blk_7_sse(cls[0], PIC(dst_buf[1]) + blk.y * STRIDE + blk.x, STRIDE, src, STRIDE, &blk, Y_C, filter_set, &clip_range);
+        }
+        else
+        {
+            alf_filter_blk_5(NULL, PIC(dst_buf[0]) + blk.y * STRIDE + blk.x, STRIDE, src, STRIDE, &blk, U_C, filter_set, &clip_range);
+            alf_filter_blk_5_sse(NULL, PIC(dst_buf[1]) + blk.y * STRIDE + blk.x, STRIDE, src, STRIDE, &blk, U_C, filter_set, &clip_range);
+        }
+
+        XEVE_TEST_CHECK(!memcmp(dst_buf[0], dst_buf[1], sizeof(dst_buf[0])),
+                        "filter %d: bd %d, %dx%d at (%d,%d)\n", luma ? 7 : 5, bit_depth, blk.width, blk.height, blk.x, blk.y);
+    }
+}
+
+static int cov_equal(ALF_COVARIANCE * a, ALF_COVARIANCE * b, int num_classes)
+{
+    int c, k, l;
+
+    for(c = 0; c < num_classes; c++)
+    {
+        if(a[c].pix_acc != b[c].pix_acc)
+        {
+            return 0;
+        }
+        for(k = 0; k < a[c].num_coef; k++)
+        {
+            if(a[c].y[k] != b[c].y[k])
+            {
+                return 0;
+            }
+            for(l = 0; l < a[c].num_coef; l++)
+            {
+                if(a[c].E[k][l] != b[c].E[k][l])
+                {
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+static void test_stats(int bit_depth, int ch, int size)
+{
+    static ALF_COVARIANCE cov[2][MAX_NUM_ALF_CLASSES];
+    ALF_FILTER_SHAPE shape;
+    const int num_classes = ch ? 1 : MAX_NUM_ALF_CLASSES;
+    int it, i, j, n, c;
+
+    alf_init_filter_shape(&shape, size);
+    for(n = 0; n < 2; n++)
+    {
+        for(c = 0; c < MAX_NUM_ALF_CLASSES; c++)
+        {
+            alf_cov_create(&cov[n][c], shape.num_coef);
+        }
+    }
+
+    for(it = 0; it < ITER; it++)
+    {
+        /* classes per 4x4 block or per sample, to break the sample groups */
+        for(i = 0; i < PIC_H; i++)
+        {
+            for(j = 0; j < PIC_W; j++)
+            {
+                cls_buf[0][i][j] = (ALF_CLASSIFIER)((xeve_test_rand_range(0, MAX_NUM_ALF_CLASSES - 1) << 2) | (xeve_test_rand() & 3));
+                if(it & 1)
+                {
+                    cls_buf[0][i][j] = cls_buf[0][i & ~3][j & ~3];
+                }
+            }
+        }
+        for(c = 0; c < MAX_NUM_ALF_CLASSES; c++)
+        {
+            alf_cov_reset(&cov[0][c]);
+            alf_cov_reset(&cov[1][c]);
+        }
+
+        /* two blocks accumulated into the same statistics */
+        for(n = 0; n < 2; n++)
+        {
+            int w = xeve_test_rand_range(1, ch ? PIC_W / 2 : PIC_W);
+            int h = xeve_test_rand_range(1, ch ? PIC_H / 2 : PIC_H);
+            int x = xeve_test_rand_range(0, (ch ? PIC_W / 2 : PIC_W) - w);
+            int y = xeve_test_rand_range(0, (ch ? PIC_H / 2 : PIC_H) - h);
+
+            xeve_test_fill(pic_buf, STRIDE, STRIDE, PIC_H + 2 * PAD, bit_depth, (it >> 1) & 3);
+            xeve_test_fill(org_buf, STRIDE, STRIDE, PIC_H + 2 * PAD, bit_depth, 0);
+
+            xeve_alf_get_blk_stats(ch, cov[0], &shape, ch ? NULL : cls[0], PIC(org_buf), STRIDE, PIC(pic_buf), STRIDE, x, y, w, h);
+            xeve_alf_get_blk_stats_avx(ch, cov[1], &shape, ch ? NULL : cls[0], PIC(org_buf), STRIDE, PIC(pic_buf), STRIDE, x, y, w, h);
+        }
+
+        XEVE_TEST_CHECK(cov_equal(cov[0], cov[1], num_classes),
+                        "statistics: bd %d, ch %d, %dx%d filter, iteration %d\n", bit_depth, ch, size, size, it);
+    }
+
+    for(n = 0; n < 2; n++)
+    {
+        for(c = 0; c < MAX_NUM_ALF_CLASSES; c++)
+        {
+            alf_cov_destroy(&cov[n][c]);
+        }
+    }
+}
+
+int main(int argc, const char ** argv)
+{
+    int cpu = xeve_check_cpu_info(XEVE_ISA_AUTO);
+    int i, bit_depth;
+
+    if(!(cpu & XEVE_TEST_CPU_SSE))
+    {
+        printf("SSE4.1 is not supported, test skipped\n");
+        return XEVE_TEST_SKIP;
+    }
+    for(i = 0; i < PIC_H; i++)
+    {
+        cls[0][i] = cls_buf[0][i];
+        cls[1][i] = cls_buf[1][i];
+    }
+
+    for(bit_depth = 8; bit_depth <= 12; bit_depth += 2)
+    {
+        test_classification(bit_depth);
+        test_filter(bit_depth, 1);
+        test_filter(bit_depth, 0);
+    }
+    if(cpu & XEVE_TEST_CPU_AVX2)
+    {
+        for(bit_depth = 8; bit_depth <= 10; bit_depth += 2)
+        {
+            test_stats(bit_depth, 0, 7);
+            test_stats(bit_depth, 0, 5);
+            test_stats(bit_depth, 1, 5);
+        }
+    }
+    else
+    {
+        printf("AVX2 is not supported, statistics not tested\n");
+    }
+
+    return xeve_test_report("xevem_alf_test");
+}
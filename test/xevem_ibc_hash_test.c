@@ -0,0 +1,101 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+#include "xevem_ibc_hash.h"
+#include "xevem_ibc_hash_avx.h"
+#include "xeve_test.h"
+
+/* CRC32C block key of the IBC hash search against the C one */
+
+#define STRIDE_L               37
+#define STRIDE_C               19
+#define ITER                   20000
+
+static pel y_buf[MIN_CU_SIZE * STRIDE_L];
+static pel u_buf[(MIN_CU_SIZE >> 1) * STRIDE_C];
+static pel v_buf[(MIN_CU_SIZE >> 1) * STRIDE_C];
+
+/* fills one plane with samples of bit_depth bits, mode as for xeve_test_fill()
+   and 4 - any non-negative pel value, so that both bytes of a sample reach
+   the key */
+static void fill(pel * buf, int stride, int w, int h, int bit_depth, int mode)
+{
+    int i;
+
+    if(mode < 4)
+    {
+        xeve_test_fill(buf, stride, w, h, bit_depth, mode);
+        return;
+    }
+    for(i = 0; i < stride * h; i++)
+    {
+        buf[i] = (pel)xeve_test_rand_range(0, 32767);
+    }
+}
+
+int main(int argc, const char ** argv)
+{
+    int it, bit_depth, mode, k;
+    u32 key[2];
+
+    if(!(xeve_check_cpu_info(XEVE_ISA_AUTO) & XEVE_TEST_CPU_AVX2))
+    {
+        printf("AVX2 is not supported, test skipped\n");
+        return XEVE_TEST_SKIP;
+    }
+
+    for(it = 0; it < ITER; it++)
+    {
+        for(bit_depth = 8; bit_depth <= 12; bit_depth += 2)
+        {
+            mode = it % 5;
+            fill(y_buf, STRIDE_L, STRIDE_L, MIN_CU_SIZE, bit_depth, mode);
+            fill(u_buf, STRIDE_C, STRIDE_C, MIN_CU_SIZE >> 1, bit_depth, mode);
+            fill(v_buf, STRIDE_C, STRIDE_C, MIN_CU_SIZE >> 1, bit_depth, mode);
+
+            /* every horizontal position, so the loads are misaligned too */
+            for(k = 0; k + MIN_CU_SIZE <= STRIDE_C; k++)
+            {
+                key[0] = xeve_ibc_hash_block_key(y_buf + 2 * k, STRIDE_L, u_buf + k, v_buf + k, STRIDE_C);
+                key[1] = xeve_ibc_hash_block_key_avx(y_buf + 2 * k, STRIDE_L, u_buf + k, v_buf + k, STRIDE_C);
+                XEVE_TEST_CHECK(key[0] == key[1], "ibc hash key: position %d, mode %d, bd %d, iteration %d: %08x != %08x\n",
+                                k, mode, bit_depth, it, key[0], key[1]);
+            }
+        }
+    }
+
+    return xeve_test_report("xevem_ibc_hash_test");
+}
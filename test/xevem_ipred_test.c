@@ -0,0 +1,105 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+#include "xevem_ipred_sse.h"
+#include "xeve_test.h"
+
+/* angular intra prediction kernels of the main profile against the C ones */
+
+#define ITER                   6
+
+static pel nb[N_REF][MAX_CU_SIZE * 3];
+static pel dst[2][MAX_CU_DIM];
+
+int main(int argc, const char ** argv)
+{
+    int bit_depth, it, log2_w, log2_h, ipm, avail_lr, i, j;
+
+    if(!(xeve_check_cpu_info(XEVE_ISA_AUTO) & XEVE_TEST_CPU_SSE))
+    {
+        printf("SSE4.1 is not supported, test skipped\n");
+        return XEVE_TEST_SKIP;
+    }
+
+    for(bit_depth = 8; bit_depth <= 12; bit_depth += 2)
+    {
+        for(it = 0; it < ITER; it++)
+        {
+            for(log2_w = 1; log2_w <= MAX_CU_LOG2; log2_w++)
+            {
+                for(log2_h = 1; log2_h <= MAX_CU_LOG2; log2_h++)
+                {
+                    const int w = 1 << log2_w;
+                    const int h = 1 << log2_h;
+                    /* neighbours laid out as for xevem_ipred() */
+                    pel * src_le = nb[0] + 2;
+                    pel * src_up = nb[1] + h;
+                    pel * src_ri = nb[2] + 2;
+
+                    for(i = 0; i < N_REF; i++)
+                    {
+                        xeve_test_fill(nb[i], MAX_CU_SIZE * 3, MAX_CU_SIZE * 3, 1, bit_depth, it == 0 ? 1 : (it == 1 ? 2 : 0));
+                    }
+
+                    for(ipm = IPD_BI + 1; ipm < IPD_CNT; ipm++)
+                    {
+                        const int func_ipm = (ipm < IPD_VER ? 0 : (ipm > IPD_HOR ? 1 : 2));
+
+                        if(ipm == IPD_VER || ipm == IPD_HOR)
+                        {
+                            continue;
+                        }
+                        for(avail_lr = LR_00; avail_lr <= LR_11; avail_lr++)
+                        {
+                            const int func_lr = func_ipm < 2 ? ((avail_lr >> 1) & 1) : (avail_lr == LR_01);
+
+                            for(j = 0; j < 2; j++)
+                            {
+                                memset(dst[j], 0x5A, sizeof(dst[j]));
+                            }
+                            xeve_tbl_intra_pred_ang[func_ipm][func_lr](src_le, src_up, src_ri, avail_lr, dst[0], w, h, ipm, bit_depth);
+                            xeve_tbl_intra_pred_ang_sse[func_ipm][func_lr](src_le, src_up, src_ri, avail_lr, dst[1], w, h, ipm, bit_depth);
+                            XEVE_TEST_CHECK(!memcmp(dst[0], dst[1], sizeof(dst[0])),
+                                            "angular: %dx%d, ipm %d, avail_lr %d, bd %d, iteration %d\n", w, h, ipm, avail_lr, bit_depth, it);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return xeve_test_report("xevem_ipred_test");
+}
@@ -0,0 +1,94 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_type.h"
+#include "xeve_test.h"
+
+/* AVX-512 motion compensation kernels of the main profile against the C
+   ones: the luma and chroma kernels with the coefficients of the main
+   profile, the DMVR kernels and the bilinear kernels. blocks narrower than
+   16 samples go through the fallback of the AVX-512 kernels, the other widths
+   include tails that are not a multiple of the vector width */
+
+#define ITER                   4
+
+static const int widths_l[] = { 4, 8, 16, 20, 24, 32, 40, 48, 64, 72, 100, 128 };
+static const int widths_c[] = { 2, 4, 8, 16, 20, 24, 32, 36, 40, 64, 68, 128 };
+/* the bilinear kernels also predict the padded blocks of DMVR and MMVD */
+static const int widths_bl[] = { 4, 8, 12, 16, 20, 24, 36, 40, 68, 72, 100, 132, 192 };
+
+static void mc_l(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth, int simd)
+{
+    const XEVE_MC_L (* tbl)[2] = simd ? xeve_tbl_mc_l_avx512 : xeve_tbl_mc_l;
+
+    tbl[(gmv_x & 15) != 0][(gmv_y & 15) != 0](ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, xevem_tbl_mc_l_coeff);
+}
+
+static void mc_c(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth, int simd)
+{
+    const XEVE_MC_C (* tbl)[2] = simd ? xeve_tbl_mc_c_avx512 : xeve_tbl_mc_c;
+
+    tbl[(gmv_x & 31) != 0][(gmv_y & 31) != 0](ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth, xevem_tbl_mc_c_coeff);
+}
+
+static void dmvr_mc_l(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth, int simd)
+{
+    const XEVEM_MC (* tbl)[2] = simd ? xeve_tbl_dmvr_mc_l_avx512 : xevem_tbl_dmvr_mc_l;
+
+    tbl[(gmv_x & 15) != 0][(gmv_y & 15) != 0](ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth);
+}
+
+static void bl_mc_l(pel * ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel * pred, int w, int h, int bit_depth, int simd)
+{
+    const XEVEM_MC (* tbl)[2] = simd ? xeve_tbl_bl_mc_l_avx512 : xevem_tbl_bl_mc_l;
+
+    tbl[(gmv_x & 15) != 0][(gmv_y & 15) != 0](ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth);
+}
+
+int main(int argc, const char ** argv)
+{
+    if(!(xeve_check_cpu_info(XEVE_ISA_AUTO) & XEVE_TEST_CPU_AVX512))
+    {
+        printf("AVX-512 is not supported, test skipped\n");
+        return XEVE_TEST_SKIP;
+    }
+
+    xeve_test_mc("luma", mc_l, 4, widths_l, sizeof(widths_l) / sizeof(widths_l[0]), MAX_CU_SIZE, ITER);
+    xeve_test_mc("chroma", mc_c, 5, widths_c, sizeof(widths_c) / sizeof(widths_c[0]), MAX_CU_SIZE, ITER);
+    xeve_test_mc("dmvr", dmvr_mc_l, 4, widths_l, sizeof(widths_l) / sizeof(widths_l[0]), MAX_CU_SIZE, ITER);
+    xeve_test_mc("bilinear", bl_mc_l, 4, widths_bl, sizeof(widths_bl) / sizeof(widths_bl[0]), MAX_CU_SIZE + OPT_MC_BI_PAD * 2, ITER);
+
+    return xeve_test_report("xevem_mc_test");
+}